@@ -0,0 +1,147 @@
+/**
+ * @file camera_path.cpp
+ * @brief Implementation of CameraPath spline evaluation.
+ */
+
+#include "camera_path.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Knot spacing below this is treated as coincident points
+    constexpr float MIN_KNOT_INTERVAL = 1e-4f;
+
+    // Centripetal knot interval: sqrt of the chord length (alpha = 0.5)
+    float knotInterval(const Vector3 &a, const Vector3 &b)
+    {
+        return std::max(std::sqrt((b - a).Magnitude()), MIN_KNOT_INTERVAL);
+    }
+
+    /**
+     * Point between p1 and p2 at u in [0, 1] (Barry-Goldman pyramid).
+     * Centripetal parameterization avoids cusps and self-intersections
+     * where keyframes are unevenly spaced.
+     */
+    Vector3 centripetalCatmullRom(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, const Vector3 &p3, float u)
+    {
+        const float t0 = 0.0f;
+        const float t1 = t0 + knotInterval(p0, p1);
+        const float t2 = t1 + knotInterval(p1, p2);
+        const float t3 = t2 + knotInterval(p2, p3);
+        const float t = t1 + (t2 - t1) * u;
+
+        const Vector3 a1 = p0 * ((t1 - t) / (t1 - t0)) + p1 * ((t - t0) / (t1 - t0));
+        const Vector3 a2 = p1 * ((t2 - t) / (t2 - t1)) + p2 * ((t - t1) / (t2 - t1));
+        const Vector3 a3 = p2 * ((t3 - t) / (t3 - t2)) + p3 * ((t - t2) / (t3 - t2));
+        const Vector3 b1 = a1 * ((t2 - t) / (t2 - t0)) + a2 * ((t - t0) / (t2 - t0));
+        const Vector3 b2 = a2 * ((t3 - t) / (t3 - t1)) + a3 * ((t - t1) / (t3 - t1));
+        return b1 * ((t2 - t) / (t2 - t1)) + b2 * ((t - t1) / (t2 - t1));
+    }
+
+    // Uniform Catmull-Rom for scalars (FOV)
+    float catmullRom(float p0, float p1, float p2, float p3, float u)
+    {
+        const float u2 = u * u;
+        const float u3 = u2 * u;
+        return 0.5f * ((2.0f * p1) + (p2 - p0) * u + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+                       (3.0f * p1 - p0 - 3.0f * p2 + p3) * u3);
+    }
+}
+
+CameraPath::CameraPath(const std::string &name)
+    : m_name(name)
+{
+}
+
+void CameraPath::addKeyframe(const CameraKeyframe &keyframe)
+{
+    const auto it = std::lower_bound(m_times.begin(), m_times.end(), keyframe.time);
+    const size_t index = static_cast<size_t>(it - m_times.begin());
+
+    if (it != m_times.end() && *it == keyframe.time)
+    {
+        m_offsets[index] = keyframe.offset;
+        m_rotations[index] = keyframe.rotation;
+        m_fovs[index] = keyframe.fovDegrees;
+        return;
+    }
+
+    m_times.insert(it, keyframe.time);
+    m_offsets.insert(m_offsets.begin() + index, keyframe.offset);
+    m_rotations.insert(m_rotations.begin() + index, keyframe.rotation);
+    m_fovs.insert(m_fovs.begin() + index, keyframe.fovDegrees);
+}
+
+CameraKeyframe CameraPath::keyframe(size_t index) const
+{
+    return {m_times[index], m_offsets[index], m_rotations[index], m_fovs[index]};
+}
+
+void CameraPath::clear()
+{
+    m_times.clear();
+    m_offsets.clear();
+    m_rotations.clear();
+    m_fovs.clear();
+}
+
+size_t CameraPath::findSegment(float time, size_t &cursor) const
+{
+    // Segment i spans [m_times[i], m_times[i + 1]); callers guarantee size() >= 2
+    const size_t last_segment = m_times.size() - 2;
+
+    if (cursor <= last_segment && m_times[cursor] <= time)
+    {
+        if (time < m_times[cursor + 1] || cursor == last_segment)
+            return cursor;
+        if (cursor + 1 <= last_segment && time < m_times[cursor + 2])
+            return ++cursor;
+    }
+
+    const auto it = std::upper_bound(m_times.begin(), m_times.end(), time);
+    const size_t after = static_cast<size_t>(it - m_times.begin());
+    cursor = std::min(after > 0 ? after - 1 : 0, last_segment);
+    return cursor;
+}
+
+CameraPath::Sample CameraPath::evaluate(float time, size_t &cursor) const
+{
+    if (m_times.empty())
+        return {Vector3(), Quaternion::Identity(), 0.0f};
+    if (m_times.size() == 1)
+        return {m_offsets[0], m_rotations[0], m_fovs[0]};
+
+    time = std::clamp(time, m_times.front(), m_times.back());
+    const size_t i = findSegment(time, cursor);
+    const size_t n = m_times.size();
+
+    const float span = m_times[i + 1] - m_times[i];
+    const float u = span > 0.0f ? std::clamp((time - m_times[i]) / span, 0.0f, 1.0f) : 1.0f;
+
+    // Missing neighbours at the ends are mirrored, so the path starts and ends along its first/last chord
+    const Vector3 &p1 = m_offsets[i];
+    const Vector3 &p2 = m_offsets[i + 1];
+    const Vector3 p0 = i > 0 ? m_offsets[i - 1] : p1 * 2.0f - p2;
+    const Vector3 p3 = i + 2 < n ? m_offsets[i + 2] : p2 * 2.0f - p1;
+
+    Sample sample;
+    sample.offset = centripetalCatmullRom(p0, p1, p2, p3, u);
+    sample.rotation = Quaternion::Slerp(m_rotations[i], m_rotations[i + 1], u);
+
+    // FOV only where both ends set one; otherwise hold the value that is set
+    const float f1 = m_fovs[i];
+    const float f2 = m_fovs[i + 1];
+    if (f1 > 0.0f && f2 > 0.0f)
+    {
+        const float f0 = (i > 0 && m_fovs[i - 1] > 0.0f) ? m_fovs[i - 1] : f1;
+        const float f3 = (i + 2 < n && m_fovs[i + 2] > 0.0f) ? m_fovs[i + 2] : f2;
+        sample.fovDegrees = catmullRom(f0, f1, f2, f3, u);
+    }
+    else
+    {
+        sample.fovDegrees = f1 > 0.0f ? f1 : f2;
+    }
+    return sample;
+}
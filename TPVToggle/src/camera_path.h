@@ -0,0 +1,85 @@
+/**
+ * @file camera_path.h
+ * @brief Keyframed camera paths evaluated with a centripetal Catmull-Rom spline.
+ *
+ * Keyframes are stored as parallel arrays (times, offsets, rotations, FOVs),
+ * so the per-frame time search touches only the packed time array. Evaluation
+ * finds the segment by binary search (O(log n)); a caller-held cursor makes
+ * sequential playback O(1) by checking the current and next segment first.
+ */
+#ifndef CAMERA_PATH_H
+#define CAMERA_PATH_H
+
+#include "math_utils.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @struct CameraKeyframe
+ * @brief One captured camera state on a path.
+ */
+struct CameraKeyframe
+{
+    float time;         // Seconds from the start of the path
+    Vector3 offset;     // Local camera offset (as g_currentCameraOffset)
+    Quaternion rotation; // Local rotation applied on top of the game camera
+    float fovDegrees;   // TPV FOV; <= 0 leaves the FOV alone
+};
+
+/**
+ * @class CameraPath
+ * @brief A named, time-ordered list of keyframes.
+ */
+class CameraPath
+{
+public:
+    /**
+     * @struct Sample
+     * @brief Camera state at one point in time.
+     */
+    struct Sample
+    {
+        Vector3 offset;
+        Quaternion rotation;
+        float fovDegrees; // <= 0 if no keyframe sets an FOV
+    };
+
+    explicit CameraPath(const std::string &name = "");
+
+    /**
+     * @brief Inserts a keyframe, keeping times ordered.
+     * @details A keyframe at the same time as an existing one replaces it.
+     */
+    void addKeyframe(const CameraKeyframe &keyframe);
+
+    /** @brief Copy of keyframe i. */
+    CameraKeyframe keyframe(size_t index) const;
+
+    /**
+     * @brief Camera state at a time (clamped to the path's time range).
+     * @param time Seconds from the start of the path.
+     * @param cursor Segment hint carried between calls; start it at 0.
+     */
+    Sample evaluate(float time, size_t &cursor) const;
+
+    const std::string &name() const { return m_name; }
+    void setName(const std::string &name) { m_name = name; }
+    size_t size() const { return m_times.size(); }
+    bool empty() const { return m_times.empty(); }
+    /** @brief Time of the last keyframe. */
+    float duration() const { return m_times.empty() ? 0.0f : m_times.back(); }
+    void clear();
+
+private:
+    size_t findSegment(float time, size_t &cursor) const;
+
+    std::string m_name;
+    std::vector<float> m_times;
+    std::vector<Vector3> m_offsets;
+    std::vector<Quaternion> m_rotations;
+    std::vector<float> m_fovs;
+};
+
+#endif // CAMERA_PATH_H
@@ -0,0 +1,309 @@
+/**
+ * @file camera_path_manager.cpp
+ * @brief Implementation of camera path recording, persistence and playback.
+ */
+
+#include "camera_path_manager.h"
+#include "global_state.h"
+#include "logger.h"
+#include "utils.h"
+#include "hooks/fov_hook.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+    bool numberFromJson(const json &obj, const char *key, float &out)
+    {
+        auto it = obj.find(key);
+        if (it == obj.end() || !it->is_number())
+            return false;
+        out = it->get<float>();
+        return std::isfinite(out);
+    }
+
+    bool vectorFromJson(const json &obj, Vector3 &out)
+    {
+        return obj.is_object() && numberFromJson(obj, "x", out.x) && numberFromJson(obj, "y", out.y) &&
+               numberFromJson(obj, "z", out.z);
+    }
+
+    bool rotationFromJson(const json &obj, Quaternion &out)
+    {
+        if (!obj.is_object() || !numberFromJson(obj, "x", out.x) || !numberFromJson(obj, "y", out.y) ||
+            !numberFromJson(obj, "z", out.z) || !numberFromJson(obj, "w", out.w))
+            return false;
+        const float length = std::sqrt(out.x * out.x + out.y * out.y + out.z * out.z + out.w * out.w);
+        if (length < 1e-6f)
+            return false;
+        out = Quaternion(out.x / length, out.y / length, out.z / length, out.w / length);
+        return true;
+    }
+
+    bool keyframeFromJson(const json &obj, CameraKeyframe &out)
+    {
+        out.rotation = Quaternion::Identity();
+        out.fovDegrees = 0.0f;
+        if (!obj.is_object() || !numberFromJson(obj, "time", out.time) || out.time < 0.0f ||
+            !obj.contains("offset") || !vectorFromJson(obj["offset"], out.offset))
+            return false;
+        if (obj.contains("rotation") && !rotationFromJson(obj["rotation"], out.rotation))
+            return false;
+        if (obj.contains("fov") && !numberFromJson(obj, "fov", out.fovDegrees))
+            return false;
+        return true;
+    }
+
+    json keyframeToJson(const CameraKeyframe &keyframe)
+    {
+        json obj;
+        obj["time"] = keyframe.time;
+        obj["offset"] = {{"x", keyframe.offset.x}, {"y", keyframe.offset.y}, {"z", keyframe.offset.z}};
+        obj["rotation"] = {{"x", keyframe.rotation.x}, {"y", keyframe.rotation.y},
+                           {"z", keyframe.rotation.z}, {"w", keyframe.rotation.w}};
+        if (keyframe.fovDegrees > 0.0f)
+            obj["fov"] = keyframe.fovDegrees;
+        return obj;
+    }
+}
+
+CameraPathManager &CameraPathManager::getInstance()
+{
+    static CameraPathManager instance;
+    return instance;
+}
+
+CameraPathManager::CameraPathManager()
+    : m_currentPath(0),
+      m_keyframeSpacing(Constants::CAMERA_PATH_DEFAULT_SPACING),
+      m_playRequested(false),
+      m_playSequence(0),
+      m_isPlayingFlag(false),
+      m_finishedSequence(0),
+      m_playingSequence(0),
+      m_playTime(0.0f),
+      m_cursor(0)
+{
+}
+
+bool CameraPathManager::loadPaths(const std::string &directory, float keyframeSpacing)
+{
+    Logger &logger = Logger::getInstance();
+    const std::filesystem::path path = std::filesystem::path(directory) / (std::string(Constants::MOD_NAME) + "_Paths.json");
+    const std::string path_string = path.lexically_normal().string();
+
+    std::vector<CameraPath> paths;
+
+    if (!std::filesystem::exists(path))
+    {
+        logger.log(LOG_INFO, "CameraPathManager: No paths file at " + path_string + ". Paths are created on first capture.");
+    }
+    else
+    {
+        try
+        {
+            std::ifstream file(path);
+            if (!file.is_open())
+            {
+                logger.log(LOG_ERROR, "CameraPathManager: Failed to open paths file: " + path_string);
+                return false;
+            }
+            const json root = json::parse(file);
+            if (!root.is_array())
+            {
+                logger.log(LOG_ERROR, "CameraPathManager: Paths file must contain an array: " + path_string);
+                return false;
+            }
+
+            paths.reserve(root.size());
+            for (size_t i = 0; i < root.size(); ++i)
+            {
+                const json &entry = root[i];
+                if (!entry.is_object() || !entry.contains("keyframes") || !entry["keyframes"].is_array())
+                {
+                    logger.log(LOG_WARNING, "CameraPathManager: Skipping path #" + std::to_string(i) + ": missing \"keyframes\" array.");
+                    continue;
+                }
+
+                const auto name = entry.find("name");
+                CameraPath camera_path(name != entry.end() && name->is_string() ? name->get<std::string>()
+                                                                                : "Path " + std::to_string(paths.size() + 1));
+                const json &keyframes = entry["keyframes"];
+                for (size_t k = 0; k < keyframes.size(); ++k)
+                {
+                    CameraKeyframe keyframe;
+                    if (keyframeFromJson(keyframes[k], keyframe))
+                        camera_path.addKeyframe(keyframe);
+                    else
+                        logger.log(LOG_WARNING, "CameraPathManager: Skipping keyframe #" + std::to_string(k) + " of '" +
+                                                    camera_path.name() + "': needs a non-negative \"time\" and an \"offset\".");
+                }
+                paths.push_back(std::move(camera_path));
+            }
+        }
+        catch (const std::exception &e)
+        {
+            logger.log(LOG_ERROR, "CameraPathManager: Error reading paths file: " + std::string(e.what()) + ". File: " + path_string);
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_filePath = path_string;
+    m_keyframeSpacing = keyframeSpacing > 0.0f ? keyframeSpacing : Constants::CAMERA_PATH_DEFAULT_SPACING;
+    m_paths = std::move(paths);
+    m_currentPath = 0;
+    if (!m_paths.empty())
+    {
+        logger.log(LOG_INFO, "CameraPathManager: Loaded " + std::to_string(m_paths.size()) + " camera paths.");
+    }
+    return true;
+}
+
+CameraPath &CameraPathManager::currentPathLocked()
+{
+    if (m_paths.empty())
+    {
+        m_paths.emplace_back("Path 1");
+        m_currentPath = 0;
+    }
+    return m_paths[m_currentPath];
+}
+
+bool CameraPathManager::savePathsLocked() const
+{
+    json root = json::array();
+    for (const CameraPath &path : m_paths)
+    {
+        json keyframes = json::array();
+        for (size_t i = 0; i < path.size(); ++i)
+            keyframes.push_back(keyframeToJson(path.keyframe(i)));
+        root.push_back({{"name", path.name()}, {"keyframes", std::move(keyframes)}});
+    }
+    return replaceFileContents(m_filePath, root.dump(4));
+}
+
+void CameraPathManager::captureKeyframe()
+{
+    Logger &logger = Logger::getInstance();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_filePath.empty())
+    {
+        logger.log(LOG_WARNING, "CameraPathManager: Capture ignored: paths were not loaded.");
+        return;
+    }
+
+    CameraPath &path = currentPathLocked();
+
+    CameraKeyframe keyframe;
+    keyframe.time = path.empty() ? 0.0f : path.duration() + m_keyframeSpacing;
+    keyframe.offset = g_currentCameraOffset.load();
+    keyframe.rotation = Quaternion::Identity(); // No live rotation control yet; editable in the file
+    keyframe.fovDegrees = std::max(0.0f, getConfiguredTpvFov());
+    path.addKeyframe(keyframe);
+
+    logger.log(LOG_INFO, "CameraPathManager: Captured keyframe " + std::to_string(path.size()) + " of '" + path.name() +
+                             "' at " + std::to_string(keyframe.time) + "s, offset " + Vector3ToString(keyframe.offset) + ".");
+    savePathsLocked();
+}
+
+void CameraPathManager::newPath()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_paths.emplace_back("Path " + std::to_string(m_paths.size() + 1));
+    m_currentPath = m_paths.size() - 1;
+    Logger::getInstance().log(LOG_INFO, "CameraPathManager: Started new path '" + m_paths.back().name() + "'.");
+}
+
+void CameraPathManager::cycleToNextPath()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_paths.empty())
+    {
+        Logger::getInstance().log(LOG_INFO, "CameraPathManager: No camera paths to cycle.");
+        return;
+    }
+    m_currentPath = (m_currentPath + 1) % m_paths.size();
+    const CameraPath &path = m_paths[m_currentPath];
+    Logger::getInstance().log(LOG_INFO, "CameraPathManager: Current path is '" + path.name() + "' (" +
+                                            std::to_string(path.size()) + " keyframes, " + std::to_string(path.duration()) + "s).");
+}
+
+void CameraPathManager::togglePlayback()
+{
+    Logger &logger = Logger::getInstance();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // A play is still on unless the render thread has since played it to the end
+    const bool playing = m_playRequested && m_finishedSequence.load(std::memory_order_acquire) != m_playSequence;
+
+    Command command;
+    if (!playing)
+    {
+        if (m_paths.empty() || m_paths[m_currentPath].size() < 2)
+        {
+            logger.log(LOG_INFO, "CameraPathManager: The current path needs at least 2 keyframes to play.");
+            return;
+        }
+        command.path = std::make_shared<const CameraPath>(m_paths[m_currentPath]); // Snapshot; later edits do not affect it
+        command.sequence = m_playSequence + 1;
+    }
+
+    const std::string action = command.path ? "Playing '" + command.path->name() + "'." : "Stopping playback.";
+
+    // m_mutex also serializes producers of the queue
+    if (!m_commands.push(std::move(command)))
+    {
+        logger.log(LOG_WARNING, "CameraPathManager: Playback command dropped (camera not updating).");
+        return;
+    }
+    m_playRequested = !playing;
+    if (m_playRequested)
+        ++m_playSequence;
+    logger.log(LOG_INFO, "CameraPathManager: " + action);
+}
+
+bool CameraPathManager::updatePlayback(float deltaTime, Vector3 &outOffset, Quaternion &outRotation)
+{
+    Command command;
+    while (m_commands.pop(command))
+    {
+        m_playing = std::move(command.path);
+        m_playingSequence = command.sequence;
+        m_playTime = 0.0f;
+        m_cursor = 0;
+        if (!m_playing)
+            setTpvFovOverride(0.0f);
+    }
+
+    if (!m_playing)
+    {
+        m_isPlayingFlag.store(false, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_playTime += deltaTime;
+    if (m_playTime > m_playing->duration())
+    {
+        // Finished: hand the camera back to the profile offset
+        m_playing.reset();
+        m_finishedSequence.store(m_playingSequence, std::memory_order_release);
+        setTpvFovOverride(0.0f);
+        m_isPlayingFlag.store(false, std::memory_order_relaxed);
+        return false;
+    }
+
+    const CameraPath::Sample sample = m_playing->evaluate(m_playTime, m_cursor);
+    setTpvFovOverride(sample.fovDegrees);
+    outOffset = sample.offset;
+    outRotation = sample.rotation;
+    m_isPlayingFlag.store(true, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file camera_path_manager.h
+ * @brief Recording and playback of keyframed camera paths.
+ *
+ * Keyframes are captured from the live camera offset by hotkey and saved to
+ * KCD2_TPVToggle_Paths.json next to the profiles file:
+ * @code
+ * [
+ *   { "name": "Path 1",
+ *     "keyframes": [
+ *       { "time": 0, "offset": {"x": 0.5, "y": -1, "z": 0.2},
+ *         "rotation": {"x": 0, "y": 0, "z": 0, "w": 1}, "fov": 70 },
+ *       { "time": 2, "offset": {"x": -0.5, "y": -2, "z": 0.4} } ] }
+ * ]
+ * @endcode
+ * "rotation" (default identity) and "fov" (default: leave the FOV alone) are
+ * optional. Playback runs on the render thread, which drives the camera
+ * offset, rotation and FOV while a path plays.
+ */
+#ifndef CAMERA_PATH_MANAGER_H
+#define CAMERA_PATH_MANAGER_H
+
+#include "camera_path.h"
+#include "spsc_queue.h"
+#include "constants.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class CameraPathManager
+ * @brief Owns the saved paths (input thread side) and the player (render thread side).
+ */
+class CameraPathManager
+{
+public:
+    static CameraPathManager &getInstance();
+
+    /**
+     * @brief Loads KCD2_TPVToggle_Paths.json from the given directory.
+     * @param keyframeSpacing Seconds between captured keyframes.
+     * @return true if the file was read (a missing file is not an error and yields no paths).
+     */
+    bool loadPaths(const std::string &directory, float keyframeSpacing);
+
+    // --- Editing (input thread) ---
+    /** @brief Appends the live camera state to the current path (creating one if there is none). */
+    void captureKeyframe();
+    /** @brief Starts a new empty path and makes it current. */
+    void newPath();
+    /** @brief Makes the next saved path current. */
+    void cycleToNextPath();
+    /**
+     * @brief Plays the current path, or stops playback if a path is playing.
+     * @details Decides from the last command sent (not from what the render thread
+     *          has applied yet), so quick repeated presses alternate play and stop.
+     */
+    void togglePlayback();
+
+    /** @brief True while a path is playing (as last seen by the render thread). */
+    bool isPlaying() const { return m_isPlayingFlag.load(std::memory_order_relaxed); }
+
+    // --- Playback (render thread only) ---
+    /**
+     * @brief Advances playback by deltaTime.
+     * @param outOffset Local camera offset while playing.
+     * @param outRotation Local camera rotation while playing.
+     * @return true if a path is playing and the outputs were set.
+     */
+    bool updatePlayback(float deltaTime, Vector3 &outOffset, Quaternion &outRotation);
+
+private:
+    CameraPathManager();
+    ~CameraPathManager() = default;
+
+    CameraPathManager(const CameraPathManager &) = delete;
+    CameraPathManager &operator=(const CameraPathManager &) = delete;
+
+    struct Command
+    {
+        std::shared_ptr<const CameraPath> path; // nullptr = stop
+        uint64_t sequence = 0;                  // Play: number of this play request
+    };
+
+    bool savePathsLocked() const;
+    CameraPath &currentPathLocked();
+
+    // Paths (input thread, guarded by m_mutex)
+    mutable std::mutex m_mutex;
+    std::vector<CameraPath> m_paths;
+    size_t m_currentPath;
+    std::string m_filePath;
+    float m_keyframeSpacing;
+    bool m_playRequested;   // Last command sent was a play (guarded by m_mutex)
+    uint64_t m_playSequence; // Sequence of the last play sent (guarded by m_mutex)
+
+    // Render thread handoff
+    SpscQueue<Command, Constants::CAMERA_PATH_COMMAND_QUEUE_SIZE> m_commands;
+    std::atomic<bool> m_isPlayingFlag;
+    std::atomic<uint64_t> m_finishedSequence; // Last play that ran to its end (written by the render thread)
+
+    // Player (render thread only)
+    std::shared_ptr<const CameraPath> m_playing;
+    uint64_t m_playingSequence;
+    float m_playTime;
+    size_t m_cursor;
+};
+
+#endif // CAMERA_PATH_MANAGER_H
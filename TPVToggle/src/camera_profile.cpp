@@ -1,7 +1,12 @@
 #include "camera_profile.h"
+#include "profile_loader.h"
+#include "profile_persistence.h"
+#include "profile_diff.h"
+#include "file_watcher.h"
 #include "logger.h"
 #include "constants.h"
 #include "global_state.h" // Access to g_currentCameraOffset
+#include "game_commands.h"
 #include "utils.h"        // Utility functions if needed
 
 #include <fstream>
@@ -11,9 +16,7 @@
 #include <ctime>      // For std::time_t, std::localtime, std::time
 #include <iomanip>    // For std::put_time, std::setw
 #include <filesystem> // Now potentially needed if getRuntimeDirectory() moved out of utils.h
-
-// Using namespace to simplify code
-using json = nlohmann::json;
+#include <iterator>
 
 // --- Singleton ---
 CameraProfileManager &CameraProfileManager::getInstance()
@@ -24,22 +27,27 @@ CameraProfileManager &CameraProfileManager::getInstance()
 
 // --- Constructor / Destructor ---
 CameraProfileManager::CameraProfileManager()
-    : m_currentProfileIndex(0), // Default to 0, validated after loading
+    : m_store(std::make_shared<ProfileStore>()),
+      m_currentProfileId(INVALID_PROFILE_ID), // Set to "Default" after loading
       m_isInitialized(false),
-      m_profilesModified(false), // Start unmodified
-      m_lastSaveTime(0)
+      m_revision(0),
+      m_persistence(std::make_unique<ProfilePersistence>()),
+      m_watcher(std::make_unique<FileWatcher>())
 {
     // Initialization logic moved to loadProfiles
+
+    // setOffset's change is only known once the queued nudges before it have been applied
+    GameCommandQueue::getInstance().setOffsetEditListener([this](const Vector3 &change)
+                                                          {
+        const ProfileId profile_id = getCurrentProfileId();
+        std::lock_guard<std::mutex> history_lock(m_historyMutex);
+        m_history.record({OffsetEdit::Target::LiveOffset, profile_id, change}); });
 }
 
 CameraProfileManager::~CameraProfileManager()
 {
-    // Attempt immediate save if modifications are pending on exit
-    if (m_profilesModified)
-    {
-        Logger::getInstance().log(LOG_INFO, "CameraProfileManager: Saving modified profiles on exit...");
-        saveProfilesToJson();
-    }
+    // Writes any snapshot still waiting for its debounce window
+    shutdownPersistence();
 }
 
 // --- Initialization & Persistence ---
@@ -47,6 +55,10 @@ CameraProfileManager::~CameraProfileManager()
 
 bool CameraProfileManager::loadProfiles(const std::string &directory)
 {
+    // The watcher's callback takes m_profileMutex, so it is stopped before locking
+    const bool was_watching = m_watcher->isRunning();
+    stopWatchingProfilesFile();
+
     std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
     Logger &logger = Logger::getInstance();
     m_profileDirectory = directory;
@@ -58,27 +70,39 @@ bool CameraProfileManager::loadProfiles(const std::string &directory)
 
     logger.log(LOG_INFO, "CameraProfileManager: Loading profiles from: " + m_jsonProfilesPath);
 
-    // Attempt to load from JSON, populating m_profiles
-    bool jsonLoadedSuccessfully = loadProfilesFromJson();
+    // Attempt to load from JSON, populating m_store
+    // (A missing or unreadable file leaves an empty store; Default is created below)
+    JournalReplayResult journal;
+    ProfileFileState file_state;
+    loadProfilesFromJson(journal, file_state);
+
+    // State now matches the file + journal; saves from here on go through the worker
+    m_persistence->start(m_jsonProfilesPath, std::chrono::seconds(SAVE_DEBOUNCE_SECONDS), journal, std::move(file_state));
 
     // Ensure "Default" profile exists at index 0
-    auto it_default = std::find_if(m_profiles.begin(), m_profiles.end(),
-                                   [](const CameraProfile &p)
-                                   { return p.name == "Default"; });
+    bool default_created = false;
+    bool default_moved = false;
+    const StoredProfile *default_profile = m_store->findByName("Default");
 
-    if (it_default == m_profiles.end())
+    if (!default_profile)
     {
         logger.log(LOG_INFO, "CameraProfileManager: 'Default' profile not found. Creating new default profile.");
-        m_profiles.insert(m_profiles.begin(), CameraProfile("Default", Vector3(0.0f, 0.0f, 0.0f), "Default", generateTimestamp()));
+        const CameraProfile default_new("Default", Vector3(0.0f, 0.0f, 0.0f), "Default", generateTimestamp());
+        m_store.apply([default_new](ProfileStore &store)
+                      { return store.insert(0, default_new); });
+        default_created = true;
         // Don't call debounce save yet, wait until end of load
     }
     else
     {
-        size_t found_default_idx = std::distance(m_profiles.begin(), it_default);
+        size_t found_default_idx = m_store->indexOf(default_profile->id);
         if (found_default_idx != 0)
         {
             logger.log(LOG_DEBUG, "CameraProfileManager: Moving 'Default' profile from index " + std::to_string(found_default_idx) + " to 0.");
-            std::rotate(m_profiles.begin(), it_default, it_default + 1);
+            const ProfileId default_id = default_profile->id;
+            m_store.apply([default_id](ProfileStore &store)
+                          { return store.moveTo(default_id, 0); });
+            default_moved = true;
         }
         else
         {
@@ -93,50 +117,41 @@ bool CameraProfileManager::loadProfiles(const std::string &directory)
     // Activate the "Default" profile (index 0) initially, loading its saved state.
     setActiveProfile(0, false); // false = no transition on initial load is appropriate.
 
-    // Consolidate modification check and debounce trigger here if Default was created/moved
-    if (it_default == m_profiles.end() || (it_default != m_profiles.end() && std::distance(m_profiles.begin(), it_default) != 0))
+    // The file must match memory before any journal record is appended:
+    // records refer to profile IDs, including the Default profile's.
+    if (default_created || default_moved)
     {
-        // If default was missing OR if it was found but had to be moved
-        if (!jsonLoadedSuccessfully && m_profiles.size() == 1)
-        {
-            // Only mark modified if we just created the default and nothing was loaded from JSON.
-            // If JSON was loaded and we just moved default, assume user wants loaded state preserved initially.
-            // Maybe even only save if *only* Default exists and it was created now.
-            logger.log(LOG_DEBUG, "CameraProfileManager: Marking profiles as modified (Default created/moved).");
-            markProfilesModifiedAndDebounceSave();
-        }
-        else if (it_default != m_profiles.end() && std::distance(m_profiles.begin(), it_default) != 0)
-        {
-            // Also mark modified if we had to rotate the existing Default profile from JSON
-            logger.log(LOG_DEBUG, "CameraProfileManager: Marking profiles as modified (Default rotated).");
-            markProfilesModifiedAndDebounceSave();
-        }
+        logger.log(LOG_DEBUG, std::string("CameraProfileManager: Marking profiles as modified (Default ") +
+                                  (default_created ? "created" : "rotated") + ").");
+        markProfilesModifiedAndDebounceSave();
     }
-
-    // Log final state *after* potentially setting active profile correctly.
-    // Use getCurrentProfile() which respects the now set m_isInitialized flag.
-    std::string activeName = "N/A";
-    if (m_isInitialized && !m_profiles.empty())
+    else if (journal.truncated)
     {
-        activeName = getCurrentProfile().name; // Get name safely after init
+        // Fold what survived into a fresh JSON file so the damaged tail is gone
+        logger.log(LOG_DEBUG, "CameraProfileManager: Marking profiles as modified (journal damaged).");
+        markProfilesModifiedAndDebounceSave();
     }
-    else if (!m_profiles.empty())
+
+    const StoredProfile *active_profile = m_store->findById(m_currentProfileId);
+    logger.log(LOG_INFO, "CameraProfileManager: Initialization complete. Active profile: '" +
+                             (active_profile ? *active_profile->name : std::string("<none>")) +
+                             "'. Total profiles: " + std::to_string(m_store->size()) + ".");
+
+    if (was_watching)
     {
-        activeName = m_profiles[0].name; // Fallback if init failed but profiles exist
+        startWatchingProfilesFile();
     }
 
-    logger.log(LOG_INFO, "CameraProfileManager: Initialization complete. Active profile: '" + activeName +
-                             "'. Total profiles: " + std::to_string(m_profiles.size()) + ".");
-
     return true; // Return overall success (could refine based on steps)
 }
 
-bool CameraProfileManager::loadProfilesFromJson()
+bool CameraProfileManager::loadProfilesFromJson(JournalReplayResult &journal, ProfileFileState &fileState)
 {
     // Assumes lock is held by caller (loadProfiles)
     Logger &logger = Logger::getInstance();
 
-    m_profiles.clear(); // Start with empty list before reading file
+    m_store.reset(std::make_shared<ProfileStore>()); // Start with empty store before reading file
+    fileState = ProfileFileState{std::string(), std::make_shared<const ProfileStore>()};
 
     // Check if file exists
     if (!std::filesystem::exists(m_jsonProfilesPath))
@@ -145,177 +160,285 @@ bool CameraProfileManager::loadProfilesFromJson()
         return false; // Indicate file not found
     }
 
-    std::vector<CameraProfile> loaded_profiles_temp; // Load into temporary vector
+    auto loaded_store = std::make_shared<ProfileStore>(); // Load into temporary store
 
     try
     {
-        std::ifstream file(m_jsonProfilesPath);
+        std::ifstream file(m_jsonProfilesPath, std::ios::binary);
         if (!file.is_open())
         {
             logger.log(LOG_ERROR, "CameraProfileManager: Failed to open JSON profiles file for reading: " + m_jsonProfilesPath);
             return false; // Indicate file error
         }
 
-        json profilesJson;
-        file >> profilesJson; // Parse the JSON data
+        // Keep the exact bytes: the journal is only valid for this file content
+        const std::string fileBytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
         file.close();
 
-        // Validate basic JSON structure
-        if (!profilesJson.is_array())
+        // Stream the entries straight into the store (no intermediate JSON document)
+        const ProfileLoadResult loadResult = ProfileLoader::load(fileBytes, *loaded_store,
+                                                                 [this]()
+                                                                 { return generateTimestamp(); });
+        if (!loadResult.ok)
         {
-            logger.log(LOG_ERROR, "CameraProfileManager: Invalid JSON format in profiles file (expected an array): " + m_jsonProfilesPath);
-            return false; // Indicate format error
+            logger.log(LOG_ERROR, "CameraProfileManager: Invalid profiles file (" + loadResult.error + "): " + m_jsonProfilesPath);
+            return false; // Indicate parse/format error
         }
 
-        if (profilesJson.empty())
+        if (loadResult.skipped > 0)
         {
-            logger.log(LOG_INFO, "CameraProfileManager: Profiles file is empty: " + m_jsonProfilesPath);
-            return true; // Successfully loaded an empty list
+            logger.log(LOG_WARNING, "CameraProfileManager: Skipped " + std::to_string(loadResult.skipped) + " invalid profile entries during JSON load.");
         }
 
-        // Parse individual profile objects
-        int errorCount = 0;
-        for (const auto &profileJson : profilesJson)
-        {
-            if (!profileJson.is_object())
-            {
-                logger.log(LOG_WARNING, "CameraProfileManager: Skipping non-object entry in profiles JSON array.");
-                errorCount++;
-                continue;
-            }
-            CameraProfile profile = profileFromJson(profileJson); // Handles errors per object
-            if (profile.name.rfind("ErrorProfile", 0) != 0)       // Check it wasn't an error profile
-            {
-                loaded_profiles_temp.push_back(profile);
-            }
-            else
-            {
-                errorCount++;
-            }
-        }
+        // Remember what the file itself holds; hot reload diffs outside edits against it
+        fileState.fingerprint = ProfilePersistence::fingerprintOf(fileBytes);
+        fileState.store = std::make_shared<const ProfileStore>(*loaded_store);
 
-        if (errorCount > 0)
-        {
-            logger.log(LOG_WARNING, "CameraProfileManager: Skipped " + std::to_string(errorCount) + " invalid profile entries during JSON load.");
-        }
+        // Apply changes recorded since the file was last written
+        journal = ProfilePersistence::replayJournal(m_jsonProfilesPath, fileBytes, *loaded_store);
 
-        // If any valid profiles were loaded, assign them
-        if (!loaded_profiles_temp.empty())
+        if (loaded_store->empty())
         {
-            m_profiles = std::move(loaded_profiles_temp); // Use move assignment
-            logger.log(LOG_DEBUG, "CameraProfileManager: Successfully parsed " +
-                                      std::to_string(m_profiles.size()) + " profiles from JSON.");
+            logger.log(LOG_WARNING, "CameraProfileManager: No valid profiles found in JSON file: " + m_jsonProfilesPath);
         }
         else
         {
-            logger.log(LOG_WARNING, "CameraProfileManager: No valid profiles found in JSON file: " + m_jsonProfilesPath);
+            logger.log(LOG_DEBUG, "CameraProfileManager: Successfully loaded " +
+                                      std::to_string(loaded_store->size()) + " profiles (" +
+                                      std::to_string(journal.applied) + " journal records applied).");
         }
-
-        // Mark as unmodified since state now matches the file (or empty if file was bad/empty)
-        m_profilesModified = false;
-        m_lastSaveTime = std::time(nullptr); // Reset last save time after successful load
+        m_store.reset(std::move(loaded_store));
 
         return true; // Indicate successful processing of the file
     }
-    catch (const json::parse_error &e)
-    {
-        logger.log(LOG_ERROR, "CameraProfileManager: JSON parsing error: " + std::string(e.what()) + " in file: " + m_jsonProfilesPath);
-        m_profiles.clear(); // Ensure profiles list is empty on error
-        return false;       // Indicate parse error
-    }
     catch (const std::exception &e)
     {
         logger.log(LOG_ERROR, "CameraProfileManager: Error reading or processing profiles file: " + std::string(e.what()) + ". File: " + m_jsonProfilesPath);
-        m_profiles.clear();
         return false; // Indicate generic error
     }
 }
 
 bool CameraProfileManager::saveProfilesToJson()
 {
-    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
-    Logger &logger = Logger::getInstance();
+    std::shared_ptr<const ProfileSnapshot> snapshot;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+        if (!m_isInitialized)
+        {
+            Logger::getInstance().log(LOG_WARNING, "CameraProfileManager: Attempted to save profiles before initialization.");
+            return false;
+        }
 
-    if (!m_isInitialized)
+        // Intentionally allow saving an empty list (e.g., after deleting all user profiles)
+        // The load logic handles creating 'Default' if the file is empty or missing.
+        snapshot = makeSnapshot();
+    }
+
+    // Serialization and disk I/O happen without holding m_profileMutex
+    return m_persistence->writeNow(snapshot);
+}
+
+void CameraProfileManager::shutdownPersistence()
+{
+    stopWatchingProfilesFile();
+
+    if (m_persistence)
     {
-        logger.log(LOG_WARNING, "CameraProfileManager: Attempted to save profiles before initialization.");
-        return false;
+        m_persistence->stop();
     }
+}
 
-    // Intentionally allow saving an empty list (e.g., after deleting all user profiles)
-    // The load logic handles creating 'Default' if the file is empty or missing.
+// --- Hot Reload ---
 
-    json profilesArray = json::array();
-    try
+bool CameraProfileManager::startWatchingProfilesFile()
+{
+    std::string path;
     {
-        for (const auto &profile : m_profiles)
+        std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+        if (!m_isInitialized)
         {
-            json profileJson;
-            profileToJson(profile, profileJson);
-            profilesArray.push_back(profileJson);
+            Logger::getInstance().log(LOG_WARNING, "CameraProfileManager: Cannot watch profiles file before initialization.");
+            return false;
         }
+        path = m_jsonProfilesPath;
     }
-    catch (const json::exception &e)
+
+    if (!m_watcher->start(path, std::chrono::milliseconds(Constants::PROFILE_RELOAD_SETTLE_MS), [this]()
+                          { reloadProfilesFromDisk(); }))
     {
-        logger.log(LOG_ERROR, "CameraProfileManager: JSON library error during profile serialization: " + std::string(e.what()));
-        return false; // Don't proceed if serialization fails
+        Logger::getInstance().log(LOG_WARNING, "CameraProfileManager: Profiles file hot reload unavailable.");
+        return false;
     }
 
-    try
+    Logger::getInstance().log(LOG_INFO, "CameraProfileManager: Watching profiles file for outside edits.");
+    return true;
+}
+
+void CameraProfileManager::stopWatchingProfilesFile()
+{
+    if (m_watcher)
     {
-        std::ofstream outFile(m_jsonProfilesPath);
-        if (!outFile.is_open())
-        {
-            logger.log(LOG_ERROR, "CameraProfileManager: Failed to open JSON file for writing: " + m_jsonProfilesPath);
-            // Keep m_profilesModified = true if open fails
-            return false;
-        }
+        m_watcher->stop();
+    }
+}
 
-        outFile << std::setw(4) << profilesArray << std::endl;
-        if (!outFile.good()) // Check stream state *after* writing and potential flushing (endl does flush)
-        {
-            logger.log(LOG_ERROR, "CameraProfileManager: Failed to write all profile data to JSON file: " + m_jsonProfilesPath);
-            outFile.close();
-            // Keep m_profilesModified = true if write fails
-            return false;
-        }
+void CameraProfileManager::reloadProfilesFromDisk()
+{
+    // Runs on the watcher thread. Everything up to the diff happens without m_profileMutex.
+    Logger &logger = Logger::getInstance();
 
-        outFile.close();
+    std::string path;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+        if (!m_isInitialized)
+            return;
+        path = m_jsonProfilesPath;
+    }
 
-        // Save successful: reset flag and update timestamp
-        m_profilesModified = false;
-        m_lastSaveTime = std::time(nullptr);
+    // Waits for a save in progress, so our own replace is recognized below. A save
+    // can still land after this; applyProfileFileDiff re-checks under the write lock.
+    const ProfileFileState previous = m_persistence->fileState();
 
-        logger.log(LOG_INFO, "CameraProfileManager: Successfully saved " + std::to_string(m_profiles.size()) +
-                                 " profiles to " + m_jsonProfilesPath);
-        return true;
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        // Deleted, or mid-replace by an editor; a following notification retries
+        logger.log(LOG_DEBUG, "CameraProfileManager: Profiles file not readable after change. Keeping current profiles.");
+        return;
     }
-    catch (const std::exception &e) // Catch potential filesystem errors during write/close
+    const std::string fileBytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    ProfileFileState current;
+    current.fingerprint = ProfilePersistence::fingerprintOf(fileBytes);
+    if (current.fingerprint == previous.fingerprint)
+        return; // Our own save, or a write that left the contents as they were
+
+    auto edited = std::make_shared<ProfileStore>();
+    const ProfileLoadResult loadResult = ProfileLoader::load(fileBytes, *edited,
+                                                             [this]()
+                                                             {
+                                                                 std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+                                                                 return generateTimestamp();
+                                                             });
+    if (!loadResult.ok)
     {
-        logger.log(LOG_ERROR, "CameraProfileManager: Filesystem error saving profiles to JSON: " + std::string(e.what()));
-        // Keep m_profilesModified = true on other errors
-        return false;
+        // Often a half-written file; the write that completes it triggers another reload
+        logger.log(LOG_WARNING, "CameraProfileManager: Ignoring edited profiles file (" + loadResult.error + "). Keeping current profiles.");
+        return;
+    }
+    if (loadResult.skipped > 0)
+    {
+        logger.log(LOG_WARNING, "CameraProfileManager: Skipped " + std::to_string(loadResult.skipped) + " invalid profile entries in edited file.");
+    }
+
+    const ProfileStore no_profiles;
+    const ProfileDiff diff = diffProfileFiles(previous.store ? *previous.store : no_profiles, *edited, loadResult.generatedIds);
+    current.store = std::move(edited);
+
+    logger.log(LOG_INFO, "CameraProfileManager: Profiles file edited outside the game (" +
+                             std::to_string(diff.added.size()) + " added, " +
+                             std::to_string(diff.removed.size()) + " removed, " +
+                             std::to_string(diff.changed.size()) + " changed).");
+    applyProfileFileDiff(diff, previous.fingerprint, std::move(current));
+}
+
+void CameraProfileManager::applyProfileFileDiff(const ProfileDiff &diff, const std::string &baseFingerprint,
+                                                ProfileFileState fileState)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+    Logger &logger = Logger::getInstance();
+
+    if (!m_isInitialized || m_store->empty())
+        return;
+
+    // The journal describes the old file; from now on the edited file is the base. Merged
+    // under the persistence write lock, so no save lands between the check and the adoption.
+    bool active_removed = false;
+    const bool adopted = m_persistence->adoptExternalFile(baseFingerprint, fileState, [&]()
+                                                          { active_removed = mergeProfileDiff(diff, m_store, m_currentProfileId); });
+    if (!adopted)
+    {
+        // The game saved after the file was read: the edit was overwritten, or its writer's
+        // next notification is diffed against the new save
+        logger.log(LOG_INFO, "CameraProfileManager: Profiles file was saved by the game while reading an outside edit. Ignoring the stale read.");
+        return;
+    }
+
+    if (active_removed)
+    {
+        logger.log(LOG_INFO, "CameraProfileManager: Active profile was removed from the file. Switching to 'Default'.");
+        setActiveProfile(0, false);
+    }
+
+    if (!sameProfiles(*m_store, *fileState.store))
+    {
+        // In-game edits the file lacked, or IDs assigned just now: write them back
+        markProfilesModifiedAndDebounceSave();
+    }
+    else
+    {
+        publishLocked();
     }
 }
 
-// Internal function to trigger save after modifications to m_profiles
+std::shared_ptr<const ProfileSnapshot> CameraProfileManager::makeSnapshot()
+{
+    // Assumes lock is already held by caller. Shares the store; the next edit goes to another one.
+    auto snapshot = std::make_shared<ProfileSnapshot>();
+    snapshot->revision = ++m_revision;
+    snapshot->store = m_store.share();
+    return snapshot;
+}
+
+void CameraProfileManager::publishLocked()
+{
+    // Assumes lock is already held by caller
+    auto set = std::make_shared<ProfileSetSnapshot>();
+    set->store = m_store.share();
+    set->currentProfileId = m_currentProfileId;
+    const size_t index = m_store->indexOf(m_currentProfileId);
+    set->currentIndex = index != ProfileStore::npos ? index : 0;
+
+    std::atomic_store(&m_published, std::shared_ptr<const ProfileSetSnapshot>(std::move(set)));
+}
+
+// Internal function to queue a full save after modifications to m_store
 void CameraProfileManager::markProfilesModifiedAndDebounceSave()
 {
     // Assumes lock is already held by caller
     if (!m_isInitialized)
         return; // Don't try to save if not ready
 
-    m_profilesModified = true;
-    time_t now_time = std::time(nullptr);
-    // Check if enough time has passed since the last save
-    if (now_time - m_lastSaveTime >= SAVE_DEBOUNCE_SECONDS)
-    {
-        saveProfilesToJson(); // This resets m_profilesModified if successful
-    }
-    else
+    publishLocked();
+
+    // Never blocks: the worker rewrites the JSON file once the debounce window allows
+    m_persistence->postFullSave(makeSnapshot());
+    Logger::getInstance().log(LOG_DEBUG, "CameraProfileManager: Profile list change queued for saving.");
+}
+
+// Internal function to queue a journal record for a single-profile change
+void CameraProfileManager::markProfilesModifiedAndDebounceSave(ProfileChange::Kind kind, ProfileId id)
+{
+    // Assumes lock is already held by caller and the change is already applied to m_store
+    if (!m_isInitialized)
+        return;
+
+    ProfileChange change;
+    change.kind = kind;
+    change.id = id;
+    change.index = m_store->indexOf(id);
+    if (const StoredProfile *profile = m_store->findById(id))
     {
-        Logger::getInstance().log(LOG_DEBUG, "CameraProfileManager: Profile save debounced (change marked).");
+        change.profile = profile->toProfile();
     }
+
+    publishLocked();
+
+    auto snapshot = makeSnapshot();
+    change.revision = snapshot->revision;
+    m_persistence->post(std::move(snapshot), change);
+    Logger::getInstance().log(LOG_DEBUG, "CameraProfileManager: Profile change queued for journaling.");
 }
 
 // --- Profile Lifecycle Actions ---
@@ -360,19 +483,18 @@ bool CameraProfileManager::createNewProfileFromLiveState(const std::string &cate
     }
 
     // Create the new profile using the LIVE offset
-    CameraProfile new_profile(new_profile_name, g_currentCameraOffset, category.empty() ? "General" : category, generateTimestamp());
+    const Vector3 live_offset = g_currentCameraOffset.load();
+    CameraProfile new_profile(new_profile_name, live_offset, category.empty() ? "General" : category, generateTimestamp());
 
-    // Append to the vector
-    m_profiles.push_back(new_profile);
-
-    // Switch active index to the new profile
-    m_currentProfileIndex = m_profiles.size() - 1;
+    // Append to the store and switch the active profile to it
+    m_currentProfileId = m_store.apply([new_profile](ProfileStore &store)
+                                       { return store.append(new_profile); });
 
     logger.log(LOG_INFO, "CameraProfileManager: Created new profile '" + new_profile.name +
-                             "' from live offset (" + std::to_string(g_currentCameraOffset.x) + ", " + /*...*/ "). Switched active profile.");
+                             "' from live offset " + Vector3ToString(live_offset) + ". Switched active profile.");
 
     // Mark profiles as modified and trigger save
-    markProfilesModifiedAndDebounceSave();
+    markProfilesModifiedAndDebounceSave(ProfileChange::Kind::Create, m_currentProfileId);
 
     // Technically g_currentCameraOffset already matches the new profile's saved offset
     // No need to call setActiveProfile here.
@@ -391,9 +513,10 @@ bool CameraProfileManager::updateActiveProfileWithLiveState()
         return false;
     }
 
-    if (m_profiles.empty() || m_currentProfileIndex >= m_profiles.size())
+    const StoredProfile *active_profile = m_store->findById(m_currentProfileId);
+    if (!active_profile)
     {
-        logger.log(LOG_ERROR, "UpdateActive: Invalid active profile index.");
+        logger.log(LOG_ERROR, "UpdateActive: Invalid active profile.");
         return false;
     }
 
@@ -404,16 +527,23 @@ bool CameraProfileManager::updateActiveProfileWithLiveState()
     //     return false;
     // }
 
-    // Update the saved state of the active (non-Default) profile
-    CameraProfile &active_profile_ref = m_profiles[m_currentProfileIndex];
-    active_profile_ref.offset = g_currentCameraOffset; // Store live offset
-    active_profile_ref.timestamp = generateTimestamp();
+    // Update the saved state of the active profile with the live offset
     // Category is not updated by this action, only offset and timestamp
+    const std::string active_name = *active_profile->name;
+    const Vector3 previous_offset = active_profile->offset;
+    const Vector3 live_offset = g_currentCameraOffset.load();
+    m_store.apply([id = m_currentProfileId, live_offset, timestamp = generateTimestamp()](ProfileStore &store)
+                  { return store.setOffset(id, live_offset, timestamp); });
+
+    {
+        std::lock_guard<std::mutex> history_lock(m_historyMutex);
+        m_history.record({OffsetEdit::Target::SavedOffset, m_currentProfileId, live_offset - previous_offset});
+    }
 
-    logger.log(LOG_INFO, "CameraProfileManager: Updated saved state for active profile '" + active_profile_ref.name + "' with live offset.");
+    logger.log(LOG_INFO, "CameraProfileManager: Updated saved state for active profile '" + active_name + "' with live offset.");
 
     // Mark profiles as modified and trigger save
-    markProfilesModifiedAndDebounceSave();
+    markProfilesModifiedAndDebounceSave(ProfileChange::Kind::Update, m_currentProfileId);
 
     // Reset pending edit flag if used: m_liveEditsPending = false;
 
@@ -423,75 +553,77 @@ bool CameraProfileManager::updateActiveProfileWithLiveState()
 bool CameraProfileManager::deleteProfile(size_t index)
 {
     std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
-    Logger &logger = Logger::getInstance();
 
     if (!m_isInitialized)
     {
-        logger.log(LOG_WARNING, "DeleteProfile: Not initialized.");
+        Logger::getInstance().log(LOG_WARNING, "DeleteProfile: Not initialized.");
         return false;
     }
 
-    // Prevent deleting Default (index 0)
-    if (index == 0)
+    // Validate index bounds
+    if (index >= m_store->size())
     {
-        logger.log(LOG_WARNING, "DeleteProfile: Cannot delete the 'Default' profile (index 0).");
+        Logger::getInstance().log(LOG_ERROR, "DeleteProfile: Invalid index " + std::to_string(index) + ". Max allowed: " + std::to_string(m_store->size() - 1) + ".");
         return false;
     }
-    // Validate index bounds
-    if (index >= m_profiles.size())
+
+    return deleteProfileLocked(m_store->at(index).id);
+}
+
+bool CameraProfileManager::deleteProfileById(ProfileId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+
+    if (!m_isInitialized)
     {
-        logger.log(LOG_ERROR, "DeleteProfile: Invalid index " + std::to_string(index) + ". Max allowed: " + std::to_string(m_profiles.size() - 1) + ".");
+        Logger::getInstance().log(LOG_WARNING, "DeleteProfile: Not initialized.");
         return false;
     }
 
-    std::string deletedName = m_profiles[index].name;
-    m_profiles.erase(m_profiles.begin() + index);
-    logger.log(LOG_INFO, "CameraProfileManager: Deleted profile '" + deletedName + "' (index " + std::to_string(index) + ").");
+    return deleteProfileLocked(id);
+}
 
-    // Adjust current index if needed and activate a safe profile
-    size_t previous_active_index = m_currentProfileIndex;
-    bool active_profile_affected = false;
+bool CameraProfileManager::deleteProfileLocked(ProfileId id)
+{
+    // Assumes lock is already held by caller
+    Logger &logger = Logger::getInstance();
 
-    if (m_profiles.empty())
-    { // Should not happen if Default deletion blocked
-        logger.log(LOG_ERROR, "DeleteProfile: Profile list became empty after deletion. Recreating Default.");
-        m_profiles.insert(m_profiles.begin(), CameraProfile("Default", Vector3(0.0f, 0.0f, 0.0f), "Default", generateTimestamp()));
-        m_currentProfileIndex = 0;
-        active_profile_affected = true;
-    }
-    else if (previous_active_index == index)
+    const size_t index = m_store->indexOf(id);
+    if (index == ProfileStore::npos)
     {
-        // Deleted the active profile. Switch to Default.
-        logger.log(LOG_INFO, "DeleteProfile: Deleted active profile. Switching to 'Default'.");
-        m_currentProfileIndex = 0;
-        active_profile_affected = true;
+        logger.log(LOG_ERROR, "DeleteProfile: Unknown profile ID " + std::to_string(id) + ".");
+        return false;
     }
-    else if (previous_active_index > index)
+
+    // Prevent deleting Default (index 0)
+    if (index == 0)
     {
-        // Deleted profile *before* the active one. Decrement active index.
-        m_currentProfileIndex--;
-        logger.log(LOG_DEBUG, "DeleteProfile: Active index shifted from " + std::to_string(previous_active_index) + " to " + std::to_string(m_currentProfileIndex));
-        // No need to set active_profile_affected = true, profile itself is same
+        logger.log(LOG_WARNING, "DeleteProfile: Cannot delete the 'Default' profile (index 0).");
+        return false;
     }
-    // else: Deleted after active, active index is unaffected.
 
-    // If the active profile changed (either by deleting it or because list became empty)
-    if (active_profile_affected)
+    const std::string deletedName = *m_store->at(index).name;
+    m_store.apply([id](ProfileStore &store)
+                  { return store.erase(id); });
+    logger.log(LOG_INFO, "CameraProfileManager: Deleted profile '" + deletedName + "' (index " + std::to_string(index) + ").");
+
+    // Other profiles keep their IDs, so only deleting the active one needs a switch
+    if (m_currentProfileId == id)
     {
-        // Load the state of the *new* current profile (which is likely Default now)
-        setActiveProfile(m_currentProfileIndex, false); // Don't trigger transition for delete
+        logger.log(LOG_INFO, "DeleteProfile: Deleted active profile. Switching to 'Default'.");
+        setActiveProfile(0, false); // Don't trigger transition for delete
     }
 
-    markProfilesModifiedAndDebounceSave(); // Profile list changed
+    markProfilesModifiedAndDebounceSave(ProfileChange::Kind::Delete, id); // Profile list changed
 
     return true;
 }
 
 bool CameraProfileManager::deleteActiveProfile()
 {
-    // Lock acquired internally by deleteProfile
-    size_t current_index = getCurrentProfileIndex(); // Gets current index safely
-    return deleteProfile(current_index);             // deleteProfile handles index 0 check
+    // Hold the writer lock so the active profile cannot change before the delete
+    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+    return deleteProfileById(m_currentProfileId); // Handles the Default check
 }
 
 // --- Profile Selection & Activation ---
@@ -505,19 +637,20 @@ bool CameraProfileManager::cycleToNextProfile()
         Logger::getInstance().log(LOG_WARNING, "Not initialized.");
         return false;
     }
-    if (m_profiles.empty())
+    if (m_store->empty())
     {
         Logger::getInstance().log(LOG_WARNING, "No profiles to cycle.");
         return false;
     }
-    if (m_profiles.size() == 1)
+    if (m_store->size() == 1)
     {
         Logger::getInstance().log(LOG_INFO, "CycleProfile: Only 'Default' profile exists. No cycling possible.");
         // Optionally re-activate Default to reset live offset? No, standard says cycle has no effect here.
         return true; // Cycle "succeeded" vacuously.
     }
 
-    size_t nextIndex = (m_currentProfileIndex + 1) % m_profiles.size();
+    const size_t currentIndex = m_store->indexOf(m_currentProfileId);
+    size_t nextIndex = currentIndex != ProfileStore::npos ? (currentIndex + 1) % m_store->size() : 0;
     setActiveProfile(nextIndex, true); // Handles loading offset, transitions, logging
 
     return true;
@@ -533,7 +666,7 @@ bool CameraProfileManager::setProfileByIndex(size_t index)
     }
 
     if (index >= getProfileCount())
-    { // Use getter for thread-safe count access (though lock is probably already held by caller often)
+    { // Lock-free read of the published count; setActiveProfile validates again under the lock
         Logger::getInstance().log(LOG_ERROR, "setProfileByIndex: Invalid index " + std::to_string(index) + ".");
         return false;
     }
@@ -542,40 +675,55 @@ bool CameraProfileManager::setProfileByIndex(size_t index)
     return true;
 }
 
+void CameraProfileManager::setActiveProfileById(ProfileId id, bool useTransition)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+
+    size_t index = m_store->indexOf(id);
+    if (index == ProfileStore::npos)
+    {
+        Logger::getInstance().log(LOG_ERROR, "setActiveProfileById: Unknown profile ID " + std::to_string(id) + ". Using index 0 instead.");
+        index = 0;
+    }
+    setActiveProfile(index, useTransition);
+}
+
 void CameraProfileManager::setActiveProfile(size_t index, bool useTransition)
 {
-    // *** NOTE: This is the ONLY function that should load m_profiles[...].offset into g_currentCameraOffset ***
+    // *** NOTE: This is the ONLY function that should load a saved offset into g_currentCameraOffset ***
+    // Like every live offset write it goes through GameCommandQueue, after any nudge queued before it
     std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
     Logger &logger = Logger::getInstance();
 
     if (!m_isInitialized)
     {
         logger.log(LOG_WARNING, "setActiveProfile called before initialized.");
-        g_currentCameraOffset = Vector3(); // Safety reset
-        m_currentProfileIndex = 0;
+        GameCommandQueue::getInstance().setOffset(Vector3()); // Safety reset
+        m_currentProfileId = INVALID_PROFILE_ID;
         return;
     }
 
-    if (m_profiles.empty())
+    if (m_store->empty())
     { // Should only happen in extreme error state
         logger.log(LOG_ERROR, "setActiveProfile called when profile list is empty. Cannot activate.");
-        g_currentCameraOffset = Vector3();
-        m_currentProfileIndex = 0;
+        GameCommandQueue::getInstance().setOffset(Vector3());
+        m_currentProfileId = INVALID_PROFILE_ID;
         return;
     }
 
-    if (index >= m_profiles.size())
+    if (index >= m_store->size())
     {
         logger.log(LOG_ERROR, "setActiveProfile: Invalid index " + std::to_string(index) +
-                                  ". Max allowed: " + std::to_string(m_profiles.size() - 1) + ". Using index 0 instead.");
+                                  ". Max allowed: " + std::to_string(m_store->size() - 1) + ". Using index 0 instead.");
         index = 0; // Fallback to Default profile on invalid index
     }
 
-    bool switching_to_same_index = (m_currentProfileIndex == index);
+    const StoredProfile &targetProfile = m_store->at(index); // Get the target profile
+    bool switching_to_same_index = (m_currentProfileId == targetProfile.id);
 
     // --- Core Logic ---
-    m_currentProfileIndex = index;                                          // Update the active index
-    const CameraProfile &targetProfile = m_profiles[m_currentProfileIndex]; // Get the target profile
+    m_currentProfileId = targetProfile.id; // Update the active profile
+    publishLocked();                       // Readers see the new active profile from here on
 
     // Reset any pending edit flag: m_liveEditsPending = false; // Reset pending edit state
 
@@ -583,34 +731,41 @@ void CameraProfileManager::setActiveProfile(size_t index, bool useTransition)
     std::string log_prefix = switching_to_same_index ? "Re-activating" : "Activating";
     if (switching_to_same_index)
     {
-        logger.log(LOG_INFO, "CameraProfileManager: " + log_prefix + " profile '" + targetProfile.name +
+        logger.log(LOG_INFO, "CameraProfileManager: " + log_prefix + " profile '" + *targetProfile.name +
                                  "'. Reloaded its saved offset, discarding any unsaved live adjustments.");
     }
     else
     {
-        logger.log(LOG_INFO, "CameraProfileManager: " + log_prefix + " profile '" + targetProfile.name +
-                                 "' (" + std::to_string(m_currentProfileIndex + 1) + "/" + std::to_string(m_profiles.size()) + "). Loaded its saved offset.");
+        logger.log(LOG_INFO, "CameraProfileManager: " + log_prefix + " profile '" + *targetProfile.name +
+                                 "' (" + std::to_string(index + 1) + "/" + std::to_string(m_store->size()) + "). Loaded its saved offset.");
     }
 
     // --- Transition ---
-    if (useTransition)
+    // Started (or an ongoing one cancelled) where the switch is applied, so it begins from the
+    // offset the camera shows then, including nudges still queued ahead of it
+    std::shared_ptr<const EasingCurve> transitionCurve;
+    if (useTransition && !targetProfile.transitionCurve->empty())
     {
-        TransitionManager::getInstance().startTransition(
-            targetProfile.offset,   // Target is the SAVED offset loaded above
-            Quaternion::Identity(), // Rotation currently identity
-            -1.0f                   // Use manager's default duration
-        );
-        logger.log(LOG_DEBUG, "CameraProfileManager: Started transition to saved offset.");
+        // Per-profile easing curve, if the profile has a usable one
+        EasingCurve profileCurve;
+        if (EasingCurve::parse(*targetProfile.transitionCurve, profileCurve))
+        {
+            transitionCurve = std::make_shared<const EasingCurve>(std::move(profileCurve));
+        }
+        else
+        {
+            logger.log(LOG_WARNING, "CameraProfileManager: Unknown transition curve '" + *targetProfile.transitionCurve +
+                                        "' in profile '" + *targetProfile.name + "'. Using the default curve.");
+        }
     }
-    else
-    {
-        // Explicitly cancel any ongoing transition if switching instantly
-        TransitionManager::getInstance().cancelTransition();
 
-        logger.log(LOG_DEBUG, "CameraProfileManager: Applied saved offset immediately (no transition).");
-    }
+    GameCommandQueue::getInstance().switchOffset(targetProfile.offset, useTransition, std::move(transitionCurve));
+    logger.log(LOG_DEBUG, useTransition ? "CameraProfileManager: Queued transition to saved offset."
+                                        : "CameraProfileManager: Queued saved offset (no transition).");
 
-    g_currentCameraOffset = targetProfile.offset;
+    // Live edits were just discarded, so their history no longer applies
+    std::lock_guard<std::mutex> history_lock(m_historyMutex);
+    m_history.clear();
 }
 
 void CameraProfileManager::resetToDefault()
@@ -618,7 +773,7 @@ void CameraProfileManager::resetToDefault()
     std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
     Logger &logger = Logger::getInstance();
 
-    if (!m_isInitialized || m_profiles.empty())
+    if (!m_isInitialized || m_store->empty())
     {
         logger.log(LOG_WARNING, "ResetToDefault: Cannot reset, not initialized or no profiles.");
         // Try setting live offset anyway? Maybe not useful without profiles structure.
@@ -648,8 +803,7 @@ void CameraProfileManager::resetToDefault()
     //     setOffset(0.0f, 0.0f, 0.0f); // Sets live offset only
     // }
 
-    size_t current_profile_index = getCurrentProfileIndex();
-    CameraProfile current_profile = m_profiles[current_profile_index];
+    CameraProfile current_profile = getCurrentProfile();
 
     setOffset(0.0f, 0.0f, 0.0f); // Sets live offset only
     logger.log(LOG_INFO, "CameraProfileManager: Reset '" + current_profile.name + "' profile's saved offset to origin.");
@@ -666,7 +820,7 @@ bool CameraProfileManager::renameProfile(size_t index, const std::string &newNam
         logger.log(LOG_WARNING, "RenameProfile: Not initialized.");
         return false;
     }
-    if (index >= m_profiles.size())
+    if (index >= m_store->size())
     {
         logger.log(LOG_ERROR, "RenameProfile: Invalid index.");
         return false;
@@ -690,23 +844,22 @@ bool CameraProfileManager::renameProfile(size_t index, const std::string &newNam
     }
 
     // Prevent duplicate names (optional but good practice)
-    auto it_dup = std::find_if(m_profiles.begin(), m_profiles.end(),
-                               [&](const CameraProfile &p)
-                               { return p.name == newName; });
-    if (it_dup != m_profiles.end())
+    if (m_store->findByName(newName))
     {
         logger.log(LOG_WARNING, "RenameProfile: Profile name '" + newName + "' already exists.");
         return false;
     }
 
-    std::string oldName = m_profiles[index].name;
-    m_profiles[index].name = newName;
-    m_profiles[index].timestamp = generateTimestamp(); // Update timestamp on metadata change
+    const ProfileId id = m_store->at(index).id;
+    std::string oldName = *m_store->at(index).name;
+    // Update timestamp on metadata change
+    m_store.apply([id, newName, timestamp = generateTimestamp()](ProfileStore &store)
+                  { return store.rename(id, newName, timestamp); });
 
     logger.log(LOG_INFO, "CameraProfileManager: Renamed profile (idx " + std::to_string(index) + ") from '" +
                              oldName + "' to '" + newName + "'.");
 
-    markProfilesModifiedAndDebounceSave(); // Metadata changed, need save
+    markProfilesModifiedAndDebounceSave(ProfileChange::Kind::Rename, id); // Metadata changed, need save
     return true;
 }
 
@@ -720,7 +873,7 @@ bool CameraProfileManager::setProfileCategory(size_t index, const std::string &n
         logger.log(LOG_WARNING, "SetCategory: Not initialized.");
         return false;
     }
-    if (index >= m_profiles.size())
+    if (index >= m_store->size())
     {
         logger.log(LOG_ERROR, "SetCategory: Invalid index.");
         return false;
@@ -734,86 +887,87 @@ bool CameraProfileManager::setProfileCategory(size_t index, const std::string &n
         // Allow it but warn. Could enforce by returning false here if desired.
     }
 
-    std::string oldCategory = m_profiles[index].category;
-    m_profiles[index].category = categoryToSet;
-    m_profiles[index].timestamp = generateTimestamp();
+    const ProfileId id = m_store->at(index).id;
+    std::string oldCategory = *m_store->at(index).category;
+    m_store.apply([id, categoryToSet, timestamp = generateTimestamp()](ProfileStore &store)
+                  { return store.setCategory(id, categoryToSet, timestamp); });
 
     logger.log(LOG_INFO, "CameraProfileManager: Changed category of profile '" +
-                             m_profiles[index].name + "' from '" + oldCategory +
-                             "' to '" + m_profiles[index].category + "'.");
+                             *m_store->at(index).name + "' from '" + oldCategory +
+                             "' to '" + categoryToSet + "'.");
 
-    markProfilesModifiedAndDebounceSave(); // Metadata changed
+    markProfilesModifiedAndDebounceSave(ProfileChange::Kind::SetCategory, id); // Metadata changed
     return true;
 }
 
 // --- Getters for Saved State ---
-const CameraProfile &CameraProfileManager::getCurrentProfile() const
+// Readers never take m_profileMutex: they copy the published snapshot pointer
+// and work on that immutable set, so a writer or a pending save cannot stall them.
+std::shared_ptr<const ProfileSetSnapshot> CameraProfileManager::getProfileSet() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+    return std::atomic_load(&m_published);
+}
 
-    if (!m_isInitialized || m_profiles.empty() || m_currentProfileIndex >= m_profiles.size())
+CameraProfile CameraProfileManager::getCurrentProfile() const
+{
+    const auto set = getProfileSet();
+    const StoredProfile *profile = set ? set->store->findById(set->currentProfileId) : nullptr;
+    if (!profile)
     {
-        static CameraProfile safeDefaultProfile("ErrorSafeDefault", Vector3(0.0f, 0.0f, 0.0f), "Error", "");
         // Avoid logging spam if called frequently in error state
-        return safeDefaultProfile;
+        return CameraProfile("ErrorSafeDefault", Vector3(0.0f, 0.0f, 0.0f), "Error", "");
     }
-    // Return reference to the SAVED profile object
-    return m_profiles[m_currentProfileIndex];
+    // Return a copy of the SAVED profile
+    return profile->toProfile();
 }
 
 Vector3 CameraProfileManager::getSavedOffsetOfCurrentProfile() const
 {
-    // getCurrentProfile handles locking and safety checks
-    return getCurrentProfile().offset; // Return SAVED offset
+    const auto set = getProfileSet();
+    const StoredProfile *profile = set ? set->store->findById(set->currentProfileId) : nullptr;
+    return profile ? profile->offset : Vector3(); // Return SAVED offset
 }
 
 size_t CameraProfileManager::getProfileCount() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
-    if (!m_isInitialized)
-        return 0;
-    return m_profiles.size();
+    const auto set = getProfileSet();
+    return set ? set->store->size() : 0;
 }
 
 size_t CameraProfileManager::getCurrentProfileIndex() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
-    if (!m_isInitialized)
-        return 0;
-    return m_currentProfileIndex;
+    const auto set = getProfileSet();
+    return set ? set->currentIndex : 0;
 }
 
-std::vector<CameraProfile> CameraProfileManager::getAllProfiles() const
+ProfileId CameraProfileManager::getCurrentProfileId() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
-    if (!m_isInitialized)
-        return {};
-    return m_profiles; // Return a copy
+    const auto set = getProfileSet();
+    return set ? set->currentProfileId : INVALID_PROFILE_ID;
 }
 
-std::vector<size_t> CameraProfileManager::getProfileIndicesByCategory(const std::string &category) const
+std::shared_ptr<const ProfileStore> CameraProfileManager::getProfilesSnapshot() const
 {
-    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
-    std::vector<size_t> indices;
-    if (!m_isInitialized)
-        return indices;
+    const auto set = getProfileSet();
+    if (!set)
+        return std::make_shared<const ProfileStore>();
+    return set->store; // Shared, not copied; writers copy-on-write
+}
 
-    for (size_t i = 0; i < m_profiles.size(); ++i)
-    {
-        if (m_profiles[i].category == category)
-        {
-            indices.push_back(i);
-        }
-    }
-    return indices;
+std::vector<size_t> CameraProfileManager::getProfileIndicesByCategory(const std::string &category) const
+{
+    const auto set = getProfileSet();
+    if (!set)
+        return {};
+    return set->store->indicesInCategory(category);
 }
 
-// --- Live Adjustments --- (No locks inside assuming g_ is safe enough for now)
+// --- Live Adjustments --- (queued on GameCommandQueue and applied in order by the game thread;
+// g_currentCameraOffset is a SeqLock snapshot, so the render thread never sees a half-applied change)
 void CameraProfileManager::adjustOffset(float x, float y, float z)
 {
-    g_currentCameraOffset.x += x;
-    g_currentCameraOffset.y += y;
-    g_currentCameraOffset.z += z;
+    // Applied by the game thread at the start of its next camera update
+    GameCommandQueue::getInstance().nudgeOffset(Vector3(x, y, z));
 
     // Optionally log less frequently or guard with debug check
     // Logger::getInstance().log(LOG_DEBUG, "Adjusted LIVE offset...");
@@ -821,29 +975,110 @@ void CameraProfileManager::adjustOffset(float x, float y, float z)
 
 void CameraProfileManager::setOffset(float x, float y, float z)
 {
-    g_currentCameraOffset.x = x;
-    g_currentCameraOffset.y = y;
-    g_currentCameraOffset.z = z;
+    // Recorded for undo when applied (setOffsetEditListener in the constructor)
+    GameCommandQueue::getInstance().setOffset(Vector3(x, y, z), true);
 
     // Logger::getInstance().log(LOG_DEBUG, "Set LIVE offset...");
 }
 
+// --- Edit History ---
+void CameraProfileManager::recordOffsetAdjustment(const Vector3 &delta)
+{
+    const ProfileId profile_id = getCurrentProfileId();
+    std::lock_guard<std::mutex> history_lock(m_historyMutex);
+    m_history.record({OffsetEdit::Target::LiveOffset, profile_id, delta});
+}
+
+bool CameraProfileManager::undoOffsetEdit()
+{
+    OffsetEdit edit;
+    bool found;
+    {
+        std::lock_guard<std::mutex> history_lock(m_historyMutex);
+        found = m_history.undo(edit);
+    }
+    if (!found)
+    {
+        Logger::getInstance().log(LOG_INFO, "CameraProfileManager: Nothing to undo.");
+        return false;
+    }
+    return applyOffsetEdit(edit, -1.0f);
+}
+
+bool CameraProfileManager::redoOffsetEdit()
+{
+    OffsetEdit edit;
+    bool found;
+    {
+        std::lock_guard<std::mutex> history_lock(m_historyMutex);
+        found = m_history.redo(edit);
+    }
+    if (!found)
+    {
+        Logger::getInstance().log(LOG_INFO, "CameraProfileManager: Nothing to redo.");
+        return false;
+    }
+    return applyOffsetEdit(edit, 1.0f);
+}
+
+bool CameraProfileManager::applyOffsetEdit(const OffsetEdit &edit, float direction)
+{
+    // Called without m_historyMutex held; applying must not record history again
+    Logger &logger = Logger::getInstance();
+    const Vector3 delta = edit.delta * direction;
+    const char *action = direction < 0.0f ? "Undo" : "Redo";
+
+    if (edit.target == OffsetEdit::Target::LiveOffset)
+    {
+        // Queued behind any nudge still pending, so it reverts exactly what was recorded
+        GameCommandQueue::getInstance().nudgeOffset(delta);
+        logger.log(LOG_INFO, std::string("CameraProfileManager: ") + action + " live offset change " + Vector3ToString(delta) + ".");
+        return true;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(m_profileMutex);
+    const StoredProfile *profile = m_isInitialized ? m_store->findById(edit.profileId) : nullptr;
+    if (!profile)
+    {
+        logger.log(LOG_WARNING, std::string("CameraProfileManager: ") + action + " skipped, profile ID " +
+                                    std::to_string(edit.profileId) + " no longer exists.");
+        return false;
+    }
+
+    const std::string name = *profile->name;
+    const Vector3 restored = profile->offset + delta;
+    m_store.apply([id = edit.profileId, restored, timestamp = generateTimestamp()](ProfileStore &store)
+                  { return store.setOffset(id, restored, timestamp); });
+    logger.log(LOG_INFO, std::string("CameraProfileManager: ") + action + " saved offset of '" + name +
+                             "'. Saved offset now " + Vector3ToString(restored) + ".");
+
+    markProfilesModifiedAndDebounceSave(ProfileChange::Kind::Update, edit.profileId);
+    return true;
+}
+
 // --- Transition Configuration ---
 void CameraProfileManager::setTransitionSettings(
     float duration,
     bool useSpringPhysics,
     float springStrength,
-    float springDamping)
+    float springDamping,
+    const std::string &curveSpec)
 {
-    // Assuming TransitionManager methods are safe to call without lock here
-    TransitionManager &transition = TransitionManager::getInstance();
-    transition.setTransitionDuration(duration);
-    transition.setUseSpringPhysics(useSpringPhysics);
-    transition.setSpringStrength(springStrength);
-    transition.setSpringDamping(springDamping);
+    // Queued for the render thread, so this is safe from any thread
+    TransitionSettings settings;
+    settings.duration = duration;
+    settings.useSpringPhysics = useSpringPhysics;
+    settings.springStrength = springStrength;
+    settings.springDamping = springDamping;
+    if (!EasingCurve::parse(curveSpec, settings.curve))
+    {
+        Logger::getInstance().log(LOG_WARNING, "CameraProfileManager: Unknown transition curve '" + curveSpec + "'. Using smoothstep.");
+    }
+    TransitionManager::getInstance().configure(settings);
 
     // Log settings
     Logger::getInstance().log(LOG_INFO, "CameraProfileManager: Updated transition settings - Duration: " + std::to_string(duration) + "s, " +
+                                            "Curve: " + settings.curve.spec() + ", " +
                                             "Spring Physics: " + (useSpringPhysics ? "ON" : "OFF") +
                                             (useSpringPhysics ? ", Strength: " + std::to_string(springStrength) + ", Damping: " + std::to_string(springDamping) : ""));
 }
@@ -877,39 +1112,3 @@ std::string CameraProfileManager::generateTimestamp() const
     ss << std::put_time(&timeinfo_tm, "%Y-%m-%d %H:%M:%S");
     return ss.str();
 }
-
-void CameraProfileManager::profileToJson(const CameraProfile &profile, json &jsonObj) const
-{
-    jsonObj["name"] = profile.name;
-    jsonObj["category"] = profile.category;
-    jsonObj["timestamp"] = profile.timestamp;
-    jsonObj["offset"] = {
-        {"x", profile.offset.x},
-        {"y", profile.offset.y},
-        {"z", profile.offset.z}};
-}
-
-CameraProfile CameraProfileManager::profileFromJson(const json &jsonObj) const
-{
-    try
-    {
-        std::string name = jsonObj.value("name", "Unnamed Profile");
-        std::string category = jsonObj.value("category", "General");
-        std::string timestamp = jsonObj.value("timestamp", generateTimestamp());
-        float x = 0.0f, y = 0.0f, z = 0.0f;
-
-        if (jsonObj.contains("offset") && jsonObj["offset"].is_object())
-        {
-            const json &offsetObj = jsonObj["offset"];
-            x = offsetObj.value("x", 0.0f);
-            y = offsetObj.value("y", 0.0f);
-            z = offsetObj.value("z", 0.0f);
-        }
-        return CameraProfile(name, Vector3(x, y, z), category, timestamp);
-    }
-    catch (const std::exception &e)
-    {
-        Logger::getInstance().log(LOG_WARNING, "CameraProfileManager: Error parsing profile JSON: " + std::string(e.what()) + ". Returning error profile.");
-        return CameraProfile("ErrorProfile", Vector3(0, 0, 0), "Error", generateTimestamp());
-    }
-}
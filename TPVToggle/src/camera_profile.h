@@ -2,31 +2,67 @@
 #ifndef CAMERA_PROFILE_H
 #define CAMERA_PROFILE_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <mutex>
 #include <memory>
 #include "math_utils.h"
+#include "profile_store.h"
+#include "offset_history.h"
 #include "transition_manager.h"
 
-#include <nlohmann/json.hpp>
+class ProfilePersistence;
+class FileWatcher;
+struct ProfileSnapshot;
+struct JournalReplayResult;
+struct ProfileFileState;
+struct ProfileDiff;
 
-// Structure to represent a saved camera profile's persistent state
-struct CameraProfile
+/**
+ * @struct ProfileChange
+ * @brief One journal record: a single edit to the profile list.
+ *
+ * Records address profiles by stable ID; only Create carries a display
+ * position, which replay clamps to the end of the list.
+ */
+struct ProfileChange
 {
-    std::string name;
-    Vector3 offset; // The *SAVED* offset for this profile
-    std::string category;
-    std::string timestamp; // Last saved timestamp
-
-    CameraProfile(const std::string &profile_name = "Default",
-                  const Vector3 &profile_offset = Vector3(0.0f, 0.0f, 0.0f),
-                  const std::string &profile_category = "General",
-                  const std::string &profile_timestamp = "")
-        : name(profile_name), offset(profile_offset), category(profile_category), timestamp(profile_timestamp) {}
+    enum class Kind
+    {
+        Create,      // Insert `profile` at `index`
+        Update,      // Set offset + timestamp of `id`
+        Rename,      // Set name + timestamp of `id`
+        SetCategory, // Set category + timestamp of `id`
+        Delete       // Erase `id`
+    };
+
+    Kind kind;
+    ProfileId id;
+    size_t index;          // Display position (Create only)
+    CameraProfile profile; // Profile state after the change (unused for Delete)
+    uint64_t revision;     // Snapshot revision that includes this change
+};
+
+/**
+ * @struct ProfileSetSnapshot
+ * @brief Immutable view of the saved profiles together with the active profile.
+ *
+ * Published by the writer after every change; readers load the current
+ * pointer and can keep using it for as long as they hold it.
+ */
+struct ProfileSetSnapshot
+{
+    std::shared_ptr<const ProfileStore> store; // Never modified once published
+    ProfileId currentProfileId;                // Active profile in this snapshot
+    size_t currentIndex;                       // Display position of currentProfileId (0 if missing)
 };
 
+
 // Manages camera profiles, separating live editing from saved states.
+// Writers are serialized and publish a new ProfileSetSnapshot; getters read
+// the published snapshot and never wait for a writer or a disk save.
 class CameraProfileManager
 {
 public:
@@ -42,9 +78,27 @@ public:
     bool loadProfiles(const std::string &directory);
     /**
      * @brief Explicitly saves all profiles to the JSON file immediately.
+     * @details Serializes and writes on the calling thread, but outside the profile lock.
      * @return true if save was successful.
      */
     bool saveProfilesToJson(); // Public for explicit save if needed outside debouncing
+    /**
+     * @brief Stops the background save worker, writing any pending changes first.
+     * @details Call during shutdown, before the process tears down static objects.
+     */
+    void shutdownPersistence();
+    /**
+     * @brief Starts applying edits that other programs make to the profiles file while the game runs.
+     * @details Call after loadProfiles(). The new file is parsed off the input and render threads
+     *          and compared with its previous contents by profile ID; only added, removed and changed
+     *          profiles are applied. The active profile, the live offset and any running transition are kept.
+     * @return true if the file is being watched.
+     */
+    bool startWatchingProfilesFile();
+    /**
+     * @brief Stops watching the profiles file. Must not be called while holding the profile lock.
+     */
+    void stopWatchingProfilesFile();
 
     // --- Profile Lifecycle Actions ---
     /**
@@ -66,6 +120,12 @@ public:
      * @return true if deletion was successful.
      */
     bool deleteProfile(size_t index);
+    /**
+     * @brief Deletes the profile with the given stable ID. Cannot delete "Default".
+     * @param id Stable ID of the profile to delete.
+     * @return true if deletion was successful.
+     */
+    bool deleteProfileById(ProfileId id);
     /**
      * @brief Helper to delete the currently active profile (unless it's "Default").
      * @return true if deletion was successful.
@@ -90,6 +150,12 @@ public:
      * @param useTransition If true, use smooth transition; otherwise, switch instantly.
      */
     void setActiveProfile(size_t index, bool useTransition = true);
+    /**
+     * @brief Activates a profile by stable ID. Same behavior as setActiveProfile().
+     * @param id Stable ID of the profile to activate; unknown IDs fall back to "Default".
+     * @param useTransition If true, use smooth transition; otherwise, switch instantly.
+     */
+    void setActiveProfileById(ProfileId id, bool useTransition = true);
     /**
      * @brief Resets the "Default" profile's saved offset to (0,0,0) and activates it.
      */
@@ -114,9 +180,9 @@ public:
     // --- Getters for Saved State ---
     /**
      * @brief Gets the profile object (saved state) for the currently active profile.
-     * @return Const reference to the active CameraProfile. Returns safe default on error.
+     * @return Copy of the active CameraProfile. Returns safe default on error.
      */
-    const CameraProfile &getCurrentProfile() const;
+    CameraProfile getCurrentProfile() const;
     /**
      * @brief Gets the SAVED offset Vector3 of the currently active profile.
      * @return The saved offset. Returns (0,0,0) on error.
@@ -133,10 +199,22 @@ public:
      */
     size_t getCurrentProfileIndex() const;
     /**
-     * @brief Gets a copy of the entire list of saved profiles.
-     * @return std::vector<CameraProfile>
+     * @brief Gets the stable ID of the currently active profile.
+     * @return Active profile ID, or INVALID_PROFILE_ID before initialization.
+     */
+    ProfileId getCurrentProfileId() const;
+    /**
+     * @brief Gets a read-only view of all saved profiles without copying them.
+     * @details The returned store never changes; later edits go to a new copy.
+     * @return Shared snapshot of the profile store (empty before initialization).
+     */
+    std::shared_ptr<const ProfileStore> getProfilesSnapshot() const;
+    /**
+     * @brief Gets the published profile set (store plus active profile) in one read.
+     * @details Use this instead of several getters when the values must agree with each other.
+     * @return Current snapshot, or nullptr before initialization.
      */
-    std::vector<CameraProfile> getAllProfiles() const;
+    std::shared_ptr<const ProfileSetSnapshot> getProfileSet() const;
     /**
      * @brief Filters profiles by category and returns their indices.
      * @param category Category string to filter by.
@@ -144,9 +222,11 @@ public:
      */
     std::vector<size_t> getProfileIndicesByCategory(const std::string &category) const;
 
-    // --- Live Adjustments (modify ONLY g_currentCameraOffset) ---
+    // --- Live Adjustments (modify ONLY g_currentCameraOffset, through GameCommandQueue) ---
     /**
      * @brief Adds delta values to the live camera offset (g_currentCameraOffset).
+     * @details Only queues the nudge, so the render thread may call it; undo history is
+     *          recorded per key hold with recordOffsetAdjustment().
      * @param x Delta X.
      * @param y Delta Y.
      * @param z Delta Z.
@@ -154,14 +234,34 @@ public:
     void adjustOffset(float x, float y, float z);
     /**
      * @brief Sets the live camera offset (g_currentCameraOffset) to absolute values.
+     * @details The undo entry is recorded when the game thread applies it, relative to the offset it replaced.
      * @param x New X.
      * @param y New Y.
      * @param z New Z.
      */
     void setOffset(float x, float y, float z);
 
+    // --- Edit History (undo/redo of live and saved offset edits) ---
+    /**
+     * @brief Records a finished key hold (the sum of its adjustOffset() calls) as one undo step.
+     * @details Takes the history lock: the render thread posts this to the input thread.
+     * @param delta Total change the hold made to the live offset.
+     */
+    void recordOffsetAdjustment(const Vector3 &delta);
+    /**
+     * @brief Reverts the most recent offset edit (a whole key hold counts as one edit).
+     * @return true if an edit was undone.
+     */
+    bool undoOffsetEdit();
+    /**
+     * @brief Re-applies the most recently undone offset edit.
+     * @return true if an edit was redone.
+     */
+    bool redoOffsetEdit();
+
     // --- Transition Configuration ---
-    void setTransitionSettings(float duration, bool useSpringPhysics, float springStrength, float springDamping);
+    void setTransitionSettings(float duration, bool useSpringPhysics, float springStrength, float springDamping,
+                               const std::string &curveSpec);
 
 private:
     // Constructor/Destructor
@@ -173,27 +273,43 @@ private:
     CameraProfileManager &operator=(const CameraProfileManager &) = delete;
 
     // Internal JSON I/O
-    bool loadProfilesFromJson();                                                     // Loads file into m_profiles
-    void profileToJson(const CameraProfile &profile, nlohmann::json &jsonObj) const; // Profile -> JSON object
-    CameraProfile profileFromJson(const nlohmann::json &jsonObj) const;              // JSON object -> Profile
+    bool loadProfilesFromJson(JournalReplayResult &journal, ProfileFileState &fileState); // Loads file + journal into m_store
+
+    // Hot reload
+    void reloadProfilesFromDisk();                                          // Watcher thread: reads, parses and diffs without the lock
+    void applyProfileFileDiff(const ProfileDiff &diff, const std::string &baseFingerprint,
+                              ProfileFileState fileState); // Applies an outside edit if the diff base is still current (takes the lock)
 
     // Internal helper
     std::string generateTimestamp() const;
 
     // Internal persistence trigger
-    void markProfilesModifiedAndDebounceSave(); // Sets flag and triggers save if needed
+    void markProfilesModifiedAndDebounceSave();                                                 // Queues a full rewrite
+    void markProfilesModifiedAndDebounceSave(ProfileChange::Kind kind, ProfileId id);            // Queues a journal record
+    std::shared_ptr<const ProfileSnapshot> makeSnapshot();                                       // Shares m_store at a new revision (lock held)
+    void publishLocked();                                                                        // Publishes m_store + m_currentProfileId to readers (lock held)
+    bool deleteProfileLocked(ProfileId id);                                                      // Shared delete logic (lock held)
+    bool applyOffsetEdit(const OffsetEdit &edit, float direction);                               // +1 redo, -1 undo
 
     // Member variables
-    std::vector<CameraProfile> m_profiles;       // Stores the SAVED states
-    size_t m_currentProfileIndex;                // Index of the active profile in m_profiles
+    ProfileStoreWriter m_store;                  // Writer's copy of the SAVED states; edits go through apply()
+    ProfileId m_currentProfileId;                // Stable ID of the active profile (writer's view)
     std::string m_profileDirectory;              // Directory containing JSON file
     std::string m_jsonProfilesPath;              // Full path to JSON file
-    bool m_isInitialized;                        // Initialization flag
-    mutable std::recursive_mutex m_profileMutex; // Protects m_profiles, m_currentProfileIndex, m_profilesModified, m_lastSaveTime
+    std::atomic<bool> m_isInitialized;           // Initialization flag
+    mutable std::recursive_mutex m_profileMutex; // Serializes writers; getters never take it
+
+    // Reader side. Only accessed through std::atomic_load / std::atomic_store.
+    std::shared_ptr<const ProfileSetSnapshot> m_published;
+
+    // Write-behind persistence
+    uint64_t m_revision;                               // Bumped on every change to m_store
+    std::unique_ptr<ProfilePersistence> m_persistence; // Background save worker
+    std::unique_ptr<FileWatcher> m_watcher;            // Hot reload of the profiles file
 
-    // Save debouncing state
-    bool m_profilesModified; // Tracks if m_profiles content requires saving
-    time_t m_lastSaveTime;   // Timestamp of last successful save
+    // Undo/redo (cleared whenever a profile is activated, which discards live edits)
+    OffsetEditHistory m_history;
+    std::mutex m_historyMutex; // Protects m_history; held for one ring operation, never while logging or taking m_profileMutex
 
     // Constants
     static constexpr int SAVE_DEBOUNCE_SECONDS = 2; // Debounce window
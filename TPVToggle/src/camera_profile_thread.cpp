@@ -1,260 +1,282 @@
 #include "camera_profile_thread.h"
 #include "camera_profile.h"
+#include "profile_zones.h"
+#include "input_service.h"
+#include "hotkey.h"
+#include "camera_path_manager.h"
+#include "held_adjustment.h"
+#include "game_interface.h"
+#include "constants.h"
 #include "logger.h"
 #include "utils.h"
 #include "global_state.h"
 #include "config.h"
 
-#include <unordered_map>
-#include <bitset>
-#include <vector>
-#include <algorithm>
-#include <chrono>
-#include <iomanip>
+#include <atomic>
+#include <cstdint>
+#include <string>
 
 // External config reference
 extern Config g_config;
 
-/**
- * @brief Structure to efficiently map VK codes to bit positions for batch processing
- */
-struct KeyBitMapInfo
+namespace
 {
-    std::vector<int> allKeys;               // All registered keys in monitoring order
-    std::unordered_map<int, size_t> keyMap; // Maps VK code -> bit position (0 to 63)
-    size_t keyCount = 0;                    // Number of unique keys mapped
+    enum ProfileAction : HotkeyEngine::ActionId
+    {
+        ActionMasterToggle,
+        ActionProfileSave, // Create New
+        ActionProfileCycle,
+        ActionProfileReset,
+        ActionProfileUpdate,
+        ActionProfileDelete,
+        ActionProfileUndo,
+        ActionProfileRedo,
+        ActionPathKeyframe,
+        ActionPathPlay,
+        ActionPathNew,
+        ActionPathCycle,
+        ActionOffsetXInc,
+        ActionOffsetXDec,
+        ActionOffsetYInc,
+        ActionOffsetYDec,
+        ActionOffsetZInc,
+        ActionOffsetZDec,
+        ActionPrecision
+    };
 
-    // Bitmasks for different key groups
-    uint64_t masterToggleMask = 0;
-    uint64_t profileSaveMask = 0; // Create New
-    uint64_t profileCycleMask = 0;
-    uint64_t profileResetMask = 0;
-    uint64_t profileUpdateMask = 0;
-    uint64_t profileDeleteMask = 0;
-    uint64_t offsetXIncMask = 0;
-    uint64_t offsetXDecMask = 0;
-    uint64_t offsetYIncMask = 0;
-    uint64_t offsetYDecMask = 0;
-    uint64_t offsetZIncMask = 0;
-    uint64_t offsetZDecMask = 0;
+    // Input thread state of the camera profile actions
+    HotkeyEngine g_hotkeys;
 
-    // Add more masks here if total unique keys > 64 bits supported by uint64_t
-};
+    // Held offset keys (bit per offset action, plus the precision key), published to the render thread
+    constexpr uint32_t PRECISION_HELD_BIT = 1u << (ActionPrecision - ActionOffsetXInc);
+    std::atomic<uint32_t> g_heldOffsetKeys(0);
 
-/**
- * @brief Create a bitmap mapping for all registered keys
- * @param config The global configuration with key settings
- * @return KeyBitMapInfo structure with mappings and masks
- */
-KeyBitMapInfo createKeyBitMap(const Config &config)
-{
-    KeyBitMapInfo info;
-    info.keyCount = 0; // Reset key count
+    // Render thread state
+    HeldAdjustment g_heldAdjustment;
+    Vector3 g_heldAdjustmentTotal; // Nudged so far in the current hold, recorded for undo when it ends
+    std::atomic<bool> g_zonesActive(false); // Zones enabled and loaded (set before the hooks see it)
+
+    /**
+     * @brief Compiles every camera profile key binding from the config
+     */
+    void addProfileHotkeys(const Config &config)
+    {
+        g_hotkeys.add(ActionMasterToggle, config.master_toggle_keys);
+        g_hotkeys.add(ActionProfileSave, config.profile_save_keys);
+        g_hotkeys.add(ActionProfileCycle, config.profile_cycle_keys);
+        g_hotkeys.add(ActionProfileReset, config.profile_reset_keys);
+        g_hotkeys.add(ActionProfileUpdate, config.profile_update_keys);
+        g_hotkeys.add(ActionProfileDelete, config.profile_delete_keys);
+        g_hotkeys.add(ActionProfileUndo, config.profile_undo_keys);
+        g_hotkeys.add(ActionProfileRedo, config.profile_redo_keys);
+        g_hotkeys.add(ActionPathKeyframe, config.path_keyframe_keys);
+        g_hotkeys.add(ActionPathPlay, config.path_play_keys);
+        g_hotkeys.add(ActionPathNew, config.path_new_keys);
+        g_hotkeys.add(ActionPathCycle, config.path_cycle_keys);
+        // Only sampled while held, so holding Ctrl for precision does not block the other hotkeys
+        g_hotkeys.addHeld(ActionOffsetXInc, config.offset_x_inc_keys);
+        g_hotkeys.addHeld(ActionOffsetXDec, config.offset_x_dec_keys);
+        g_hotkeys.addHeld(ActionOffsetYInc, config.offset_y_inc_keys);
+        g_hotkeys.addHeld(ActionOffsetYDec, config.offset_y_dec_keys);
+        g_hotkeys.addHeld(ActionOffsetZInc, config.offset_z_inc_keys);
+        g_hotkeys.addHeld(ActionOffsetZDec, config.offset_z_dec_keys);
+        g_hotkeys.addHeld(ActionPrecision, config.precision_keys);
+    }
 
-    // Helper to register keys and update masks
-    auto registerKeys = [&](const std::vector<int> &keys, uint64_t &mask)
+    uint32_t sampleHeldOffsetKeys()
     {
-        for (int vk : keys)
+        const KeyState &state = InputService::getInstance().keyState();
+        uint32_t held = 0;
+        for (HotkeyEngine::ActionId action = ActionOffsetXInc; action <= ActionOffsetZDec; ++action)
         {
-            if (vk != 0)
-            {
-                // Check if key already registered and if we have space in the 64-bit map
-                if (info.keyMap.find(vk) == info.keyMap.end())
-                {
-                    if (info.keyCount >= 64)
-                    {
-                        // Log error or warning: exceeded 64 unique hotkeys
-                        Logger::getInstance().log(LOG_ERROR, "CameraProfileThread: Exceeded maximum unique hotkeys (64). Key " + format_vkcode(vk) + " ignored.");
-                        continue; // Skip this key
-                    }
-                    info.keyMap[vk] = info.keyCount; // Assign current bit position
-                    info.allKeys.push_back(vk);
-                    info.keyCount++;
-                }
-                // Set the corresponding bit in the specific action mask
-                mask |= (1ULL << info.keyMap[vk]);
-            }
+            if (g_hotkeys.isHeld(action, state))
+                held |= 1u << (action - ActionOffsetXInc);
         }
-    };
+        if (held && g_hotkeys.isHeld(ActionPrecision, state))
+            held |= PRECISION_HELD_BIT;
+        return held;
+    }
 
-    // Register all key groups from config, including new ones
-    registerKeys(config.master_toggle_keys, info.masterToggleMask);
-    registerKeys(config.profile_save_keys, info.profileSaveMask); // Create New
-    registerKeys(config.profile_cycle_keys, info.profileCycleMask);
-    registerKeys(config.profile_reset_keys, info.profileResetMask);
-    registerKeys(config.profile_update_keys, info.profileUpdateMask);
-    registerKeys(config.profile_delete_keys, info.profileDeleteMask);
-    registerKeys(config.offset_x_inc_keys, info.offsetXIncMask);
-    registerKeys(config.offset_x_dec_keys, info.offsetXDecMask);
-    registerKeys(config.offset_y_inc_keys, info.offsetYIncMask);
-    registerKeys(config.offset_y_dec_keys, info.offsetYDecMask);
-    registerKeys(config.offset_z_inc_keys, info.offsetZIncMask);
-    registerKeys(config.offset_z_dec_keys, info.offsetZDecMask);
+    // -1, 0 or 1 for one axis of the held offset keys
+    float heldAxis(uint32_t held, HotkeyEngine::ActionId increase, HotkeyEngine::ActionId decrease)
+    {
+        const bool up = (held & (1u << (increase - ActionOffsetXInc))) != 0;
+        const bool down = (held & (1u << (decrease - ActionOffsetXInc))) != 0;
+        return (up ? 1.0f : 0.0f) - (down ? 1.0f : 0.0f);
+    }
 
-    return info;
-}
+    /**
+     * @brief Runs a fired camera profile hotkey (input thread)
+     */
+    void runProfileAction(HotkeyEngine::ActionId action, int)
+    {
+        Logger &logger = Logger::getInstance();
 
-/**
- * @brief Get current state of all registered keys as a bitmap
- * @param keys Vector of VK codes to check
- * @param keyMap Mapping of VK codes to bit positions
- * @return 64-bit bitmap where each bit represents a key state (1=pressed)
- */
-uint64_t getKeyStateBitmap(const std::vector<int> &keys, const std::unordered_map<int, size_t> &keyMap)
-{
-    uint64_t stateBitmap = 0;
+        // Master toggle: Always check regardless of adjustment mode
+        if (action == ActionMasterToggle)
+        {
+            bool newMode = !g_cameraAdjustmentMode.load();
+            g_cameraAdjustmentMode.store(newMode);
+            logger.log(LOG_INFO, "CameraProfileActions: Adjustment mode " + std::string(newMode ? "ENABLED" : "DISABLED"));
+            return;
+        }
 
-    for (int vk : keys)
-    {
-        if (vk != 0)
+        // Check other keys only if adjustment mode is enabled
+        if (!g_cameraAdjustmentMode.load())
+            return;
+
+        switch (action)
         {
-            auto it = keyMap.find(vk);
-            if (it != keyMap.end())
-            {
-                // GetAsyncKeyState returns non-zero if pressed; highest bit indicates currently down.
-                bool pressed = (GetAsyncKeyState(vk) & 0x8000) != 0;
-                if (pressed)
-                {
-                    // Set the corresponding bit if key is down
-                    stateBitmap |= (1ULL << it->second);
-                }
-            }
+        // 1. CREATE NEW Profile key (e.g., Numpad 1)
+        case ActionProfileSave:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Create New Profile key press detected.");
+            CameraProfileManager::getInstance().createNewProfileFromLiveState("General");
+            break;
+
+        // 2. UPDATE ACTIVE Profile key (e.g., Numpad 7)
+        case ActionProfileUpdate:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Update Active Profile key press detected.");
+            // This function internally checks if active is "Default" and logs a warning if so.
+            CameraProfileManager::getInstance().updateActiveProfileWithLiveState();
+            break;
+
+        // 3. DELETE ACTIVE Profile key (e.g., Numpad 9)
+        case ActionProfileDelete:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Delete Active Profile key press detected.");
+            // This function internally checks if active is "Default" and prevents deletion if so.
+            CameraProfileManager::getInstance().deleteActiveProfile();
+            break;
+
+        // 4. Cycle Profiles key (e.g., Numpad 3)
+        case ActionProfileCycle:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Cycle Profiles key press detected.");
+            CameraProfileManager::getInstance().cycleToNextProfile();
+            break;
+
+        // 5. Reset to Default key (e.g., Numpad 5)
+        case ActionProfileReset:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Reset to Default key press detected.");
+            CameraProfileManager::getInstance().resetToDefault();
+            break;
+
+        // 6. Undo / Redo offset edits (e.g., Numpad / and *)
+        case ActionProfileUndo:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Undo key press detected.");
+            CameraProfileManager::getInstance().undoOffsetEdit();
+            break;
+        case ActionProfileRedo:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Redo key press detected.");
+            CameraProfileManager::getInstance().redoOffsetEdit();
+            break;
+
+        // 7. Camera paths (e.g., Numpad 0 captures, Numpad . plays/stops)
+        case ActionPathNew:
+            logger.log(LOG_DEBUG, "CameraProfileActions: New Path key press detected.");
+            CameraPathManager::getInstance().newPath();
+            break;
+        case ActionPathCycle:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Cycle Paths key press detected.");
+            CameraPathManager::getInstance().cycleToNextPath();
+            break;
+        case ActionPathKeyframe:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Capture Keyframe key press detected.");
+            CameraPathManager::getInstance().captureKeyframe();
+            break;
+        case ActionPathPlay:
+            logger.log(LOG_DEBUG, "CameraProfileActions: Play Path key press detected.");
+            CameraPathManager::getInstance().togglePlayback();
+            break;
+
+        // Offset and precision keys never fire; they act while held (updateHeldOffsetAdjustment)
+        default:
+            break;
         }
     }
 
-    return stateBitmap;
-}
-
-/**
- * @brief Compare current key state bitmap with previous to detect new key presses
- * @param currentState Current key state bitmap
- * @param previousState Previous key state bitmap
- * @param actionMask Bitmap mask for the specific key group
- * @return true if any key in the group was newly pressed
- */
-bool isNewKeyPress(uint64_t currentState, uint64_t previousState, uint64_t actionMask)
-{
-    // A key is newly pressed if it's set in current state but not in previous state
-    uint64_t newPresses = (currentState & ~previousState) & actionMask;
-    return newPresses != 0;
+    /**
+     * @brief Publishes the held offset keys after every key event (input thread)
+     */
+    void updateOffsetKeyHold(const KeyEvent &)
+    {
+        g_heldOffsetKeys.store(sampleHeldOffsetKeys(), std::memory_order_release);
+    }
 }
 
-/**
- * @brief Camera profile thread entry point - optimized with batch key checking
- */
-DWORD WINAPI CameraProfileThread(LPVOID param)
+void registerCameraProfileActions()
 {
     Logger &logger = Logger::getInstance();
-    logger.log(LOG_INFO, "CameraProfileThread: Started");
+    InputService &input = InputService::getInstance();
 
-    // Read thread parameters (adjustment step)
-    CameraProfileThreadData *data = static_cast<CameraProfileThreadData *>(param);
-    if (!data)
+    // Compile the key bindings from the loaded config
+    addProfileHotkeys(g_config);
+    g_heldOffsetKeys.store(0);
+
+    HeldAdjustment::Settings settings;
+    settings.speed = g_config.offset_adjustment_speed;
+    settings.maxMultiplier = g_config.adjustment_max_multiplier;
+    settings.rampSeconds = g_config.adjustment_ramp_time;
+    settings.precisionScale = g_config.precision_scale;
+    if (!EasingCurve::parse(g_config.adjustment_curve, settings.curve))
     {
-        logger.log(LOG_ERROR, "CameraProfileThread: NULL data received");
-        return 1;
+        logger.log(LOG_WARNING, "CameraProfileActions: Unknown adjustment curve '" + g_config.adjustment_curve + "'. Using smoothstep.");
     }
-    float adjustmentStep = data->adjustmentStep;
-    delete data; // Clean up thread data structure
+    g_heldAdjustment.setSettings(settings);
 
-    // Create key mappings based on loaded config
-    KeyBitMapInfo keyInfo = createKeyBitMap(g_config);
+    g_hotkeys.bind(runProfileAction, updateOffsetKeyHold);
+    logger.log(LOG_DEBUG, "CameraProfileActions: Registered " + std::to_string(g_hotkeys.size()) + " hotkeys on " +
+                              std::to_string(g_hotkeys.keys().size()) + " keys.");
 
-    // Initialize key state tracker (all keys initially up)
-    uint64_t previousKeyState = 0;
+    // Adjustment mode keeps key polling (hook fallback) at the full rate
+    input.addPollBoost([]
+                       { return g_cameraAdjustmentMode.load(); });
 
-    logger.log(LOG_DEBUG, "CameraProfileThread: Registered " + std::to_string(keyInfo.keyCount) + " unique keys for monitoring.");
+    // Zones are looked up every frame by the camera hook (updateProfileZones)
+    g_zonesActive.store(g_config.enable_profile_zones && ProfileZoneManager::getInstance().getZoneCount() > 0);
+}
 
-    // Main loop
-    while (WaitForSingleObject(g_exitEvent, 16) != WAIT_OBJECT_0) // ~60 Hz check
+void updateHeldOffsetAdjustment(float deltaTime)
+{
+    const uint32_t held = g_heldOffsetKeys.load(std::memory_order_acquire);
+    if (!(held & ~PRECISION_HELD_BIT) || !g_cameraAdjustmentMode.load())
     {
-        try
+        // A finished key hold becomes one undo step; recording takes the history lock, so the input thread does it
+        if (g_heldAdjustment.isActive())
         {
-            // Get current state of all monitored keys
-            uint64_t currentKeyState = getKeyStateBitmap(keyInfo.allKeys, keyInfo.keyMap);
-
-            // --- Process Keys ---
-
-            // Master toggle: Always check regardless of adjustment mode
-            if (isNewKeyPress(currentKeyState, previousKeyState, keyInfo.masterToggleMask))
+            g_heldAdjustment.reset();
+            const Vector3 total = g_heldAdjustmentTotal;
+            g_heldAdjustmentTotal = Vector3(0.0f, 0.0f, 0.0f);
+            if (total.x != 0.0f || total.y != 0.0f || total.z != 0.0f)
             {
-                bool newMode = !g_cameraAdjustmentMode.load();
-                g_cameraAdjustmentMode.store(newMode);
-                logger.log(LOG_INFO, "CameraProfileThread: Adjustment mode " + std::string(newMode ? "ENABLED" : "DISABLED"));
+                InputService::getInstance().post([total]
+                                                 { CameraProfileManager::getInstance().recordOffsetAdjustment(total); });
             }
+        }
+        return;
+    }
 
-            // Check other keys only if adjustment mode is enabled
-            if (g_cameraAdjustmentMode.load())
-            {
-                // 1. CREATE NEW Profile key (e.g., Numpad 1)
-                if (isNewKeyPress(currentKeyState, previousKeyState, keyInfo.profileSaveMask))
-                {
-                    logger.log(LOG_DEBUG, "CameraProfileThread: Create New Profile key press detected.");
-                    CameraProfileManager::getInstance().createNewProfileFromLiveState("General");
-                }
-
-                // 2. UPDATE ACTIVE Profile key (e.g., Numpad 7)
-                if (isNewKeyPress(currentKeyState, previousKeyState, keyInfo.profileUpdateMask))
-                {
-                    logger.log(LOG_DEBUG, "CameraProfileThread: Update Active Profile key press detected.");
-                    // This function internally checks if active is "Default" and logs a warning if so.
-                    CameraProfileManager::getInstance().updateActiveProfileWithLiveState();
-                }
-
-                // 3. DELETE ACTIVE Profile key (e.g., Numpad 9)
-                if (isNewKeyPress(currentKeyState, previousKeyState, keyInfo.profileDeleteMask))
-                {
-                    logger.log(LOG_DEBUG, "CameraProfileThread: Delete Active Profile key press detected.");
-                    // This function internally checks if active is "Default" and prevents deletion if so.
-                    CameraProfileManager::getInstance().deleteActiveProfile();
-                }
-
-                // 4. Cycle Profiles key (e.g., Numpad 3)
-                if (isNewKeyPress(currentKeyState, previousKeyState, keyInfo.profileCycleMask))
-                {
-                    logger.log(LOG_DEBUG, "CameraProfileThread: Cycle Profiles key press detected.");
-                    CameraProfileManager::getInstance().cycleToNextProfile();
-                }
-
-                // 5. Reset to Default key (e.g., Numpad 5)
-                if (isNewKeyPress(currentKeyState, previousKeyState, keyInfo.profileResetMask))
-                {
-                    logger.log(LOG_DEBUG, "CameraProfileThread: Reset to Default key press detected.");
-                    CameraProfileManager::getInstance().resetToDefault();
-                }
-
-                // --- Continuous Adjustment Handling (Check current state, not just new presses) ---
-                // Check adjustment keys only if they exist in the map (non-zero mask)
-                if (keyInfo.offsetXIncMask && (currentKeyState & keyInfo.offsetXIncMask))
-                    CameraProfileManager::getInstance().adjustOffset(adjustmentStep, 0.0f, 0.0f);
-                if (keyInfo.offsetXDecMask && (currentKeyState & keyInfo.offsetXDecMask))
-                    CameraProfileManager::getInstance().adjustOffset(-adjustmentStep, 0.0f, 0.0f);
-                if (keyInfo.offsetYIncMask && (currentKeyState & keyInfo.offsetYIncMask))
-                    CameraProfileManager::getInstance().adjustOffset(0.0f, adjustmentStep, 0.0f);
-                if (keyInfo.offsetYDecMask && (currentKeyState & keyInfo.offsetYDecMask))
-                    CameraProfileManager::getInstance().adjustOffset(0.0f, -adjustmentStep, 0.0f);
-                if (keyInfo.offsetZIncMask && (currentKeyState & keyInfo.offsetZIncMask))
-                    CameraProfileManager::getInstance().adjustOffset(0.0f, 0.0f, adjustmentStep);
-                if (keyInfo.offsetZDecMask && (currentKeyState & keyInfo.offsetZDecMask))
-                    CameraProfileManager::getInstance().adjustOffset(0.0f, 0.0f, -adjustmentStep);
-
-            } // end if(adjustment mode active)
+    const Vector3 direction(heldAxis(held, ActionOffsetXInc, ActionOffsetXDec),
+                            heldAxis(held, ActionOffsetYInc, ActionOffsetYDec),
+                            heldAxis(held, ActionOffsetZInc, ActionOffsetZDec));
+    const Vector3 delta = g_heldAdjustment.step(direction, (held & PRECISION_HELD_BIT) != 0, deltaTime);
+    if (delta.x != 0.0f || delta.y != 0.0f || delta.z != 0.0f)
+    {
+        CameraProfileManager::getInstance().adjustOffset(delta.x, delta.y, delta.z);
+        g_heldAdjustmentTotal += delta;
+    }
+}
 
-            // Remember current key state for the next loop iteration
-            previousKeyState = currentKeyState;
-        }
-        catch (const std::exception &e)
-        {
-            logger.log(LOG_ERROR, "CameraProfileThread: Exception caught: " + std::string(e.what()));
-            Sleep(1000); // Prevent spamming errors
-        }
-        catch (...)
-        {
-            logger.log(LOG_ERROR, "CameraProfileThread: Caught unknown exception!");
-            Sleep(1000);
-        }
-    } // end while (main loop)
+void updateProfileZones()
+{
+    if (!g_zonesActive.load(std::memory_order_relaxed) || !g_thePlayerEntity)
+        return;
 
-    logger.log(LOG_INFO, "CameraProfileThread: Exiting");
-    return 0;
+    Vector3 playerPosition;
+    Quaternion playerOrientation;
+    if (GetPlayerWorldTransform(playerPosition, playerOrientation) &&
+        ProfileZoneManager::getInstance().locate(playerPosition))
+    {
+        // Switching takes the profile lock and may start a transition; keep it off the render thread
+        InputService::getInstance().post([]
+                                         { ProfileZoneManager::getInstance().applyZoneChange(); });
+    }
 }
@@ -1,16 +1,25 @@
 #ifndef CAMERA_PROFILE_THREAD_H
 #define CAMERA_PROFILE_THREAD_H
 
-#include <windows.h>
+/**
+ * @brief Binds the camera profile, offset and path keys on the InputService.
+ * @details Keys and adjustment speeds are read from g_config. Call before InputService::start().
+ */
+void registerCameraProfileActions();
 
-// Thread function prototype
-DWORD WINAPI CameraProfileThread(LPVOID param);
+/**
+ * @brief Moves the live offset while offset keys are held in adjustment mode.
+ * @details Called by the TPV camera hook once per frame (render thread), so the
+ *          camera moves smoothly at the configured speed whatever the frame rate.
+ * @param deltaTime Frame time in seconds.
+ */
+void updateHeldOffsetAdjustment(float deltaTime);
 
-// Helper structure to pass data to the thread
-struct CameraProfileThreadData
-{
-    float adjustmentStep;
-    // Keys are already stored in Config and accessible via g_config
-};
+/**
+ * @brief Switches profiles when the player moves into or out of a profile zone.
+ * @details Called by the TPV camera hook once per frame (render thread). The zone
+ *          lookup is O(1); the profile switch itself is posted to the input thread.
+ */
+void updateProfileZones();
 
 #endif // CAMERA_PROFILE_THREAD_H
@@ -85,20 +85,21 @@ static std::string getIniFilePath(const std::string &ini_filename)
 }
 
 /**
- * @brief Parses a comma-separated string of hexadecimal VK codes from INI value.
- * @details Handles optional "0x" prefixes, trims whitespace, validates hex
- *          format for each token, and converts valid tokens to integer VK codes.
- *          Logs warnings for invalid tokens or codes outside typical range.
+ * @brief Parses a comma-separated list of hotkey expressions from an INI value.
+ * @details Each token is one alternative: a hex VK code with optional "0x"
+ *          prefix, or a chord/sequence such as "Ctrl+0x61" or "0x47>0x47:tap"
+ *          (syntax in hotkey.h). Trims whitespace and logs warnings for
+ *          invalid tokens, which are skipped.
  * @param value_str The raw string value read from the INI file.
  * @param logger Reference to the logger for reporting parsing details/errors.
  * @param key_name The name of the INI key being parsed (e.g., "ToggleKey") for logs.
- * @return std::vector<int> A vector containing the valid integer VK codes found.
- *         Returns an empty vector if the input string is empty or contains no valid codes.
+ * @return HotkeyList The valid hotkeys found.
+ *         Returns an empty list if the input string is empty or contains no valid hotkeys.
  */
-static std::vector<int> parseKeyList(const std::string &value_str, Logger &logger,
-                                     const std::string &key_name)
+static HotkeyList parseKeyList(const std::string &value_str, Logger &logger,
+                               const std::string &key_name)
 {
-    std::vector<int> keys;
+    HotkeyList keys;
 
     // First, remove any inline comment (everything after semicolon)
     std::string str_no_comment = value_str;
@@ -112,7 +113,7 @@ static std::vector<int> parseKeyList(const std::string &value_str, Logger &logge
 
     if (trimmed_val.empty())
     {
-        return keys; // Return empty vector, not an error.
+        return keys; // Return empty list, not an error.
     }
 
     std::istringstream iss(trimmed_val);
@@ -123,60 +124,28 @@ static std::vector<int> parseKeyList(const std::string &value_str, Logger &logge
     while (std::getline(iss, token, ','))
     {
         token_idx++;
-        // Strip any inline comments from individual tokens too
-        size_t token_comment_pos = token.find(';');
-        if (token_comment_pos != std::string::npos)
-        {
-            token = token.substr(0, token_comment_pos);
-        }
-
         std::string trimmed_token = trim(token);
         if (trimmed_token.empty())
         {
             continue; // Ignore empty tokens
         }
 
-        // Check for and remove optional "0x" or "0X" prefix.
-        std::string hex_part = trimmed_token;
-        if (hex_part.size() >= 2 && hex_part[0] == '0' && (hex_part[1] == 'x' || hex_part[1] == 'X'))
-        {
-            hex_part = hex_part.substr(2);
-            if (hex_part.empty())
-            {
-                logger.log(LOG_WARNING, "Config: Invalid key token '" + token + "' (just prefix) in '" + key_name + "' at token " + std::to_string(token_idx));
-                continue;
-            }
-        }
-
-        // Validate hexadecimal format
-        if (hex_part.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+        Hotkey hotkey;
+        std::string error;
+        if (!Hotkey::parse(trimmed_token, hotkey, error))
         {
-            logger.log(LOG_WARNING, "Config: Invalid non-hex character in key token '" + token + "' for '" + key_name + "' at token " + std::to_string(token_idx));
+            logger.log(LOG_WARNING, "Config: Invalid hotkey '" + trimmed_token + "' for '" + key_name + "' at token " +
+                                        std::to_string(token_idx) + ": " + error);
             continue;
         }
 
-        // Convert to integer VK code
-        try
-        {
-            unsigned long code_ul = std::stoul(hex_part, nullptr, 16);
-            if (code_ul == 0 || code_ul > 0xFF)
-            {
-                logger.log(LOG_WARNING, "Config: Key code " + format_hex(static_cast<int>(code_ul)) +
-                                            " ('" + token + "') for '" + key_name + "' is outside typical VK range (0x01-0xFF)");
-            }
-            int key_code = static_cast<int>(code_ul);
-            keys.push_back(key_code);
-            logger.log(LOG_DEBUG, "Config: Added key for '" + key_name + "': " + format_vkcode(key_code));
-        }
-        catch (const std::exception &e)
-        {
-            logger.log(LOG_WARNING, "Config: Error converting hex token '" + token + "' for '" + key_name + "': " + e.what());
-        }
+        logger.log(LOG_DEBUG, "Config: Added hotkey for '" + key_name + "': " + hotkey.toString());
+        keys.push_back(std::move(hotkey));
     }
 
-    if (keys.empty() && !trimmed_val.empty())
+    if (keys.empty())
     {
-        logger.log(LOG_WARNING, "Config: Processed value for '" + key_name + "' (\"" + trimmed_val + "\") but found no valid key codes.");
+        logger.log(LOG_WARNING, "Config: Processed value for '" + key_name + "' (\"" + trimmed_val + "\") but found no valid hotkeys.");
     }
 
     return keys;
@@ -215,7 +184,7 @@ Config loadConfig(const std::string &ini_filename)
         logger.log(LOG_INFO, "Config: Successfully opened INI file.");
 
         // Helper lambda to read key lists with defaults
-        auto load_key_list = [&](const char *key, std::vector<int> &target_vector, const char *default_value)
+        auto load_key_list = [&](const char *key, HotkeyList &target_vector, const char *default_value)
         {
             const char *value = ini.GetValue("CameraProfiles", key, default_value);
             if (value)
@@ -236,6 +205,9 @@ Config loadConfig(const std::string &ini_filename)
 
         // Log Level
         config.log_level = ini.GetValue("Settings", "LogLevel", Constants::DEFAULT_LOG_LEVEL);
+        config.log_max_file_size_mb = (int)ini.GetLongValue("Settings", "LogMaxFileSizeMB", config.log_max_file_size_mb);
+        config.log_max_files = (int)ini.GetLongValue("Settings", "LogMaxFiles", config.log_max_files);
+        config.record_input = ini.GetBoolValue("Settings", "RecordInput", config.record_input);
 
         // Features
         config.enable_overlay_feature = ini.GetBoolValue("Settings", "EnableOverlayFeature", true);
@@ -267,6 +239,15 @@ Config loadConfig(const std::string &ini_filename)
             load_key_list("ProfileResetKey", config.profile_reset_keys, "0x65");   // Numpad 5
             load_key_list("ProfileUpdateKey", config.profile_update_keys, "0x67"); // Numpad 7 (UPDATE)
             load_key_list("ProfileDeleteKey", config.profile_delete_keys, "0x69"); // Numpad 9 (DELETE)
+            load_key_list("UndoKey", config.profile_undo_keys, "0x6F");            // Numpad /
+            load_key_list("RedoKey", config.profile_redo_keys, "0x6A");            // Numpad *
+
+            // Camera paths
+            load_key_list("PathKeyframeKey", config.path_keyframe_keys, "0x60"); // Numpad 0
+            load_key_list("PathPlayKey", config.path_play_keys, "0x6E");         // Numpad .
+            load_key_list("PathNewKey", config.path_new_keys, "");
+            load_key_list("PathCycleKey", config.path_cycle_keys, "");
+            config.path_keyframe_spacing = (float)ini.GetDoubleValue("CameraProfiles", "PathKeyframeSpacing", 2.0);
 
             // Offset adjustments
             load_key_list("OffsetXIncKey", config.offset_x_inc_keys, "0x66"); // Numpad 6
@@ -275,13 +256,25 @@ Config loadConfig(const std::string &ini_filename)
             load_key_list("OffsetYDecKey", config.offset_y_dec_keys, "0x6D"); // Numpad -
             load_key_list("OffsetZIncKey", config.offset_z_inc_keys, "0x68"); // Numpad 8
             load_key_list("OffsetZDecKey", config.offset_z_dec_keys, "0x62"); // Numpad 2
+            load_key_list("PrecisionKey", config.precision_keys, "0x11");     // Ctrl
 
             // Adjustment & Transition Settings
-            config.offset_adjustment_step = (float)ini.GetDoubleValue("CameraProfiles", "AdjustmentStep", 0.05);
+            // AdjustmentStep (older INIs) was added every 16 ms while a key was held; it still sets the speed
+            const double legacy_step = ini.GetDoubleValue("CameraProfiles", "AdjustmentStep", 0.0);
+            const double default_speed = legacy_step > 0.0 ? legacy_step * 1000.0 / Constants::OFFSET_ADJUST_TICK_MS
+                                                           : config.offset_adjustment_speed;
+            config.offset_adjustment_speed = (float)ini.GetDoubleValue("CameraProfiles", "AdjustmentSpeed", default_speed);
+            config.adjustment_max_multiplier = (float)ini.GetDoubleValue("CameraProfiles", "AdjustmentMaxMultiplier", config.adjustment_max_multiplier);
+            config.adjustment_ramp_time = (float)ini.GetDoubleValue("CameraProfiles", "AdjustmentRampTime", config.adjustment_ramp_time);
+            config.adjustment_curve = ini.GetValue("CameraProfiles", "AdjustmentCurve", config.adjustment_curve.c_str());
+            config.precision_scale = (float)ini.GetDoubleValue("CameraProfiles", "PrecisionScale", config.precision_scale);
+            config.profile_hot_reload = ini.GetBoolValue("CameraProfiles", "HotReload", true);
+            config.enable_profile_zones = ini.GetBoolValue("CameraProfiles", "EnableZones", false);
             config.transition_duration = (float)ini.GetDoubleValue("CameraProfiles", "TransitionDuration", 0.5);
+            config.transition_curve = ini.GetValue("CameraProfiles", "TransitionCurve", "smoothstep");
             config.use_spring_physics = ini.GetBoolValue("CameraProfiles", "UseSpringPhysics", false);
             config.spring_strength = (float)ini.GetDoubleValue("CameraProfiles", "SpringStrength", 8.0);
-            config.spring_damping = (float)ini.GetDoubleValue("CameraProfiles", "SpringDamping", 0.7);
+            config.spring_damping = (float)ini.GetDoubleValue("CameraProfiles", "SpringDamping", 1.0);
 
             // Profile directory
             config.profile_directory = ini.GetValue("CameraProfiles", "ProfileDirectory", "");
@@ -324,6 +317,40 @@ Config loadConfig(const std::string &ini_filename)
         config.log_level = Constants::DEFAULT_LOG_LEVEL;
     }
 
+    // Validate log rotation settings
+    if (config.log_max_file_size_mb < 1)
+    {
+        logger.log(LOG_WARNING, "Config: LogMaxFileSizeMB must be at least 1. Using 1.");
+        config.log_max_file_size_mb = 1;
+    }
+    if (config.log_max_files < 0)
+    {
+        logger.log(LOG_WARNING, "Config: LogMaxFiles cannot be negative. Using 0.");
+        config.log_max_files = 0;
+    }
+
+    // Validate held adjustment settings
+    if (config.offset_adjustment_speed < 0.0f)
+    {
+        logger.log(LOG_WARNING, "Config: AdjustmentSpeed cannot be negative. Using 0.5.");
+        config.offset_adjustment_speed = 0.5f;
+    }
+    if (config.adjustment_max_multiplier < 1.0f)
+    {
+        logger.log(LOG_WARNING, "Config: AdjustmentMaxMultiplier must be at least 1. Using 1.");
+        config.adjustment_max_multiplier = 1.0f;
+    }
+    if (config.adjustment_ramp_time < 0.0f)
+    {
+        logger.log(LOG_WARNING, "Config: AdjustmentRampTime cannot be negative. Using 0.");
+        config.adjustment_ramp_time = 0.0f;
+    }
+    if (config.precision_scale <= 0.0f)
+    {
+        logger.log(LOG_WARNING, "Config: PrecisionScale must be positive. Using 0.2.");
+        config.precision_scale = 0.2f;
+    }
+
     // --- Log Summary ---
     logger.log(LOG_INFO, "Config: Log level set to: " + config.log_level);
     logger.log(LOG_INFO, "Config: Overlay feature: " + std::string(config.enable_overlay_feature ? "ENABLED" : "DISABLED"));
@@ -332,10 +359,10 @@ Config loadConfig(const std::string &ini_filename)
     else
         logger.log(LOG_INFO, "Config: TPV FOV: DISABLED");
     logger.log(LOG_INFO, "Config: Base TPV Offset (X, Y, Z): (" + std::to_string(config.tpv_offset_x) + ", " + std::to_string(config.tpv_offset_y) + ", " + std::to_string(config.tpv_offset_z) + ")");
-    logger.log(LOG_INFO, "Config: Hold-to-scroll keys: " + format_vkcode_list(config.hold_scroll_keys));
-    logger.log(LOG_INFO, "Config: TPV/FPV keys (Toggle:" + format_vkcode_list(config.toggle_keys) +
-                             "/FPV:" + format_vkcode_list(config.fpv_keys) +
-                             "/TPV:" + format_vkcode_list(config.tpv_keys) + ")");
+    logger.log(LOG_INFO, "Config: Hold-to-scroll keys: " + formatHotkeyList(config.hold_scroll_keys));
+    logger.log(LOG_INFO, "Config: TPV/FPV keys (Toggle:" + formatHotkeyList(config.toggle_keys) +
+                             "/FPV:" + formatHotkeyList(config.fpv_keys) +
+                             "/TPV:" + formatHotkeyList(config.tpv_keys) + ")");
 
     // Camera sensitivity system summary
     logger.log(LOG_INFO, "Config: Camera Sensitivity Settings:");
@@ -357,17 +384,26 @@ Config loadConfig(const std::string &ini_filename)
     if (config.enable_camera_profiles)
     {
         logger.log(LOG_INFO, "  Profile Dir: " + config.profile_directory);
-        logger.log(LOG_INFO, "  Adjustment Step: " + std::to_string(config.offset_adjustment_step));
-        logger.log(LOG_INFO, "  Master Toggle: " + format_vkcode_list(config.master_toggle_keys));
-        logger.log(LOG_INFO, "  Create New Profile: " + format_vkcode_list(config.profile_save_keys));
-        logger.log(LOG_INFO, "  Update Active Profile: " + format_vkcode_list(config.profile_update_keys)); // Log new key
-        logger.log(LOG_INFO, "  Delete Active Profile: " + format_vkcode_list(config.profile_delete_keys)); // Log new key
-        logger.log(LOG_INFO, "  Cycle Profiles: " + format_vkcode_list(config.profile_cycle_keys));
-        logger.log(LOG_INFO, "  Reset to Default: " + format_vkcode_list(config.profile_reset_keys));
-        logger.log(LOG_INFO, "  Adjust X +/-: " + format_vkcode_list(config.offset_x_inc_keys) + "/" + format_vkcode_list(config.offset_x_dec_keys));
-        logger.log(LOG_INFO, "  Adjust Y +/-: " + format_vkcode_list(config.offset_y_inc_keys) + "/" + format_vkcode_list(config.offset_y_dec_keys));
-        logger.log(LOG_INFO, "  Adjust Z +/-: " + format_vkcode_list(config.offset_z_inc_keys) + "/" + format_vkcode_list(config.offset_z_dec_keys));
-        logger.log(LOG_INFO, "  Transition: " + std::to_string(config.transition_duration) + "s, Spring: " +
+        logger.log(LOG_INFO, "  Profile Hot Reload: " + std::string(config.profile_hot_reload ? "ON" : "OFF"));
+        logger.log(LOG_INFO, "  Profile Zones: " + std::string(config.enable_profile_zones ? "ON" : "OFF"));
+        logger.log(LOG_INFO, "  Adjustment Speed: " + std::to_string(config.offset_adjustment_speed) + "/s, up to x" +
+                                 std::to_string(config.adjustment_max_multiplier) + " over " + std::to_string(config.adjustment_ramp_time) +
+                                 "s (" + config.adjustment_curve + "), Precision: " + formatHotkeyList(config.precision_keys) +
+                                 " x" + std::to_string(config.precision_scale));
+        logger.log(LOG_INFO, "  Master Toggle: " + formatHotkeyList(config.master_toggle_keys));
+        logger.log(LOG_INFO, "  Create New Profile: " + formatHotkeyList(config.profile_save_keys));
+        logger.log(LOG_INFO, "  Update Active Profile: " + formatHotkeyList(config.profile_update_keys)); // Log new key
+        logger.log(LOG_INFO, "  Delete Active Profile: " + formatHotkeyList(config.profile_delete_keys)); // Log new key
+        logger.log(LOG_INFO, "  Cycle Profiles: " + formatHotkeyList(config.profile_cycle_keys));
+        logger.log(LOG_INFO, "  Reset to Default: " + formatHotkeyList(config.profile_reset_keys));
+        logger.log(LOG_INFO, "  Undo/Redo Offset Edit: " + formatHotkeyList(config.profile_undo_keys) + "/" + formatHotkeyList(config.profile_redo_keys));
+        logger.log(LOG_INFO, "  Path Keyframe/Play: " + formatHotkeyList(config.path_keyframe_keys) + "/" + formatHotkeyList(config.path_play_keys) +
+                                 ", New/Cycle: " + formatHotkeyList(config.path_new_keys) + "/" + formatHotkeyList(config.path_cycle_keys) +
+                                 ", Spacing: " + std::to_string(config.path_keyframe_spacing) + "s");
+        logger.log(LOG_INFO, "  Adjust X +/-: " + formatHotkeyList(config.offset_x_inc_keys) + "/" + formatHotkeyList(config.offset_x_dec_keys));
+        logger.log(LOG_INFO, "  Adjust Y +/-: " + formatHotkeyList(config.offset_y_inc_keys) + "/" + formatHotkeyList(config.offset_y_dec_keys));
+        logger.log(LOG_INFO, "  Adjust Z +/-: " + formatHotkeyList(config.offset_z_inc_keys) + "/" + formatHotkeyList(config.offset_z_dec_keys));
+        logger.log(LOG_INFO, "  Transition: " + std::to_string(config.transition_duration) + "s, Curve: " + config.transition_curve + ", Spring: " +
                                  (config.use_spring_physics ? "ON (Str:" + std::to_string(config.spring_strength) + ", Damp:" + std::to_string(config.spring_damping) + ")" : "OFF"));
     }
 
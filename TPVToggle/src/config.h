@@ -8,6 +8,9 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include "hotkey.h"
+#include "constants.h"
+
 #include <vector>
 #include <string>
 
@@ -21,20 +24,23 @@
 struct Config
 {
     // Key binding lists (populated from INI's [Settings] section).
-    // Store VK codes as integers.
-    std::vector<int> toggle_keys; /**< VK codes that toggle between FPV/TPV. */
-    std::vector<int> fpv_keys;    /**< VK codes that force First Person View. */
-    std::vector<int> tpv_keys;    /**< VK codes that force Third Person View. */
+    // Each entry is one hotkey expression (see hotkey.h).
+    HotkeyList toggle_keys; /**< Hotkeys that toggle between FPV/TPV. */
+    HotkeyList fpv_keys;    /**< Hotkeys that force First Person View. */
+    HotkeyList tpv_keys;    /**< Hotkeys that force Third Person View. */
 
     // Other configurable settings from INI.
     std::string log_level; /**< Logging level as string (e.g., "INFO", "DEBUG"). */
+    int log_max_file_size_mb; /**< Size cap of one log file in MB before rotation. */
+    int log_max_files;        /**< Number of rotated log files kept (0 = none). */
+    bool record_input;        /**< Record key and overlay events for replay (debugging). */
 
     // Optional features
     bool enable_overlay_feature; /**< Enable overlay detection and handling. */
     float tpv_fov_degrees;       /**< Custom TPV FOV in degrees; -1.0f if disabled. */
 
     // Hold-key-to-scroll feature
-    std::vector<int> hold_scroll_keys; /**< Keys that, when held, enable mouse wheel scrolling. */
+    HotkeyList hold_scroll_keys; /**< Keys that, when held, enable mouse wheel scrolling. */
 
     // TPV Camera Offset Settings
     float tpv_offset_x;
@@ -42,31 +48,48 @@ struct Config
     float tpv_offset_z;
 
     // Camera profile system
-    bool enable_camera_profiles;          // Master toggle for camera profile system
-    std::vector<int> master_toggle_keys;  // Keys to enable/disable adjustment mode
-    std::vector<int> profile_save_keys;   // Keys to save current profile
-    std::vector<int> profile_cycle_keys;  // Keys to cycle through profiles
-    std::vector<int> profile_reset_keys;  // Keys to reset offsets to 0
-    std::vector<int> profile_update_keys; // Keys to cycle through profiles UPDATE the currently active non-Default profile with live offset.
-    std::vector<int> profile_delete_keys; // Keys to DELETE the currently active non-Default profile.
+    bool enable_camera_profiles;    // Master toggle for camera profile system
+    HotkeyList master_toggle_keys;  // Keys to enable/disable adjustment mode
+    HotkeyList profile_save_keys;   // Keys to save current profile
+    HotkeyList profile_cycle_keys;  // Keys to cycle through profiles
+    HotkeyList profile_reset_keys;  // Keys to reset offsets to 0
+    HotkeyList profile_update_keys; // Keys to cycle through profiles UPDATE the currently active non-Default profile with live offset.
+    HotkeyList profile_delete_keys; // Keys to DELETE the currently active non-Default profile.
+    HotkeyList profile_undo_keys;   // Keys to undo the last offset edit
+    HotkeyList profile_redo_keys;   // Keys to redo the last undone offset edit
+
+    // Camera path keys
+    HotkeyList path_keyframe_keys; // Keys to capture a keyframe into the current path
+    HotkeyList path_play_keys;     // Keys to play/stop the current path
+    HotkeyList path_new_keys;      // Keys to start a new path
+    HotkeyList path_cycle_keys;    // Keys to select the next path
+    float path_keyframe_spacing;   // Seconds between captured keyframes
 
     // Offset adjustment keys
-    std::vector<int> offset_x_inc_keys; // Keys to increase X offset
-    std::vector<int> offset_x_dec_keys; // Keys to decrease X offset
-    std::vector<int> offset_y_inc_keys; // Keys to increase Y offset
-    std::vector<int> offset_y_dec_keys; // Keys to decrease Y offset
-    std::vector<int> offset_z_inc_keys; // Keys to increase Z offset
-    std::vector<int> offset_z_dec_keys; // Keys to decrease Z offset
+    HotkeyList offset_x_inc_keys; // Keys to increase X offset
+    HotkeyList offset_x_dec_keys; // Keys to decrease X offset
+    HotkeyList offset_y_inc_keys; // Keys to increase Y offset
+    HotkeyList offset_y_dec_keys; // Keys to decrease Y offset
+    HotkeyList offset_z_inc_keys; // Keys to increase Z offset
+    HotkeyList offset_z_dec_keys; // Keys to decrease Z offset
+    HotkeyList precision_keys;    // Keys that slow offset adjustment down while held
 
     // Adjustment settings
-    float offset_adjustment_step;  // How much to adjust per keypress
-    std::string profile_directory; // Directory to store camera profiles
+    float offset_adjustment_speed;   // Offset units per second while an offset key is held
+    float adjustment_max_multiplier; // Speed multiplier reached after adjustment_ramp_time
+    float adjustment_ramp_time;      // Seconds of holding until full adjustment speed
+    std::string adjustment_curve;    // Easing curve of the speed ramp (see EasingCurve)
+    float precision_scale;           // Speed multiplier while a precision key is held
+    std::string profile_directory;   // Directory to store camera profiles
+    bool profile_hot_reload;       // Apply outside edits of the profiles file while running
+    bool enable_profile_zones;     // Switch profiles by player location
 
     // Transition settings
     float transition_duration;
+    std::string transition_curve; // Easing curve spec (see EasingCurve)
     bool use_spring_physics;
-    float spring_strength;
-    float spring_damping;
+    float spring_strength; // Spring angular frequency (rad/s)
+    float spring_damping;  // Spring damping ratio (1 = critically damped)
 
     // TPV Camera sensitivity settings
     float tpv_pitch_sensitivity;   // Vertical mouse sensitivity multiplier (0.0-2.0)
@@ -81,17 +104,28 @@ struct Config
      *        responsible for populating with defaults or INI values.
      */
     Config() : log_level("INFO"),
+               log_max_file_size_mb(static_cast<int>(Constants::LOG_DEFAULT_MAX_FILE_BYTES / (1024 * 1024))),
+               log_max_files(static_cast<int>(Constants::LOG_DEFAULT_MAX_FILES)),
+               record_input(false),
                enable_overlay_feature(true),
                tpv_fov_degrees(-1.0f),
                tpv_offset_x(0.0f),
                tpv_offset_y(0.0f),
                tpv_offset_z(0.0f),
                enable_camera_profiles(false),
-               offset_adjustment_step(0.01f),
+               path_keyframe_spacing(2.0f),
+               offset_adjustment_speed(0.5f),
+               adjustment_max_multiplier(4.0f),
+               adjustment_ramp_time(1.5f),
+               adjustment_curve("ease-in"),
+               precision_scale(0.2f),
+               profile_hot_reload(true),
+               enable_profile_zones(false),
                transition_duration(0.3f),
+               transition_curve("smoothstep"),
                use_spring_physics(false),
                spring_strength(10.0f),
-               spring_damping(0.8f),
+               spring_damping(1.0f),
                tpv_pitch_sensitivity(1.0f),
                tpv_yaw_sensitivity(1.0f),
                tpv_pitch_limits_enabled(false),
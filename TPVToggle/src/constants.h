@@ -8,6 +8,8 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <math.h>
 
@@ -42,6 +44,58 @@ namespace Constants
     // --- Default Configuration Values ---
     /** @brief Default logging level ("INFO"). */
     constexpr const char *DEFAULT_LOG_LEVEL = "INFO";
+    /** @brief Default size cap of a single log file before it is rotated (10 MB). */
+    constexpr size_t LOG_DEFAULT_MAX_FILE_BYTES = 10 * 1024 * 1024;
+    /** @brief Smallest accepted log file cap, keeps a single record from forcing constant rotation. */
+    constexpr size_t LOG_MIN_FILE_BYTES = 64 * 1024;
+    /** @brief Default number of rotated log files (previous sessions / overflow) to keep. */
+    constexpr size_t LOG_DEFAULT_MAX_FILES = 5;
+    /** @brief Size at which the profile journal is folded back into the profiles JSON file (256 KB). */
+    constexpr size_t PROFILE_JOURNAL_COMPACT_BYTES = 256 * 1024;
+    /** @brief Quiet time after the last change notification before an edited profiles file is reloaded (ms). */
+    constexpr unsigned long PROFILE_RELOAD_SETTLE_MS = 500;
+    /** @brief Edge length of a profile zone grid cell (world units). */
+    constexpr float PROFILE_ZONE_CELL_SIZE = 32.0f;
+    /** @brief Zones touching more grid cells than this are tested on every query instead of being gridded. */
+    constexpr uint64_t PROFILE_ZONE_MAX_CELLS = 4096;
+    /** @brief Distance the player must move outside a zone before it counts as left (world units). */
+    constexpr float PROFILE_ZONE_EXIT_MARGIN = 1.0f;
+    /** @brief Number of offset edits kept for undo/redo. */
+    constexpr size_t OFFSET_HISTORY_CAPACITY = 64;
+
+    // --- Frame Clock ---
+    /** @brief Delta reported before the first frame has been measured (seconds, 60 FPS). */
+    constexpr float FRAME_CLOCK_NOMINAL_DELTA = 1.0f / 60.0f;
+    /** @brief Ticks closer together than this count as the same frame (seconds). */
+    constexpr double FRAME_CLOCK_MIN_DELTA = 0.0001;
+    /** @brief Longest frame accepted; longer hitches are clamped to it (seconds). */
+    constexpr float FRAME_CLOCK_MAX_DELTA = 0.1f;
+    /** @brief Gaps longer than this are pauses or loading screens and are skipped (seconds). */
+    constexpr double FRAME_CLOCK_RESUME_THRESHOLD = 0.5;
+    /** @brief Weight of the newest frame in the smoothed delta (0-1). */
+    constexpr float FRAME_CLOCK_SMOOTHING = 0.2f;
+
+    // --- Spring Transitions ---
+    /** @brief A spring transition ends once it is this close to the target (world units). */
+    constexpr float SPRING_SETTLE_DISTANCE = 0.0005f;
+    /** @brief A spring transition ends only once it is also slower than this (world units per second). */
+    constexpr float SPRING_SETTLE_SPEED = 0.005f;
+    /** @brief Linear segments in a baked easing curve table. */
+    constexpr size_t EASING_TABLE_SEGMENTS = 128;
+    /** @brief Transition commands that can wait for the render thread (power of two). */
+    constexpr size_t TRANSITION_COMMAND_QUEUE_SIZE = 64;
+
+    // --- Camera Paths ---
+    /** @brief Default seconds between captured path keyframes. */
+    constexpr float CAMERA_PATH_DEFAULT_SPACING = 2.0f;
+    /** @brief Playback commands that can wait for the render thread (power of two). */
+    constexpr size_t CAMERA_PATH_COMMAND_QUEUE_SIZE = 16;
+
+    // --- Game Commands ---
+    /** @brief Commands (view switches, offset nudges) that can wait for the game thread (power of two). */
+    constexpr size_t GAME_COMMAND_QUEUE_SIZE = 256;
+    /** @brief Without a camera update for this long (ms), the input thread applies queued commands itself. */
+    constexpr unsigned long GAME_COMMAND_STALL_MS = 50;
 
     // --- AOB (Array-of-Bytes) Patterns ---
 
@@ -253,8 +307,39 @@ namespace Constants
     constexpr int MOUSE_INPUT_TYPE_ID = 8;
     constexpr int MOUSE_WHEEL_EVENT_ID = 0x10C;
 
-    // --- Timing ---
-    constexpr unsigned long MAIN_MONITOR_SLEEP_MS = 33;
+    // --- Input ---
+    /** @brief Key polling interval used only when the low-level keyboard hook cannot be installed. */
+    constexpr unsigned long INPUT_FALLBACK_POLL_MS = 16;
+    /** @brief Key polling interval once no polled key has changed for INPUT_IDLE_AFTER_MS. */
+    constexpr unsigned long INPUT_IDLE_POLL_MS = 100;
+    /** @brief Time without key changes (and outside adjustment mode) before polling slows down. */
+    constexpr unsigned long INPUT_IDLE_AFTER_MS = 5000;
+    /** @brief Interval at which the keyboard hook's key state is checked against GetAsyncKeyState. */
+    constexpr unsigned long INPUT_HOOK_CHECK_MS = 1000;
+    /** @brief Consecutive checks a key must be down without the hook seeing it before falling back to polling. */
+    constexpr int INPUT_HOOK_LOST_CHECKS = 3;
+    /** @brief Resolution of the input thread's timer wheel for delayed tasks. */
+    constexpr unsigned long INPUT_TIMER_TICK_MS = 1;
+    /** @brief Buckets in the input thread's timer wheel (one turn = this many ticks). */
+    constexpr size_t INPUT_TIMER_WHEEL_SLOTS = 256;
+    /** @brief File name suffix of the input recording (RecordInput), next to the log. */
+    constexpr const char *INPUT_RECORDING_SUFFIX = "_Input.rec";
+    /** @brief Virtual time a replay keeps running after the last record, so pending delays fire. */
+    constexpr unsigned long INPUT_REPLAY_SETTLE_MS = 2000;
+    /** @brief Window over which the input thread's wakeups per minute are logged. */
+    constexpr unsigned long INPUT_WAKEUP_METRIC_WINDOW_MS = 60000;
+    /** @brief Former repeat interval of held offset keys; converts an old AdjustmentStep into a speed. */
+    constexpr unsigned long OFFSET_ADJUST_TICK_MS = 16;
+    /** @brief Longest substep (s) when integrating the held adjustment speed ramp over one frame. */
+    constexpr float OFFSET_ADJUST_MAX_SUBSTEP = 1.0f / 120.0f;
+    /** @brief Delay before restoring TPV after an overlay closes, letting the UI settle. */
+    constexpr unsigned long OVERLAY_TPV_RESTORE_DELAY_MS = 200;
+    /** @brief Longest press (ms) that still counts for a ":tap" hotkey. */
+    constexpr unsigned long HOTKEY_TAP_MAX_MS = 250;
+    /** @brief How long (ms) a ":hold" hotkey must be held before it fires. */
+    constexpr unsigned long HOTKEY_HOLD_MS = 500;
+    /** @brief Maximum gap (ms) between the steps of a hotkey sequence such as "0x47>0x47". */
+    constexpr unsigned long HOTKEY_SEQUENCE_TIMEOUT_MS = 1000;
 
     /** @brief Name of the target game module. */
     constexpr const char *MODULE_NAME = "WHGame.dll";
@@ -0,0 +1,84 @@
+/**
+ * @file damped_spring.cpp
+ * @brief Implementation of the closed-form damped spring.
+ */
+
+#include "damped_spring.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Damping ratios this close to 1 use the critical solution; the other two lose precision there
+    constexpr float CRITICAL_BAND = 1e-3f;
+
+    // omega * t at which (1 + omega*t) * exp(-omega*t) = 0.5
+    constexpr float CRITICAL_HALF_LIFE_PRODUCT = 1.6783470f;
+}
+
+DampedSpring::DampedSpring(float angularFrequency, float dampingRatio)
+    : m_omega(std::max(0.0f, angularFrequency)),
+      m_zeta(std::max(0.0f, dampingRatio))
+{
+}
+
+float DampedSpring::frequencyForHalfLife(float halfLife)
+{
+    return halfLife > 0.0f ? CRITICAL_HALF_LIFE_PRODUCT / halfLife : 0.0f;
+}
+
+DampedSpring::Transition DampedSpring::transition(float dt) const
+{
+    const float w = m_omega;
+    if (dt <= 0.0f || w <= 0.0f)
+        return {1.0f, std::max(0.0f, dt), 0.0f, 1.0f}; // No spring: keep drifting at the current velocity
+
+    if (std::fabs(m_zeta - 1.0f) < CRITICAL_BAND)
+    {
+        // x(t) = (c1 + c2 t) e^(-w t)
+        const float e = std::exp(-w * dt);
+        return {e * (1.0f + w * dt), e * dt,
+                -e * w * w * dt, e * (1.0f - w * dt)};
+    }
+
+    if (m_zeta < 1.0f)
+    {
+        // x(t) = e^(-zeta w t) (c1 cos(wd t) + c2 sin(wd t))
+        const float wd = w * std::sqrt(1.0f - m_zeta * m_zeta);
+        const float e = std::exp(-m_zeta * w * dt);
+        const float c = std::cos(wd * dt);
+        const float s = std::sin(wd * dt);
+        const float k = m_zeta * w / wd;
+        return {e * (c + k * s), e * s / wd,
+                -e * w * w / wd * s, e * (c - k * s)};
+    }
+
+    // x(t) = c1 e^(r1 t) + c2 e^(r2 t)
+    const float root = w * std::sqrt(m_zeta * m_zeta - 1.0f);
+    const float r1 = -m_zeta * w + root;
+    const float r2 = -m_zeta * w - root;
+    const float e1 = std::exp(r1 * dt);
+    const float e2 = std::exp(r2 * dt);
+    const float inv = 1.0f / (r1 - r2);
+    return {(r1 * e2 - r2 * e1) * inv, (e1 - e2) * inv,
+            r1 * r2 * (e2 - e1) * inv, (r1 * e1 - r2 * e2) * inv};
+}
+
+void DampedSpring::step(Vector3 &position, Vector3 &velocity, const Vector3 &target, float dt) const
+{
+    const Transition m = transition(dt);
+    const Vector3 x = position - target;
+    const Vector3 v = velocity;
+    position = target + x * m.xx + v * m.xv;
+    velocity = x * m.vx + v * m.vv;
+}
+
+void DampedSpring::step(float &position, float &velocity, float target, float dt) const
+{
+    const Transition m = transition(dt);
+    const float x = position - target;
+    const float v = velocity;
+    position = target + x * m.xx + v * m.xv;
+    velocity = x * m.vx + v * m.vv;
+}
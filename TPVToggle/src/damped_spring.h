@@ -0,0 +1,56 @@
+/**
+ * @file damped_spring.h
+ * @brief Closed-form damped harmonic oscillator ("smooth damp") for camera motion.
+ *
+ * The spring is integrated analytically, so a step of dt lands exactly where
+ * any number of smaller steps adding up to dt would: the motion is stable for
+ * any frame time and identical at 30, 60 or 240 FPS.
+ */
+#ifndef DAMPED_SPRING_H
+#define DAMPED_SPRING_H
+
+#include "math_utils.h"
+
+/**
+ * @class DampedSpring
+ * @brief Advances position/velocity pairs toward a target along the exact spring trajectory.
+ *
+ * Parameterized by the undamped angular frequency (rad/s) and the damping
+ * ratio (1 = critically damped, < 1 overshoots, > 1 approaches more slowly).
+ */
+class DampedSpring
+{
+public:
+    DampedSpring(float angularFrequency, float dampingRatio);
+
+    /**
+     * @brief Angular frequency whose critically damped spring covers half the distance in halfLife.
+     * @param halfLife Seconds to close half the gap when starting at rest.
+     */
+    static float frequencyForHalfLife(float halfLife);
+
+    /**
+     * @brief Moves position and velocity dt seconds along the trajectory toward target.
+     */
+    void step(Vector3 &position, Vector3 &velocity, const Vector3 &target, float dt) const;
+
+    /** @brief One-dimensional form of step(). */
+    void step(float &position, float &velocity, float target, float dt) const;
+
+    float angularFrequency() const { return m_omega; }
+    float dampingRatio() const { return m_zeta; }
+
+private:
+    // State transition for one dt: [x; v] -> [xx*x + xv*v; vx*x + vv*v], x relative to target
+    struct Transition
+    {
+        float xx, xv, vx, vv;
+    };
+
+    Transition transition(float dt) const;
+
+    float m_omega;
+    float m_zeta;
+};
+
+#endif // DAMPED_SPRING_H
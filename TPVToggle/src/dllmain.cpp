@@ -15,6 +15,10 @@
 #include "global_state.h"
 #include "camera_profile.h"
 #include "camera_profile_thread.h"
+#include "profile_zones.h"
+#include "camera_path_manager.h"
+#include "input_service.h"
+#include "input_recording.h"
 #include "hooks/event_hooks.h"
 #include "hooks/fov_hook.h"
 #include "hooks/tpv_camera_hook.h"
@@ -29,6 +33,7 @@
 #include <psapi.h>
 #include <thread>
 #include <stdexcept>
+#include <filesystem>
 
 // Configuration state
 Config g_config;
@@ -51,30 +56,14 @@ void cleanupResources()
         Sleep(100); // Allow threads time to process exit signal
     }
 
-    // Wait for main monitor thread to complete (with timeout)
-    if (g_hMonitorThread)
-    {
-        DWORD wait_result = WaitForSingleObject(g_hMonitorThread, 2000); // 2 second timeout
-        if (wait_result == WAIT_TIMEOUT)
-        {
-            logger.log(LOG_WARNING, "Cleanup: Monitor thread wait timeout - thread may not have exited cleanly");
-        }
-
-        CloseHandle(g_hMonitorThread);
-        g_hMonitorThread = NULL;
-    }
+    // Stop key handling (joins the input and hook threads)
+    InputService::getInstance().stop();
+    InputRecorder::getInstance().stop();
 
-    // Clean up camera profile thread if active
-    if (g_hCameraProfileThread)
+    // Flush pending profile saves now that nothing else modifies profiles
+    if (g_config.enable_camera_profiles)
     {
-        DWORD wait_result = WaitForSingleObject(g_hCameraProfileThread, 2000);
-        if (wait_result == WAIT_TIMEOUT)
-        {
-            logger.log(LOG_WARNING, "Cleanup: Camera profile thread wait timeout");
-        }
-
-        CloseHandle(g_hCameraProfileThread);
-        g_hCameraProfileThread = NULL;
+        CameraProfileManager::getInstance().shutdownPersistence();
     }
 
     // Clean up hooks and interfaces in reverse order of initialization
@@ -230,35 +219,43 @@ bool initializeHooks()
 }
 
 /**
- * @brief Creates and starts the main monitor thread.
- * @return true if main thread started successfully, false otherwise.
+ * @brief Binds the view toggle hotkeys on the input service.
  */
-bool startMonitorThread()
+void registerViewToggleActions()
 {
-    Logger &logger = Logger::getInstance();
-
-    // Prepare toggle data for the main monitor thread
-    ToggleData *toggle_data = new (std::nothrow) ToggleData{
+    // Keys move into the toggle actions; g_config no longer needs them
+    registerToggleActions(ToggleData{
         std::move(g_config.toggle_keys),
         std::move(g_config.fpv_keys),
-        std::move(g_config.tpv_keys)};
+        std::move(g_config.tpv_keys)});
+}
 
-    if (!toggle_data)
+/**
+ * @brief Starts the input service once every action is bound.
+ * @return true if key handling is running.
+ */
+bool startInputService()
+{
+    Logger &logger = Logger::getInstance();
+
+    // Record captured keys (overlay and menu hooks record themselves) for offline replay
+    if (g_config.record_input)
     {
-        logger.log(LOG_ERROR, "Failed to allocate memory for toggle data");
-        return false;
+        const std::filesystem::path path = std::filesystem::path(getRuntimeDirectory()) /
+                                           (std::string(Constants::MOD_NAME) + Constants::INPUT_RECORDING_SUFFIX);
+        if (InputRecorder::getInstance().start(path.string()))
+        {
+            InputService::getInstance().setEventObserver([](const KeyEvent &event)
+                                                         { InputRecorder::getInstance().recordKey(event); });
+        }
     }
 
-    // Start main monitor thread
-    g_hMonitorThread = CreateThread(NULL, 0, MonitorThread, toggle_data, 0, NULL);
-    if (!g_hMonitorThread)
+    if (!InputService::getInstance().start())
     {
-        delete toggle_data;
-        logger.log(LOG_ERROR, "Failed to create monitor thread: " + std::to_string(GetLastError()));
+        logger.log(LOG_ERROR, "Failed to start input service");
         return false;
     }
-
-    logger.log(LOG_INFO, "Main monitor thread started successfully");
+    logger.log(LOG_INFO, "Input service started successfully");
     return true;
 }
 
@@ -290,6 +287,8 @@ DWORD WINAPI MainThread(LPVOID hModule_param)
         else if (g_config.log_level == "ERROR")
             log_level = LOG_ERROR;
         logger.setLogLevel(log_level);
+        logger.setRotationPolicy(static_cast<size_t>(g_config.log_max_file_size_mb) * 1024 * 1024,
+                                 static_cast<size_t>(g_config.log_max_files));
 
         // Initialize memory cache
         initMemoryCache();
@@ -314,11 +313,8 @@ DWORD WINAPI MainThread(LPVOID hModule_param)
             throw std::runtime_error("Hook initialization failed");
         }
 
-        // Start monitor thread
-        if (!startMonitorThread())
-        {
-            throw std::runtime_error("Failed to start monitor thread");
-        }
+        // Bind view toggle hotkeys (handled once the input service starts)
+        registerViewToggleActions();
 
         // Initialize and start camera profile system if enabled
         if (g_config.enable_camera_profiles)
@@ -326,39 +322,41 @@ DWORD WINAPI MainThread(LPVOID hModule_param)
             logger.log(LOG_INFO, "Initializing camera profile system...");
 
             // Set initial global camera offset from config
-            g_currentCameraOffset = Vector3(g_config.tpv_offset_x, g_config.tpv_offset_y, g_config.tpv_offset_z);
+            g_currentCameraOffset.store(Vector3(g_config.tpv_offset_x, g_config.tpv_offset_y, g_config.tpv_offset_z));
 
             // Initialize the camera profile manager with JSON-based persistence
             CameraProfileManager::getInstance().loadProfiles(g_config.profile_directory);
 
+            // Pick up hand edits of the profiles file without a restart
+            if (g_config.profile_hot_reload)
+            {
+                CameraProfileManager::getInstance().startWatchingProfilesFile();
+            }
+
+            // Location-based profile switching (looked up by the camera hook, switched on the input thread)
+            if (g_config.enable_profile_zones)
+            {
+                ProfileZoneManager::getInstance().loadZones(g_config.profile_directory);
+            }
+
+            // Cinematic camera paths (recorded and played by hotkey)
+            CameraPathManager::getInstance().loadPaths(g_config.profile_directory, g_config.path_keyframe_spacing);
+
             // Configure transition settings
             CameraProfileManager::getInstance().setTransitionSettings(
                 g_config.transition_duration,
                 g_config.use_spring_physics,
                 g_config.spring_strength,
-                g_config.spring_damping);
+                g_config.spring_damping,
+                g_config.transition_curve);
 
-            // Start camera profile thread
-            CameraProfileThreadData *profile_data = new (std::nothrow) CameraProfileThreadData{
-                g_config.offset_adjustment_step};
+            // Bind profile, offset and path keys
+            registerCameraProfileActions();
+        }
 
-            if (!profile_data)
-            {
-                logger.log(LOG_ERROR, "Failed to allocate memory for camera profile thread data");
-            }
-            else
-            {
-                g_hCameraProfileThread = CreateThread(NULL, 0, CameraProfileThread, profile_data, 0, NULL);
-                if (!g_hCameraProfileThread)
-                {
-                    delete profile_data;
-                    logger.log(LOG_ERROR, "Failed to create camera profile thread: " + std::to_string(GetLastError()));
-                }
-                else
-                {
-                    logger.log(LOG_INFO, "Camera profile thread started successfully");
-                }
-            }
+        if (!startInputService())
+        {
+            throw std::runtime_error("Failed to start input service");
         }
 
         logger.log(LOG_INFO, "Initialization completed successfully");
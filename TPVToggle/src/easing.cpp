@@ -0,0 +1,186 @@
+/**
+ * @file easing.cpp
+ * @brief Named easing functions, cubic Bezier inversion and table baking.
+ */
+
+#include "easing.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    constexpr float PI = 3.14159265358979323846f;
+
+    // Standard constants (Penner / easings.net)
+    constexpr float BACK_OVERSHOOT = 1.70158f;
+    constexpr float BACK_OVERSHOOT_IN_OUT = BACK_OVERSHOOT * 1.525f;
+    constexpr float ELASTIC_PERIOD = 2.0f * PI / 3.0f;
+
+    float easeInCubic(float t) { return t * t * t; }
+    float easeOutCubic(float t) { return 1.0f - easeInCubic(1.0f - t); }
+    float easeInOutCubic(float t) { return t < 0.5f ? 4.0f * t * t * t : 1.0f - easeInCubic(2.0f - 2.0f * t) * 0.5f; }
+
+    float easeInBack(float t) { return t * t * ((BACK_OVERSHOOT + 1.0f) * t - BACK_OVERSHOOT); }
+    float easeOutBack(float t) { return 1.0f - easeInBack(1.0f - t); }
+    float easeInOutBack(float t)
+    {
+        const float c = BACK_OVERSHOOT_IN_OUT;
+        if (t < 0.5f)
+            return (2.0f * t) * (2.0f * t) * ((c + 1.0f) * 2.0f * t - c) * 0.5f;
+        const float u = 2.0f * t - 2.0f;
+        return (u * u * ((c + 1.0f) * u + c) + 2.0f) * 0.5f;
+    }
+
+    float easeOutElastic(float t)
+    {
+        if (t <= 0.0f || t >= 1.0f)
+            return t <= 0.0f ? 0.0f : 1.0f;
+        return std::pow(2.0f, -10.0f * t) * std::sin((t * 10.0f - 0.75f) * ELASTIC_PERIOD) + 1.0f;
+    }
+    float easeInElastic(float t) { return 1.0f - easeOutElastic(1.0f - t); }
+
+    float smoothstep(float t) { return t * t * (3.0f - 2.0f * t); }
+    float smootherstep(float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+    float linear(float t) { return t; }
+
+    struct NamedCurve
+    {
+        const char *name;
+        float (*function)(float);
+    };
+
+    const NamedCurve NAMED_CURVES[] = {
+        {"linear", linear},
+        {"smoothstep", smoothstep},
+        {"smootherstep", smootherstep},
+        {"ease-in", easeInCubic},
+        {"ease-out", easeOutCubic},
+        {"ease-in-out", easeInOutCubic},
+        {"ease-in-back", easeInBack},
+        {"ease-out-back", easeOutBack},
+        {"ease-in-out-back", easeInOutBack},
+        {"ease-in-elastic", easeInElastic},
+        {"ease-out-elastic", easeOutElastic},
+    };
+
+    // Bezier coordinate for control values a (at 1/3) and b (at 2/3): 3a(1-s)^2 s + 3b(1-s) s^2 + s^3
+    float bezier(float a, float b, float s)
+    {
+        return ((1.0f - 3.0f * b + 3.0f * a) * s + (3.0f * b - 6.0f * a)) * s * s + 3.0f * a * s;
+    }
+
+    float bezierSlope(float a, float b, float s)
+    {
+        return 3.0f * (1.0f - 3.0f * b + 3.0f * a) * s * s + 2.0f * (3.0f * b - 6.0f * a) * s + 3.0f * a;
+    }
+
+    std::string normalize(const std::string &spec)
+    {
+        std::string text;
+        text.reserve(spec.size());
+        for (char c : spec)
+        {
+            if (!std::isspace(static_cast<unsigned char>(c)))
+                text += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    }
+}
+
+EasingCurve::EasingCurve()
+{
+    bake(smoothstep);
+    m_spec = "smoothstep";
+}
+
+template <typename Function>
+void EasingCurve::bake(Function &&function)
+{
+    for (size_t i = 0; i <= SEGMENTS; ++i)
+    {
+        m_table[i] = function(static_cast<float>(i) / static_cast<float>(SEGMENTS));
+    }
+    // Exact end points whatever the function's rounding
+    m_table[0] = 0.0f;
+    m_table[SEGMENTS] = 1.0f;
+}
+
+float EasingCurve::solveCubicBezier(float x1, float y1, float x2, float y2, float x)
+{
+    // Newton's method on x(s) = x, then bisection if the slope is too flat
+    float s = x;
+    for (int i = 0; i < 8; ++i)
+    {
+        const float error = bezier(x1, x2, s) - x;
+        if (std::fabs(error) < 1e-7f)
+            return bezier(y1, y2, s);
+        const float slope = bezierSlope(x1, x2, s);
+        if (std::fabs(slope) < 1e-6f)
+            break;
+        s -= error / slope;
+    }
+
+    float low = 0.0f, high = 1.0f;
+    s = x;
+    for (int i = 0; i < 32; ++i)
+    {
+        const float value = bezier(x1, x2, s);
+        if (std::fabs(value - x) < 1e-7f)
+            break;
+        (value < x ? low : high) = s;
+        s = (low + high) * 0.5f;
+    }
+    return bezier(y1, y2, s);
+}
+
+EasingCurve EasingCurve::cubicBezier(float x1, float y1, float x2, float y2)
+{
+    // x must be monotonic for the curve to be a function of progress
+    x1 = std::clamp(x1, 0.0f, 1.0f);
+    x2 = std::clamp(x2, 0.0f, 1.0f);
+
+    EasingCurve curve;
+    curve.bake([&](float x)
+               { return solveCubicBezier(x1, y1, x2, y2, x); });
+
+    char spec[96];
+    std::snprintf(spec, sizeof(spec), "cubic-bezier(%g,%g,%g,%g)", x1, y1, x2, y2);
+    curve.m_spec = spec;
+    return curve;
+}
+
+bool EasingCurve::parse(const std::string &spec, EasingCurve &out)
+{
+    const std::string text = normalize(spec);
+
+    for (const NamedCurve &named : NAMED_CURVES)
+    {
+        if (text == named.name)
+        {
+            out.bake(named.function);
+            out.m_spec = named.name;
+            return true;
+        }
+    }
+
+    if (text == "ease") // CSS preset
+    {
+        out = cubicBezier(0.25f, 0.1f, 0.25f, 1.0f);
+        return true;
+    }
+
+    float x1, y1, x2, y2;
+    int consumed = 0;
+    if (std::sscanf(text.c_str(), "cubic-bezier(%f,%f,%f,%f)%n", &x1, &y1, &x2, &y2, &consumed) == 4 &&
+        static_cast<size_t>(consumed) == text.size() &&
+        std::isfinite(x1) && std::isfinite(y1) && std::isfinite(x2) && std::isfinite(y2))
+    {
+        out = cubicBezier(x1, y1, x2, y2);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file easing.h
+ * @brief Easing curves for camera transitions, baked into lookup tables.
+ *
+ * A curve is described by a spec string, as used in the INI and the profiles
+ * file:
+ * - a named curve: linear, smoothstep, smootherstep, ease-in, ease-out,
+ *   ease-in-out, ease-in-back, ease-out-back, ease-in-out-back,
+ *   ease-in-elastic, ease-out-elastic, or the CSS preset ease
+ * - cubic-bezier(x1, y1, x2, y2) with x1 and x2 in [0, 1], as in CSS
+ *
+ * The curve is sampled once when it is created (Bezier curves are inverted
+ * with Newton's method at that point), so evaluating it per frame is a table
+ * read and a linear interpolation.
+ */
+#ifndef EASING_H
+#define EASING_H
+
+#include "constants.h"
+
+#include <array>
+#include <string>
+
+/**
+ * @class EasingCurve
+ * @brief Maps transition progress in [0, 1] to an interpolation factor.
+ *
+ * The factor is 0 at 0 and 1 at 1; back and elastic curves leave [0, 1] in
+ * between. Immutable after construction, so it may be copied between threads.
+ */
+class EasingCurve
+{
+public:
+    static constexpr size_t SEGMENTS = Constants::EASING_TABLE_SEGMENTS;
+
+    /** @brief The smoothstep curve (the transition default). */
+    EasingCurve();
+
+    /**
+     * @brief Builds a curve from a spec string (case-insensitive).
+     * @param spec Curve name or cubic-bezier(...) expression.
+     * @param out Receives the curve on success; untouched otherwise.
+     * @return false if the spec is not recognized.
+     */
+    static bool parse(const std::string &spec, EasingCurve &out);
+
+    /** @brief Curve through (0,0), (x1,y1), (x2,y2), (1,1); x1 and x2 are clamped to [0, 1]. */
+    static EasingCurve cubicBezier(float x1, float y1, float x2, float y2);
+
+    /**
+     * @brief Exact value of a cubic Bezier curve at x (Newton's method with a bisection fallback).
+     * @details Used to bake tables; too slow to call per frame.
+     */
+    static float solveCubicBezier(float x1, float y1, float x2, float y2, float x);
+
+    /** @brief Interpolation factor at progress t; t is clamped to [0, 1]. */
+    float operator()(float t) const
+    {
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        const float position = t * static_cast<float>(SEGMENTS);
+        size_t index = static_cast<size_t>(position);
+        if (index >= SEGMENTS)
+            index = SEGMENTS - 1;
+        const float fraction = position - static_cast<float>(index);
+        return m_table[index] + (m_table[index + 1] - m_table[index]) * fraction;
+    }
+
+    /** @brief The normalized spec the curve was built from. */
+    const std::string &spec() const { return m_spec; }
+
+private:
+    template <typename Function>
+    void bake(Function &&function);
+
+    std::array<float, SEGMENTS + 1> m_table;
+    std::string m_spec;
+};
+
+#endif // EASING_H
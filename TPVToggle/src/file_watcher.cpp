@@ -0,0 +1,338 @@
+/**
+ * @file file_watcher.cpp
+ * @brief Implementation of FileWatcher (ReadDirectoryChangesW / inotify).
+ */
+
+#include "file_watcher.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <cwctype>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Milliseconds until the settle interval after lastEvent has passed (0 if already passed)
+    long long remainingMs(std::chrono::steady_clock::time_point lastEvent, std::chrono::milliseconds settle)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - lastEvent);
+        return std::max<long long>(0, (settle - elapsed).count());
+    }
+
+#ifdef _WIN32
+    bool equalsIgnoreCase(const WCHAR *name, size_t length, const std::wstring &target)
+    {
+        if (length != target.size())
+            return false;
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (std::towlower(name[i]) != std::towlower(target[i]))
+                return false;
+        }
+        return true;
+    }
+#endif
+}
+
+FileWatcher::FileWatcher()
+    : m_settle(0),
+      m_running(false)
+#ifdef _WIN32
+      ,
+      m_directoryHandle(INVALID_HANDLE_VALUE),
+      m_stopEvent(NULL)
+#else
+      ,
+      m_inotifyFd(-1),
+      m_stopPipe{-1, -1}
+#endif
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+}
+
+bool FileWatcher::start(const std::string &filePath, std::chrono::milliseconds settle, Callback onChange)
+{
+    stop();
+
+    std::filesystem::path path(filePath);
+    m_directory = path.has_parent_path() ? path.parent_path().string() : std::string(".");
+    m_fileName = path.filename().string();
+    m_settle = settle;
+    m_onChange = std::move(onChange);
+
+    if (!openPlatform())
+    {
+        closePlatform();
+        return false;
+    }
+
+    m_running = true;
+    m_thread = std::thread(&FileWatcher::run, this);
+    Logger::getInstance().log(LOG_DEBUG, "FileWatcher: Watching " + m_fileName + " in " + m_directory);
+    return true;
+}
+
+void FileWatcher::stop()
+{
+    if (m_thread.joinable())
+    {
+        signalStop();
+        m_thread.join();
+    }
+    m_running = false;
+    closePlatform();
+}
+
+#ifdef _WIN32
+
+bool FileWatcher::openPlatform()
+{
+    m_directoryHandle = CreateFileA(m_directory.c_str(), FILE_LIST_DIRECTORY,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                                    FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    if (m_directoryHandle == INVALID_HANDLE_VALUE)
+    {
+        Logger::getInstance().log(LOG_WARNING, "FileWatcher: Cannot open directory " + m_directory +
+                                                   " (error " + std::to_string(GetLastError()) + ")");
+        return false;
+    }
+
+    m_stopEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+    if (!m_stopEvent)
+    {
+        Logger::getInstance().log(LOG_WARNING, "FileWatcher: Cannot create stop event (error " + std::to_string(GetLastError()) + ")");
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::closePlatform()
+{
+    if (m_directoryHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_directoryHandle);
+        m_directoryHandle = INVALID_HANDLE_VALUE;
+    }
+    if (m_stopEvent)
+    {
+        CloseHandle(m_stopEvent);
+        m_stopEvent = NULL;
+    }
+}
+
+void FileWatcher::signalStop()
+{
+    if (m_stopEvent)
+        SetEvent(m_stopEvent);
+}
+
+void FileWatcher::run()
+{
+    Logger &logger = Logger::getInstance();
+
+    std::wstring target(m_fileName.size(), L'\0');
+    const int wide_length = MultiByteToWideChar(CP_ACP, 0, m_fileName.c_str(), static_cast<int>(m_fileName.size()),
+                                                &target[0], static_cast<int>(target.size()));
+    target.resize(wide_length > 0 ? static_cast<size_t>(wide_length) : 0);
+
+    // FILE_NOTIFY_INFORMATION records must be DWORD-aligned
+    alignas(DWORD) char buffer[16 * 1024];
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+    if (!overlapped.hEvent)
+    {
+        logger.log(LOG_ERROR, "FileWatcher: Cannot create I/O event (error " + std::to_string(GetLastError()) + ")");
+        return;
+    }
+
+    bool read_outstanding = false;
+    bool change_pending = false;
+    Clock::time_point last_event;
+
+    for (;;)
+    {
+        if (!read_outstanding)
+        {
+            ResetEvent(overlapped.hEvent);
+            if (!ReadDirectoryChangesW(m_directoryHandle, buffer, sizeof(buffer), FALSE,
+                                       FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+                                       NULL, &overlapped, NULL))
+            {
+                logger.log(LOG_ERROR, "FileWatcher: ReadDirectoryChangesW failed (error " + std::to_string(GetLastError()) + ")");
+                break;
+            }
+            read_outstanding = true;
+        }
+
+        const DWORD timeout = change_pending ? static_cast<DWORD>(remainingMs(last_event, m_settle)) : INFINITE;
+        HANDLE handles[2] = {m_stopEvent, overlapped.hEvent};
+        const DWORD wait = WaitForMultipleObjects(2, handles, FALSE, timeout);
+
+        if (wait == WAIT_OBJECT_0)
+            break; // Stop requested
+
+        if (wait == WAIT_OBJECT_0 + 1)
+        {
+            read_outstanding = false;
+            DWORD bytes = 0;
+            if (!GetOverlappedResult(m_directoryHandle, &overlapped, &bytes, FALSE))
+            {
+                logger.log(LOG_ERROR, "FileWatcher: Reading directory changes failed (error " + std::to_string(GetLastError()) + ")");
+                break;
+            }
+
+            // Zero bytes means the buffer overflowed and the changes are unknown: assume ours is among them
+            bool relevant = (bytes == 0);
+            for (DWORD offset = 0; !relevant && offset < bytes;)
+            {
+                const auto *info = reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(buffer + offset);
+                relevant = equalsIgnoreCase(info->FileName, info->FileNameLength / sizeof(WCHAR), target);
+                if (info->NextEntryOffset == 0)
+                    break;
+                offset += info->NextEntryOffset;
+            }
+
+            if (relevant)
+            {
+                change_pending = true;
+                last_event = Clock::now();
+            }
+            continue;
+        }
+
+        if (wait == WAIT_TIMEOUT)
+        {
+            if (change_pending && remainingMs(last_event, m_settle) == 0)
+            {
+                change_pending = false;
+                m_onChange();
+            }
+            continue;
+        }
+
+        logger.log(LOG_ERROR, "FileWatcher: Wait failed (error " + std::to_string(GetLastError()) + ")");
+        break;
+    }
+
+    if (read_outstanding)
+    {
+        // The kernel writes into buffer until the cancellation completes
+        DWORD bytes = 0;
+        CancelIo(m_directoryHandle);
+        GetOverlappedResult(m_directoryHandle, &overlapped, &bytes, TRUE);
+    }
+    CloseHandle(overlapped.hEvent);
+}
+
+#else // inotify
+
+bool FileWatcher::openPlatform()
+{
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0)
+    {
+        Logger::getInstance().log(LOG_WARNING, "FileWatcher: inotify_init1 failed: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    if (inotify_add_watch(m_inotifyFd, m_directory.c_str(),
+                          IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE) < 0)
+    {
+        Logger::getInstance().log(LOG_WARNING, "FileWatcher: Cannot watch directory " + m_directory + ": " + std::strerror(errno));
+        return false;
+    }
+    if (pipe(m_stopPipe) != 0)
+    {
+        m_stopPipe[0] = m_stopPipe[1] = -1;
+        Logger::getInstance().log(LOG_WARNING, "FileWatcher: Cannot create stop pipe: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::closePlatform()
+{
+    for (int *fd : {&m_inotifyFd, &m_stopPipe[0], &m_stopPipe[1]})
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void FileWatcher::signalStop()
+{
+    if (m_stopPipe[1] >= 0)
+    {
+        const char byte = 1;
+        (void)!write(m_stopPipe[1], &byte, 1);
+    }
+}
+
+void FileWatcher::run()
+{
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    bool change_pending = false;
+    Clock::time_point last_event;
+
+    for (;;)
+    {
+        pollfd fds[2] = {{m_stopPipe[0], POLLIN, 0}, {m_inotifyFd, POLLIN, 0}};
+        const int timeout = change_pending ? static_cast<int>(remainingMs(last_event, m_settle)) : -1;
+        const int ready = poll(fds, 2, timeout);
+
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            Logger::getInstance().log(LOG_ERROR, "FileWatcher: poll failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+        if (fds[0].revents != 0)
+            break; // Stop requested
+
+        if (fds[1].revents & POLLIN)
+        {
+            ssize_t length;
+            while ((length = read(m_inotifyFd, buffer, sizeof(buffer))) > 0)
+            {
+                for (ssize_t offset = 0; offset < length;)
+                {
+                    const auto *event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+                    // Queue overflow means changes were lost: assume ours is among them
+                    if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && m_fileName == event->name))
+                    {
+                        change_pending = true;
+                        last_event = Clock::now();
+                    }
+                    offset += sizeof(struct inotify_event) + event->len;
+                }
+            }
+            continue;
+        }
+
+        if (ready == 0 && change_pending && remainingMs(last_event, m_settle) == 0)
+        {
+            change_pending = false;
+            m_onChange();
+        }
+    }
+}
+
+#endif
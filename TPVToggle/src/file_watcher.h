@@ -0,0 +1,71 @@
+/**
+ * @file file_watcher.h
+ * @brief Watches a single file for changes made by other programs.
+ *
+ * Uses ReadDirectoryChangesW on Windows and inotify elsewhere (so the reload
+ * logic can be exercised on Linux). The parent directory is watched, since
+ * editors and atomic savers usually replace a file rather than write to it.
+ * Bursts of notifications are collapsed: the callback runs once the file has
+ * been quiet for the settle interval.
+ */
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+class FileWatcher
+{
+public:
+    using Callback = std::function<void()>;
+
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    /**
+     * @brief Starts watching; stops a previous watch first.
+     * @param filePath File to watch (its directory must exist).
+     * @param settle Quiet time after the last notification before onChange runs.
+     * @param onChange Called on the watcher thread. Must not call stop().
+     * @return true if the watch was set up.
+     */
+    bool start(const std::string &filePath, std::chrono::milliseconds settle, Callback onChange);
+
+    /**
+     * @brief Stops the watcher thread and waits for it (and any running callback) to finish.
+     */
+    void stop();
+
+    bool isRunning() const { return m_running.load(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool openPlatform();
+    void closePlatform();
+    void signalStop();
+    void run();
+
+    std::string m_directory;
+    std::string m_fileName;
+    std::chrono::milliseconds m_settle;
+    Callback m_onChange;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+
+#ifdef _WIN32
+    void *m_directoryHandle; // HANDLE opened with FILE_FLAG_OVERLAPPED
+    void *m_stopEvent;       // Manual-reset event
+#else
+    int m_inotifyFd;
+    int m_stopPipe[2]; // Written by signalStop() to wake poll()
+#endif
+};
+
+#endif // FILE_WATCHER_H
@@ -0,0 +1,83 @@
+/**
+ * @file frame_clock.cpp
+ * @brief Implementation of FrameClock.
+ */
+
+#include "frame_clock.h"
+#include "constants.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+
+FrameClock &FrameClock::getInstance()
+{
+    static FrameClock instance;
+    return instance;
+}
+
+FrameClock::FrameClock(TimeSource source)
+    : m_source(source),
+      m_lastTime(-1.0),
+      m_smoothedValue(Constants::FRAME_CLOCK_NOMINAL_DELTA),
+      m_smoothedDelta(Constants::FRAME_CLOCK_NOMINAL_DELTA)
+{
+}
+
+float FrameClock::tick()
+{
+    const double now = m_source();
+    if (m_lastTime < 0.0)
+    {
+        m_lastTime = now;
+        return m_smoothedValue;
+    }
+
+    const double raw = now - m_lastTime;
+    if (raw < Constants::FRAME_CLOCK_MIN_DELTA)
+    {
+        // Same frame (or a timer that did not advance): keep accumulating from the earlier tick
+        return 0.0f;
+    }
+    m_lastTime = now;
+
+    if (raw > Constants::FRAME_CLOCK_RESUME_THRESHOLD)
+    {
+        // Paused, loading or out of TPV: the gap is not frame time, continue at the previous rate
+        return m_smoothedValue;
+    }
+
+    const float clamped = std::min(static_cast<float>(raw), Constants::FRAME_CLOCK_MAX_DELTA);
+    m_smoothedValue += (clamped - m_smoothedValue) * Constants::FRAME_CLOCK_SMOOTHING;
+    m_smoothedDelta.store(m_smoothedValue, std::memory_order_relaxed);
+    return m_smoothedValue;
+}
+
+void FrameClock::reset()
+{
+    m_lastTime = -1.0;
+    m_smoothedValue = Constants::FRAME_CLOCK_NOMINAL_DELTA;
+    m_smoothedDelta.store(m_smoothedValue, std::memory_order_relaxed);
+}
+
+double FrameClock::platformSeconds()
+{
+#ifdef _WIN32
+    static const double inverse_frequency = []
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        return 1.0 / static_cast<double>(frequency.QuadPart);
+    }();
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<double>(counter.QuadPart) * inverse_frequency;
+#else
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
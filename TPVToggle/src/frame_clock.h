@@ -0,0 +1,62 @@
+/**
+ * @file frame_clock.h
+ * @brief Per-frame delta time measured from the TPV camera update hook.
+ *
+ * The camera hook ticks the clock once per camera update. The raw frame time
+ * comes from a high-resolution monotonic timer (QueryPerformanceCounter on
+ * Windows). It is clamped so a single hitch cannot jump a transition forward,
+ * and gaps long enough to be a pause or loading screen are ignored. The
+ * result is then smoothed with an exponential moving average.
+ */
+#ifndef FRAME_CLOCK_H
+#define FRAME_CLOCK_H
+
+#include <atomic>
+
+/**
+ * @class FrameClock
+ * @brief Smoothed frame delta source for time-based camera systems.
+ *
+ * tick() must only be called from one thread (the camera hook); deltaSeconds()
+ * may be read from any thread.
+ */
+class FrameClock
+{
+public:
+    /** @brief Returns monotonic time in seconds. Replaceable for synthetic clocks. */
+    using TimeSource = double (*)();
+
+    /**
+     * @brief The clock ticked by the TPV camera hook.
+     */
+    static FrameClock &getInstance();
+
+    explicit FrameClock(TimeSource source = &FrameClock::platformSeconds);
+
+    FrameClock(const FrameClock &) = delete;
+    FrameClock &operator=(const FrameClock &) = delete;
+
+    /**
+     * @brief Advances the clock to now; call once per camera update.
+     * @return Smoothed delta time in seconds, or 0 if no measurable time passed
+     *         since the previous tick (a second update within the same frame).
+     */
+    float tick();
+
+    /** @brief Smoothed delta of the most recent tick() in seconds. */
+    float deltaSeconds() const { return m_smoothedDelta.load(std::memory_order_relaxed); }
+
+    /** @brief Forgets the previous tick; the next tick() returns the nominal delta. */
+    void reset();
+
+    /** @brief High-resolution monotonic time in seconds (QPC on Windows, steady_clock elsewhere). */
+    static double platformSeconds();
+
+private:
+    TimeSource m_source;
+    double m_lastTime;      // Time of the previous tick, or < 0 before the first one
+    float m_smoothedValue;  // Smoothed delta owned by the ticking thread
+    std::atomic<float> m_smoothedDelta;
+};
+
+#endif // FRAME_CLOCK_H
@@ -0,0 +1,232 @@
+/**
+ * @file game_commands.cpp
+ * @brief Implementation of the game command queue.
+ */
+
+#include "game_commands.h"
+#include "game_interface.h"
+#include "global_state.h"
+#include "input_service.h"
+#include "transition_manager.h"
+#include "frame_clock.h"
+#include "logger.h"
+#include "utils.h"
+
+#include <chrono>
+
+namespace
+{
+    // Set on the game thread between beginCameraUpdate() and onCameraUpdate()
+    thread_local bool t_inCameraUpdate = false;
+}
+
+GameCommandQueue &GameCommandQueue::getInstance()
+{
+    static GameCommandQueue instance;
+    return instance;
+}
+
+GameCommandQueue::GameCommandQueue()
+    : m_gameThreadAttached(false),
+      m_lastCameraUpdate(-1.0),
+      m_stallCheckPending(false),
+      m_expectedView(-1)
+{
+}
+
+bool GameCommandQueue::setView(uint8_t view, int vkCode)
+{
+    GameCommand command;
+    command.type = GameCommand::Type::SetView;
+    command.view = view;
+    command.vkCode = vkCode;
+    return push(command);
+}
+
+bool GameCommandQueue::toggleView(int vkCode)
+{
+    GameCommand command;
+    command.type = GameCommand::Type::ToggleView;
+    command.vkCode = vkCode;
+    return push(command);
+}
+
+bool GameCommandQueue::nudgeOffset(const Vector3 &delta)
+{
+    GameCommand command;
+    command.type = GameCommand::Type::NudgeOffset;
+    command.offset = delta;
+    return push(command);
+}
+
+bool GameCommandQueue::setOffset(const Vector3 &offset, bool reportEdit)
+{
+    GameCommand command;
+    command.type = GameCommand::Type::SetOffset;
+    command.offset = offset;
+    command.reportEdit = reportEdit;
+    return push(command);
+}
+
+bool GameCommandQueue::switchOffset(const Vector3 &offset, bool transition, std::shared_ptr<const EasingCurve> curve)
+{
+    GameCommand command;
+    command.type = GameCommand::Type::SwitchOffset;
+    command.offset = offset;
+    command.transition = transition;
+    command.curve = std::move(curve);
+    return push(std::move(command));
+}
+
+bool GameCommandQueue::push(GameCommand command)
+{
+    if (!m_queue.push(std::move(command)))
+    {
+        Logger::getInstance().log(LOG_WARNING, "GameCommands: Queue full, command dropped");
+        return false;
+    }
+
+    // Queued by the camera update that drains next: no need to wake the input thread
+    if (t_inCameraUpdate && m_gameThreadAttached.load())
+        return true;
+
+    // Without camera updates nobody would apply the command: let the input thread do it now
+    scheduleStallCheck(isGameThreadStalled() ? 0 : Constants::GAME_COMMAND_STALL_MS);
+    return true;
+}
+
+void GameCommandQueue::beginCameraUpdate()
+{
+    t_inCameraUpdate = true;
+}
+
+void GameCommandQueue::onCameraUpdate()
+{
+    t_inCameraUpdate = false;
+    m_lastCameraUpdate.store(FrameClock::platformSeconds(), std::memory_order_relaxed);
+    drain();
+
+    // The input thread was draining: what it missed waits for the next frame, or a stall check if none comes
+    if (!m_queue.empty())
+        scheduleStallCheck(Constants::GAME_COMMAND_STALL_MS);
+}
+
+bool GameCommandQueue::isGameThreadStalled() const
+{
+    if (!m_gameThreadAttached.load())
+        return true;
+    const double last = m_lastCameraUpdate.load(std::memory_order_relaxed);
+    return last < 0.0 || (FrameClock::platformSeconds() - last) * 1000.0 >= Constants::GAME_COMMAND_STALL_MS;
+}
+
+void GameCommandQueue::scheduleStallCheck(unsigned long delayMs)
+{
+    if (m_stallCheckPending.exchange(true))
+        return; // One pending check covers everything queued before it runs
+
+    InputService::getInstance().post([this]
+                                     { onStallCheck(); },
+                                     std::chrono::milliseconds(delayMs));
+}
+
+void GameCommandQueue::onStallCheck()
+{
+    m_stallCheckPending.store(false);
+    if (isGameThreadStalled())
+        drain();
+
+    // Work left over (or a view change to confirm) gets another look after one stall period
+    if (!m_queue.empty() || m_expectedView.load() >= 0)
+        scheduleStallCheck(Constants::GAME_COMMAND_STALL_MS);
+}
+
+void GameCommandQueue::drain()
+{
+    if (m_draining.test_and_set(std::memory_order_acquire))
+        return; // Another thread is draining
+
+    // The previous drain's view change has had a frame to take effect
+    if (m_expectedView.load(std::memory_order_relaxed) >= 0)
+        confirmViewChange();
+
+    GameCommand command;
+    while (m_queue.pop(command))
+        execute(command);
+
+    m_draining.clear(std::memory_order_release);
+}
+
+void GameCommandQueue::execute(const GameCommand &command)
+{
+    switch (command.type)
+    {
+    case GameCommand::Type::NudgeOffset:
+        g_currentCameraOffset.update([&](Vector3 &offset)
+                                     { offset += command.offset; });
+        break;
+
+    case GameCommand::Type::SetOffset:
+    {
+        Vector3 previous;
+        g_currentCameraOffset.update([&](Vector3 &offset)
+                                     {
+                                         previous = offset;
+                                         offset = command.offset; });
+        if (command.reportEdit && m_offsetEditListener)
+            m_offsetEditListener(command.offset - previous);
+        break;
+    }
+
+    case GameCommand::Type::SwitchOffset:
+    {
+        // Nudges queued before the switch are already in previous, so the transition starts where the camera is
+        Vector3 previous;
+        g_currentCameraOffset.update([&](Vector3 &offset)
+                                     {
+                                         previous = offset;
+                                         offset = command.offset; });
+        if (command.transition)
+            TransitionManager::getInstance().startTransition(previous, command.offset, Quaternion::Identity(), -1.0f, command.curve);
+        else
+            TransitionManager::getInstance().cancelTransition();
+        break;
+    }
+
+    case GameCommand::Type::SetView:
+    case GameCommand::Type::ToggleView:
+    {
+        int vk = command.vkCode;
+        int *trigger = command.vkCode ? &vk : nullptr;
+        const int before = getViewState();
+        const bool written = (command.type == GameCommand::Type::ToggleView) ? safeToggleViewState(trigger)
+                                                                              : setViewState(command.view, trigger);
+        const int expected = (command.type == GameCommand::Type::ToggleView) ? (before == 0 ? 1 : 0) : command.view;
+        if (!written)
+        {
+            Logger::getInstance().log(LOG_ERROR, "GameCommands: View change failed");
+        }
+        else if (before != expected)
+        {
+            m_expectedTrigger = command.vkCode ? " (K:" + format_vkcode(command.vkCode) + ")" : "(I)";
+            m_expectedView.store(expected, std::memory_order_relaxed);
+        }
+        break;
+    }
+    }
+}
+
+void GameCommandQueue::confirmViewChange()
+{
+    const int expected = m_expectedView.exchange(-1, std::memory_order_relaxed);
+    const std::string desc = (expected == 0) ? "FPV" : "TPV";
+
+    const int after = getViewState();
+    if (after == expected)
+    {
+        Logger::getInstance().log(LOG_INFO, "Set" + desc + m_expectedTrigger + ": Success");
+    }
+    else
+    {
+        Logger::getInstance().log(LOG_ERROR, "Set" + desc + m_expectedTrigger + ": Failed (State=" + std::to_string(after) + ")");
+    }
+}
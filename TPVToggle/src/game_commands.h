@@ -0,0 +1,138 @@
+/**
+ * @file game_commands.h
+ * @brief Commands that change game-facing state, applied on the game thread.
+ *
+ * View switches and every change of the live camera offset are queued by the
+ * input thread and the game hooks instead of being written where they are
+ * requested, so offset writes apply in the order they were made (a profile
+ * switch is not undone by a nudge queued before it). The TPV
+ * camera hook drains the queue at the start of every camera update, so the
+ * game sees the change between two of its own frames, and a view switch is
+ * confirmed on the following frame instead of sleeping and re-reading the
+ * flag. The TPV camera only updates in third-person view (and its hook may
+ * not be installed), so when no frame arrives within
+ * Constants::GAME_COMMAND_STALL_MS the input thread drains the queue instead.
+ * Only one thread drains at a time. Commands the camera hook queues itself
+ * during an update (held offset keys nudge every frame) are drained by that
+ * same update, so they do not wake the input thread for a stall check.
+ */
+#ifndef GAME_COMMANDS_H
+#define GAME_COMMANDS_H
+
+#include "math_utils.h"
+#include "mpsc_queue.h"
+#include "easing.h"
+#include "constants.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * @struct GameCommand
+ * @brief One queued change of game-facing state.
+ */
+struct GameCommand
+{
+    enum class Type : uint8_t
+    {
+        SetView,    // Switch to view (0 = FPV, 1 = TPV)
+        ToggleView, // Switch to the other view
+        NudgeOffset, // Add offset to the live camera offset
+        SetOffset,   // Replace the live camera offset with offset
+        SwitchOffset // SetOffset for a profile switch: start or cancel its transition
+    };
+
+    Type type = Type::SetView;
+    uint8_t view = 0;
+    int vkCode = 0;                           // Key that requested a view change (0 = internal), for logs
+    bool reportEdit = false;                  // SetOffset: pass the change to the edit listener
+    bool transition = false;                  // SwitchOffset: ease from the replaced offset (else cut)
+    Vector3 offset;                           // NudgeOffset: delta; SetOffset, SwitchOffset: new value
+    std::shared_ptr<const EasingCurve> curve; // SwitchOffset: nullptr = TransitionManager's default curve
+};
+
+/**
+ * @class GameCommandQueue
+ * @brief Lock-free queue of GameCommand, drained once per camera update.
+ */
+class GameCommandQueue
+{
+public:
+    static GameCommandQueue &getInstance();
+
+    // --- Any thread ---
+
+    /** @brief Queues a switch to FPV (0) or TPV (1). */
+    bool setView(uint8_t view, int vkCode = 0);
+
+    /** @brief Queues a switch to the other view. */
+    bool toggleView(int vkCode = 0);
+
+    /** @brief Queues delta to be added to g_currentCameraOffset. */
+    bool nudgeOffset(const Vector3 &delta);
+
+    /**
+     * @brief Queues g_currentCameraOffset to be replaced with offset.
+     * @param reportEdit Pass the resulting change to the edit listener (for undo).
+     */
+    bool setOffset(const Vector3 &offset, bool reportEdit = false);
+
+    /**
+     * @brief Queues a profile switch to offset, with or without a transition.
+     * @details Applied like setOffset(). The transition starts from the offset it replaces,
+     *          nudges queued before it included; without one, a running transition is cancelled.
+     * @param curve Easing curve for the transition, or nullptr for the default.
+     */
+    bool switchOffset(const Vector3 &offset, bool transition, std::shared_ptr<const EasingCurve> curve = nullptr);
+
+    /**
+     * @brief Receives the change (new minus old) made by each reported setOffset, on the draining thread.
+     * @details The change is only known once queued nudges before it have been applied. Set before commands are queued.
+     */
+    void setOffsetEditListener(std::function<void(const Vector3 &change)> listener) { m_offsetEditListener = std::move(listener); }
+
+    /** @brief Tells the queue whether the TPV camera hook (game thread) drains it. */
+    void setGameThreadAttached(bool attached) { m_gameThreadAttached.store(attached); }
+
+    // --- Game thread ---
+
+    /**
+     * @brief Marks the calling thread as about to drain the queue.
+     * @details Commands it queues until its onCameraUpdate() skip the stall check.
+     */
+    void beginCameraUpdate();
+
+    /** @brief Applies queued commands; call at the start of every camera update. */
+    void onCameraUpdate();
+
+private:
+    GameCommandQueue();
+    ~GameCommandQueue() = default;
+
+    GameCommandQueue(const GameCommandQueue &) = delete;
+    GameCommandQueue &operator=(const GameCommandQueue &) = delete;
+
+    bool push(GameCommand command);
+    void drain();
+    void execute(const GameCommand &command);
+    void confirmViewChange();
+    void scheduleStallCheck(unsigned long delayMs);
+    void onStallCheck();
+    bool isGameThreadStalled() const;
+
+    MpscQueue<GameCommand, Constants::GAME_COMMAND_QUEUE_SIZE> m_queue;
+    std::atomic_flag m_draining = ATOMIC_FLAG_INIT;
+    std::atomic<bool> m_gameThreadAttached;
+    std::atomic<double> m_lastCameraUpdate; // FrameClock::platformSeconds(), < 0 before the first
+    std::atomic<bool> m_stallCheckPending;
+    std::function<void(const Vector3 &)> m_offsetEditListener;
+
+    // Owned by the draining thread
+    std::atomic<int> m_expectedView; // View to confirm on the next drain, or -1
+    std::string m_expectedTrigger;
+};
+
+#endif // GAME_COMMANDS_H
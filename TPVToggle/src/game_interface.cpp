@@ -222,7 +222,7 @@ void cleanupGameInterface()
 /**
  * @brief Gets the resolved address of the TPV flag using the original working logic.
  */
-volatile BYTE *getResolvedTpvFlagAddress()
+volatile uint8_t *getResolvedTpvFlagAddress()
 {
     if (g_tpvFlagAddress != nullptr)
     {
@@ -264,7 +264,7 @@ int getViewState()
     return (val == 0 || val == 1) ? static_cast<int>(val) : -1;
 }
 
-bool setViewState(BYTE new_state, int *key_pressed_vk)
+bool setViewState(uint8_t new_state, int *key_pressed_vk)
 {
     Logger &logger = Logger::getInstance();
 
@@ -296,19 +296,8 @@ bool setViewState(BYTE new_state, int *key_pressed_vk)
     logger.log(LOG_DEBUG, "Set" + desc + trigger + ": Writing " + std::to_string(new_state) + " at " + format_address(reinterpret_cast<uintptr_t>(flag_addr)));
     *flag_addr = new_state;
 
-    Sleep(1); // Small delay for stability
-
-    int after = getViewState();
-    if (after == static_cast<int>(new_state))
-    {
-        logger.log(LOG_INFO, "Set" + desc + trigger + ": Success");
-        return true;
-    }
-    else
-    {
-        logger.log(LOG_ERROR, "Set" + desc + trigger + ": Failed (State=" + std::to_string(after) + ")");
-        return false;
-    }
+    // The game picks the flag up on its next frame; GameCommandQueue confirms it then
+    return true;
 }
 
 bool safeToggleViewState(int *key_pressed_vk)
@@ -378,34 +367,33 @@ bool GetPlayerWorldTransform(::Vector3 &outPosition, ::Quaternion &outOrientatio
     const GameStructures::Matrix34f &playerMatrix =
         *reinterpret_cast<const GameStructures::Matrix34f *>(matrix_address);
 
-    // Extract position
-    outPosition.x = playerMatrix.m[0][3];
-    outPosition.y = playerMatrix.m[1][3];
-    outPosition.z = playerMatrix.m[2][3];
-
-    // Extract rotation from the 3x3 part and convert to Quaternion
-    DirectX::XMMATRIX dxRotMatrix = DirectX::XMMatrixSet(
-        playerMatrix.m[0][0], playerMatrix.m[0][1], playerMatrix.m[0][2], 0.0f,
-        playerMatrix.m[1][0], playerMatrix.m[1][1], playerMatrix.m[1][2], 0.0f,
-        playerMatrix.m[2][0], playerMatrix.m[2][1], playerMatrix.m[2][2], 0.0f,
-        0.0f, 0.0f, 0.0f, 1.0f);
-    // Note: CRYENGINE matrices (Matrix34_tpl specifically) store basis vectors as ROWS.
-    // m00, m01, m02 is the X-basis vector (Right).
-    // m10, m11, m12 is the Y-basis vector (Forward for CryEngine).
-    // m20, m21, m22 is the Z-basis vector (Up for CryEngine).
-    // The DirectX::XMMatrixSet function takes arguments row by row.
-    // So, the current mapping directly forms a matrix whose rows are these basis vectors.
-    // This is standard for creating a rotation matrix for DirectXMath.
-    outOrientation = ::Quaternion::FromXMVector(DirectX::XMQuaternionRotationMatrix(dxRotMatrix));
-
-    std::ostringstream matrix_dump;
-    matrix_dump << std::fixed << std::setprecision(4);
-    matrix_dump << "\n  Matrix Read from Entity " << format_address(reinterpret_cast<uintptr_t>(g_thePlayerEntity)) << " @ offset " << format_hex(Constants::OFFSET_ENTITY_WORLD_MATRIX_MEMBER) << " (Addr: " << format_address(matrix_address) << "):";
-    matrix_dump << "\n    R0: [" << playerMatrix.m[0][0] << ", " << playerMatrix.m[0][1] << ", " << playerMatrix.m[0][2] << "] T.x: " << playerMatrix.m[0][3];
-    matrix_dump << "\n    R1: [" << playerMatrix.m[1][0] << ", " << playerMatrix.m[1][1] << ", " << playerMatrix.m[1][2] << "] T.y: " << playerMatrix.m[1][3];
-    matrix_dump << "\n    R2: [" << playerMatrix.m[2][0] << ", " << playerMatrix.m[2][1] << ", " << playerMatrix.m[2][2] << "] T.z: " << playerMatrix.m[2][3];
-
-    logger.log(LOG_TRACE, "GetPlayerWorldTransform SUCCESS:" + matrix_dump.str());
-    logger.log(LOG_TRACE, "  Converted Pos: " + Vector3ToString(outPosition) + " | Converted Rot: " + QuatToString(outOrientation));
+    // CRYENGINE matrices (Matrix34_tpl) store the basis vectors as ROWS:
+    // row 0 is the X-basis (Right), row 1 the Y-basis (Forward), row 2 the Z-basis (Up).
+    if (!playerMatrix.Decompose(outPosition, outOrientation))
+    {
+        logger.log(LOG_DEBUG, "GetPlayerWorldTransform: Degenerate world matrix for entity " +
+                                  format_address(reinterpret_cast<uintptr_t>(g_thePlayerEntity)));
+        return false;
+    }
+
+    // Publish the sample for other threads as one snapshot, so position and orientation always match
+    PlayerTransform sample;
+    sample.position = outPosition;
+    sample.orientation = outOrientation;
+    g_playerWorldTransform.store(sample);
+
+    // Called every frame for zone checks: only format the matrix dump when it will be written
+    if (logger.isEnabled(LOG_TRACE))
+    {
+        std::ostringstream matrix_dump;
+        matrix_dump << std::fixed << std::setprecision(4);
+        matrix_dump << "\n  Matrix Read from Entity " << format_address(reinterpret_cast<uintptr_t>(g_thePlayerEntity)) << " @ offset " << format_hex(Constants::OFFSET_ENTITY_WORLD_MATRIX_MEMBER) << " (Addr: " << format_address(matrix_address) << "):";
+        matrix_dump << "\n    R0: [" << playerMatrix.m[0][0] << ", " << playerMatrix.m[0][1] << ", " << playerMatrix.m[0][2] << "] T.x: " << playerMatrix.m[0][3];
+        matrix_dump << "\n    R1: [" << playerMatrix.m[1][0] << ", " << playerMatrix.m[1][1] << ", " << playerMatrix.m[1][2] << "] T.y: " << playerMatrix.m[1][3];
+        matrix_dump << "\n    R2: [" << playerMatrix.m[2][0] << ", " << playerMatrix.m[2][1] << ", " << playerMatrix.m[2][2] << "] T.z: " << playerMatrix.m[2][3];
+
+        logger.log(LOG_TRACE, "GetPlayerWorldTransform SUCCESS:" + matrix_dump.str());
+        logger.log(LOG_TRACE, "  Converted Pos: " + Vector3ToString(outPosition) + " | Converted Rot: " + QuatToString(outOrientation));
+    }
     return true;
 }
@@ -4,13 +4,21 @@
  *
  * Handles the complex pointer chain navigation to access game state like
  * TPV flags and manages memory safety and validation.
+ *
+ * The header builds without Windows: game commands, the toggle actions and
+ * input replay only see these declarations, so host-side tests and tools
+ * link a simulated game (tests/sim_game.cpp) in place of game_interface.cpp.
  */
 #ifndef GAME_INTERFACE_H
 #define GAME_INTERFACE_H
 
-#include <windows.h>
+#include <cstddef>
 #include <cstdint>
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 #include "math_utils.h"
 
 /**
@@ -38,7 +46,7 @@ void cleanupGameInterface();
  * @details Resolves the full pointer chain: global context -> camera manager -> TPV object -> flag.
  * @return Pointer to TPV flag byte, or nullptr if resolution fails.
  */
-volatile BYTE *getResolvedTpvFlagAddress();
+volatile uint8_t *getResolvedTpvFlagAddress();
 
 /**
  * @brief Gets the current view state (FPV=0, TPV=1).
@@ -48,16 +56,19 @@ int getViewState();
 
 /**
  * @brief Sets the view state.
+ * @details Writes the flag without waiting for the game to react. Use
+ *          GameCommandQueue, which calls this on the game thread and confirms
+ *          the change on the next frame.
  * @param new_state 0 for FPV, 1 for TPV.
  * @param key_pressed_vk Optional VK code that triggered this change.
- * @return true if successful, false otherwise.
+ * @return true if the flag was written (or already had that value), false otherwise.
  */
-bool setViewState(BYTE new_state, int *key_pressed_vk = nullptr);
+bool setViewState(uint8_t new_state, int *key_pressed_vk = nullptr);
 
 /**
- * @brief Toggles between FPV and TPV modes.
+ * @brief Toggles between FPV and TPV modes (see setViewState).
  * @param key_pressed_vk Optional VK code that triggered this change.
- * @return true if successful, false otherwise.
+ * @return true if the flag was written, false otherwise.
  */
 bool safeToggleViewState(int *key_pressed_vk = nullptr);
 
@@ -66,7 +77,9 @@ bool safeToggleViewState(int *key_pressed_vk = nullptr);
  * @details Used for FOV and other camera operations.
  * @return Pointer to camera manager, or 0 if not available.
  */
+#ifdef _WIN32
 extern "C" uintptr_t __cdecl getCameraManagerInstance();
+#endif
 
 bool GetPlayerWorldTransform(Vector3 &outPosition, Quaternion &outOrientation);
 
@@ -33,9 +33,8 @@ namespace GameStructures
         {
             // Assumes CryEngine default: Y-Forward, Z-Up, X-Right for entity's local axes
             // Matrix rows store these basis vectors in world space.
-            Vector3 R = q_orientation.Rotate(Vector3(1.0f, 0.0f, 0.0f)); // Local X axis (Right)
-            Vector3 F = q_orientation.Rotate(Vector3(0.0f, 1.0f, 0.0f)); // Local Y axis (Forward)
-            Vector3 U = q_orientation.Rotate(Vector3(0.0f, 0.0f, 1.0f)); // Local Z axis (Up)
+            Vector3 R, F, U; // Local X (Right), Y (Forward), Z (Up) axes
+            q_orientation.ToBasis(R, F, U);
 
             // Row 0: Right vector components + Position X
             m[0][0] = R.x;
@@ -54,6 +53,79 @@ namespace GameStructures
             m[2][3] = v_position.z;
         }
 
+        /** @brief Row length error (squared) below which rows are treated as unit length. */
+        static constexpr float ORTHONORMAL_TOLERANCE = 1e-3f;
+
+        /**
+         * @brief Extracts position and rotation (the inverse of Set)
+         * @param outPosition Translation column
+         * @param outOrientation Unit quaternion whose ToBasis() gives the rows
+         * @return false if a basis row is degenerate (zero length or not finite)
+         * @details Reads the row-major layout directly and uses Shepperd's method:
+         *          the quaternion component with the largest magnitude is taken
+         *          from the diagonal, the others from off-diagonal sums/differences,
+         *          so the single square root is never taken of a value near zero.
+         *          The component is selected with conditional moves and a lookup
+         *          table, so random orientations cost no mispredicted branches.
+         *          Rows off unit length by more than ORTHONORMAL_TOLERANCE (scaled
+         *          entities) are normalized first; the result is renormalized to
+         *          absorb small skew.
+         */
+        bool Decompose(Vector3 &outPosition, Quaternion &outOrientation) const
+        {
+            outPosition = Vector3(m[0][3], m[1][3], m[2][3]);
+
+            // Rigid transforms, the usual case, need no row normalization. Scalars rather
+            // than a local array keep everything in registers.
+            const float length0 = m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2];
+            const float length1 = m[1][0] * m[1][0] + m[1][1] * m[1][1] + m[1][2] * m[1][2];
+            const float length2 = m[2][0] * m[2][0] + m[2][1] * m[2][1] + m[2][2] * m[2][2];
+            float scale0 = 1.0f, scale1 = 1.0f, scale2 = 1.0f;
+            if (!(std::abs(length0 - 1.0f) <= ORTHONORMAL_TOLERANCE && std::abs(length1 - 1.0f) <= ORTHONORMAL_TOLERANCE &&
+                  std::abs(length2 - 1.0f) <= ORTHONORMAL_TOLERANCE))
+            {
+                if (!(length0 > 1e-12f && length1 > 1e-12f && length2 > 1e-12f)) // Also rejects NaN
+                    return false;
+                scale0 = 1.0f / std::sqrt(length0);
+                scale1 = 1.0f / std::sqrt(length1);
+                scale2 = 1.0f / std::sqrt(length2);
+            }
+            const float r00 = m[0][0] * scale0, r01 = m[0][1] * scale0, r02 = m[0][2] * scale0;
+            const float r10 = m[1][0] * scale1, r11 = m[1][1] * scale1, r12 = m[1][2] * scale1;
+            const float r20 = m[2][0] * scale2, r21 = m[2][1] * scale2, r22 = m[2][2] * scale2;
+
+            // 4*w^2, 4*x^2, 4*y^2, 4*z^2 minus one; pick the largest
+            const float trace = r00 + r11 + r22;
+            int largest = 0;
+            float largestValue = trace;
+            const float diagonal[3] = {2.0f * r00 - trace, 2.0f * r11 - trace, 2.0f * r22 - trace};
+            for (int i = 0; i < 3; ++i)
+            {
+                const bool larger = diagonal[i] > largestValue;
+                largest = larger ? i + 1 : largest;
+                largestValue = larger ? diagonal[i] : largestValue;
+            }
+
+            const float s = 2.0f * std::sqrt(largestValue + 1.0f); // 4 * |largest component|
+            const float inverseS = 1.0f / s;
+            // wx, wy, wz, xy, xz, yz (each over 4 * the largest component), then the largest itself
+            const float terms[7] = {(r12 - r21) * inverseS, (r20 - r02) * inverseS, (r01 - r10) * inverseS,
+                                    (r01 + r10) * inverseS, (r02 + r20) * inverseS, (r12 + r21) * inverseS,
+                                    0.25f * s};
+            // Which term gives x, y, z, w for each choice of largest component (w, x, y, z)
+            static constexpr uint8_t PICK[4][4] = {{0, 1, 2, 6}, {6, 3, 4, 0}, {3, 6, 5, 1}, {4, 5, 6, 2}};
+            const uint8_t *pick = PICK[largest];
+            const float x = terms[pick[0]], y = terms[pick[1]], z = terms[pick[2]], w = terms[pick[3]];
+
+            // Orthonormal rows give a unit result to within rounding: one Newton step of
+            // 1/sqrt around 1 is exact enough there and avoids a square root and a divide
+            const float lengthSquared = x * x + y * y + z * z + w * w;
+            const float inverseLength = std::abs(lengthSquared - 1.0f) <= 1e-4f ? 0.5f * (3.0f - lengthSquared)
+                                                                                : 1.0f / std::sqrt(lengthSquared);
+            outOrientation = Quaternion(x * inverseLength, y * inverseLength, z * inverseLength, w * inverseLength);
+            return true;
+        }
+
         /**
          * @brief Gets the raw float pointer to the matrix data
          * @return Pointer to the first element of the matrix
@@ -14,18 +14,16 @@ uintptr_t g_ModuleBase = 0;
 size_t g_ModuleSize = 0;
 
 // Thread control
-HANDLE g_exitEvent = NULL;
+void *g_exitEvent = nullptr;
 
 // Thread handles
-HANDLE g_hMonitorThread = NULL;
-HANDLE g_hOverlayThread = NULL;
-HANDLE g_hCameraProfileThread = NULL;
+void *g_hOverlayThread = nullptr;
 
 // Game interface globals
 extern "C"
 {
-    BYTE *g_global_context_ptr_address = nullptr;
-    volatile BYTE *g_tpvFlagAddress = nullptr;
+    uint8_t *g_global_context_ptr_address = nullptr;
+    volatile uint8_t *g_tpvFlagAddress = nullptr;
 }
 
 // Hook globals
@@ -35,26 +33,23 @@ extern "C"
 }
 
 // Event hook globals
-BYTE *g_accumulatorWriteAddress = nullptr;
-BYTE g_originalAccumulatorWriteBytes[Constants::ACCUMULATOR_WRITE_INSTR_LENGTH] = {0};
+uint8_t *g_accumulatorWriteAddress = nullptr;
+uint8_t g_originalAccumulatorWriteBytes[Constants::ACCUMULATOR_WRITE_INSTR_LENGTH] = {0};
 volatile uintptr_t *g_scrollAccumulatorAddress = nullptr;
 volatile uintptr_t *g_scrollPtrStorageAddress = nullptr;
 
 // Thread communication atomics
 std::atomic<bool> g_isOverlayActive(false);
-std::atomic<bool> g_overlayFpvRequest(false);
-std::atomic<bool> g_overlayTpvRestoreRequest(false);
 std::atomic<bool> g_wasTpvBeforeOverlay(false);
 std::atomic<bool> g_accumulatorWriteNOPped(false);
 std::atomic<bool> g_holdToScrollActive(false);
 
 Vector3 g_latestTpvCameraForward = {0.0f, 1.0f, 0.0f};
 
-Vector3 g_currentCameraOffset(0.0f, 0.0f, 0.0f);
+SeqLock<Vector3> g_currentCameraOffset(Vector3(0.0f, 0.0f, 0.0f));
 std::atomic<bool> g_cameraAdjustmentMode(false);
 
-Vector3 g_playerWorldPosition(0.0f, 0.0f, 0.0f);
-Quaternion g_playerWorldOrientation = Quaternion::Identity();
+SeqLock<PlayerTransform> g_playerWorldTransform;
 
 GameStructures::CEntity *g_thePlayerEntity = nullptr;
 CEntity_SetWorldTM_Func_t g_funcCEntitySetWorldTM = nullptr;
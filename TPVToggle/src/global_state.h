@@ -3,58 +3,62 @@
  * @brief Header for all global variables shared across the mod.
  *
  * This header provides declarations (not definitions) for all global variables,
- * preventing multiple definition errors during linking.
+ * preventing multiple definition errors during linking. Windows types are
+ * spelled as their plain equivalents (HANDLE = void *, BYTE = uint8_t), so
+ * code that only needs the camera state builds without windows.h.
  */
 #ifndef GLOBAL_STATE_H
 #define GLOBAL_STATE_H
 
-#include <windows.h>
 #include <cstdint>
 #include <atomic>
 #include "game_structures.h"
 #include "constants.h"
 #include "math_utils.h"
+#include "seqlock.h"
 
 // Global module information
 extern uintptr_t g_ModuleBase;
 extern size_t g_ModuleSize;
 
 // Thread control
-extern HANDLE g_exitEvent;
+extern void *g_exitEvent; // HANDLE
 
 // Thread handles (for cleanup)
-extern HANDLE g_hMonitorThread;
-extern HANDLE g_hOverlayThread;
-extern HANDLE g_hCameraProfileThread;
+extern void *g_hOverlayThread; // HANDLE
 
 // Game interface globals
 extern "C"
 {
-    extern BYTE *g_global_context_ptr_address;
-    extern volatile BYTE *g_tpvFlagAddress;
+    extern uint8_t *g_global_context_ptr_address;
+    extern volatile uint8_t *g_tpvFlagAddress;
 }
 
 // Event hook globals
-extern BYTE *g_accumulatorWriteAddress;
-extern BYTE g_originalAccumulatorWriteBytes[Constants::ACCUMULATOR_WRITE_INSTR_LENGTH];
+extern uint8_t *g_accumulatorWriteAddress;
+extern uint8_t g_originalAccumulatorWriteBytes[Constants::ACCUMULATOR_WRITE_INSTR_LENGTH];
 extern volatile uintptr_t *g_scrollAccumulatorAddress;
 extern volatile uintptr_t *g_scrollPtrStorageAddress;
 
 // Thread communication atomics
 extern std::atomic<bool> g_isOverlayActive;
-extern std::atomic<bool> g_overlayFpvRequest;
-extern std::atomic<bool> g_overlayTpvRestoreRequest;
 extern std::atomic<bool> g_wasTpvBeforeOverlay;
 extern std::atomic<bool> g_accumulatorWriteNOPped;
 extern std::atomic<bool> g_holdToScrollActive;
 
 extern Vector3 g_latestTpvCameraForward;
 
-extern Vector3 g_currentCameraOffset;
+// Live camera offset: written by the profile/input threads, read by the render thread each frame
+extern SeqLock<Vector3> g_currentCameraOffset;
 extern std::atomic<bool> g_cameraAdjustmentMode;
 
-extern Vector3 g_playerWorldPosition;
-extern Quaternion g_playerWorldOrientation;
+// Last sampled player transform (see GetPlayerWorldTransform); position and orientation come from the same frame
+struct PlayerTransform
+{
+    Vector3 position;
+    Quaternion orientation = Quaternion::Identity();
+};
+extern SeqLock<PlayerTransform> g_playerWorldTransform;
 
 extern GameStructures::CEntity *g_thePlayerEntity;
 typedef void (*CEntity_SetWorldTM_Func_t)(GameStructures::CEntity *this_ptr, float *tm_3x4, int flags);
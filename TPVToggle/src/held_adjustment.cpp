@@ -0,0 +1,62 @@
+/**
+ * @file held_adjustment.cpp
+ * @brief Implementation of the held offset adjustment speed curve.
+ */
+
+#include "held_adjustment.h"
+#include "constants.h"
+
+#include <algorithm>
+#include <cmath>
+
+Vector3 HeldAdjustment::step(const Vector3 &direction, bool precision, float dt)
+{
+    m_active = true;
+    if (dt <= 0.0f)
+        return Vector3();
+
+    const float start = m_holdTime;
+    m_holdTime += dt;
+
+    float moved = distance(start, m_holdTime);
+    if (precision)
+        moved *= m_settings.precisionScale;
+    return direction * moved;
+}
+
+void HeldAdjustment::reset()
+{
+    m_holdTime = 0.0f;
+    m_active = false;
+}
+
+float HeldAdjustment::speedAt(float t) const
+{
+    if (m_settings.rampSeconds <= 0.0f)
+        return m_settings.speed * m_settings.maxMultiplier;
+
+    const float ramp = m_settings.curve(t / m_settings.rampSeconds);
+    return m_settings.speed * (1.0f + (m_settings.maxMultiplier - 1.0f) * ramp);
+}
+
+float HeldAdjustment::distance(float t0, float t1) const
+{
+    // Past the ramp the speed is constant
+    const float rampEnd = std::max(0.0f, m_settings.rampSeconds);
+    float moved = 0.0f;
+    if (t1 > rampEnd)
+    {
+        moved += speedAt(rampEnd) * (t1 - std::max(t0, rampEnd));
+        t1 = std::max(t0, rampEnd);
+    }
+
+    // On the ramp: midpoint rule on short substeps, so a long frame covers the same distance as several short ones
+    const float span = t1 - t0;
+    if (span <= 0.0f)
+        return moved;
+    const int substeps = std::max(1, static_cast<int>(std::ceil(span / Constants::OFFSET_ADJUST_MAX_SUBSTEP)));
+    const float h = span / static_cast<float>(substeps);
+    for (int i = 0; i < substeps; ++i)
+        moved += speedAt(t0 + (static_cast<float>(i) + 0.5f) * h) * h;
+    return moved;
+}
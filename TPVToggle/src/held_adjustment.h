@@ -0,0 +1,71 @@
+/**
+ * @file held_adjustment.h
+ * @brief Speed of a held offset adjustment key over time.
+ *
+ * While offset keys are held the camera moves at a speed in units per
+ * second instead of by a fixed step per tick, so it moves the same distance
+ * at any frame rate. The speed starts at the base speed and ramps up to
+ * maxMultiplier times that over rampSeconds, following an easing curve
+ * (slow start, then faster for long moves). A precision modifier scales the
+ * speed down for fine placement.
+ *
+ * Time only enters through step(), so the same code runs on frame time in
+ * the game and on a simulated clock elsewhere.
+ */
+#ifndef HELD_ADJUSTMENT_H
+#define HELD_ADJUSTMENT_H
+
+#include "easing.h"
+#include "math_utils.h"
+
+/**
+ * @class HeldAdjustment
+ * @brief Turns held adjustment directions and elapsed time into offset deltas.
+ */
+class HeldAdjustment
+{
+public:
+    struct Settings
+    {
+        float speed = 0.5f;          // Units per second when a key goes down
+        float maxMultiplier = 1.0f;  // Speed multiplier reached after rampSeconds
+        float rampSeconds = 0.0f;    // Time to reach full speed (0 = no acceleration)
+        EasingCurve curve;           // Shape of the ramp
+        float precisionScale = 1.0f; // Speed multiplier while the precision key is held
+    };
+
+    HeldAdjustment() : m_holdTime(0.0f), m_active(false) {}
+
+    void setSettings(const Settings &settings) { m_settings = settings; }
+    const Settings &settings() const { return m_settings; }
+
+    /**
+     * @brief Advances the hold by dt seconds.
+     * @param direction -1, 0 or 1 per axis.
+     * @param precision true while the precision key is held.
+     * @return Offset change for this step.
+     */
+    Vector3 step(const Vector3 &direction, bool precision, float dt);
+
+    /** @brief Ends the hold; the next step() starts again at the base speed. */
+    void reset();
+
+    /** @brief True between the first step() of a hold and reset(). */
+    bool isActive() const { return m_active; }
+
+    /** @brief Seconds since the hold started. */
+    float holdTime() const { return m_holdTime; }
+
+    /** @brief Speed (units per second) after holding for t seconds, before the precision scale. */
+    float speedAt(float t) const;
+
+private:
+    // Distance covered between hold times t0 and t1
+    float distance(float t0, float t1) const;
+
+    Settings m_settings;
+    float m_holdTime;
+    bool m_active;
+};
+
+#endif // HELD_ADJUSTMENT_H
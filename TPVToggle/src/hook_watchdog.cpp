@@ -0,0 +1,46 @@
+/**
+ * @file hook_watchdog.cpp
+ * @brief Implementation of the keyboard hook cross-check.
+ */
+
+#include "hook_watchdog.h"
+
+KeyHookWatchdog::KeyHookWatchdog(int checksBeforeLost)
+    : m_checksBeforeLost(checksBeforeLost > 0 ? checksBeforeLost : 1),
+      m_unseenChecks(0)
+{
+}
+
+void KeyHookWatchdog::reset(const KeyBits &downNow)
+{
+    m_ignored = downNow;
+    m_unseen.reset();
+    m_unseenChecks = 0;
+}
+
+KeyHookWatchdog::Verdict KeyHookWatchdog::check(const KeyBits &sampled, const KeyBits &seen)
+{
+    // A key held since the reset counts again once it has been released
+    m_ignored &= sampled;
+
+    Verdict verdict;
+    verdict.stuck = seen & ~sampled;
+
+    // A key pressed just before the check may not have reached the hook yet, so only
+    // the same key missing on consecutive checks counts
+    const KeyBits unseen = sampled & ~seen & ~m_ignored;
+    const KeyBits persisting = unseen & m_unseen;
+    if (persisting.any())
+    {
+        m_unseen = persisting;
+        ++m_unseenChecks;
+    }
+    else
+    {
+        m_unseen = unseen;
+        m_unseenChecks = unseen.any() ? 1 : 0;
+    }
+
+    verdict.hookLost = m_unseenChecks >= m_checksBeforeLost;
+    return verdict;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file hook_watchdog.h
+ * @brief Cross-checks what the low-level keyboard hook reported against the real key state.
+ *
+ * A WH_KEYBOARD_LL hook can miss transitions: a key released while another
+ * desktop (UAC, Ctrl+Alt+Del) or a higher-integrity window has the input
+ * never sends its key-up, leaving the key stuck down. Windows also removes
+ * the hook without notice when one call takes longer than
+ * LowLevelHooksTimeout, after which no key is reported at all.
+ *
+ * The input service samples the keys now and then and passes both views in:
+ * keys the hook still has down but are up are stuck and get released; a key
+ * that stays down without the hook ever reporting it over several checks
+ * means the hook is gone. Like AdaptivePollScheduler it holds no clock or
+ * platform state, so the policy is tested with fake key states.
+ */
+#ifndef HOOK_WATCHDOG_H
+#define HOOK_WATCHDOG_H
+
+#include <bitset>
+
+/**
+ * @class KeyHookWatchdog
+ * @brief Decides which keys are stuck and whether the hook was lost. Not thread-safe.
+ */
+class KeyHookWatchdog
+{
+public:
+    static constexpr int KEY_COUNT = 256;
+    using KeyBits = std::bitset<KEY_COUNT>;
+
+    struct Verdict
+    {
+        KeyBits stuck; // Down as far as the hook knows, but released
+        bool hookLost; // Keys are going down without the hook seeing them
+    };
+
+    /**
+     * @param checksBeforeLost Consecutive checks a key must be down but unseen before the hook counts as lost.
+     */
+    explicit KeyHookWatchdog(int checksBeforeLost);
+
+    /**
+     * @brief Starts over, ignoring keys already down (held before the hook could see them).
+     * @details Also used while another application has the focus, where the hook legitimately sees nothing.
+     */
+    void reset(const KeyBits &downNow);
+
+    /**
+     * @param sampled Keys that are down now.
+     * @param seen Keys the hook has reported down and not yet up.
+     */
+    Verdict check(const KeyBits &sampled, const KeyBits &seen);
+
+private:
+    int m_checksBeforeLost;
+    KeyBits m_ignored;
+    KeyBits m_unseen; // Down but unseen on every check since m_unseenChecks started
+    int m_unseenChecks;
+};
+
+#endif // HOOK_WATCHDOG_H
@@ -11,13 +11,18 @@
 #include "game_interface.h"
 #include "MinHook.h"
 
+#include <atomic>
 #include <stdexcept>
 #include <math.h>
 
+// Function signature for the TPV FOV calculation function
+typedef void(__fastcall *TpvFovCalculateFunc)(float *pViewStruct, float deltaTime);
+
 // Hook state
 static TpvFovCalculateFunc Original_TpvFovCalculate = nullptr;
 static BYTE *g_fovHookAddress = nullptr;
 static float g_desiredFovRadians = 0.0f;
+static std::atomic<float> g_fovOverrideRadians(0.0f); // 0 = no override
 
 /**
  * @brief Detour function for TPV FOV calculation.
@@ -53,8 +58,10 @@ static void __fastcall Detour_TpvFovCalculate(float *pViewStruct, float deltaTim
                 uintptr_t fovWriteAddress = reinterpret_cast<uintptr_t>(pViewStruct) + Constants::OFFSET_TpvFovWrite;
                 if (isMemoryWritable(reinterpret_cast<void *>(fovWriteAddress), sizeof(float)))
                 {
-                    *reinterpret_cast<float *>(fovWriteAddress) = g_desiredFovRadians;
-                    logger.log(LOG_TRACE, "FovHook: Applied FOV " + std::to_string(g_desiredFovRadians) + " radians");
+                    const float overrideRadians = g_fovOverrideRadians.load(std::memory_order_relaxed);
+                    const float fovRadians = overrideRadians > 0.0f ? overrideRadians : g_desiredFovRadians;
+                    *reinterpret_cast<float *>(fovWriteAddress) = fovRadians;
+                    logger.log(LOG_TRACE, "FovHook: Applied FOV " + std::to_string(fovRadians) + " radians");
                 }
             }
         }
@@ -148,3 +155,16 @@ bool isFovHookActive()
 {
     return (g_fovHookAddress != nullptr && Original_TpvFovCalculate != nullptr);
 }
+
+void setTpvFovOverride(float degrees)
+{
+    g_fovOverrideRadians.store(degrees > 0.0f ? static_cast<float>(degrees * (M_PI / 180.0f)) : 0.0f,
+                               std::memory_order_relaxed);
+}
+
+float getConfiguredTpvFov()
+{
+    if (!isFovHookActive())
+        return -1.0f;
+    return static_cast<float>(g_desiredFovRadians * (180.0 / M_PI));
+}
@@ -8,12 +8,9 @@
 #ifndef FOV_HOOK_H
 #define FOV_HOOK_H
 
-#include <windows.h>
+#include <cstddef>
 #include <cstdint>
 
-// Function signature for the TPV FOV calculation function
-typedef void(__fastcall *TpvFovCalculateFunc)(float *pViewStruct, float deltaTime);
-
 /**
  * @brief Initialize the TPV FOV hook.
  * @param module_base Base address of the target game module.
@@ -34,4 +31,17 @@ void cleanupFovHook();
  */
 bool isFovHookActive();
 
+/**
+ * @brief Temporarily replaces the configured TPV FOV (e.g., during camera path playback).
+ * @param degrees FOV in degrees, or <= 0 to return to the configured FOV.
+ * @details Has no effect unless the hook is installed (TpvFovDegrees > 0). Thread-safe.
+ */
+void setTpvFovOverride(float degrees);
+
+/**
+ * @brief The FOV the hook applies when no override is set.
+ * @return Degrees, or -1 if the hook is not installed.
+ */
+float getConfiguredTpvFov();
+
 #endif // FOV_HOOK_H
@@ -17,6 +17,10 @@
 #include "math_utils.h"
 #include "config.h"
 #include "transition_manager.h"
+#include "frame_clock.h"
+#include "camera_path_manager.h"
+#include "game_commands.h"
+#include "camera_profile_thread.h"
 
 #include "MinHook.h"
 
@@ -38,24 +42,35 @@ static BYTE *g_tpvCameraHookAddress = nullptr;
 /**
  * @brief Gets the currently active camera offset
  * @details Determines which offset source to use based on configuration
+ * @param deltaTime Frame time in seconds (see FrameClock)
+ * @param outRotation Local rotation to apply on top of the camera's (identity unless a path is playing)
  * @return Vector3 The local space offset to apply
  */
-Vector3 GetActiveOffset()
+Vector3 GetActiveOffset(float deltaTime, Quaternion &outRotation)
 {
-    // Priority 1: Active transition
+    outRotation = Quaternion::Identity();
+
     if (g_config.enable_camera_profiles)
     {
+        // Priority 0: Camera path playback
+        Vector3 pathOffset;
+        if (CameraPathManager::getInstance().updatePlayback(deltaTime, pathOffset, outRotation))
+        {
+            return pathOffset;
+        }
+
+        // Priority 1: Active transition
         Vector3 transitionPosition;
         Quaternion transitionRotation;
 
         // Check if a transition is in progress
-        if (TransitionManager::getInstance().updateTransition(0.016f, transitionPosition, transitionRotation))
+        if (TransitionManager::getInstance().updateTransition(deltaTime, transitionPosition, transitionRotation))
         {
             return transitionPosition;
         }
 
         // Priority 2: Camera profile system
-        return g_currentCameraOffset;
+        return g_currentCameraOffset.load();
     }
 
     // Priority 3: Static configuration offsets
@@ -95,6 +110,19 @@ void __fastcall Detour_TpvCameraUpdate(uintptr_t thisPtr, uintptr_t outputPosePt
         return;
     }
 
+    // Measure every camera update, so time spent outside TPV shows up as one long gap
+    const float deltaTime = FrameClock::getInstance().tick();
+
+    // Held offset keys move the camera by frame time; the nudge is applied just below
+    GameCommandQueue::getInstance().beginCameraUpdate();
+    updateHeldOffsetAdjustment(deltaTime);
+
+    // Zone lookup for the player's position; a zone change is handed to the input thread
+    updateProfileZones();
+
+    // Apply queued view switches and nudges between two game frames
+    GameCommandQueue::getInstance().onCameraUpdate();
+
     // Validate parameters and check if we're in TPV mode
     if (outputPosePtr == 0 || getViewState() != 1)
     {
@@ -120,11 +148,13 @@ void __fastcall Detour_TpvCameraUpdate(uintptr_t thisPtr, uintptr_t outputPosePt
         Vector3 currentPosition = *positionPtr;
         Quaternion currentRotation = *rotationPtr;
 
-        // Determine which offset to apply (priority order: transition > profile > config)
-        Vector3 localOffset = GetActiveOffset();
+        // Determine which offset to apply (priority order: path > transition > profile > config)
+        Quaternion localRotation;
+        Vector3 localOffset = GetActiveOffset(deltaTime, localRotation);
+        const bool rotate = localRotation != Quaternion::Identity();
 
-        // Skip if no offset to apply
-        if (localOffset.x == 0.0f && localOffset.y == 0.0f && localOffset.z == 0.0f)
+        // Skip if nothing to apply
+        if (localOffset.x == 0.0f && localOffset.y == 0.0f && localOffset.z == 0.0f && !rotate)
         {
             return;
         }
@@ -139,6 +169,10 @@ void __fastcall Detour_TpvCameraUpdate(uintptr_t thisPtr, uintptr_t outputPosePt
         if (isMemoryWritable(positionPtr, sizeof(Vector3)))
         {
             *positionPtr = newPosition;
+            if (rotate && isMemoryWritable(rotationPtr, sizeof(Quaternion)))
+            {
+                *rotationPtr = currentRotation * localRotation;
+            }
 
             logger.log(LOG_TRACE, "TpvCameraHook: Applied offset - Local: " +
                                       Vector3ToString(localOffset) + " World: " + Vector3ToString(worldOffset));
@@ -233,6 +267,7 @@ bool initializeTpvCameraHook(uintptr_t moduleBase, size_t moduleSize)
                                      " Z=" + std::to_string(g_config.tpv_offset_z));
         }
 
+        GameCommandQueue::getInstance().setGameThreadAttached(true);
         return true;
     }
     catch (const std::exception &e)
@@ -246,6 +281,7 @@ bool initializeTpvCameraHook(uintptr_t moduleBase, size_t moduleSize)
 void cleanupTpvCameraHook()
 {
     Logger &logger = Logger::getInstance();
+    GameCommandQueue::getInstance().setGameThreadAttached(false);
 
     if (g_tpvCameraHookAddress)
     {
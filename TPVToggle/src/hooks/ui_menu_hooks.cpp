@@ -14,6 +14,7 @@
 #include "game_interface.h"
 #include "global_state.h"
 #include "tpv_input_hook.h"
+#include "input_recording.h"
 #include "MinHook.h"
 
 #include <stdexcept>
@@ -46,6 +47,7 @@ static void __fastcall MenuOpenDetour(void *thisPtr, char paramByte)
     {
         // Before calling original - menu is about to open
         logger.log(LOG_INFO, "UIMenuHook: Game menu is opening");
+        InputRecorder::getInstance().recordEvent(InputRecord::Type::MenuOpened);
 
         resetScrollAccumulator();
         // Set menu state to open
@@ -96,6 +98,7 @@ static void __fastcall MenuCloseDetour(void *thisPtr)
     {
         // Before calling original - menu is about to close
         logger.log(LOG_INFO, "UIMenuHook: Game menu is closing");
+        InputRecorder::getInstance().recordEvent(InputRecord::Type::MenuClosed);
 
         resetScrollAccumulator(true);
         // Set menu state to closed
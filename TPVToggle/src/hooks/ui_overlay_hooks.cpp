@@ -16,6 +16,8 @@
 #include "aob_scanner.h"
 #include "game_interface.h"
 #include "global_state.h"
+#include "toggle_thread.h"
+#include "input_recording.h"
 #include "config.h"
 #include "MinHook.h"
 
@@ -66,36 +68,12 @@ static void __fastcall HideOverlaysDetour(void *thisPtr, uint8_t paramByte, char
             logger.log(LOG_ERROR, "UIOverlayHook: HideOverlays original function pointer is NULL");
         }
 
-        // If is currently in overlays and open another overlay, skip
-        if (!g_isOverlayActive.load())
-        {
-            // Remember if we're currently in TPV mode
-            int viewState = getViewState();
-            if (viewState == 1)
-            {
-                // We're in TPV - remember this for later restoration
-                g_wasTpvBeforeOverlay.store(true);
-                logger.log(LOG_DEBUG, "UIOverlayHook: Stored TPV state for later restoration");
-            }
-            else
-            {
-                // We're already in FPV or unknown state
-                g_wasTpvBeforeOverlay.store(false);
-            }
+        InputRecorder::getInstance().recordEvent(InputRecord::Type::OverlayHidden);
 
-            // Request switch to FPV when UI shows
-            // This will be processed by the monitor thread
-            g_overlayFpvRequest.store(true);
-
-            resetScrollAccumulator(true);
-            // Mark overlay as active
-            g_isOverlayActive.store(true);
-        }
-        else
+        // Request switch to FPV when UI shows; only the first overlay resets scrolling
+        if (handleOverlayHidden())
         {
-            // Request switch to FPV when UI shows
-            // This will be processed by the monitor thread
-            g_overlayFpvRequest.store(true);
+            resetScrollAccumulator(true);
         }
     }
     catch (const std::exception &e)
@@ -149,23 +127,11 @@ static void __fastcall ShowOverlaysDetour(void *thisPtr, uint8_t paramByte, char
             logger.log(LOG_ERROR, "UIOverlayHook: ShowOverlays original function pointer is NULL");
         }
 
-        resetScrollAccumulator(true);
-        // Mark overlay as inactive
-        g_isOverlayActive.store(false);
+        InputRecorder::getInstance().recordEvent(InputRecord::Type::OverlayShown);
 
-        // Request restoration to TPV if that was the previous state
-        if (g_wasTpvBeforeOverlay.load())
-        {
-            logger.log(LOG_DEBUG, "UIOverlayHook: Requesting TPV restoration");
-            g_overlayTpvRestoreRequest.store(true);
-        }
-        else
-        {
-            logger.log(LOG_DEBUG, "UIOverlayHook: No TPV restoration needed");
-        }
-
-        // Reset restoration flag
-        g_wasTpvBeforeOverlay.store(false);
+        resetScrollAccumulator(true);
+        // Mark overlay as inactive and restore TPV if that was the previous state
+        handleOverlayShown();
     }
     catch (const std::exception &e)
     {
@@ -191,7 +157,7 @@ static void __fastcall ShowOverlaysDetour(void *thisPtr, uint8_t paramByte, char
 
 /**
  * @brief Handler for hold-to-scroll key state changes
- * @details Called by the main monitor thread when hold-to-scroll key state changes
+ * @details Called on the input thread when hold-to-scroll key state changes
  * @param holdKeyPressed Whether a hold key is currently pressed
  * @return true if the state was successfully handled, false otherwise
  */
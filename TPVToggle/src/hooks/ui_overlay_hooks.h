@@ -9,7 +9,7 @@
 #ifndef UI_OVERLAY_HOOKS_H
 #define UI_OVERLAY_HOOKS_H
 
-#include <windows.h>
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -33,7 +33,7 @@ bool areUiOverlayHooksActive();
 
 /**
  * @brief Handler for hold-to-scroll key state changes
- * @details Called by the main monitor thread when hold-to-scroll key state changes
+ * @details Called on the input thread when hold-to-scroll key state changes
  * @param holdKeyPressed Whether a hold key is currently pressed
  * @return true if the state was successfully handled, false otherwise
  */
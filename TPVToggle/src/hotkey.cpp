@@ -0,0 +1,473 @@
+/**
+ * @file hotkey.cpp
+ * @brief Implementation of hotkey parsing and the HotkeyEngine.
+ */
+
+#include "hotkey.h"
+#include "input_service.h"
+#include "constants.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+
+static_assert(sizeof(KeyState) == sizeof(std::bitset<InputService::KEY_COUNT>), "KeyState must match InputService::keyState()");
+
+namespace
+{
+    constexpr int VK_CODE_SHIFT = 0x10;
+    constexpr int VK_CODE_CONTROL = 0x11;
+    constexpr int VK_CODE_MENU = 0x12;
+    constexpr int VK_CODE_LSHIFT = 0xA0;
+    constexpr int VK_CODE_LCONTROL = 0xA2;
+    constexpr int VK_CODE_LMENU = 0xA4;
+
+    struct ModifierName
+    {
+        const char *name;
+        int vkCode;
+    };
+
+    // Matched case-insensitively; the first name of a code is used when formatting
+    constexpr ModifierName MODIFIER_NAMES[] = {
+        {"Ctrl", VK_CODE_CONTROL},
+        {"Control", VK_CODE_CONTROL},
+        {"Shift", VK_CODE_SHIFT},
+        {"Alt", VK_CODE_MENU},
+        {"LCtrl", VK_CODE_LCONTROL},
+        {"RCtrl", VK_CODE_LCONTROL + 1},
+        {"LShift", VK_CODE_LSHIFT},
+        {"RShift", VK_CODE_LSHIFT + 1},
+        {"LAlt", VK_CODE_LMENU},
+        {"RAlt", VK_CODE_LMENU + 1},
+    };
+
+    // Generic code of a modifier (generic, left or right), or 0
+    int modifierFamily(int vkCode)
+    {
+        switch (vkCode)
+        {
+        case VK_CODE_SHIFT:
+        case VK_CODE_LSHIFT:
+        case VK_CODE_LSHIFT + 1:
+            return VK_CODE_SHIFT;
+        case VK_CODE_CONTROL:
+        case VK_CODE_LCONTROL:
+        case VK_CODE_LCONTROL + 1:
+            return VK_CODE_CONTROL;
+        case VK_CODE_MENU:
+        case VK_CODE_LMENU:
+        case VK_CODE_LMENU + 1:
+            return VK_CODE_MENU;
+        default:
+            return 0;
+        }
+    }
+
+    int leftKeyFor(int generic)
+    {
+        return generic == VK_CODE_SHIFT ? VK_CODE_LSHIFT : generic == VK_CODE_CONTROL ? VK_CODE_LCONTROL
+                                                                                      : VK_CODE_LMENU;
+    }
+
+    std::string toLower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    std::vector<std::string> split(const std::string &text, char separator)
+    {
+        std::vector<std::string> parts;
+        size_t begin = 0;
+        for (;;)
+        {
+            const size_t end = text.find(separator, begin);
+            parts.push_back(trim(text.substr(begin, end == std::string::npos ? std::string::npos : end - begin)));
+            if (end == std::string::npos)
+                return parts;
+            begin = end + 1;
+        }
+    }
+
+    bool parseKey(const std::string &token, int &vkCode, std::string &error)
+    {
+        if (token.empty())
+        {
+            error = "missing key";
+            return false;
+        }
+
+        const std::string lower = toLower(token);
+        for (const ModifierName &modifier : MODIFIER_NAMES)
+        {
+            if (lower == toLower(modifier.name))
+            {
+                vkCode = modifier.vkCode;
+                return true;
+            }
+        }
+
+        std::string hex = lower;
+        if (hex.size() >= 2 && hex[0] == '0' && hex[1] == 'x')
+            hex = hex.substr(2);
+        if (hex.empty() || hex.size() > 8 || hex.find_first_not_of("0123456789abcdef") != std::string::npos)
+        {
+            error = "'" + token + "' is neither a hex VK code nor a modifier name";
+            return false;
+        }
+
+        const unsigned long code = std::stoul(hex, nullptr, 16);
+        if (code == 0 || code > 0xFF)
+        {
+            error = "key code '" + token + "' is outside the VK range (0x01-0xFF)";
+            return false;
+        }
+        vkCode = static_cast<int>(code);
+        return true;
+    }
+
+    std::string keyName(int vkCode)
+    {
+        for (const ModifierName &modifier : MODIFIER_NAMES)
+        {
+            if (modifier.vkCode == vkCode)
+                return modifier.name;
+        }
+        return format_vkcode(vkCode);
+    }
+}
+
+bool Hotkey::parse(const std::string &expression, Hotkey &out, std::string &error)
+{
+    Hotkey hotkey;
+    std::string body = trim(expression);
+
+    const size_t colon = body.rfind(':');
+    if (colon != std::string::npos)
+    {
+        const std::string suffix = toLower(trim(body.substr(colon + 1)));
+        if (suffix == "tap")
+            hotkey.trigger = Trigger::Tap;
+        else if (suffix == "hold")
+            hotkey.trigger = Trigger::Hold;
+        else
+        {
+            error = "unknown trigger ':" + suffix + "' (expected :tap or :hold)";
+            return false;
+        }
+        body = trim(body.substr(0, colon));
+    }
+
+    for (const std::string &step : split(body, '>'))
+    {
+        std::vector<int> chord;
+        for (const std::string &token : split(step, '+'))
+        {
+            int vkCode = 0;
+            if (!parseKey(token, vkCode, error))
+                return false;
+            if (std::find(chord.begin(), chord.end(), vkCode) == chord.end())
+                chord.push_back(vkCode);
+        }
+        hotkey.steps.push_back(std::move(chord));
+    }
+
+    out = std::move(hotkey);
+    return true;
+}
+
+std::string Hotkey::toString() const
+{
+    std::string text;
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        if (i > 0)
+            text += ">";
+        for (size_t j = 0; j < steps[i].size(); ++j)
+        {
+            if (j > 0)
+                text += "+";
+            text += keyName(steps[i][j]);
+        }
+    }
+    if (trigger == Trigger::Tap)
+        text += ":tap";
+    else if (trigger == Trigger::Hold)
+        text += ":hold";
+    return text;
+}
+
+std::string formatHotkeyList(const HotkeyList &hotkeys)
+{
+    if (hotkeys.empty())
+        return "(None)";
+
+    std::string text;
+    for (size_t i = 0; i < hotkeys.size(); ++i)
+    {
+        if (i > 0)
+            text += ", ";
+        text += hotkeys[i].toString();
+    }
+    return text;
+}
+
+HotkeyEngine::HotkeyEngine()
+    : m_bindingsByKey(InputService::KEY_COUNT),
+      m_scheduledDeadline(-1.0)
+{
+}
+
+void HotkeyEngine::add(ActionId action, const HotkeyList &hotkeys)
+{
+    addBindings(action, hotkeys, false);
+}
+
+void HotkeyEngine::addHeld(ActionId action, const HotkeyList &hotkeys)
+{
+    addBindings(action, hotkeys, true);
+}
+
+void HotkeyEngine::addBindings(ActionId action, const HotkeyList &hotkeys, bool heldOnly)
+{
+    for (const Hotkey &hotkey : hotkeys)
+    {
+        Binding binding{action, hotkey.trigger, {}, {}, 0, 0.0, 0.0, false, false};
+        KeyState modifiers;
+        for (const std::vector<int> &keys : hotkey.steps)
+        {
+            Chord chord;
+            for (int vk : keys)
+            {
+                if (vk <= 0 || vk >= InputService::KEY_COUNT)
+                    continue;
+                chord.keys.set(static_cast<size_t>(vk));
+                const int family = modifierFamily(vk);
+                if (family)
+                    chord.modifiers.set(static_cast<size_t>(family));
+            }
+            if (chord.keys.none())
+                continue;
+            binding.keys |= chord.keys;
+            modifiers |= chord.modifiers;
+            binding.steps.push_back(chord);
+        }
+        if (binding.steps.empty())
+            continue;
+
+        m_keys |= binding.keys;
+        if (!heldOnly)
+        {
+            m_modifierMask |= modifiers;
+            const uint32_t index = static_cast<uint32_t>(m_bindings.size());
+            for (int vk = 1; vk < InputService::KEY_COUNT; ++vk)
+            {
+                if (binding.keys.test(static_cast<size_t>(vk)))
+                    m_bindingsByKey[static_cast<size_t>(vk)].push_back(index);
+            }
+        }
+        m_bindings.push_back(std::move(binding));
+    }
+}
+
+std::vector<int> HotkeyEngine::keys() const
+{
+    std::vector<int> keys;
+    for (int vk = 1; vk < InputService::KEY_COUNT; ++vk)
+    {
+        if (m_keys.test(static_cast<size_t>(vk)))
+            keys.push_back(vk);
+    }
+
+    // Modifier state is derived from both sides, and exact matching needs every modifier used
+    for (int generic : {VK_CODE_SHIFT, VK_CODE_CONTROL, VK_CODE_MENU})
+    {
+        if (!m_modifierMask.test(static_cast<size_t>(generic)))
+            continue;
+        const int left = leftKeyFor(generic);
+        for (int vk : {generic, left, left + 1})
+        {
+            if (!m_keys.test(static_cast<size_t>(vk)))
+                keys.push_back(vk);
+        }
+    }
+    return keys;
+}
+
+bool HotkeyEngine::matches(const Chord &chord, const KeyState &state, bool exactModifiers) const
+{
+    if ((state & chord.keys) != chord.keys)
+        return false;
+    return !exactModifiers || (state & m_modifierMask) == chord.modifiers;
+}
+
+void HotkeyEngine::advance(Binding &binding, const KeyEvent &event, const KeyState &state, std::vector<ActionId> &fired) const
+{
+    const size_t bit = static_cast<size_t>(event.vkCode);
+    const KeyState &lastChord = binding.steps.back().keys;
+
+    if (!event.down)
+    {
+        // Releasing part of the last chord ends a tap or a hold
+        if (binding.armed && lastChord.test(bit))
+        {
+            const double heldMs = (event.timestamp - binding.pressTime) * 1000.0;
+            if (binding.trigger == Hotkey::Trigger::Tap && heldMs <= Constants::HOTKEY_TAP_MAX_MS)
+                fired.push_back(binding.action);
+            binding.armed = false;
+        }
+        return;
+    }
+
+    // Another key during a tap makes it a chord with something else
+    if (binding.armed && binding.trigger == Hotkey::Trigger::Tap && !lastChord.test(bit))
+        binding.armed = false;
+
+    if (binding.step > 0 && event.timestamp > binding.stepDeadline)
+        binding.step = 0;
+
+    const Chord *chord = &binding.steps[binding.step];
+    if (!chord->keys.test(bit))
+    {
+        // A wrong key (modifiers excepted) breaks a sequence; it may start it again
+        if (binding.step == 0 || modifierFamily(event.vkCode))
+            return;
+        binding.step = 0;
+        chord = &binding.steps[0];
+        if (!chord->keys.test(bit))
+            return;
+    }
+
+    if (!matches(*chord, state, true))
+        return;
+
+    if (binding.step + 1 < binding.steps.size())
+    {
+        ++binding.step;
+        binding.stepDeadline = event.timestamp + Constants::HOTKEY_SEQUENCE_TIMEOUT_MS / 1000.0;
+        return;
+    }
+
+    binding.step = 0;
+    if (binding.trigger == Hotkey::Trigger::Press)
+    {
+        fired.push_back(binding.action);
+        return;
+    }
+    binding.armed = true;
+    binding.holdFired = false;
+    binding.pressTime = event.timestamp;
+}
+
+bool HotkeyEngine::isInterruptible(const Binding &binding)
+{
+    return binding.step > 0 || (binding.armed && binding.trigger == Hotkey::Trigger::Tap);
+}
+
+void HotkeyEngine::onKeyEvent(const KeyEvent &event, const KeyState &state, std::vector<ActionId> &fired)
+{
+    if (event.vkCode <= 0 || event.vkCode >= InputService::KEY_COUNT)
+        return;
+    const size_t bit = static_cast<size_t>(event.vkCode);
+    const std::vector<uint32_t> &users = m_bindingsByKey[bit];
+
+    // A binding that does not use the key can only be broken by it (a press during a
+    // sequence or a tap); only keys this engine binds reach it at all
+    m_interruptibleScratch.clear();
+    for (uint32_t index : m_interruptible)
+    {
+        Binding &binding = m_bindings[index];
+        if (binding.keys.test(bit))
+            continue; // Handled with the key's users below
+        if (event.down)
+            advance(binding, event, state, fired);
+        if (isInterruptible(binding))
+            m_interruptibleScratch.push_back(index);
+    }
+
+    for (uint32_t index : users)
+    {
+        Binding &binding = m_bindings[index];
+        advance(binding, event, state, fired);
+        if (isInterruptible(binding))
+            m_interruptibleScratch.push_back(index);
+    }
+    m_interruptible.swap(m_interruptibleScratch);
+}
+
+void HotkeyEngine::onTime(double now, std::vector<ActionId> &fired)
+{
+    const double holdSeconds = Constants::HOTKEY_HOLD_MS / 1000.0;
+    for (Binding &binding : m_bindings)
+    {
+        if (binding.trigger == Hotkey::Trigger::Hold && binding.armed && !binding.holdFired &&
+            now >= binding.pressTime + holdSeconds)
+        {
+            binding.holdFired = true;
+            fired.push_back(binding.action);
+        }
+    }
+}
+
+double HotkeyEngine::nextDeadline() const
+{
+    const double holdSeconds = Constants::HOTKEY_HOLD_MS / 1000.0;
+    double deadline = -1.0;
+    for (const Binding &binding : m_bindings)
+    {
+        if (binding.trigger == Hotkey::Trigger::Hold && binding.armed && !binding.holdFired)
+        {
+            const double due = binding.pressTime + holdSeconds;
+            if (deadline < 0.0 || due < deadline)
+                deadline = due;
+        }
+    }
+    return deadline;
+}
+
+bool HotkeyEngine::isHeld(ActionId action, const KeyState &state) const
+{
+    return std::any_of(m_bindings.begin(), m_bindings.end(), [&](const Binding &binding)
+                       { return binding.action == action && matches(binding.steps.back(), state, false); });
+}
+
+void HotkeyEngine::bind(ActionHandler handler, std::function<void(const KeyEvent &)> onEvent)
+{
+    if (m_bindings.empty())
+        return;
+
+    InputService::getInstance().bindKeys(keys(), [this, handler, onEvent](const KeyEvent &event)
+                                         {
+        m_fired.clear();
+        onKeyEvent(event, InputService::getInstance().keyState(), m_fired);
+        for (ActionId action : m_fired)
+            handler(action, event.vkCode);
+        if (onEvent)
+            onEvent(event);
+        scheduleHoldCheck(handler); });
+}
+
+void HotkeyEngine::scheduleHoldCheck(const ActionHandler &handler)
+{
+    const double deadline = nextDeadline();
+    // A check that is already pending reschedules itself for later deadlines
+    if (deadline < 0.0 || (m_scheduledDeadline >= 0.0 && deadline >= m_scheduledDeadline))
+        return;
+
+    m_scheduledDeadline = deadline;
+    InputService &input = InputService::getInstance();
+    const double delayMs = std::max(0.0, std::ceil((deadline - input.nowSeconds()) * 1000.0));
+    input.post([this, handler]
+               {
+        m_scheduledDeadline = -1.0;
+        m_fired.clear();
+        onTime(InputService::getInstance().nowSeconds(), m_fired);
+        for (ActionId action : m_fired)
+            handler(action, 0);
+        scheduleHoldCheck(handler); },
+               std::chrono::milliseconds(static_cast<long long>(delayMs) + 1));
+}
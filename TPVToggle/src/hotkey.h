@@ -0,0 +1,154 @@
+/**
+ * @file hotkey.h
+ * @brief Hotkey expressions (modifiers, chords, tap/hold, sequences) and the engine matching them.
+ *
+ * INI key settings hold a comma-separated list of alternatives. Each one is:
+ * - a key: a hex VK code ("0x61" or "61") or a modifier name (Ctrl, Shift,
+ *   Alt, or LCtrl, RCtrl, LShift, RShift, LAlt, RAlt)
+ * - a chord of keys joined with '+': "Ctrl+0x61", "0x41+0x42"
+ * - a sequence of chords joined with '>': "0x47>0x47" (G twice)
+ * - optionally followed by ":tap" (released quickly) or ":hold" (held for a while)
+ *
+ * Bindings are compiled into 256-bit key masks, so matching an event is a few
+ * word-wide AND/compare operations per binding, whatever the number of keys.
+ * An event is only matched against the bindings that use its key, plus those
+ * any press can interrupt (a sequence in progress, a tap waiting for release).
+ */
+#ifndef HOTKEY_H
+#define HOTKEY_H
+
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct KeyEvent;
+
+/** @brief One bit per VK code (the layout of InputService::keyState()). */
+using KeyState = std::bitset<256>;
+
+/**
+ * @struct Hotkey
+ * @brief A parsed hotkey expression.
+ */
+struct Hotkey
+{
+    enum class Trigger : uint8_t
+    {
+        Press, // Fires when the last chord is completed
+        Tap,   // Fires when the last chord is released within HOTKEY_TAP_MAX_MS
+        Hold   // Fires once the last chord has been held for HOTKEY_HOLD_MS
+    };
+
+    std::vector<std::vector<int>> steps; // Chords in sequence order; each chord lists its VK codes
+    Trigger trigger = Trigger::Press;
+
+    /**
+     * @brief Parses one expression (no commas).
+     * @param error Set to a description of the problem on failure.
+     * @return false if the expression is invalid.
+     */
+    static bool parse(const std::string &expression, Hotkey &out, std::string &error);
+
+    /** @brief Canonical text, e.g. "Ctrl+0x61:hold". */
+    std::string toString() const;
+};
+
+using HotkeyList = std::vector<Hotkey>;
+
+/** @brief Formats alternatives like format_vkcode_list ("(None)" if empty). */
+std::string formatHotkeyList(const HotkeyList &hotkeys);
+
+/**
+ * @class HotkeyEngine
+ * @brief Matches key events against compiled hotkey bindings. Input thread only.
+ *
+ * Bindings fire only when their modifiers match exactly (among the modifiers
+ * this engine's bindings use), so Ctrl+Numpad1 and Numpad1 can be bound to
+ * different actions. isHeld() ignores extra modifiers. Modifiers of held-only
+ * bindings (addHeld) take no part in exact matching, so holding one of them
+ * does not block the other hotkeys.
+ */
+class HotkeyEngine
+{
+public:
+    using ActionId = uint32_t;
+    using ActionHandler = std::function<void(ActionId action, int vkCode)>; // vkCode is 0 for hold timeouts
+
+    HotkeyEngine();
+
+    /** @brief Adds the alternatives of one action. Call before bind(). */
+    void add(ActionId action, const HotkeyList &hotkeys);
+
+    /**
+     * @brief Adds alternatives that are only queried with isHeld() and never fire.
+     * @details Their modifiers are not part of exact matching: a precision key on
+     *          Ctrl leaves the plain hotkeys working while it is held.
+     */
+    void addHeld(ActionId action, const HotkeyList &hotkeys);
+
+    /**
+     * @brief Binds every key used by the bindings on the InputService.
+     * @details Fired actions are passed to handler on the input thread, as is every
+     *          key event afterwards (onEvent may be empty). Call before InputService::start().
+     */
+    void bind(ActionHandler handler, std::function<void(const KeyEvent &)> onEvent = nullptr);
+
+    /**
+     * @brief Feeds one transition; actions it completes are appended to fired.
+     * @param state Key state after the transition.
+     */
+    void onKeyEvent(const KeyEvent &event, const KeyState &state, std::vector<ActionId> &fired);
+
+    /** @brief Fires hold bindings whose time has come. */
+    void onTime(double now, std::vector<ActionId> &fired);
+
+    /** @brief Earliest pending hold time (InputService::nowSeconds()), or a negative value if none. */
+    double nextDeadline() const;
+
+    /** @brief True if the last chord of any binding of action is down (extra keys allowed). */
+    bool isHeld(ActionId action, const KeyState &state) const;
+
+    /** @brief VK codes used by the bindings, with both sides of every modifier. */
+    std::vector<int> keys() const;
+
+    size_t size() const { return m_bindings.size(); }
+
+private:
+    struct Chord
+    {
+        KeyState keys;
+        KeyState modifiers; // Generic modifier bits implied by keys
+    };
+
+    struct Binding
+    {
+        ActionId action;
+        Hotkey::Trigger trigger;
+        std::vector<Chord> steps;
+        KeyState keys;       // Every key of every chord
+        size_t step;         // Next chord of a sequence
+        double stepDeadline; // Sequence times out after this
+        double pressTime;    // When the last chord was completed
+        bool armed;          // Last chord down, waiting for release (tap) or time (hold)
+        bool holdFired;
+    };
+
+    void addBindings(ActionId action, const HotkeyList &hotkeys, bool heldOnly);
+    bool matches(const Chord &chord, const KeyState &state, bool exactModifiers) const;
+    void advance(Binding &binding, const KeyEvent &event, const KeyState &state, std::vector<ActionId> &fired) const;
+    static bool isInterruptible(const Binding &binding);
+    void scheduleHoldCheck(const ActionHandler &handler);
+
+    std::vector<Binding> m_bindings;
+    std::vector<std::vector<uint32_t>> m_bindingsByKey; // Per VK code: bindings that fire and use the key
+    std::vector<uint32_t> m_interruptible;              // Bindings any key press can affect (isInterruptible)
+    std::vector<uint32_t> m_interruptibleScratch;
+    KeyState m_keys;               // Every key any binding uses
+    KeyState m_modifierMask;       // Generic modifiers any binding that fires uses
+    double m_scheduledDeadline;    // Hold deadline a check is already posted for (negative if none)
+    std::vector<ActionId> m_fired; // Scratch
+};
+
+#endif // HOTKEY_H
@@ -0,0 +1,260 @@
+/**
+ * @file input_recording.cpp
+ * @brief Implementation of input recording and replay.
+ */
+
+#include "input_recording.h"
+#include "input_service.h"
+#include "toggle_thread.h"
+#include "frame_clock.h"
+#include "constants.h"
+#include "logger.h"
+#include "utils.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    constexpr char RECORDING_MAGIC[4] = {'T', 'P', 'V', 'R'};
+    constexpr uint32_t RECORDING_VERSION = 1;
+    constexpr size_t HEADER_SIZE = 16; // Magic, version, record size, reserved
+    constexpr size_t RECORD_SIZE = 8;  // Delta (us), type, VK code, padding
+
+    void putU32(unsigned char *out, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+
+    uint32_t getU32(const unsigned char *in)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+            value |= static_cast<uint32_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    const char *typeName(InputRecord::Type type)
+    {
+        switch (type)
+        {
+        case InputRecord::Type::KeyDown:
+            return "KeyDown";
+        case InputRecord::Type::KeyUp:
+            return "KeyUp";
+        case InputRecord::Type::OverlayHidden:
+            return "OverlayHidden";
+        case InputRecord::Type::OverlayShown:
+            return "OverlayShown";
+        case InputRecord::Type::MenuOpened:
+            return "MenuOpened";
+        case InputRecord::Type::MenuClosed:
+            return "MenuClosed";
+        default:
+            return "Wait";
+        }
+    }
+}
+
+// --- InputRecorder ---
+
+InputRecorder &InputRecorder::getInstance()
+{
+    static InputRecorder instance;
+    return instance;
+}
+
+InputRecorder::InputRecorder() : m_recording(false), m_lastTime(-1.0), m_count(0)
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+    stop();
+}
+
+bool InputRecorder::start(const std::string &path)
+{
+    stop();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+    {
+        Logger::getInstance().log(LOG_ERROR, "InputRecorder: Cannot create " + path);
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE] = {0};
+    std::memcpy(header, RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    putU32(header + 4, RECORDING_VERSION);
+    putU32(header + 8, static_cast<uint32_t>(RECORD_SIZE));
+    m_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+    m_lastTime = -1.0;
+    m_count = 0;
+    m_recording.store(true);
+    Logger::getInstance().log(LOG_INFO, "InputRecorder: Recording input to " + path);
+    return true;
+}
+
+void InputRecorder::stop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_recording.exchange(false))
+        return;
+
+    m_file.close();
+    Logger::getInstance().log(LOG_INFO, "InputRecorder: Recorded " + std::to_string(m_count) + " events");
+}
+
+void InputRecorder::recordKey(const KeyEvent &event)
+{
+    if (isRecording())
+        write(event.down ? InputRecord::Type::KeyDown : InputRecord::Type::KeyUp, event.vkCode, event.timestamp);
+}
+
+void InputRecorder::recordEvent(InputRecord::Type type)
+{
+    if (isRecording())
+        write(type, 0, FrameClock::platformSeconds());
+}
+
+void InputRecorder::write(InputRecord::Type type, int vkCode, double timestamp)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_recording.load(std::memory_order_relaxed))
+        return;
+
+    // Keys are stamped on the hook thread and UI events on the game thread, so a
+    // record can be slightly older than the one before it; the file keeps arrival order
+    double delta = 0.0;
+    if (m_lastTime >= 0.0 && timestamp > m_lastTime)
+        delta = timestamp - m_lastTime;
+    if (m_lastTime < 0.0 || timestamp > m_lastTime)
+        m_lastTime = timestamp;
+
+    uint64_t micros = static_cast<uint64_t>(std::llround(delta * 1e6));
+    unsigned char record[RECORD_SIZE] = {0};
+    while (micros > std::numeric_limits<uint32_t>::max())
+    {
+        putU32(record, std::numeric_limits<uint32_t>::max());
+        record[4] = static_cast<unsigned char>(InputRecord::Type::Wait);
+        m_file.write(reinterpret_cast<const char *>(record), sizeof(record));
+        micros -= std::numeric_limits<uint32_t>::max();
+    }
+
+    putU32(record, static_cast<uint32_t>(micros));
+    record[4] = static_cast<unsigned char>(type);
+    record[5] = static_cast<unsigned char>(vkCode);
+    m_file.write(reinterpret_cast<const char *>(record), sizeof(record));
+    ++m_count;
+
+    if (!m_file)
+    {
+        m_recording.store(false);
+        Logger::getInstance().log(LOG_ERROR, "InputRecorder: Write failed, recording stopped");
+    }
+}
+
+// --- Loading ---
+
+bool loadInputRecording(const std::string &path, std::vector<InputRecord> &out, std::string &error)
+{
+    out.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE];
+    if (!file.read(reinterpret_cast<char *>(header), sizeof(header)) ||
+        std::memcmp(header, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0)
+    {
+        error = "not an input recording";
+        return false;
+    }
+    if (getU32(header + 4) != RECORDING_VERSION || getU32(header + 8) != RECORD_SIZE)
+    {
+        error = "unsupported recording version " + std::to_string(getU32(header + 4));
+        return false;
+    }
+
+    uint64_t micros = 0;
+    unsigned char record[RECORD_SIZE];
+    while (file.read(reinterpret_cast<char *>(record), sizeof(record)))
+    {
+        micros += getU32(record);
+        if (record[4] > static_cast<unsigned char>(InputRecord::Type::Wait))
+        {
+            error = "unknown record type " + std::to_string(record[4]) + " at event " + std::to_string(out.size());
+            return false;
+        }
+
+        const InputRecord::Type type = static_cast<InputRecord::Type>(record[4]);
+        if (type != InputRecord::Type::Wait)
+            out.push_back({type, record[5], static_cast<double>(micros) / 1e6});
+    }
+    if (file.gcount() != 0)
+    {
+        error = "truncated record at event " + std::to_string(out.size());
+        return false;
+    }
+    return true;
+}
+
+// --- InputReplay ---
+
+double InputReplay::run()
+{
+    using Clock = InputService::Clock;
+    Logger &logger = Logger::getInstance();
+    InputService &input = InputService::getInstance();
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    const Clock::time_point start = Clock::now();
+    auto at = [start](double seconds)
+    {
+        return start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    };
+
+    input.beginReplay(start);
+    for (const InputRecord &record : m_records)
+    {
+        input.advanceReplay(at(record.time));
+        logger.log(LOG_TRACE, "InputReplay: " + std::string(typeName(record.type)) +
+                                  (record.vkCode ? " " + format_vkcode(record.vkCode) : std::string()));
+
+        switch (record.type)
+        {
+        case InputRecord::Type::KeyDown:
+        case InputRecord::Type::KeyUp:
+            input.injectKeyEvent(record.vkCode, record.type == InputRecord::Type::KeyDown);
+            break;
+        case InputRecord::Type::OverlayHidden:
+            handleOverlayHidden();
+            break;
+        case InputRecord::Type::OverlayShown:
+            handleOverlayShown();
+            break;
+        default:
+            // Menu state only gates the game's camera input hook, which is not replayed
+            break;
+        }
+    }
+
+    // Let hold checks, restore delays and queued commands run out
+    input.advanceReplay(at(duration() + Constants::INPUT_REPLAY_SETTLE_MS / 1000.0));
+    input.endReplay();
+
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    logger.log(LOG_INFO, "InputReplay: Replayed " + std::to_string(m_records.size()) + " events (" +
+                             std::to_string(duration()) + " s recorded) in " + std::to_string(wallSeconds * 1000.0) + " ms");
+    return wallSeconds;
+}
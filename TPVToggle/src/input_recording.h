@@ -0,0 +1,131 @@
+/**
+ * @file input_recording.h
+ * @brief Recording and deterministic replay of key and UI events.
+ *
+ * With RecordInput enabled, every key transition the InputService captures
+ * and every overlay/menu hook call is written to KCD2_TPVToggle_Input.rec
+ * with its monotonic timestamp. The file is a 16-byte header followed by
+ * 8-byte records: microseconds since the previous record (uint32), the
+ * record type, the VK code and two bytes of padding, all little-endian.
+ *
+ * InputReplay feeds a recording back through the same code: key transitions
+ * go into the bound InputService handlers and overlay events into the
+ * overlay handlers, against a virtual clock (see InputService::beginReplay).
+ * Waits are skipped rather than slept, so a replay runs as fast as the
+ * handlers do while hold, tap and restore delays behave as recorded. The
+ * game state the handlers touch (view flag, offsets) is whatever
+ * game_interface provides; tpvtoggle_replay (tests/replay_main.cpp) links
+ * the simulated game from tests/sim_game.cpp.
+ */
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct KeyEvent;
+
+/**
+ * @struct InputRecord
+ * @brief One recorded event.
+ */
+struct InputRecord
+{
+    enum class Type : uint8_t
+    {
+        KeyDown,
+        KeyUp,
+        OverlayHidden, // A UI element opened (HideOverlays)
+        OverlayShown,  // The UI element closed again (ShowOverlays)
+        MenuOpened,
+        MenuClosed,
+        Wait // Only carries time, for gaps too long for one record
+    };
+
+    Type type;
+    uint8_t vkCode; // Key records only
+    double time;    // Seconds since the recording started
+};
+
+/**
+ * @class InputRecorder
+ * @brief Appends events to a recording file while recording is on.
+ *
+ * record() may be called from any thread; events are written in the order
+ * the calls arrive.
+ */
+class InputRecorder
+{
+public:
+    static InputRecorder &getInstance();
+
+    /** @brief Starts a new recording at path (overwriting it). */
+    bool start(const std::string &path);
+
+    /** @brief Finishes and closes the recording. */
+    void stop();
+
+    bool isRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+    /** @brief Records a key transition (InputService event observer). */
+    void recordKey(const KeyEvent &event);
+
+    /** @brief Records a UI event at the current time. */
+    void recordEvent(InputRecord::Type type);
+
+private:
+    InputRecorder();
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder &) = delete;
+    InputRecorder &operator=(const InputRecorder &) = delete;
+
+    void write(InputRecord::Type type, int vkCode, double timestamp);
+
+    std::mutex m_mutex;
+    std::ofstream m_file;
+    std::atomic<bool> m_recording;
+    double m_lastTime; // Timestamp of the previous record, or < 0 before the first
+    uint64_t m_count;
+};
+
+/**
+ * @brief Reads a recording file.
+ * @param out Receives the events (Wait records are folded into the times).
+ * @param error Receives a description if the file cannot be read.
+ * @return true on success.
+ */
+bool loadInputRecording(const std::string &path, std::vector<InputRecord> &out, std::string &error);
+
+/**
+ * @class InputReplay
+ * @brief Plays a recording through the InputService handlers with a virtual clock.
+ *
+ * Bind the actions (registerToggleActions, registerCameraProfileActions)
+ * before run(); the InputService must not be needed for live input meanwhile.
+ */
+class InputReplay
+{
+public:
+    explicit InputReplay(std::vector<InputRecord> records) : m_records(std::move(records)) {}
+
+    /**
+     * @brief Replays every record, then lets pending delays run out.
+     * @return Wall-clock seconds the replay took.
+     */
+    double run();
+
+    /** @brief Recorded length in seconds. */
+    double duration() const { return m_records.empty() ? 0.0 : m_records.back().time; }
+
+    size_t size() const { return m_records.size(); }
+
+private:
+    std::vector<InputRecord> m_records;
+};
+
+#endif // INPUT_RECORDING_H
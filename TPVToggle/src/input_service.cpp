@@ -0,0 +1,810 @@
+/**
+ * @file input_service.cpp
+ * @brief Implementation of InputService (low-level hooks / simulated input).
+ */
+
+#include "input_service.h"
+#include "frame_clock.h"
+#include "constants.h"
+#include "logger.h"
+#include "utils.h"
+
+#include <algorithm>
+
+namespace
+{
+    // VK codes used without <windows.h> so the simulated path builds everywhere
+    constexpr int VK_CODE_LBUTTON = 0x01;
+    constexpr int VK_CODE_RBUTTON = 0x02;
+    constexpr int VK_CODE_MBUTTON = 0x04;
+    constexpr int VK_CODE_XBUTTON1 = 0x05;
+    constexpr int VK_CODE_XBUTTON2 = 0x06;
+    constexpr int VK_CODE_SHIFT = 0x10;
+    constexpr int VK_CODE_CONTROL = 0x11;
+    constexpr int VK_CODE_MENU = 0x12;
+    constexpr int VK_CODE_LSHIFT = 0xA0;
+    constexpr int VK_CODE_RSHIFT = 0xA1;
+    constexpr int VK_CODE_LCONTROL = 0xA2;
+    constexpr int VK_CODE_RCONTROL = 0xA3;
+    constexpr int VK_CODE_LMENU = 0xA4;
+    constexpr int VK_CODE_RMENU = 0xA5;
+
+    // Hooks report left/right modifiers; GetAsyncKeyState-style bindings also use the generic code
+    int genericKeyFor(int vkCode)
+    {
+        switch (vkCode)
+        {
+        case VK_CODE_LSHIFT:
+        case VK_CODE_RSHIFT:
+            return VK_CODE_SHIFT;
+        case VK_CODE_LCONTROL:
+        case VK_CODE_RCONTROL:
+            return VK_CODE_CONTROL;
+        case VK_CODE_LMENU:
+        case VK_CODE_RMENU:
+            return VK_CODE_MENU;
+        default:
+            return 0;
+        }
+    }
+
+    // Left/right code for a generic modifier (right = left + 1), or 0
+    int leftKeyFor(int vkCode)
+    {
+        switch (vkCode)
+        {
+        case VK_CODE_SHIFT:
+            return VK_CODE_LSHIFT;
+        case VK_CODE_CONTROL:
+            return VK_CODE_LCONTROL;
+        case VK_CODE_MENU:
+            return VK_CODE_LMENU;
+        default:
+            return 0;
+        }
+    }
+
+#ifdef _WIN32
+    bool isMouseButton(int vkCode)
+    {
+        return vkCode == VK_CODE_LBUTTON || vkCode == VK_CODE_RBUTTON || vkCode == VK_CODE_MBUTTON ||
+               vkCode == VK_CODE_XBUTTON1 || vkCode == VK_CODE_XBUTTON2;
+    }
+
+    // Posted to the hook thread: release keys whose key-up the hook missed
+    constexpr UINT WM_RECONCILE_KEYS = WM_APP + 1;
+#endif
+
+    template <typename Callable>
+    void runGuarded(const char *what, Callable &&callable)
+    {
+        try
+        {
+            callable();
+        }
+        catch (const std::exception &e)
+        {
+            Logger::getInstance().log(LOG_ERROR, std::string("InputService: Exception in ") + what + ": " + e.what());
+        }
+        catch (...)
+        {
+            Logger::getInstance().log(LOG_ERROR, std::string("InputService: Unknown exception in ") + what);
+        }
+    }
+}
+
+InputService &InputService::getInstance()
+{
+    static InputService instance;
+    return instance;
+}
+
+InputService::InputService()
+    : m_scheduledTasks(std::chrono::milliseconds(Constants::INPUT_TIMER_TICK_MS)),
+      m_polling(false),
+      m_pollScheduler(std::chrono::milliseconds(Constants::INPUT_FALLBACK_POLL_MS),
+                      std::chrono::milliseconds(Constants::INPUT_IDLE_POLL_MS),
+                      std::chrono::milliseconds(Constants::INPUT_IDLE_AFTER_MS)),
+      m_pollIdle(false),
+      m_metricWindowWakeups(0),
+      m_stopRequested(false),
+      m_running(false),
+      m_wakeups(0),
+      m_replaying(false),
+      m_virtualNow(0)
+#ifdef _WIN32
+      ,
+      m_wakeEvent(NULL),
+      m_hookThreadId(0),
+      m_keyboardHook(NULL),
+      m_mouseHook(NULL),
+      m_foregroundHook(NULL),
+      m_hookKeyDown{},
+      m_hookWatchdog(Constants::INPUT_HOOK_LOST_CHECKS)
+#endif
+{
+}
+
+InputService::~InputService()
+{
+    stop();
+}
+
+void InputService::bindKeys(const std::vector<int> &keys, KeyHandler handler)
+{
+    Binding binding;
+    for (int vk : keys)
+    {
+        if (vk > 0 && vk < KEY_COUNT)
+            binding.keys.set(static_cast<size_t>(vk));
+    }
+    if (binding.keys.none())
+        return;
+
+    m_boundKeys |= binding.keys;
+    binding.handler = std::move(handler);
+    m_bindings.push_back(std::move(binding));
+}
+
+void InputService::addPollBoost(std::function<bool()> isActive)
+{
+    m_pollBoosts.push_back(std::move(isActive));
+}
+
+void InputService::clearBindings()
+{
+    m_bindings.clear();
+    m_tickers.clear();
+    m_pollBoosts.clear();
+    m_boundKeys.reset();
+}
+
+void InputService::addTicker(std::chrono::milliseconds interval, std::function<bool()> isActive, Task tick)
+{
+    m_tickers.push_back({interval, std::move(isActive), std::move(tick), false, Clock::time_point()});
+}
+
+bool InputService::start()
+{
+    stop();
+    prepare();
+
+    if (!startPlatform())
+    {
+        stopPlatform();
+        return false;
+    }
+
+    m_running = true;
+    m_thread = std::thread(&InputService::run, this);
+    Logger::getInstance().log(LOG_INFO, "InputService: Started with " + std::to_string(m_boundKeys.count()) + " bound keys (" +
+                                            (m_polling ? "polling" : "event-driven") + ")");
+    return true;
+}
+
+void InputService::prepare()
+{
+    // Generic modifiers are derived from their left/right events, so those must be captured too.
+    // Polling samples only the sides; the generic state follows from them.
+    m_captureKeys = m_boundKeys;
+    m_pollKeys = m_boundKeys;
+    for (int vk = 0; vk < KEY_COUNT; ++vk)
+    {
+        const int left = leftKeyFor(vk);
+        if (left && m_boundKeys.test(static_cast<size_t>(vk)))
+        {
+            m_captureKeys.set(static_cast<size_t>(left));
+            m_captureKeys.set(static_cast<size_t>(left + 1));
+            m_pollKeys.set(static_cast<size_t>(left));
+            m_pollKeys.set(static_cast<size_t>(left + 1));
+            m_pollKeys.reset(static_cast<size_t>(vk));
+        }
+    }
+
+    m_keyDown.reset();
+    m_stopRequested = false;
+    m_wakeups.store(0, std::memory_order_relaxed);
+    m_startTime = now();
+    m_scheduledTasks.reset(m_startTime);
+    m_metricWindowStart = m_startTime;
+    m_metricWindowWakeups = 0;
+    m_pollScheduler.reset(m_startTime);
+    m_pollIdle = false;
+}
+
+void InputService::stop()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            m_stopRequested = true;
+        }
+        wake();
+        m_thread.join();
+        const auto minutes = std::chrono::duration<double, std::ratio<60>>(Clock::now() - m_startTime).count();
+        const uint64_t wakeups = getWakeupCount();
+        Logger::getInstance().log(LOG_DEBUG, "InputService: Stopped after " + std::to_string(wakeups) + " wakeups (" +
+                                                 std::to_string(minutes > 0.0 ? static_cast<uint64_t>(wakeups / minutes) : wakeups) + "/min)");
+    }
+    m_running = false;
+    stopPlatform();
+}
+
+void InputService::beginReplay(Clock::time_point start)
+{
+    stop();
+    m_virtualNow.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+    m_replaying.store(true);
+    prepare();
+    m_polling = false;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingEvents.clear();
+        m_pendingTasks.clear();
+    }
+}
+
+void InputService::advanceReplay(Clock::time_point time)
+{
+    for (;;)
+    {
+        processPending();
+        const Clock::time_point next = runTimers();
+        if (hasPending())
+            continue; // A handler or task queued more work for the current time
+        if (next > time)
+            break;
+        // runTimers() only returns times after now, so the clock always moves forward
+        m_virtualNow.store(next.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+    if (time > now())
+        m_virtualNow.store(time.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void InputService::endReplay()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingEvents.clear();
+        m_pendingTasks.clear();
+    }
+    m_scheduledTasks.reset(Clock::now());
+    m_replaying.store(false);
+}
+
+InputService::Clock::time_point InputService::now() const
+{
+    if (m_replaying.load())
+        return Clock::time_point(Clock::duration(m_virtualNow.load(std::memory_order_relaxed)));
+    return Clock::now();
+}
+
+double InputService::nowSeconds() const
+{
+    if (m_replaying.load())
+        return std::chrono::duration<double>(now().time_since_epoch()).count();
+    return FrameClock::platformSeconds();
+}
+
+void InputService::post(Task task, std::chrono::milliseconds delay)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingTasks.push_back({now() + delay, std::move(task)});
+    }
+    wake();
+}
+
+void InputService::injectKeyEvent(int vkCode, bool down)
+{
+    enqueue({vkCode, down, nowSeconds()});
+}
+
+void InputService::enqueue(const KeyEvent &event)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingEvents.push_back(event);
+    }
+    wake();
+}
+
+bool InputService::isKeyDown(int vkCode) const
+{
+    return vkCode > 0 && vkCode < KEY_COUNT && m_keyDown.test(static_cast<size_t>(vkCode));
+}
+
+bool InputService::isAnyKeyDown(const std::vector<int> &keys) const
+{
+    return std::any_of(keys.begin(), keys.end(), [this](int vk)
+                       { return isKeyDown(vk); });
+}
+
+void InputService::run()
+{
+    for (;;)
+    {
+        Clock::time_point next = runTimers();
+        if (m_polling)
+            next = std::min(next, Clock::now() + pollInterval());
+#ifdef _WIN32
+        else if (m_hookThread.joinable())
+            next = std::min(next, m_nextHookCheck);
+#endif
+
+#ifdef _WIN32
+        DWORD timeout = INFINITE;
+        if (next != Clock::time_point::max())
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(next - Clock::now()).count();
+            timeout = static_cast<DWORD>(std::max<long long>(0, remaining));
+        }
+        WaitForSingleObject(m_wakeEvent, timeout);
+#else
+        {
+            std::unique_lock<std::mutex> lock(m_pendingMutex);
+            auto ready = [this]
+            { return m_stopRequested || !m_pendingEvents.empty() || !m_pendingTasks.empty(); };
+            if (next == Clock::time_point::max())
+                m_wakeCondition.wait(lock, ready);
+            else
+                m_wakeCondition.wait_until(lock, next, ready);
+        }
+#endif
+        countWakeup();
+
+#ifdef _WIN32
+        if (!m_polling && m_hookThread.joinable() && Clock::now() >= m_nextHookCheck)
+            checkHook();
+#endif
+        if (m_polling)
+            pollBoundKeys();
+        if (!processPending())
+            break;
+    }
+}
+
+bool InputService::processPending()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        if (m_stopRequested)
+            return false;
+        m_eventScratch.swap(m_pendingEvents);
+        for (DelayedTask &task : m_pendingTasks)
+            m_scheduledTasks.schedule(task.due, std::move(task.task));
+        m_pendingTasks.clear();
+    }
+
+    for (const KeyEvent &event : m_eventScratch)
+        dispatch(event);
+    m_eventScratch.clear(); // Keeps its capacity for the next swap
+    return true;
+}
+
+bool InputService::hasPending()
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    return !m_pendingEvents.empty() || !m_pendingTasks.empty();
+}
+
+void InputService::dispatch(const KeyEvent &event)
+{
+    if (event.vkCode <= 0 || event.vkCode >= KEY_COUNT)
+        return;
+
+    const size_t bit = static_cast<size_t>(event.vkCode);
+    if (m_keyDown.test(bit) == event.down)
+        return; // Auto-repeat or a duplicate from another source
+    m_keyDown.set(bit, event.down);
+    if (m_eventObserver)
+        runGuarded("event observer", [&]
+                   { m_eventObserver(event); });
+    deliver(event);
+
+    const int generic = genericKeyFor(event.vkCode);
+    if (generic)
+    {
+        const int left = leftKeyFor(generic);
+        const bool down = m_keyDown.test(static_cast<size_t>(left)) || m_keyDown.test(static_cast<size_t>(left + 1));
+        if (down != m_keyDown.test(static_cast<size_t>(generic)))
+        {
+            m_keyDown.set(static_cast<size_t>(generic), down);
+            deliver({generic, down, event.timestamp});
+        }
+    }
+}
+
+void InputService::deliver(const KeyEvent &event)
+{
+    const size_t bit = static_cast<size_t>(event.vkCode);
+    for (const Binding &binding : m_bindings)
+    {
+        if (binding.keys.test(bit))
+            runGuarded("key handler", [&]
+                       { binding.handler(event); });
+    }
+}
+
+InputService::Clock::time_point InputService::runTimers()
+{
+    const Clock::time_point now = this->now();
+    m_scheduledTasks.advance(now, [](Task &task)
+                             { runGuarded("posted task", task); });
+    Clock::time_point next = m_scheduledTasks.nextDue();
+
+    for (Ticker &ticker : m_tickers)
+    {
+        if (!ticker.isActive())
+        {
+            ticker.active = false;
+            continue;
+        }
+        if (!ticker.active)
+        {
+            ticker.active = true;
+            ticker.next = now;
+        }
+        if (ticker.next <= now)
+        {
+            runGuarded("ticker", ticker.tick);
+            ticker.next += ticker.interval;
+            if (ticker.next <= now)
+                ticker.next = now + ticker.interval; // Fell behind: don't burst to catch up
+        }
+        next = std::min(next, ticker.next);
+    }
+
+    return next;
+}
+
+std::chrono::milliseconds InputService::pollInterval()
+{
+    const Clock::time_point now = this->now();
+    const bool boosted = std::any_of(m_pollBoosts.begin(), m_pollBoosts.end(), [](const std::function<bool()> &isActive)
+                                     { return isActive(); });
+    m_pollScheduler.setBoosted(boosted, now);
+
+    const std::chrono::milliseconds interval = m_pollScheduler.interval(now);
+    const bool idle = m_pollScheduler.isIdle(now);
+    if (idle != m_pollIdle)
+    {
+        m_pollIdle = idle;
+        Logger::getInstance().log(LOG_DEBUG, "InputService: Key polling " + std::string(idle ? "idle" : "active") +
+                                                 " (every " + std::to_string(interval.count()) + " ms)");
+    }
+    return interval;
+}
+
+void InputService::countWakeup()
+{
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    ++m_metricWindowWakeups;
+
+    const Clock::time_point now = Clock::now();
+    const auto elapsed = now - m_metricWindowStart;
+    if (elapsed < std::chrono::milliseconds(Constants::INPUT_WAKEUP_METRIC_WINDOW_MS))
+        return;
+
+    // Without hooks or a held key the thread sleeps, so a window may span much more than a minute
+    const double minutes = std::chrono::duration<double, std::ratio<60>>(elapsed).count();
+    Logger::getInstance().log(LOG_DEBUG, "InputService: " + std::to_string(static_cast<uint64_t>(m_metricWindowWakeups / minutes)) +
+                                             " wakeups/min" + (m_polling ? (m_pollIdle ? " (polling, idle)" : " (polling)") : ""));
+    m_metricWindowStart = now;
+    m_metricWindowWakeups = 0;
+}
+
+void InputService::pollBoundKeys()
+{
+    // Sample each polled key once into a bitmap; only keys whose state changed are dispatched
+    std::bitset<KEY_COUNT> sampled;
+    for (int vk = 1; vk < KEY_COUNT; ++vk)
+    {
+        if (m_pollKeys.test(static_cast<size_t>(vk)) && m_sampler(vk))
+            sampled.set(static_cast<size_t>(vk));
+    }
+
+    const std::bitset<KEY_COUNT> changed = (sampled ^ m_keyDown) & m_pollKeys;
+    if (changed.none())
+        return;
+
+    m_pollScheduler.onKeyActivity(Clock::now());
+    const double now = FrameClock::platformSeconds();
+    for (int vk = 1; vk < KEY_COUNT; ++vk)
+    {
+        if (changed.test(static_cast<size_t>(vk)))
+            dispatch({vk, sampled.test(static_cast<size_t>(vk)), now});
+    }
+}
+
+#ifdef _WIN32
+
+void InputService::wake()
+{
+    if (m_wakeEvent)
+        SetEvent(m_wakeEvent);
+}
+
+bool InputService::startPlatform()
+{
+    m_wakeEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+    if (!m_wakeEvent)
+    {
+        Logger::getInstance().log(LOG_ERROR, "InputService: Cannot create wake event (error " + std::to_string(GetLastError()) + ")");
+        return false;
+    }
+
+    m_polling = false;
+    for (std::atomic<uint64_t> &word : m_hookKeyDown)
+        word.store(0, std::memory_order_relaxed);
+
+    if (m_customSampler)
+    {
+        m_sampler = m_customSampler;
+        m_polling = true;
+        return true;
+    }
+
+    // The keyboard hook reports left/right modifiers only, and mouse buttons come from the mouse hook
+    m_watchKeys.set();
+    m_watchKeys.reset(0);
+    for (int vk = 1; vk < KEY_COUNT; ++vk)
+    {
+        if (isMouseButton(vk) || leftKeyFor(vk))
+            m_watchKeys.reset(static_cast<size_t>(vk));
+    }
+
+    std::promise<bool> installed;
+    std::future<bool> result = installed.get_future();
+    m_hookThread = std::thread(&InputService::runHookThread, this, std::ref(installed));
+    if (!result.get())
+    {
+        m_hookThread.join();
+        startPolling();
+        Logger::getInstance().log(LOG_WARNING, "InputService: Keyboard hook unavailable, polling keys every " +
+                                                   std::to_string(Constants::INPUT_FALLBACK_POLL_MS) + " ms instead (" +
+                                                   std::to_string(Constants::INPUT_IDLE_POLL_MS) + " ms while idle)");
+        return true;
+    }
+
+    // Keys held before the hook was installed were never reported to it
+    std::bitset<KEY_COUNT> down;
+    for (int vk = 1; vk < KEY_COUNT; ++vk)
+    {
+        if (m_watchKeys.test(static_cast<size_t>(vk)) && (GetAsyncKeyState(vk) & 0x8000))
+            down.set(static_cast<size_t>(vk));
+    }
+    m_hookWatchdog.reset(down);
+    m_nextHookCheck = Clock::now() + std::chrono::milliseconds(Constants::INPUT_HOOK_CHECK_MS);
+    return true;
+}
+
+void InputService::startPolling()
+{
+    m_sampler = [](int vk)
+    { return (GetAsyncKeyState(vk) & 0x8000) != 0; };
+    m_polling = true;
+    m_pollScheduler.reset(Clock::now());
+}
+
+bool InputService::hookKeyDown(int vk) const
+{
+    return (m_hookKeyDown[vk / 64].load(std::memory_order_relaxed) >> (vk % 64)) & 1u;
+}
+
+void InputService::hookTransition(int vk, bool down)
+{
+    // Drop auto-repeat here so holding a key does not wake the input thread
+    if (hookKeyDown(vk) == down)
+        return;
+    const uint64_t bit = uint64_t(1) << (vk % 64);
+    if (down)
+        m_hookKeyDown[vk / 64].fetch_or(bit, std::memory_order_relaxed);
+    else
+        m_hookKeyDown[vk / 64].fetch_and(~bit, std::memory_order_relaxed);
+
+    if (m_captureKeys.test(static_cast<size_t>(vk)))
+        enqueue({vk, down, FrameClock::platformSeconds()});
+}
+
+void InputService::reconcileHookKeys()
+{
+    // Hook thread, between hook calls: GetAsyncKeyState is up to date here
+    for (int vk = 1; vk < KEY_COUNT; ++vk)
+    {
+        if (hookKeyDown(vk) && !(GetAsyncKeyState(vk) & 0x8000))
+        {
+            Logger::getInstance().log(LOG_DEBUG, "InputService: Releasing key " + format_vkcode(vk) + " (key-up was missed)");
+            hookTransition(vk, false);
+        }
+    }
+}
+
+void InputService::checkHook()
+{
+    m_nextHookCheck = Clock::now() + std::chrono::milliseconds(Constants::INPUT_HOOK_CHECK_MS);
+
+    std::bitset<KEY_COUNT> sampled;
+    std::bitset<KEY_COUNT> seen;
+    for (int vk = 1; vk < KEY_COUNT; ++vk)
+    {
+        if (!m_watchKeys.test(static_cast<size_t>(vk)))
+            continue;
+        if (GetAsyncKeyState(vk) & 0x8000)
+            sampled.set(static_cast<size_t>(vk));
+        if (hookKeyDown(vk))
+            seen.set(static_cast<size_t>(vk));
+    }
+
+    // Input for another process's window (e.g. an elevated one) may legitimately bypass the hook
+    DWORD foregroundProcess = 0;
+    GetWindowThreadProcessId(GetForegroundWindow(), &foregroundProcess);
+    if (foregroundProcess != GetCurrentProcessId())
+    {
+        m_hookWatchdog.reset(sampled);
+        if ((seen & ~sampled).any())
+            PostThreadMessageA(m_hookThreadId, WM_RECONCILE_KEYS, 0, 0);
+        return;
+    }
+
+    const KeyHookWatchdog::Verdict verdict = m_hookWatchdog.check(sampled, seen);
+    if (verdict.hookLost)
+    {
+        // Windows removes a low-level hook without notice after a call exceeds LowLevelHooksTimeout
+        Logger::getInstance().log(LOG_WARNING, "InputService: Keyboard hook stopped receiving keys, polling keys every " +
+                                                   std::to_string(Constants::INPUT_FALLBACK_POLL_MS) + " ms instead");
+        PostThreadMessageA(m_hookThreadId, WM_QUIT, 0, 0);
+        m_hookThread.join();
+        startPolling();
+        return; // The first poll reconciles m_keyDown with the real state
+    }
+    if (verdict.stuck.any())
+        PostThreadMessageA(m_hookThreadId, WM_RECONCILE_KEYS, 0, 0);
+}
+
+void InputService::stopPlatform()
+{
+    if (m_hookThread.joinable())
+    {
+        PostThreadMessageA(m_hookThreadId, WM_QUIT, 0, 0);
+        m_hookThread.join();
+    }
+    m_hookThreadId = 0;
+    if (m_wakeEvent)
+    {
+        CloseHandle(m_wakeEvent);
+        m_wakeEvent = NULL;
+    }
+}
+
+void InputService::runHookThread(std::promise<bool> &installed)
+{
+    Logger &logger = Logger::getInstance();
+
+    // Create this thread's message queue before anyone can post WM_QUIT to it
+    MSG msg;
+    PeekMessageA(&msg, NULL, WM_USER, WM_USER, PM_NOREMOVE);
+    m_hookThreadId = GetCurrentThreadId();
+
+    HMODULE module = NULL;
+    GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCSTR>(&InputService::keyboardHookProc), &module);
+
+    bool needsMouse = false;
+    for (int vk = 0; vk < KEY_COUNT; ++vk)
+        needsMouse = needsMouse || (isMouseButton(vk) && m_captureKeys.test(static_cast<size_t>(vk)));
+
+    m_keyboardHook = SetWindowsHookExA(WH_KEYBOARD_LL, &InputService::keyboardHookProc, module, 0);
+    if (m_keyboardHook && needsMouse)
+        m_mouseHook = SetWindowsHookExA(WH_MOUSE_LL, &InputService::mouseHookProc, module, 0);
+
+    if (!m_keyboardHook || (needsMouse && !m_mouseHook))
+    {
+        logger.log(LOG_WARNING, "InputService: SetWindowsHookEx failed (error " + std::to_string(GetLastError()) + ")");
+        if (m_keyboardHook)
+            UnhookWindowsHookEx(m_keyboardHook);
+        m_keyboardHook = NULL;
+        installed.set_value(false);
+        return;
+    }
+
+    // Key-ups sent while another window had the focus may never reach the hook
+    m_foregroundHook = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, NULL,
+                                       &InputService::foregroundEventProc, 0, 0, WINEVENT_OUTOFCONTEXT);
+    installed.set_value(true);
+
+    // Low-level hook and WinEvent procedures are called from inside GetMessage on this thread
+    while (GetMessageA(&msg, NULL, 0, 0) > 0)
+    {
+        if (msg.message == WM_RECONCILE_KEYS)
+            reconcileHookKeys();
+    }
+
+    if (m_foregroundHook)
+        UnhookWinEvent(m_foregroundHook);
+    if (m_mouseHook)
+        UnhookWindowsHookEx(m_mouseHook);
+    UnhookWindowsHookEx(m_keyboardHook);
+    m_foregroundHook = NULL;
+    m_mouseHook = NULL;
+    m_keyboardHook = NULL;
+}
+
+LRESULT CALLBACK InputService::keyboardHookProc(int code, WPARAM wParam, LPARAM lParam)
+{
+    if (code == HC_ACTION)
+    {
+        const auto *info = reinterpret_cast<const KBDLLHOOKSTRUCT *>(lParam);
+        const int vk = static_cast<int>(info->vkCode);
+        // Every key is tracked, bound or not, so checkHook() can tell whether the hook is still called
+        if (vk > 0 && vk < KEY_COUNT)
+            getInstance().hookTransition(vk, wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN);
+    }
+    return CallNextHookEx(NULL, code, wParam, lParam);
+}
+
+void CALLBACK InputService::foregroundEventProc(HWINEVENTHOOK, DWORD, HWND, LONG, LONG, DWORD, DWORD)
+{
+    getInstance().reconcileHookKeys();
+}
+
+LRESULT CALLBACK InputService::mouseHookProc(int code, WPARAM wParam, LPARAM lParam)
+{
+    if (code == HC_ACTION && wParam != WM_MOUSEMOVE && wParam != WM_MOUSEWHEEL && wParam != WM_MOUSEHWHEEL)
+    {
+        const auto *info = reinterpret_cast<const MSLLHOOKSTRUCT *>(lParam);
+        int vk = 0;
+        bool down = false;
+        switch (wParam)
+        {
+        case WM_LBUTTONDOWN:
+        case WM_LBUTTONUP:
+            vk = VK_CODE_LBUTTON;
+            down = (wParam == WM_LBUTTONDOWN);
+            break;
+        case WM_RBUTTONDOWN:
+        case WM_RBUTTONUP:
+            vk = VK_CODE_RBUTTON;
+            down = (wParam == WM_RBUTTONDOWN);
+            break;
+        case WM_MBUTTONDOWN:
+        case WM_MBUTTONUP:
+            vk = VK_CODE_MBUTTON;
+            down = (wParam == WM_MBUTTONDOWN);
+            break;
+        case WM_XBUTTONDOWN:
+        case WM_XBUTTONUP:
+            vk = (HIWORD(info->mouseData) == XBUTTON1) ? VK_CODE_XBUTTON1 : VK_CODE_XBUTTON2;
+            down = (wParam == WM_XBUTTONDOWN);
+            break;
+        default:
+            break;
+        }
+
+        if (vk)
+            getInstance().hookTransition(vk, down);
+    }
+    return CallNextHookEx(NULL, code, wParam, lParam);
+}
+
+#else // Simulated input only
+
+void InputService::wake()
+{
+    m_wakeCondition.notify_one();
+}
+
+bool InputService::startPlatform()
+{
+    // Without hooks, keys only come from injectKeyEvent() or a custom sampler
+    m_sampler = m_customSampler;
+    m_polling = static_cast<bool>(m_sampler);
+    return true;
+}
+
+void InputService::stopPlatform()
+{
+}
+
+#endif
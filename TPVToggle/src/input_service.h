@@ -0,0 +1,286 @@
+/**
+ * @file input_service.h
+ * @brief Event-driven hotkey input shared by all key actions.
+ *
+ * One input thread receives key transitions and calls the handlers bound to
+ * those keys. On Windows the transitions come from low-level keyboard (and,
+ * if a mouse button is bound, mouse) hooks running on a small hook thread, so
+ * the input thread sleeps until a bound key changes instead of polling.
+ * Elsewhere, and for simulated input, transitions are fed in with
+ * injectKeyEvent(). If the hooks cannot be installed the service falls back
+ * to polling the bound keys; a custom key sampler (e.g. a fake keyboard)
+ * drives the same polling path on any platform.
+ *
+ * Hooks can miss transitions, so once a second (and whenever the foreground
+ * window changes) the hook's view is checked against GetAsyncKeyState: keys
+ * it still has down are released if they are up, and if keys go down without
+ * the hook seeing them it was removed by Windows and the service switches to
+ * polling (see KeyHookWatchdog).
+ *
+ * Work that must happen while no key changes (holding an adjustment key)
+ * is done by tickers, which only wake the thread while active.
+ * When polling, the rate drops to an idle rate after a quiet period (see
+ * AdaptivePollScheduler). Wakeups per minute are logged at DEBUG level.
+ *
+ * For replaying recorded input (see input_recording.h) the service can also
+ * run without its threads: beginReplay() switches to a virtual clock and
+ * advanceReplay() processes events, tickers and posted tasks on the calling
+ * thread, jumping straight from one due time to the next.
+ */
+#ifndef INPUT_SERVICE_H
+#define INPUT_SERVICE_H
+
+#include "hook_watchdog.h"
+#include "poll_scheduler.h"
+#include "timer_wheel.h"
+#include "constants.h"
+
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <future>
+#else
+#include <condition_variable>
+#endif
+
+/**
+ * @struct KeyEvent
+ * @brief A key (or mouse button) going down or up.
+ */
+struct KeyEvent
+{
+    int vkCode;
+    bool down;
+    double timestamp; // InputService::nowSeconds() when the transition was captured
+};
+
+/**
+ * @class InputService
+ * @brief Delivers key transitions to bound handlers on a single input thread.
+ *
+ * Bindings and tickers are set up before start(). All handlers, ticks and
+ * posted tasks run on the input thread, one at a time.
+ */
+class InputService
+{
+public:
+    using KeyHandler = std::function<void(const KeyEvent &)>;
+    using KeySampler = std::function<bool(int vkCode)>; // true if the key is down
+    using Task = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int KEY_COUNT = 256;
+
+    static InputService &getInstance();
+
+    // --- Setup (before start) ---
+
+    /**
+     * @brief Calls handler whenever one of keys goes down or up (auto-repeat is filtered out).
+     */
+    void bindKeys(const std::vector<int> &keys, KeyHandler handler);
+
+    /**
+     * @brief Runs tick every interval while isActive() returns true.
+     * @details isActive is checked after every event, task and tick. The first
+     *          tick runs as soon as the ticker becomes active.
+     */
+    void addTicker(std::chrono::milliseconds interval, std::function<bool()> isActive, Task tick);
+
+    /**
+     * @brief Polls keys through sampler instead of hooks (empty restores the default).
+     * @details Used for simulated keyboards; the Windows fallback uses GetAsyncKeyState.
+     */
+    void setKeySampler(KeySampler sampler) { m_customSampler = std::move(sampler); }
+
+    /**
+     * @brief Calls observer for every captured transition, before the bound handlers.
+     * @details Generic modifiers derived from their left/right keys are not observed.
+     */
+    void setEventObserver(KeyHandler observer) { m_eventObserver = std::move(observer); }
+
+    /**
+     * @brief Keeps polling at the active rate while isActive() returns true.
+     * @details Checked before every poll; only matters while the service is polling.
+     */
+    void addPollBoost(std::function<bool()> isActive);
+
+    /** @brief Removes all bindings, tickers and poll boosts (while stopped). */
+    void clearBindings();
+
+    /**
+     * @brief Starts the input thread (and on Windows the hook thread).
+     * @return true if the service is running.
+     */
+    bool start();
+
+    /**
+     * @brief Stops the threads and waits for them. Bindings are kept.
+     */
+    void stop();
+
+    bool isRunning() const { return m_running.load(); }
+
+    // --- Replay (instead of start/stop) ---
+
+    /**
+     * @brief Stops the threads and runs on the calling thread with a virtual clock set to start.
+     */
+    void beginReplay(Clock::time_point start);
+
+    /**
+     * @brief Handles queued events and runs every ticker and task due by time, in order.
+     * @details The virtual clock jumps to each due time in turn and ends at time.
+     */
+    void advanceReplay(Clock::time_point time);
+
+    /** @brief Drops pending work and returns to the real clock. Bindings are kept. */
+    void endReplay();
+
+    // --- Any thread ---
+
+    /** @brief Runs task on the input thread after delay (kept in a timer wheel, not a sleeping thread). */
+    void post(Task task, std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+
+    /** @brief Feeds a transition as if it came from the keyboard (simulated input). */
+    void injectKeyEvent(int vkCode, bool down);
+
+    /** @brief Current time of the service (virtual while replaying). */
+    Clock::time_point now() const;
+
+    /** @brief now() in seconds: FrameClock::platformSeconds(), or the virtual clock while replaying. */
+    double nowSeconds() const;
+
+    /** @brief Number of times the input thread woke up since start(). */
+    uint64_t getWakeupCount() const { return m_wakeups.load(std::memory_order_relaxed); }
+
+    // --- Input thread ---
+
+    /** @brief Current state of a key as seen by the input thread. */
+    bool isKeyDown(int vkCode) const;
+
+    /** @brief True if any of keys is down. */
+    bool isAnyKeyDown(const std::vector<int> &keys) const;
+
+    /** @brief State of every captured key (one bit per VK code). */
+    const std::bitset<KEY_COUNT> &keyState() const { return m_keyDown; }
+
+private:
+    InputService();
+    ~InputService();
+
+    InputService(const InputService &) = delete;
+    InputService &operator=(const InputService &) = delete;
+
+    struct Binding
+    {
+        std::bitset<KEY_COUNT> keys;
+        KeyHandler handler;
+    };
+
+    struct Ticker
+    {
+        std::chrono::milliseconds interval;
+        std::function<bool()> isActive;
+        Task tick;
+        bool active;
+        Clock::time_point next;
+    };
+
+    struct DelayedTask
+    {
+        Clock::time_point due;
+        Task task;
+    };
+
+    void prepare();
+    void run();
+    bool processPending(); // false once stop was requested
+    bool hasPending();
+    void dispatch(const KeyEvent &event);
+    void deliver(const KeyEvent &event);
+    Clock::time_point runTimers(); // Returns the next wake time (max() if none)
+    void enqueue(const KeyEvent &event);
+    void wake();
+
+    bool startPlatform();
+    void stopPlatform();
+    void pollBoundKeys();
+    std::chrono::milliseconds pollInterval();
+    void countWakeup();
+
+    // Fixed after start()
+    std::vector<Binding> m_bindings;
+    std::vector<Ticker> m_tickers;
+    std::vector<std::function<bool()>> m_pollBoosts;
+    std::bitset<KEY_COUNT> m_boundKeys;
+    std::bitset<KEY_COUNT> m_captureKeys; // Bound keys plus left/right variants of bound modifiers
+    std::bitset<KEY_COUNT> m_pollKeys;    // Captured keys minus generic modifiers (derived from their sides)
+    KeySampler m_customSampler;
+    KeyHandler m_eventObserver;
+
+    // Input thread only
+    std::bitset<KEY_COUNT> m_keyDown;
+    std::vector<KeyEvent> m_eventScratch;
+    TimerWheel<Task, Constants::INPUT_TIMER_WHEEL_SLOTS> m_scheduledTasks;
+    bool m_polling;       // Hooks unavailable: sample bound keys instead
+    KeySampler m_sampler; // Used while polling
+    AdaptivePollScheduler m_pollScheduler;
+    bool m_pollIdle;
+    Clock::time_point m_startTime;
+    Clock::time_point m_metricWindowStart;
+    uint64_t m_metricWindowWakeups;
+
+    // Handoff to the input thread
+    std::mutex m_pendingMutex;
+    std::vector<KeyEvent> m_pendingEvents;
+    std::vector<DelayedTask> m_pendingTasks;
+    bool m_stopRequested;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_wakeups;
+    std::atomic<bool> m_replaying;
+    std::atomic<Clock::rep> m_virtualNow; // Ticks since the clock's epoch while replaying
+
+#ifdef _WIN32
+    static LRESULT CALLBACK keyboardHookProc(int code, WPARAM wParam, LPARAM lParam);
+    static LRESULT CALLBACK mouseHookProc(int code, WPARAM wParam, LPARAM lParam);
+    static void CALLBACK foregroundEventProc(HWINEVENTHOOK hook, DWORD event, HWND window, LONG object, LONG child,
+                                             DWORD thread, DWORD time);
+    void runHookThread(std::promise<bool> &installed);
+    void hookTransition(int vk, bool down);
+    void reconcileHookKeys();
+    void checkHook();
+    void startPolling();
+    bool hookKeyDown(int vk) const;
+
+    HANDLE m_wakeEvent; // Auto-reset event signalled by wake()
+    std::thread m_hookThread;
+    DWORD m_hookThreadId;
+    HHOOK m_keyboardHook;
+    HHOOK m_mouseHook; // Only installed when a mouse button is bound
+    HWINEVENTHOOK m_foregroundHook;
+
+    // Every key the hooks saw go down and not yet up, captured or not (filters auto-repeat).
+    // Written by the hook thread only; the input thread reads it to check the hook.
+    std::atomic<uint64_t> m_hookKeyDown[KEY_COUNT / 64];
+
+    // Input thread only
+    KeyHookWatchdog m_hookWatchdog;
+    std::bitset<KEY_COUNT> m_watchKeys; // Keys the keyboard hook reports (no mouse buttons, no generic modifiers)
+    Clock::time_point m_nextHookCheck;
+#else
+    std::condition_variable m_wakeCondition;
+#endif
+};
+
+#endif // INPUT_SERVICE_H
@@ -5,18 +5,23 @@
 
 #include "logger.h"
 #include "constants.h"
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <filesystem>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 Logger::Logger() : current_log_level(LOG_INFO)
 {
     std::string log_file_path = generateLogFilePath();
-    log_file_stream.open(log_file_path, std::ios::trunc);
-    if (!log_file_stream.is_open())
+    // Previous session's log is rotated to a numbered backup, not truncated. The INI's
+    // LogMaxFiles is not loaded yet, so every backup is kept until setRotationPolicy() prunes them
+    log_sink.open(log_file_path, Constants::LOG_DEFAULT_MAX_FILE_BYTES, MappedLogSink::KEEP_ALL_FILES);
+    if (!log_sink.isOpen())
     {
         std::cerr << "[" << Constants::MOD_NAME << " Logger ERROR] "
                   << "Failed to open log file: " << log_file_path << std::endl;
@@ -29,12 +34,12 @@ Logger::Logger() : current_log_level(LOG_INFO)
 
 Logger::~Logger()
 {
-    if (log_file_stream.is_open())
+    std::lock_guard<std::mutex> lock(log_mutex);
+    if (log_sink.isOpen())
     {
-        std::lock_guard<std::mutex> lock(log_mutex);
-        log_file_stream << "[" << getTimestamp() << "] [INFO   ] :: Logger shutting down." << std::endl;
-        log_file_stream.flush();
-        log_file_stream.close();
+        const std::string line = "[" + getTimestamp() + "] [INFO   ] :: Logger shutting down.\r\n";
+        log_sink.write(line.data(), line.size());
+        log_sink.close();
     }
 }
 
@@ -82,6 +87,16 @@ void Logger::setLogLevel(LogLevel level)
     log(LOG_INFO, "Log level changed from " + oldLevelStr + " to " + newLevelStr);
 }
 
+void Logger::setRotationPolicy(size_t max_file_bytes, size_t max_files)
+{
+    {
+        std::lock_guard<std::mutex> lock(log_mutex);
+        log_sink.setRotationPolicy(max_file_bytes, max_files);
+    }
+    log(LOG_INFO, "Log rotation: cap " + std::to_string(max_file_bytes / 1024) + " KB per file, keeping " +
+                      std::to_string(max_files) + " rotated files");
+}
+
 void Logger::log(LogLevel level, const std::string &message)
 {
     if (level >= current_log_level)
@@ -105,12 +120,18 @@ void Logger::log(LogLevel level, const std::string &message)
             level_str = "ERROR";
             break;
         }
+        std::ostringstream line;
+        line << "[" << getTimestamp() << "] "
+             << "[" << std::setw(7) << std::left << level_str << "] :: "
+             << message << "\r\n"; // CRLF, matching the previous text-mode stream output
+        const std::string record = line.str();
+
         std::lock_guard<std::mutex> lock(log_mutex);
-        if (log_file_stream.is_open() && log_file_stream.good())
+        if (log_sink.isOpen() && log_sink.write(record.data(), record.size()))
         {
-            log_file_stream << "[" << getTimestamp() << "] "
-                            << "[" << std::setw(7) << std::left << level_str << "] :: "
-                            << message << std::endl;
+            // Errors are pushed to disk right away; everything else rides the page cache
+            if (level >= LOG_ERROR)
+                log_sink.flush();
         }
         else if (level >= LOG_ERROR)
         {
@@ -159,6 +180,7 @@ std::string Logger::generateLogFilePath() const
 {
     const std::string base_filename = Constants::getLogFilename();
     std::string result_path = base_filename;
+#ifdef _WIN32
     HMODULE h_self = NULL;
     char module_path_buffer[MAX_PATH] = {0};
     try
@@ -186,5 +208,6 @@ std::string Logger::generateLogFilePath() const
     {
         std::cerr << "[" << Constants::MOD_NAME << " Logger WARNING] Unknown exception get module path. Using fallback: " << result_path << std::endl;
     }
+#endif
     return result_path;
 }
@@ -2,9 +2,10 @@
 #define LOGGER_H
 
 #include <string>
-#include <fstream>
 #include <mutex>
 
+#include "mapped_log_sink.h"
+
 enum LogLevel
 {
     LOG_TRACE = 0,
@@ -24,7 +25,10 @@ public:
     }
 
     void setLogLevel(LogLevel level);
+    void setRotationPolicy(size_t max_file_bytes, size_t max_files);
     void log(LogLevel level, const std::string &message);
+    // Lets callers skip building messages that would be filtered out
+    bool isEnabled(LogLevel level) const { return level >= current_log_level; }
 
 private:
     Logger();
@@ -35,7 +39,7 @@ private:
     std::string getTimestamp() const;
     std::string generateLogFilePath() const;
 
-    std::ofstream log_file_stream;
+    MappedLogSink log_sink;
     LogLevel current_log_level;
     std::mutex log_mutex;
 };
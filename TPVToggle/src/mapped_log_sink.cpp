@@ -0,0 +1,374 @@
+/**
+ * @file mapped_log_sink.cpp
+ * @brief Implementation of the memory-mapped rotating log sink.
+ */
+
+#include "mapped_log_sink.h"
+#include "constants.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr intptr_t INVALID_FILE = -1;
+
+#ifdef _WIN32
+    HANDLE toHandle(intptr_t file)
+    {
+        return reinterpret_cast<HANDLE>(file);
+    }
+
+    unsigned long lastError()
+    {
+        return GetLastError();
+    }
+#else
+    int toFd(intptr_t file)
+    {
+        return static_cast<int>(file);
+    }
+
+    int lastError()
+    {
+        return errno;
+    }
+#endif
+}
+
+/**
+ * @brief Removes the zero padding a crashed session leaves after its last record.
+ * @details A mapped log file is preallocated, so if the process dies before
+ *          close() trims it the tail is filled with NUL bytes. Scans backwards
+ *          in chunks for the last non-zero byte and truncates the file there.
+ * @param path File to trim.
+ */
+static void trimZeroPadding(const std::filesystem::path &path)
+{
+    std::error_code ec;
+    const uintmax_t file_size = std::filesystem::file_size(path, ec);
+    if (ec || file_size == 0)
+        return;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return;
+
+    constexpr size_t CHUNK_SIZE = 64 * 1024;
+    std::vector<char> chunk(CHUNK_SIZE);
+    uintmax_t end = file_size;
+
+    while (end > 0)
+    {
+        const size_t to_read = static_cast<size_t>(std::min<uintmax_t>(CHUNK_SIZE, end));
+        in.seekg(static_cast<std::streamoff>(end - to_read));
+        if (!in.read(chunk.data(), static_cast<std::streamsize>(to_read)))
+            return;
+
+        size_t i = to_read;
+        while (i > 0 && chunk[i - 1] == '\0')
+            --i;
+        end -= (to_read - i);
+        if (i > 0)
+            break; // Found the last written byte
+    }
+    in.close();
+
+    if (end != file_size)
+    {
+        std::filesystem::resize_file(path, end, ec);
+    }
+}
+
+MappedLogSink::MappedLogSink()
+    : m_file(INVALID_FILE),
+      m_mapping(nullptr),
+      m_view(nullptr),
+      m_capacity(0),
+      m_written(0),
+      m_maxFiles(0)
+{
+}
+
+MappedLogSink::~MappedLogSink()
+{
+    close();
+}
+
+bool MappedLogSink::open(const std::string &path, size_t capacity_bytes, size_t max_files)
+{
+    close();
+
+    m_path = path;
+    m_capacity = std::max(capacity_bytes, Constants::LOG_MIN_FILE_BYTES);
+    m_maxFiles = max_files;
+
+    // Keep the previous session instead of truncating it
+    std::error_code ec;
+    if (std::filesystem::exists(m_path, ec))
+    {
+        trimZeroPadding(m_path);
+        rotateFiles();
+    }
+
+    return createActiveFile();
+}
+
+void MappedLogSink::setRotationPolicy(size_t capacity_bytes, size_t max_files)
+{
+    m_maxFiles = max_files;
+    capacity_bytes = std::max(capacity_bytes, Constants::LOG_MIN_FILE_BYTES);
+    if (!m_path.empty())
+        pruneBackups(); // Includes the previous session rotated by open()
+
+    if (capacity_bytes == m_capacity || !isOpen())
+    {
+        m_capacity = capacity_bytes;
+        return;
+    }
+
+    if (m_written >= capacity_bytes)
+    {
+        // Current contents do not fit the new cap: start a new file
+        closeActiveFile();
+        rotateFiles();
+        m_capacity = capacity_bytes;
+        createActiveFile();
+        return;
+    }
+
+    // Remap the same file at the new size, keeping what was written so far
+    unmapView();
+    m_capacity = capacity_bytes;
+    if (!mapView())
+    {
+        closeActiveFile();
+    }
+}
+
+bool MappedLogSink::write(const char *data, size_t length)
+{
+    if (!isOpen() || !data || length == 0)
+        return false;
+
+    // A single record larger than a whole file is cut to fit
+    length = std::min(length, m_capacity);
+
+    if (m_written + length > m_capacity)
+    {
+        closeActiveFile();
+        rotateFiles();
+        if (!createActiveFile())
+            return false;
+    }
+
+    std::memcpy(m_view + m_written, data, length);
+    m_written += length; // Record is committed once the offset moves past it
+    return true;
+}
+
+void MappedLogSink::flush()
+{
+    if (isOpen() && m_written > 0)
+    {
+#ifdef _WIN32
+        FlushViewOfFile(m_view, m_written);
+#else
+        msync(m_view, m_written, MS_SYNC);
+#endif
+    }
+}
+
+void MappedLogSink::close()
+{
+    closeActiveFile();
+}
+
+bool MappedLogSink::createActiveFile()
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(m_path.c_str(),
+                              GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL,
+                              CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL,
+                              NULL);
+    m_file = (file == INVALID_HANDLE_VALUE) ? INVALID_FILE : reinterpret_cast<intptr_t>(file);
+#else
+    m_file = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+    if (m_file == INVALID_FILE)
+    {
+        std::cerr << "[" << Constants::MOD_NAME << " Logger ERROR] "
+                  << "Cannot create " << m_path << ": " << lastError() << std::endl;
+        return false;
+    }
+
+    m_written = 0;
+    if (!mapView())
+    {
+#ifdef _WIN32
+        CloseHandle(toHandle(m_file));
+#else
+        ::close(toFd(m_file));
+#endif
+        m_file = INVALID_FILE;
+        return false;
+    }
+    return true;
+}
+
+bool MappedLogSink::mapView()
+{
+#ifdef _WIN32
+    const unsigned long long size = static_cast<unsigned long long>(m_capacity);
+
+    // CreateFileMapping grows the file to the requested size (preallocation)
+    m_mapping = CreateFileMappingA(toHandle(m_file), NULL, PAGE_READWRITE,
+                                   static_cast<DWORD>(size >> 32),
+                                   static_cast<DWORD>(size & 0xFFFFFFFFull),
+                                   NULL);
+    if (m_mapping == NULL)
+    {
+        std::cerr << "[" << Constants::MOD_NAME << " Logger ERROR] "
+                  << "CreateFileMappingA failed: " << lastError() << std::endl;
+        return false;
+    }
+
+    m_view = static_cast<char *>(MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, m_capacity));
+    if (!m_view)
+    {
+        std::cerr << "[" << Constants::MOD_NAME << " Logger ERROR] "
+                  << "MapViewOfFile failed: " << lastError() << std::endl;
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        return false;
+    }
+#else
+    // Grow the file to the mapped size (preallocation)
+    if (ftruncate(toFd(m_file), static_cast<off_t>(m_capacity)) != 0)
+    {
+        std::cerr << "[" << Constants::MOD_NAME << " Logger ERROR] "
+                  << "ftruncate failed: " << lastError() << std::endl;
+        return false;
+    }
+
+    void *view = mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, toFd(m_file), 0);
+    if (view == MAP_FAILED)
+    {
+        std::cerr << "[" << Constants::MOD_NAME << " Logger ERROR] "
+                  << "mmap failed: " << lastError() << std::endl;
+        return false;
+    }
+    m_view = static_cast<char *>(view);
+#endif
+    return true;
+}
+
+void MappedLogSink::unmapView()
+{
+#ifdef _WIN32
+    if (m_view)
+    {
+        FlushViewOfFile(m_view, m_written);
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+#else
+    if (m_view)
+    {
+        munmap(m_view, m_capacity);
+        m_view = nullptr;
+    }
+#endif
+}
+
+void MappedLogSink::closeActiveFile()
+{
+    unmapView();
+
+    if (m_file != INVALID_FILE)
+    {
+        // Drop the unused preallocated tail so the file ends at the last record
+#ifdef _WIN32
+        LARGE_INTEGER end_pos;
+        end_pos.QuadPart = static_cast<LONGLONG>(m_written);
+        if (SetFilePointerEx(toHandle(m_file), end_pos, NULL, FILE_BEGIN))
+        {
+            SetEndOfFile(toHandle(m_file));
+        }
+        CloseHandle(toHandle(m_file));
+#else
+        if (ftruncate(toFd(m_file), static_cast<off_t>(m_written)) != 0)
+        {
+            std::cerr << "[" << Constants::MOD_NAME << " Logger WARNING] "
+                      << "Cannot trim " << m_path << ": " << lastError() << std::endl;
+        }
+        ::close(toFd(m_file));
+#endif
+        m_file = INVALID_FILE;
+    }
+    m_written = 0;
+}
+
+void MappedLogSink::rotateFiles() const
+{
+    std::error_code ec;
+
+    // Shift the whole existing chain up by one (N -> N+1, ..., 1 -> 2, active -> 1),
+    // then drop whatever is past the retention count
+    size_t last = 0;
+    while (last < m_maxFiles && std::filesystem::exists(numberedPath(last + 1), ec))
+        ++last;
+    for (size_t i = last; i >= 1; --i)
+    {
+        std::filesystem::rename(numberedPath(i), numberedPath(i + 1), ec);
+    }
+    std::filesystem::rename(m_path, numberedPath(1), ec);
+    if (ec)
+    {
+        std::cerr << "[" << Constants::MOD_NAME << " Logger WARNING] "
+                  << "Failed to rotate " << m_path << ": " << ec.message() << std::endl;
+    }
+    pruneBackups();
+}
+
+void MappedLogSink::pruneBackups() const
+{
+    if (m_maxFiles == KEEP_ALL_FILES)
+        return;
+
+    std::error_code ec;
+    for (size_t i = m_maxFiles + 1; std::filesystem::exists(numberedPath(i), ec); ++i)
+    {
+        std::filesystem::remove(numberedPath(i), ec);
+    }
+}
+
+std::string MappedLogSink::numberedPath(size_t index) const
+{
+    // KCD2_TPVToggle.log -> KCD2_TPVToggle.<index>.log
+    std::filesystem::path p(m_path);
+    std::filesystem::path numbered = p.parent_path() /
+                                     (p.stem().string() + "." + std::to_string(index) + p.extension().string());
+    return numbered.string();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file mapped_log_sink.h
+ * @brief Size-capped, rotating log file backed by a memory-mapped view.
+ *
+ * The active log file is preallocated to a fixed capacity and mapped into the
+ * process, so appending a record is a single memcpy into the mapped pages.
+ * When the capacity is reached the file is trimmed to its written length and
+ * rotated to a numbered backup (KCD2_TPVToggle.1.log, .2.log, ...).
+ *
+ * The native handles are stored as plain integers/pointers so this header
+ * (and logger.h with it) does not pull in <windows.h>. Windows builds map the
+ * file with CreateFileMapping; other platforms use mmap.
+ */
+#ifndef MAPPED_LOG_SINK_H
+#define MAPPED_LOG_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedLogSink
+ * @brief Append-only log file writer using a memory-mapped, preallocated file.
+ *
+ * Records are committed by copying them into the mapped view and then advancing
+ * the write offset. Mapped pages belong to the system file cache, so if the
+ * process crashes the file stays readable up to the last committed record
+ * (followed by zero padding up to the preallocated size).
+ *
+ * @note Not thread-safe. The owning Logger serializes access with its mutex.
+ */
+class MappedLogSink
+{
+public:
+    /** @brief max_files value that keeps every backup until setRotationPolicy() sets the real count. */
+    static constexpr size_t KEEP_ALL_FILES = static_cast<size_t>(-1);
+
+    MappedLogSink();
+    ~MappedLogSink();
+
+    MappedLogSink(const MappedLogSink &) = delete;
+    MappedLogSink &operator=(const MappedLogSink &) = delete;
+
+    /**
+     * @brief Rotates any previous session's file and opens a fresh mapped log file.
+     * @param path Full path of the active log file.
+     * @param capacity_bytes Preallocated size of each log file; rotation happens when full.
+     * @param max_files Number of numbered backup files to keep (0 = keep none),
+     *                  or KEEP_ALL_FILES when the retention is not known yet.
+     * @return true if the file was created and mapped.
+     */
+    bool open(const std::string &path, size_t capacity_bytes, size_t max_files);
+
+    /**
+     * @brief Changes the size cap and retention count for the open log.
+     * @details Remaps the active file at the new capacity. If the data already
+     *          written exceeds the new capacity, the file is rotated first.
+     *          Backups beyond the new retention count are deleted.
+     */
+    void setRotationPolicy(size_t capacity_bytes, size_t max_files);
+
+    /**
+     * @brief Appends one record to the log, rotating first if it does not fit.
+     * @param data Record bytes (normally one formatted line including newline).
+     * @param length Number of bytes in the record.
+     * @return true if the record was committed.
+     */
+    bool write(const char *data, size_t length);
+
+    /**
+     * @brief Asks the OS to write dirty mapped pages to disk.
+     * @details Not needed for crash safety; used for records that must survive
+     *          a power loss or OS failure (e.g., errors).
+     */
+    void flush();
+
+    /**
+     * @brief Unmaps the view and trims the file to its written length.
+     */
+    void close();
+
+    bool isOpen() const { return m_view != nullptr; }
+    const std::string &path() const { return m_path; }
+
+private:
+    bool createActiveFile();
+    bool mapView();
+    void unmapView();
+    void closeActiveFile();
+    void rotateFiles() const;
+    void pruneBackups() const;
+    std::string numberedPath(size_t index) const;
+
+    std::string m_path;
+    intptr_t m_file;  // File HANDLE on Windows, file descriptor elsewhere; -1 when closed
+    void *m_mapping;  // File mapping HANDLE (Windows only)
+    char *m_view;
+    size_t m_capacity;
+    size_t m_written;
+    size_t m_maxFiles;
+};
+
+#endif // MAPPED_LOG_SINK_H
@@ -0,0 +1,60 @@
+/**
+ * @file math_utils.cpp
+ * @brief Batch vector rotation kernels.
+ */
+
+#include "math_utils.h"
+
+using namespace DirectX;
+
+void RotateVectors(const Quaternion &rotation, const Vector3 *in, Vector3 *out, size_t count)
+{
+    const QuaternionA q(rotation);
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = q.Rotate(Vector3A(in[i])).ToVector3();
+    }
+}
+
+void RotateVectorsSoA(const Quaternion &rotation, const float *inX, const float *inY, const float *inZ,
+                      float *outX, float *outY, float *outZ, size_t count)
+{
+    // Same formula as QuaternionA::Rotate, with each lane holding a different vector
+    const XMVECTOR qx = XMVectorReplicate(rotation.x);
+    const XMVECTOR qy = XMVectorReplicate(rotation.y);
+    const XMVECTOR qz = XMVectorReplicate(rotation.z);
+    const XMVECTOR qw = XMVectorReplicate(rotation.w);
+    const XMVECTOR two = XMVectorReplicate(2.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const XMVECTOR vx = XMLoadFloat4(reinterpret_cast<const XMFLOAT4 *>(inX + i));
+        const XMVECTOR vy = XMLoadFloat4(reinterpret_cast<const XMFLOAT4 *>(inY + i));
+        const XMVECTOR vz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4 *>(inZ + i));
+
+        // t = 2 (q.xyz x v)
+        const XMVECTOR tx = XMVectorMultiply(two, XMVectorSubtract(XMVectorMultiply(qy, vz), XMVectorMultiply(qz, vy)));
+        const XMVECTOR ty = XMVectorMultiply(two, XMVectorSubtract(XMVectorMultiply(qz, vx), XMVectorMultiply(qx, vz)));
+        const XMVECTOR tz = XMVectorMultiply(two, XMVectorSubtract(XMVectorMultiply(qx, vy), XMVectorMultiply(qy, vx)));
+
+        // v + w*t + q.xyz x t
+        const XMVECTOR rx = XMVectorAdd(XMVectorMultiplyAdd(qw, tx, vx), XMVectorSubtract(XMVectorMultiply(qy, tz), XMVectorMultiply(qz, ty)));
+        const XMVECTOR ry = XMVectorAdd(XMVectorMultiplyAdd(qw, ty, vy), XMVectorSubtract(XMVectorMultiply(qz, tx), XMVectorMultiply(qx, tz)));
+        const XMVECTOR rz = XMVectorAdd(XMVectorMultiplyAdd(qw, tz, vz), XMVectorSubtract(XMVectorMultiply(qx, ty), XMVectorMultiply(qy, tx)));
+
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4 *>(outX + i), rx);
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4 *>(outY + i), ry);
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4 *>(outZ + i), rz);
+    }
+
+    // Remainder one at a time
+    const QuaternionA q(rotation);
+    for (; i < count; ++i)
+    {
+        const Vector3 r = q.Rotate(Vector3A(Vector3(inX[i], inY[i], inZ[i]))).ToVector3();
+        outX[i] = r.x;
+        outY[i] = r.y;
+        outZ[i] = r.z;
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <DirectXMath.h>
 
 // Basic Vector3 structure
@@ -99,6 +100,15 @@ struct Quaternion
 
     static Quaternion Identity() { return Quaternion(0.0f, 0.0f, 0.0f, 1.0f); }
 
+    // Hamilton product: rotating by (a * b) applies b first, then a
+    Quaternion operator*(const Quaternion &o) const
+    {
+        return Quaternion(w * o.x + x * o.w + y * o.z - z * o.y,
+                          w * o.y - x * o.z + y * o.w + z * o.x,
+                          w * o.z + x * o.y - y * o.x + z * o.w,
+                          w * o.w - x * o.x - y * o.y - z * o.z);
+    }
+
     // DirectXMath conversion
     DirectX::XMVECTOR ToXMVector() const { return DirectX::XMVectorSet(x, y, z, w); }
     static Quaternion FromXMVector(DirectX::FXMVECTOR v)
@@ -108,13 +118,21 @@ struct Quaternion
         return Quaternion(f4.x, f4.y, f4.z, f4.w);
     }
 
-    // Rotate a vector by this quaternion
-    Vector3 Rotate(const Vector3 &v) const
+    // Rotate a vector by this quaternion (see QuaternionA::Rotate)
+    Vector3 Rotate(const Vector3 &v) const;
+
+    // Rotated unit axes (the rows of the rotation matrix) computed directly from the
+    // components, which is cheaper than rotating the three axes one by one.
+    // Assumes a unit quaternion.
+    void ToBasis(Vector3 &right, Vector3 &forward, Vector3 &up) const
     {
-        DirectX::XMVECTOR q = ToXMVector();
-        DirectX::XMVECTOR vec = v.ToXMVector();
-        DirectX::XMVECTOR rotatedVec = DirectX::XMVector3Rotate(vec, q);
-        return Vector3::FromXMVector(rotatedVec);
+        const float xx = x * x, yy = y * y, zz = z * z;
+        const float xy = x * y, xz = x * z, yz = y * z;
+        const float wx = w * x, wy = w * y, wz = w * z;
+
+        right = Vector3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy));
+        forward = Vector3(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx));
+        up = Vector3(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
     }
 
     // Static function to create a rotation looking along forward vector
@@ -157,3 +175,72 @@ struct Quaternion
         return Quaternion::FromXMVector(result);
     }
 };
+
+// Vector3 and Quaternion are read from and written to game memory, so they must
+// stay plain packed floats. The aligned types below are for math in between.
+static_assert(sizeof(Vector3) == sizeof(DirectX::XMFLOAT3), "Vector3 must match XMFLOAT3");
+static_assert(sizeof(Quaternion) == sizeof(DirectX::XMFLOAT4), "Quaternion must match XMFLOAT4");
+
+// 16-byte aligned vector held in an XMVECTOR (w = 0), so chained math stays in
+// SIMD registers. Convert from/to Vector3 at the edges.
+struct alignas(16) Vector3A
+{
+    DirectX::XMVECTOR v;
+
+    Vector3A() : v(DirectX::XMVectorZero()) {}
+    explicit Vector3A(DirectX::FXMVECTOR vec) : v(vec) {}
+    Vector3A(const Vector3 &o) : v(DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3 *>(&o))) {}
+
+    Vector3 ToVector3() const
+    {
+        Vector3 result;
+        DirectX::XMStoreFloat3(reinterpret_cast<DirectX::XMFLOAT3 *>(&result), v);
+        return result;
+    }
+
+    Vector3A operator+(const Vector3A &o) const { return Vector3A(DirectX::XMVectorAdd(v, o.v)); }
+    Vector3A operator-(const Vector3A &o) const { return Vector3A(DirectX::XMVectorSubtract(v, o.v)); }
+    Vector3A operator*(float scalar) const { return Vector3A(DirectX::XMVectorScale(v, scalar)); }
+
+    float Dot(const Vector3A &o) const { return DirectX::XMVectorGetX(DirectX::XMVector3Dot(v, o.v)); }
+    Vector3A Cross(const Vector3A &o) const { return Vector3A(DirectX::XMVector3Cross(v, o.v)); }
+};
+
+// 16-byte aligned quaternion held in an XMVECTOR (x, y, z, w)
+struct alignas(16) QuaternionA
+{
+    DirectX::XMVECTOR q;
+
+    QuaternionA() : q(DirectX::XMQuaternionIdentity()) {}
+    explicit QuaternionA(DirectX::FXMVECTOR quat) : q(quat) {}
+    QuaternionA(const Quaternion &o) : q(DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4 *>(&o))) {}
+
+    Quaternion ToQuaternion() const
+    {
+        Quaternion result;
+        DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4 *>(&result), q);
+        return result;
+    }
+
+    // v' = v + w*t + q.xyz x t with t = 2 (q.xyz x v). Two cross products instead of
+    // the two full quaternion products XMVector3Rotate performs. Assumes a unit quaternion.
+    Vector3A Rotate(const Vector3A &v) const
+    {
+        DirectX::XMVECTOR t = DirectX::XMVector3Cross(q, v.v);
+        t = DirectX::XMVectorAdd(t, t);
+        DirectX::XMVECTOR result = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatW(q), t, v.v);
+        return Vector3A(DirectX::XMVectorAdd(result, DirectX::XMVector3Cross(q, t)));
+    }
+};
+
+inline Vector3 Quaternion::Rotate(const Vector3 &v) const
+{
+    return QuaternionA(*this).Rotate(Vector3A(v)).ToVector3();
+}
+
+// Batch rotation kernels (math_utils.cpp). Input and output may be the same array.
+// Rotates count vectors stored as Vector3 structs.
+void RotateVectors(const Quaternion &rotation, const Vector3 *in, Vector3 *out, size_t count);
+// Rotates count vectors stored as separate x/y/z arrays, four per SIMD operation.
+void RotateVectorsSoA(const Quaternion &rotation, const float *inX, const float *inY, const float *inZ,
+                      float *outX, float *outY, float *outZ, size_t count);
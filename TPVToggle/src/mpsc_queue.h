@@ -0,0 +1,114 @@
+/**
+ * @file mpsc_queue.h
+ * @brief Bounded lock-free multi-producer/single-consumer queue.
+ *
+ * Used to hand game-facing commands (view switches, offset nudges) from the
+ * input thread and game hooks to whichever thread applies them, without any
+ * of them taking a lock. Each slot carries a sequence number (Vyukov's bounded
+ * queue): producers claim a slot with one compare-exchange on the tail and
+ * publish it with a release store; the consumer never writes shared counters
+ * other than the slot it frees. Only one thread may pop at a time.
+ */
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief Fixed-capacity ring of T shared by any number of producers and one consumer.
+ * @tparam T Element type (default-constructible and move-assignable).
+ * @tparam Capacity Number of slots; must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class MpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() : m_tail(0), m_head(0), m_headPublished(0)
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * @brief Appends value (any thread).
+     * @return false if the queue is full; value is left untouched.
+     */
+    bool push(T &&value)
+    {
+        size_t position = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot &slot = m_slots[position & (Capacity - 1)];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                // Slot is free for this position; claim it
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // The consumer has not freed this slot yet: full
+            }
+            else
+            {
+                position = m_tail.load(std::memory_order_relaxed); // Another producer took it
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest element into out (one consumer at a time).
+     * @return false if the queue is empty, or the oldest element is still being written.
+     */
+    bool pop(T &out)
+    {
+        Slot &slot = m_slots[m_head & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+            return false;
+
+        out = std::move(slot.value);
+        slot.sequence.store(m_head + Capacity, std::memory_order_release);
+        ++m_head;
+        m_headPublished.store(m_head, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief True if nothing is queued (approximate while producers are active). */
+    bool empty() const
+    {
+        return m_tail.load(std::memory_order_acquire) == m_headPublished.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence; // position + 1 once filled, position + Capacity once freed
+        T value;
+    };
+
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail; // Next position to claim (producers)
+    alignas(CACHE_LINE) size_t m_head;              // Next position to pop (consumer)
+    std::atomic<size_t> m_headPublished;            // m_head, readable by other threads for empty()
+    alignas(CACHE_LINE) std::array<Slot, Capacity> m_slots;
+};
+
+#endif // MPSC_QUEUE_H
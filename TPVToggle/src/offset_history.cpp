@@ -0,0 +1,60 @@
+/**
+ * @file offset_history.cpp
+ * @brief Implementation of the offset undo/redo ring.
+ */
+
+#include "offset_history.h"
+
+OffsetEditHistory::OffsetEditHistory()
+    : m_ring(),
+      m_oldest(0),
+      m_undoCount(0),
+      m_redoCount(0)
+{
+}
+
+void OffsetEditHistory::record(const OffsetEdit &edit)
+{
+    // A new edit discards the redo branch
+    m_redoCount = 0;
+
+    if (m_undoCount == CAPACITY)
+    {
+        // Full: the new entry replaces the oldest
+        m_ring[m_oldest] = edit;
+        m_oldest = (m_oldest + 1) % CAPACITY;
+        return;
+    }
+
+    slot(m_undoCount) = edit;
+    ++m_undoCount;
+}
+
+bool OffsetEditHistory::undo(OffsetEdit &out)
+{
+    if (m_undoCount == 0)
+        return false;
+
+    --m_undoCount;
+    ++m_redoCount;
+    out = slot(m_undoCount);
+    return true;
+}
+
+bool OffsetEditHistory::redo(OffsetEdit &out)
+{
+    if (m_redoCount == 0)
+        return false;
+
+    out = slot(m_undoCount);
+    ++m_undoCount;
+    --m_redoCount;
+    return true;
+}
+
+void OffsetEditHistory::clear()
+{
+    m_oldest = 0;
+    m_undoCount = 0;
+    m_redoCount = 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file offset_history.h
+ * @brief Bounded undo/redo history for camera offset edits.
+ *
+ * Edits are stored as deltas in a fixed ring, so recording never allocates.
+ * A continuous key hold is recorded once, as the sum of its nudges, when it
+ * ends. When the ring is full the oldest entry is dropped.
+ */
+#ifndef OFFSET_HISTORY_H
+#define OFFSET_HISTORY_H
+
+#include "math_utils.h"
+#include "profile_store.h"
+#include "constants.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct OffsetEdit
+ * @brief One undoable change: a delta applied to the live offset or to a profile's saved offset.
+ */
+struct OffsetEdit
+{
+    enum class Target : uint8_t
+    {
+        LiveOffset, // g_currentCameraOffset
+        SavedOffset // Saved offset of profileId
+    };
+
+    Target target;
+    ProfileId profileId; // Profile that was edited (SavedOffset) or active (LiveOffset)
+    Vector3 delta;       // New value minus old value
+};
+
+/**
+ * @class OffsetEditHistory
+ * @brief Fixed-capacity undo/redo ring of OffsetEdit records. Not thread-safe.
+ */
+class OffsetEditHistory
+{
+public:
+    static constexpr size_t CAPACITY = Constants::OFFSET_HISTORY_CAPACITY;
+
+    OffsetEditHistory();
+
+    /**
+     * @brief Records an edit, discarding the redo branch.
+     */
+    void record(const OffsetEdit &edit);
+
+    /**
+     * @brief Steps back one entry.
+     * @param out The edit to revert (apply -delta).
+     * @return false if there is nothing to undo.
+     */
+    bool undo(OffsetEdit &out);
+
+    /**
+     * @brief Steps forward one entry.
+     * @param out The edit to re-apply (apply +delta).
+     * @return false if there is nothing to redo.
+     */
+    bool redo(OffsetEdit &out);
+
+    void clear();
+
+    size_t undoCount() const { return m_undoCount; }
+    size_t redoCount() const { return m_redoCount; }
+
+private:
+    OffsetEdit &slot(size_t position) { return m_ring[(m_oldest + position) % CAPACITY]; }
+
+    std::array<OffsetEdit, CAPACITY> m_ring;
+    size_t m_oldest;    // Ring index of the oldest entry
+    size_t m_undoCount; // Entries before the cursor
+    size_t m_redoCount; // Entries after the cursor
+};
+
+#endif // OFFSET_HISTORY_H
@@ -0,0 +1,45 @@
+/**
+ * @file poll_scheduler.cpp
+ * @brief Implementation of the adaptive key polling rate.
+ */
+
+#include "poll_scheduler.h"
+
+AdaptivePollScheduler::AdaptivePollScheduler(std::chrono::milliseconds activeInterval, std::chrono::milliseconds idleInterval,
+                                             std::chrono::milliseconds idleAfter)
+    : m_activeInterval(activeInterval),
+      m_idleInterval(idleInterval),
+      m_idleAfter(idleAfter),
+      m_lastActivity(),
+      m_boosted(false)
+{
+}
+
+void AdaptivePollScheduler::reset(Clock::time_point now)
+{
+    m_lastActivity = now;
+    m_boosted = false;
+}
+
+void AdaptivePollScheduler::onKeyActivity(Clock::time_point now)
+{
+    m_lastActivity = now;
+}
+
+void AdaptivePollScheduler::setBoosted(bool boosted, Clock::time_point now)
+{
+    // Leaving the boost counts as activity, so the rate stays up for a full quiet period
+    if (m_boosted && !boosted)
+        m_lastActivity = now;
+    m_boosted = boosted;
+}
+
+bool AdaptivePollScheduler::isIdle(Clock::time_point now) const
+{
+    return !m_boosted && now - m_lastActivity >= m_idleAfter;
+}
+
+std::chrono::milliseconds AdaptivePollScheduler::interval(Clock::time_point now) const
+{
+    return isIdle(now) ? m_idleInterval : m_activeInterval;
+}
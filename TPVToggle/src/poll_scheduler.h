@@ -0,0 +1,56 @@
+/**
+ * @file poll_scheduler.h
+ * @brief Adaptive key polling rate: fast while keys are in use, slow while idle.
+ *
+ * Polling is only needed when the low-level hooks are unavailable, but then it
+ * runs for the whole session, including hours in menus or with the game
+ * minimized. The scheduler keeps the fast rate while a key changed recently or
+ * a boost condition (adjustment mode) holds, and drops to the idle rate after
+ * a quiet period. Time is passed in by the caller, so the policy runs the
+ * same against the real clock or a simulated one.
+ */
+#ifndef POLL_SCHEDULER_H
+#define POLL_SCHEDULER_H
+
+#include <chrono>
+
+/**
+ * @class AdaptivePollScheduler
+ * @brief Chooses the interval until the next key poll. Not thread-safe.
+ */
+class AdaptivePollScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param activeInterval Poll interval while keys are in use.
+     * @param idleInterval Poll interval once idle.
+     * @param idleAfter Time without key changes (and without boost) before going idle.
+     */
+    AdaptivePollScheduler(std::chrono::milliseconds activeInterval, std::chrono::milliseconds idleInterval,
+                          std::chrono::milliseconds idleAfter);
+
+    /** @brief Starts a session at the active rate. */
+    void reset(Clock::time_point now);
+
+    /** @brief A polled key changed state: back to the active rate. */
+    void onKeyActivity(Clock::time_point now);
+
+    /** @brief Holds the active rate while set (the quiet period restarts when it clears). */
+    void setBoosted(bool boosted, Clock::time_point now);
+
+    bool isIdle(Clock::time_point now) const;
+
+    /** @brief Interval until the next poll. */
+    std::chrono::milliseconds interval(Clock::time_point now) const;
+
+private:
+    std::chrono::milliseconds m_activeInterval;
+    std::chrono::milliseconds m_idleInterval;
+    std::chrono::milliseconds m_idleAfter;
+    Clock::time_point m_lastActivity;
+    bool m_boosted;
+};
+
+#endif // POLL_SCHEDULER_H
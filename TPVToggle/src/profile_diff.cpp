@@ -0,0 +1,154 @@
+/**
+ * @file profile_diff.cpp
+ * @brief Implementation of the profiles file diff.
+ */
+
+#include "profile_diff.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
+namespace
+{
+    bool sameOffset(const Vector3 &a, const Vector3 &b)
+    {
+        // Exact comparison: both sides come from the same float parsing
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+}
+
+ProfileDiff diffProfileFiles(const ProfileStore &before, const ProfileStore &after,
+                             const std::vector<ProfileId> &generatedIds)
+{
+    ProfileDiff diff;
+
+    // A file without "id" fields has every entry generated; keep the check O(1)
+    const std::unordered_set<ProfileId> generated_ids(generatedIds.begin(), generatedIds.end());
+    auto isGenerated = [&generated_ids](ProfileId id)
+    {
+        return generated_ids.count(id) != 0;
+    };
+
+    // Removed: the old file had the ID, the new file does not (a generated ID is not the same profile)
+    for (const auto &old_profile : before.profiles())
+    {
+        if (!after.findById(old_profile.id) || isGenerated(old_profile.id))
+        {
+            diff.removed.push_back(old_profile.id);
+        }
+    }
+
+    const auto &new_profiles = after.profiles();
+    for (size_t i = 0; i < new_profiles.size(); ++i)
+    {
+        const StoredProfile &new_profile = new_profiles[i];
+        const bool generated = isGenerated(new_profile.id);
+        const StoredProfile *old_profile = generated ? nullptr : before.findById(new_profile.id);
+
+        if (!old_profile)
+        {
+            diff.added.push_back({i, new_profile.toProfile(), !generated});
+            continue;
+        }
+
+        // Interned pointers from different pools cannot be compared; compare text
+        ChangedProfile change{new_profile.toProfile(),
+                              *old_profile->name != *new_profile.name,
+                              *old_profile->category != *new_profile.category,
+                              !sameOffset(old_profile->offset, new_profile.offset),
+                              *old_profile->transitionCurve != *new_profile.transitionCurve};
+        if (change.nameChanged || change.categoryChanged || change.offsetChanged || change.transitionChanged)
+        {
+            diff.changed.push_back(std::move(change));
+        }
+    }
+
+    return diff;
+}
+
+bool sameProfiles(const ProfileStore &a, const ProfileStore &b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        const StoredProfile &pa = a.at(i);
+        const StoredProfile &pb = b.at(i);
+        if (pa.id != pb.id || *pa.name != *pb.name || *pa.category != *pb.category ||
+            *pa.transitionCurve != *pb.transitionCurve || !sameOffset(pa.offset, pb.offset) ||
+            pa.timestamp != pb.timestamp)
+            return false;
+    }
+    return true;
+}
+
+bool mergeProfileDiff(const ProfileDiff &diff, ProfileStoreWriter &store, ProfileId activeId)
+{
+    Logger &logger = Logger::getInstance();
+
+    // Same rules as the in-game actions: Default stays first, is never deleted and keeps its name
+    const ProfileId default_id = store->at(0).id;
+    bool active_removed = false;
+
+    for (ProfileId id : diff.removed)
+    {
+        if (id == default_id)
+        {
+            logger.log(LOG_WARNING, "ProfileDiff: Edited file removed the 'Default' profile. Keeping it.");
+            continue;
+        }
+        if (!store->findById(id))
+            continue; // Already deleted in game
+        store.apply([id](ProfileStore &target)
+                    { return target.erase(id); });
+        active_removed = active_removed || id == activeId;
+    }
+
+    for (const ChangedProfile &change : diff.changed)
+    {
+        const ProfileId id = change.profile.id;
+        if (!store->findById(id))
+            continue; // Deleted in game since the file was written
+
+        if (change.nameChanged)
+        {
+            if (id == default_id || change.profile.name == "Default")
+                logger.log(LOG_WARNING, "ProfileDiff: Edited file renames 'Default' or renames a profile to 'Default'. Keeping the old name.");
+            else
+                store.apply([id, profile = change.profile](ProfileStore &target)
+                            { return target.rename(id, profile.name, profile.timestamp); });
+        }
+        if (change.categoryChanged)
+            store.apply([id, profile = change.profile](ProfileStore &target)
+                        { return target.setCategory(id, profile.category, profile.timestamp); });
+        if (change.offsetChanged) // Live offset is left alone
+            store.apply([id, profile = change.profile](ProfileStore &target)
+                        { return target.setOffset(id, profile.offset, profile.timestamp); });
+        if (change.transitionChanged)
+            store.apply([id, profile = change.profile](ProfileStore &target)
+                        { return target.setTransitionCurve(id, profile.transitionCurve, profile.timestamp); });
+    }
+
+    for (const AddedProfile &added : diff.added)
+    {
+        CameraProfile profile = added.profile;
+        if (!added.hasStableId)
+        {
+            profile.id = INVALID_PROFILE_ID;
+        }
+        else if (store->findById(profile.id))
+        {
+            // Already live: created in game and written by a save the diff base predates
+            logger.log(LOG_DEBUG, "ProfileDiff: Edited file adds profile ID " + std::to_string(profile.id) + " which already exists. Skipping.");
+            continue;
+        }
+        const size_t position = std::max<size_t>(added.index, 1);
+        store.apply([position, profile](ProfileStore &target)
+                    { return target.insert(position, profile); });
+    }
+
+    return active_removed;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file profile_diff.h
+ * @brief Differences between two versions of the profiles file, keyed by stable ID.
+ *
+ * Used when the profiles file is edited outside the game: comparing the file
+ * as it was last read or written with its new contents yields only the
+ * profiles that were added, removed or changed. Applying those to the live
+ * store leaves every other profile (and edits not yet folded into the file)
+ * untouched.
+ */
+#ifndef PROFILE_DIFF_H
+#define PROFILE_DIFF_H
+
+#include "profile_store.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct AddedProfile
+ * @brief A profile present only in the new file.
+ */
+struct AddedProfile
+{
+    size_t index;          // Display position in the new file
+    CameraProfile profile; // Entry as loaded
+    bool hasStableId;      // false if the file gave no usable "id" (a new one must be assigned)
+};
+
+/**
+ * @struct ChangedProfile
+ * @brief A profile present in both files with different contents.
+ */
+struct ChangedProfile
+{
+    CameraProfile profile; // New state
+    bool nameChanged;
+    bool categoryChanged;
+    bool offsetChanged;
+    bool transitionChanged;
+};
+
+/**
+ * @struct ProfileDiff
+ * @brief Everything that differs between two versions of the profiles file.
+ * @details Timestamp-only changes and reordering of existing profiles are not reported.
+ */
+struct ProfileDiff
+{
+    std::vector<ProfileId> removed;
+    std::vector<AddedProfile> added;
+    std::vector<ChangedProfile> changed;
+
+    bool empty() const { return removed.empty() && added.empty() && changed.empty(); }
+};
+
+/**
+ * @brief Compares two versions of the profiles file by stable ID.
+ * @param before Profiles the file held when it was last read or written.
+ * @param after Profiles the file holds now.
+ * @param generatedIds IDs the loader assigned in `after` to entries without
+ *        one of their own; those entries are always reported as added.
+ */
+ProfileDiff diffProfileFiles(const ProfileStore &before, const ProfileStore &after,
+                             const std::vector<ProfileId> &generatedIds);
+
+/**
+ * @brief Checks whether two stores hold the same profiles (IDs, fields and order).
+ */
+bool sameProfiles(const ProfileStore &a, const ProfileStore &b);
+
+/**
+ * @brief Applies an outside edit to the live store with the rules of the in-game actions.
+ * @details Default stays first, is never deleted and keeps its name. Profiles the game
+ *          deleted since the file was written stay deleted; added profiles go after Default.
+ * @param activeId Active profile, reported if the edit removed it.
+ * @return true if activeId was removed.
+ */
+bool mergeProfileDiff(const ProfileDiff &diff, ProfileStoreWriter &store, ProfileId activeId);
+
+#endif // PROFILE_DIFF_H
@@ -0,0 +1,339 @@
+/**
+ * @file profile_loader.cpp
+ * @brief Implementation of the streaming profiles JSON reader.
+ */
+
+#include "profile_loader.h"
+
+#include <limits>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+    /**
+     * @class ProfileSaxHandler
+     * @brief Receives parser events for `[ {profile}, {profile}, ... ]`.
+     *
+     * Depth 1 is the top-level array, depth 2 a profile object and depth 3
+     * its "offset" object. Any other container (or the value of an unknown
+     * key) is skipped by counting nesting until it closes.
+     */
+    class ProfileSaxHandler : public nlohmann::json_sax<json>
+    {
+    public:
+        ProfileSaxHandler(ProfileStore &store, const std::function<std::string()> &defaultTimestamp,
+                          ProfileLoadResult &result)
+            : m_store(store), m_defaultTimestamp(defaultTimestamp), m_result(result)
+        {
+        }
+
+        bool null() override { return scalar(Kind::Other, nullptr, 0.0); }
+        bool boolean(bool) override { return scalar(Kind::Other, nullptr, 0.0); }
+        bool number_integer(number_integer_t value) override { return scalar(Kind::Number, nullptr, static_cast<double>(value)); }
+        bool number_unsigned(number_unsigned_t value) override
+        {
+            if (m_skipDepth == 0 && m_depth == 2 && m_field == Field::Id)
+            {
+                // Only here is an ID acceptable; everywhere else it is just a number
+                if (value > INVALID_PROFILE_ID && value <= std::numeric_limits<ProfileId>::max())
+                    m_entry.id = static_cast<ProfileId>(value);
+                m_field = Field::None;
+                return true;
+            }
+            return scalar(Kind::Number, nullptr, static_cast<double>(value));
+        }
+        bool number_float(number_float_t value, const string_t &) override { return scalar(Kind::Number, nullptr, value); }
+        bool string(string_t &value) override { return scalar(Kind::String, &value, 0.0); }
+        bool binary(binary_t &) override { return scalar(Kind::Other, nullptr, 0.0); }
+
+        bool start_object(std::size_t) override
+        {
+            if (m_skipDepth > 0)
+            {
+                ++m_skipDepth;
+                return true;
+            }
+            switch (m_depth)
+            {
+            case 0:
+                return fail("expected an array of profiles");
+            case 1:
+                beginEntry();
+                m_depth = 2;
+                return true;
+            case 2:
+                if (m_field == Field::Offset)
+                {
+                    m_depth = 3;
+                    m_field = Field::None;
+                    return true;
+                }
+                return skipFieldValue();
+            default:
+                return skipFieldValue();
+            }
+        }
+
+        bool end_object() override
+        {
+            if (m_skipDepth > 0)
+            {
+                --m_skipDepth;
+                return true;
+            }
+            if (m_depth == 3)
+            {
+                m_depth = 2;
+                return true;
+            }
+            // m_depth == 2: profile complete
+            m_depth = 1;
+            finishEntry();
+            return true;
+        }
+
+        bool start_array(std::size_t) override
+        {
+            if (m_skipDepth > 0)
+            {
+                ++m_skipDepth;
+                return true;
+            }
+            if (m_depth == 0)
+            {
+                m_depth = 1;
+                m_sawArray = true;
+                return true;
+            }
+            if (m_depth == 1)
+            {
+                ++m_result.skipped; // Non-object entry
+                m_skipDepth = 1;
+                return true;
+            }
+            return skipFieldValue();
+        }
+
+        bool end_array() override
+        {
+            if (m_skipDepth > 0)
+            {
+                --m_skipDepth;
+                return true;
+            }
+            m_depth = 0; // Top-level array closed
+            return true;
+        }
+
+        bool key(string_t &name) override
+        {
+            if (m_skipDepth > 0)
+                return true;
+
+            if (m_depth == 2)
+            {
+                if (name == "id")
+                    m_field = Field::Id;
+                else if (name == "name")
+                    m_field = Field::Name;
+                else if (name == "category")
+                    m_field = Field::Category;
+                else if (name == "timestamp")
+                    m_field = Field::Timestamp;
+                else if (name == "offset")
+                    m_field = Field::Offset;
+                else if (name == "transition")
+                    m_field = Field::Transition;
+                else
+                    m_field = Field::Unknown;
+            }
+            else // m_depth == 3
+            {
+                if (name == "x")
+                    m_field = Field::OffsetX;
+                else if (name == "y")
+                    m_field = Field::OffsetY;
+                else if (name == "z")
+                    m_field = Field::OffsetZ;
+                else
+                    m_field = Field::Unknown;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &ex) override
+        {
+            return fail("parse error at byte " + std::to_string(position) + ": " + ex.what());
+        }
+
+        bool sawArray() const { return m_sawArray; }
+
+    private:
+        enum class Field
+        {
+            None,
+            Id,
+            Name,
+            Category,
+            Timestamp,
+            Transition,
+            Offset,
+            OffsetX,
+            OffsetY,
+            OffsetZ,
+            Unknown
+        };
+
+        enum class Kind
+        {
+            String,
+            Number,
+            Other
+        };
+
+        bool scalar(Kind kind, string_t *text, double number)
+        {
+            if (m_skipDepth > 0)
+                return true;
+
+            if (m_depth == 0)
+                return fail("expected an array of profiles");
+
+            if (m_depth == 1)
+            {
+                ++m_result.skipped; // Non-object entry
+                return true;
+            }
+
+            const Field field = m_field;
+            m_field = Field::None;
+
+            switch (field)
+            {
+            case Field::Name:
+            case Field::Category:
+            case Field::Timestamp:
+            case Field::Transition:
+                if (kind != Kind::String)
+                {
+                    m_entryValid = false;
+                    return true;
+                }
+                if (field == Field::Name)
+                    m_entry.name = std::move(*text);
+                else if (field == Field::Category)
+                    m_entry.category = std::move(*text);
+                else if (field == Field::Transition)
+                    m_entry.transitionCurve = std::move(*text);
+                else
+                {
+                    m_entry.timestamp = std::move(*text);
+                    m_hasTimestamp = true;
+                }
+                return true;
+
+            case Field::OffsetX:
+            case Field::OffsetY:
+            case Field::OffsetZ:
+                if (kind != Kind::Number)
+                {
+                    m_entryValid = false;
+                    return true;
+                }
+                if (field == Field::OffsetX)
+                    m_entry.offset.x = static_cast<float>(number);
+                else if (field == Field::OffsetY)
+                    m_entry.offset.y = static_cast<float>(number);
+                else
+                    m_entry.offset.z = static_cast<float>(number);
+                return true;
+
+            default:
+                // Id of the wrong kind gets a fresh ID; a non-object offset means (0,0,0)
+                return true;
+            }
+        }
+
+        bool skipFieldValue()
+        {
+            // A container where a known scalar field was expected invalidates the entry
+            switch (m_field)
+            {
+            case Field::Name:
+            case Field::Category:
+            case Field::Timestamp:
+            case Field::Transition:
+            case Field::OffsetX:
+            case Field::OffsetY:
+            case Field::OffsetZ:
+                m_entryValid = false;
+                break;
+            default:
+                break;
+            }
+            m_field = Field::None;
+            m_skipDepth = 1;
+            return true;
+        }
+
+        void beginEntry()
+        {
+            m_entry = CameraProfile("Unnamed Profile", Vector3(0.0f, 0.0f, 0.0f), "General", "");
+            m_entryValid = true;
+            m_hasTimestamp = false;
+            m_field = Field::None;
+        }
+
+        void finishEntry()
+        {
+            if (!m_entryValid)
+            {
+                ++m_result.skipped;
+                return;
+            }
+            if (!m_hasTimestamp)
+                m_entry.timestamp = m_defaultTimestamp();
+            const ProfileId requested = m_entry.id;
+            const ProfileId assigned = m_store.append(m_entry);
+            if (assigned != requested) // Missing or duplicate "id"
+                m_result.generatedIds.push_back(assigned);
+            ++m_result.loaded;
+        }
+
+        bool fail(const std::string &message)
+        {
+            if (m_result.error.empty())
+                m_result.error = message;
+            return false;
+        }
+
+        ProfileStore &m_store;
+        const std::function<std::string()> &m_defaultTimestamp;
+        ProfileLoadResult &m_result;
+
+        int m_depth = 0;
+        int m_skipDepth = 0;
+        bool m_sawArray = false;
+        Field m_field = Field::None;
+
+        CameraProfile m_entry;
+        bool m_entryValid = false;
+        bool m_hasTimestamp = false;
+    };
+}
+
+ProfileLoadResult ProfileLoader::load(const std::string &bytes, ProfileStore &store,
+                                      const std::function<std::string()> &defaultTimestamp)
+{
+    ProfileLoadResult result;
+    ProfileSaxHandler handler(store, defaultTimestamp, result);
+
+    const bool parsed = json::sax_parse(bytes, &handler);
+    result.ok = parsed && handler.sawArray();
+    if (!result.ok && result.error.empty())
+        result.error = "expected an array of profiles";
+    return result;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file profile_loader.h
+ * @brief Streaming (SAX) reader for the camera profiles JSON file.
+ *
+ * Builds a ProfileStore straight from parser events instead of parsing the
+ * file into an nlohmann::json DOM and converting that. Fields are validated
+ * as they arrive; an entry with a field of the wrong type is dropped without
+ * affecting the rest of the file.
+ */
+#ifndef PROFILE_LOADER_H
+#define PROFILE_LOADER_H
+
+#include "profile_store.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ProfileLoadResult
+ * @brief Outcome of ProfileLoader::load().
+ */
+struct ProfileLoadResult
+{
+    bool ok = false;    // File is a well-formed JSON array (individual entries may still be skipped)
+    size_t loaded = 0;  // Profiles added to the store
+    size_t skipped = 0; // Entries that were not objects or had invalid fields
+    std::vector<ProfileId> generatedIds; // IDs assigned to entries without a usable "id" of their own
+    std::string error;  // Reason when !ok
+};
+
+/**
+ * @class ProfileLoader
+ * @brief Parses the profiles JSON array into a ProfileStore.
+ *
+ * Accepted entry fields (all optional):
+ * - "id" (unsigned): stable profile ID; missing or unusable IDs get a new one
+ * - "name", "category", "timestamp" (strings); defaults "Unnamed Profile",
+ *   "General" and the current time. The default timestamp is only generated
+ *   for entries that lack one.
+ * - "offset" (object with numeric "x", "y", "z"); missing parts are 0
+ * - "transition" (string): easing curve for transitions to the profile (see EasingCurve)
+ * Unknown fields are ignored.
+ */
+class ProfileLoader
+{
+public:
+    /**
+     * @param bytes Full contents of the profiles file.
+     * @param store Store to append the loaded profiles to.
+     * @param defaultTimestamp Called for each entry without a "timestamp".
+     */
+    static ProfileLoadResult load(const std::string &bytes, ProfileStore &store,
+                                  const std::function<std::string()> &defaultTimestamp);
+};
+
+#endif // PROFILE_LOADER_H
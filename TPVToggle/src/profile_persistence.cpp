@@ -0,0 +1,530 @@
+/**
+ * @file profile_persistence.cpp
+ * @brief Implementation of the write-behind profile persistence worker and journal.
+ */
+
+#include "profile_persistence.h"
+#include "constants.h"
+#include "logger.h"
+#include "utils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+    constexpr int JOURNAL_FORMAT_VERSION = 1;
+
+    std::string journalPathFor(const std::string &path)
+    {
+        std::filesystem::path p(path);
+        p.replace_extension(".journal");
+        return p.string();
+    }
+
+    json offsetToJson(const Vector3 &offset)
+    {
+        return {{"x", offset.x}, {"y", offset.y}, {"z", offset.z}};
+    }
+
+    json profileToJson(const CameraProfile &profile)
+    {
+        json jsonObj;
+        jsonObj["id"] = profile.id;
+        jsonObj["name"] = profile.name;
+        jsonObj["category"] = profile.category;
+        jsonObj["timestamp"] = profile.timestamp;
+        jsonObj["offset"] = offsetToJson(profile.offset);
+        if (!profile.transitionCurve.empty())
+            jsonObj["transition"] = profile.transitionCurve;
+        return jsonObj;
+    }
+
+    // Journal records are machine-written, so anything unexpected is treated as damage
+    bool offsetFromRecord(const json &obj, Vector3 &out)
+    {
+        if (!obj.is_object() || !obj.contains("x") || !obj.contains("y") || !obj.contains("z") ||
+            !obj["x"].is_number() || !obj["y"].is_number() || !obj["z"].is_number())
+            return false;
+        out = Vector3(obj["x"].get<float>(), obj["y"].get<float>(), obj["z"].get<float>());
+        return true;
+    }
+
+    bool stringFromRecord(const json &obj, const char *key, std::string &out)
+    {
+        auto it = obj.find(key);
+        if (it == obj.end() || !it->is_string())
+            return false;
+        out = it->get<std::string>();
+        return true;
+    }
+
+    std::string changeToJournalLine(const ProfileChange &change)
+    {
+        json record;
+        record["id"] = change.id;
+        switch (change.kind)
+        {
+        case ProfileChange::Kind::Create:
+            record["op"] = "create";
+            record["index"] = change.index;
+            record["profile"] = profileToJson(change.profile);
+            break;
+        case ProfileChange::Kind::Update:
+            record["op"] = "update";
+            record["offset"] = offsetToJson(change.profile.offset);
+            record["timestamp"] = change.profile.timestamp;
+            break;
+        case ProfileChange::Kind::Rename:
+            record["op"] = "rename";
+            record["name"] = change.profile.name;
+            record["timestamp"] = change.profile.timestamp;
+            break;
+        case ProfileChange::Kind::SetCategory:
+            record["op"] = "category";
+            record["category"] = change.profile.category;
+            record["timestamp"] = change.profile.timestamp;
+            break;
+        case ProfileChange::Kind::Delete:
+            record["op"] = "delete";
+            break;
+        }
+        return record.dump() + "\n";
+    }
+
+    bool applyJournalRecord(const json &record, ProfileStore &profiles)
+    {
+        std::string op;
+        if (!record.is_object() || !stringFromRecord(record, "op", op) ||
+            !record.contains("id") || !record["id"].is_number_unsigned())
+            return false;
+
+        const ProfileId id = record["id"].get<ProfileId>();
+
+        if (op == "create")
+        {
+            CameraProfile profile;
+            const auto it = record.find("profile");
+            if (profiles.findById(id) || !record.contains("index") || !record["index"].is_number_unsigned() ||
+                it == record.end() || !it->is_object() ||
+                !stringFromRecord(*it, "name", profile.name) ||
+                !stringFromRecord(*it, "category", profile.category) ||
+                !stringFromRecord(*it, "timestamp", profile.timestamp) ||
+                !it->contains("offset") || !offsetFromRecord((*it)["offset"], profile.offset))
+                return false;
+            if (it->contains("transition") && !stringFromRecord(*it, "transition", profile.transitionCurve))
+                return false;
+            profile.id = id;
+            profiles.insert(record["index"].get<size_t>(), profile);
+            return true;
+        }
+
+        if (!profiles.findById(id))
+            return false;
+
+        if (op == "delete")
+            return profiles.erase(id);
+
+        std::string timestamp;
+        if (!stringFromRecord(record, "timestamp", timestamp))
+            return false;
+
+        if (op == "update")
+        {
+            Vector3 offset;
+            return record.contains("offset") && offsetFromRecord(record["offset"], offset) &&
+                   profiles.setOffset(id, offset, timestamp);
+        }
+        if (op == "rename")
+        {
+            std::string name;
+            return stringFromRecord(record, "name", name) && profiles.rename(id, name, timestamp);
+        }
+        if (op == "category")
+        {
+            std::string category;
+            return stringFromRecord(record, "category", category) && profiles.setCategory(id, category, timestamp);
+        }
+        return false;
+    }
+
+    std::string journalHeader(const std::string &snapshotBytes)
+    {
+        json header;
+        header["journal"] = JOURNAL_FORMAT_VERSION;
+        header["snapshot"] = ProfilePersistence::fingerprintOf(snapshotBytes);
+        return header.dump() + "\n";
+    }
+}
+
+ProfilePersistence::ProfilePersistence()
+    : m_debounce(0),
+      m_compactRequested(false),
+      m_stopRequested(false),
+      m_lastWriteTime(),
+      m_writtenRevision(0),
+      m_journalValid(false),
+      m_journalBytes(0)
+{
+}
+
+ProfilePersistence::~ProfilePersistence()
+{
+    stop();
+}
+
+// Ties a journal to the exact JSON file it was started against, and tells our
+// own writes apart from outside edits when the file changes
+std::string ProfilePersistence::fingerprintOf(const std::string &bytes)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : bytes)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+}
+
+void ProfilePersistence::start(const std::string &path, std::chrono::milliseconds debounce, const JournalReplayResult &journal,
+                               ProfileFileState fileState)
+{
+    stop();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_path = path;
+        m_journalPath = journalPathFor(path);
+        m_debounce = debounce;
+        m_stopRequested = false;
+        m_pending.reset();
+        m_pendingChanges.clear();
+        m_compactRequested = false;
+        // The file was just loaded, so the first change waits out one window
+        m_lastWriteTime = Clock::now();
+    }
+    {
+        std::lock_guard<std::mutex> write_lock(m_writeMutex);
+        m_writtenRevision = 0;
+        // A damaged or foreign journal is never appended to; the first write compacts
+        m_journalValid = journal.valid && !journal.truncated;
+        m_journalBytes = m_journalValid ? journal.bytes : 0;
+        m_fileState = std::move(fileState);
+    }
+
+    m_worker = std::thread(&ProfilePersistence::workerLoop, this);
+}
+
+void ProfilePersistence::post(ProfileSnapshotPtr snapshot, const ProfileChange &change)
+{
+    if (!snapshot)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingChanges.push_back(change);
+        if (!m_pending || m_pending->revision < snapshot->revision)
+            m_pending = std::move(snapshot);
+    }
+    m_wakeup.notify_one();
+}
+
+void ProfilePersistence::postFullSave(ProfileSnapshotPtr snapshot)
+{
+    if (!snapshot)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_compactRequested = true;
+        if (!m_pending || m_pending->revision < snapshot->revision)
+            m_pending = std::move(snapshot);
+    }
+    m_wakeup.notify_one();
+}
+
+bool ProfilePersistence::writeNow(const ProfileSnapshotPtr &snapshot)
+{
+    if (!snapshot)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending && m_pending->revision <= snapshot->revision)
+        {
+            // Superseded by this write
+            m_pending.reset();
+            m_pendingChanges.clear();
+            m_compactRequested = false;
+        }
+        m_lastWriteTime = Clock::now();
+    }
+    return persist(snapshot, {}, true);
+}
+
+void ProfilePersistence::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wakeup.notify_one();
+
+    if (m_worker.joinable())
+        m_worker.join();
+
+    // Flush what the worker did not get to, on the caller's thread
+    ProfileSnapshotPtr pending;
+    std::vector<ProfileChange> changes;
+    bool compact = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending = std::move(m_pending);
+        m_pending.reset();
+        changes.swap(m_pendingChanges);
+        compact = m_compactRequested;
+        m_compactRequested = false;
+    }
+    if (pending)
+    {
+        Logger::getInstance().log(LOG_INFO, "ProfilePersistence: Saving pending profile changes on shutdown...");
+        persist(pending, changes, compact);
+    }
+}
+
+ProfileFileState ProfilePersistence::fileState()
+{
+    std::lock_guard<std::mutex> write_lock(m_writeMutex);
+    return m_fileState;
+}
+
+bool ProfilePersistence::adoptExternalFile(const std::string &expectedFingerprint, ProfileFileState fileState,
+                                           const std::function<void()> &apply)
+{
+    std::lock_guard<std::mutex> write_lock(m_writeMutex);
+    if (m_fileState.fingerprint != expectedFingerprint)
+        return false;
+
+    apply();
+    m_fileState = std::move(fileState);
+    m_journalValid = false;
+    m_journalBytes = 0;
+    return true;
+}
+
+void ProfilePersistence::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_stopRequested)
+    {
+        if (!m_pending)
+        {
+            m_wakeup.wait(lock, [this]
+                          { return m_stopRequested || m_pending != nullptr; });
+            continue;
+        }
+
+        // Trailing edge: hold the write until the window since the last write ends
+        const Clock::time_point due = m_lastWriteTime + m_debounce;
+        if (Clock::now() < due)
+        {
+            m_wakeup.wait_until(lock, due, [this]
+                                { return m_stopRequested; });
+            continue;
+        }
+
+        ProfileSnapshotPtr snapshot = std::move(m_pending);
+        m_pending.reset();
+        std::vector<ProfileChange> changes;
+        changes.swap(m_pendingChanges);
+        const bool compact = m_compactRequested;
+        m_compactRequested = false;
+        m_lastWriteTime = Clock::now();
+
+        lock.unlock();
+        const bool ok = persist(snapshot, changes, compact);
+        lock.lock();
+
+        if (!ok)
+        {
+            // The batch's records are gone; retry next window with a full rewrite
+            m_compactRequested = true;
+            if (!m_pending)
+                m_pending = std::move(snapshot);
+        }
+    }
+}
+
+bool ProfilePersistence::persist(const ProfileSnapshotPtr &snapshot, const std::vector<ProfileChange> &changes, bool compact)
+{
+    std::lock_guard<std::mutex> write_lock(m_writeMutex);
+
+    if (snapshot->revision != 0 && snapshot->revision <= m_writtenRevision)
+        return true; // Newer or identical state is already on disk
+
+    std::string lines;
+    if (!compact && m_journalValid)
+    {
+        for (const auto &change : changes)
+        {
+            if (change.revision > m_writtenRevision) // Skip records already folded into a compaction
+                lines += changeToJournalLine(change);
+        }
+    }
+
+    bool ok = false;
+    if (compact || !m_journalValid || m_journalBytes + lines.size() > Constants::PROFILE_JOURNAL_COMPACT_BYTES)
+    {
+        ok = compactTo(*snapshot);
+    }
+    else
+    {
+        ok = appendToJournal(lines) || compactTo(*snapshot);
+    }
+
+    if (ok)
+        m_writtenRevision = snapshot->revision;
+    return ok;
+}
+
+bool ProfilePersistence::compactTo(const ProfileSnapshot &snapshot)
+{
+    Logger &logger = Logger::getInstance();
+
+    std::string payload;
+    try
+    {
+        json profilesArray = json::array();
+        for (const auto &profile : snapshot.store->profiles())
+        {
+            profilesArray.push_back(profileToJson(profile.toProfile()));
+        }
+        std::ostringstream oss;
+        oss << std::setw(4) << profilesArray << std::endl;
+        payload = oss.str();
+    }
+    catch (const json::exception &e)
+    {
+        logger.log(LOG_ERROR, "ProfilePersistence: JSON library error during profile serialization: " + std::string(e.what()));
+        return false;
+    }
+
+    // JSON first: until the new journal lands, the old one fails the fingerprint check
+    m_journalValid = false;
+    // Recorded before the replace, so a change notification for it is recognized as ours
+    ProfileFileState previous_state = std::move(m_fileState);
+    m_fileState = {fingerprintOf(payload), snapshot.store};
+    if (!replaceFileContents(m_path, payload))
+    {
+        m_fileState = std::move(previous_state);
+        return false;
+    }
+
+    const std::string header = journalHeader(payload);
+    if (replaceFileContents(m_journalPath, header))
+    {
+        m_journalValid = true;
+        m_journalBytes = header.size();
+    }
+
+    logger.log(LOG_INFO, "ProfilePersistence: Saved " + std::to_string(snapshot.store->size()) +
+                             " profiles to " + m_path);
+    return true;
+}
+
+bool ProfilePersistence::appendToJournal(const std::string &lines)
+{
+    if (lines.empty())
+        return true;
+
+    if (!appendFileContents(m_journalPath, lines))
+    {
+        // A partial tail is dropped on the next load; never append after it
+        Logger::getInstance().log(LOG_WARNING, "ProfilePersistence: Journal append failed, compacting instead.");
+        m_journalValid = false;
+        return false;
+    }
+
+    m_journalBytes += lines.size();
+    Logger::getInstance().log(LOG_DEBUG, "ProfilePersistence: Appended " + std::to_string(lines.size()) +
+                                             " bytes to profile journal (" + std::to_string(m_journalBytes) + " total).");
+    return true;
+}
+
+JournalReplayResult ProfilePersistence::replayJournal(const std::string &path, const std::string &snapshotBytes,
+                                                      ProfileStore &profiles)
+{
+    Logger &logger = Logger::getInstance();
+    JournalReplayResult result;
+    const std::string journal_path = journalPathFor(path);
+
+    std::ifstream file(journal_path, std::ios::binary);
+    if (!file.is_open())
+        return result; // No journal yet
+
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    // Header line ties the journal to one exact JSON file
+    const size_t header_end = contents.find('\n');
+    if (header_end == std::string::npos)
+    {
+        logger.log(LOG_WARNING, "ProfilePersistence: Profile journal has no complete header, ignoring it.");
+        return result;
+    }
+
+    const json header = json::parse(contents.begin(), contents.begin() + header_end, nullptr, false);
+    if (header.is_discarded() || !header.is_object() ||
+        header.value("journal", 0) != JOURNAL_FORMAT_VERSION ||
+        header.value("snapshot", std::string()) != ProfilePersistence::fingerprintOf(snapshotBytes))
+    {
+        logger.log(LOG_INFO, "ProfilePersistence: Profile journal does not match " + path + ", ignoring it.");
+        return result;
+    }
+
+    result.valid = true;
+    result.bytes = contents.size();
+
+    // A record counts only once its newline is on disk; stop at the first bad one
+    size_t line_start = header_end + 1;
+    while (line_start < contents.size())
+    {
+        const size_t line_end = contents.find('\n', line_start);
+        if (line_end == std::string::npos)
+        {
+            result.truncated = true;
+            break;
+        }
+
+        const json record = json::parse(contents.begin() + line_start, contents.begin() + line_end, nullptr, false);
+        if (record.is_discarded() || !applyJournalRecord(record, profiles))
+        {
+            result.truncated = true;
+            break;
+        }
+
+        ++result.applied;
+        line_start = line_end + 1;
+    }
+
+    if (result.truncated)
+    {
+        logger.log(LOG_WARNING, "ProfilePersistence: Profile journal is damaged after record " +
+                                    std::to_string(result.applied) + "; later records were dropped.");
+    }
+    else if (result.applied > 0)
+    {
+        logger.log(LOG_DEBUG, "ProfilePersistence: Replayed " + std::to_string(result.applied) + " profile journal records.");
+    }
+    return result;
+}
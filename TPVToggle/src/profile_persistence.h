@@ -0,0 +1,186 @@
+/**
+ * @file profile_persistence.h
+ * @brief Background (write-behind) writer for the camera profiles JSON file and its journal.
+ *
+ * CameraProfileManager posts an immutable snapshot of its profile list after
+ * every change, together with a small record describing the change, and
+ * returns immediately. A worker thread appends the records to
+ * KCD2_TPVToggle_Profiles.journal (one JSON object per line) outside the
+ * manager's lock. Once the journal passes Constants::PROFILE_JOURNAL_COMPACT_BYTES
+ * the newest snapshot is written to KCD2_TPVToggle_Profiles.json (temp file +
+ * MoveFileEx) and the journal is restarted.
+ *
+ * The journal's first line records a fingerprint of the JSON file it applies
+ * to. A journal whose fingerprint does not match the JSON file on disk (crash
+ * between the two replaces of a compaction, or a hand-edited JSON file) is
+ * ignored on load.
+ *
+ * The worker also remembers what the JSON file holds (ProfileFileState), so
+ * a change notification for the file can tell its own writes from edits made
+ * by other programs, and can diff an outside edit against the old contents.
+ */
+#ifndef PROFILE_PERSISTENCE_H
+#define PROFILE_PERSISTENCE_H
+
+#include "camera_profile.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct ProfileSnapshot
+ * @brief The saved profile list at one revision.
+ * @details The store is shared with CameraProfileManager, which never edits
+ *          it again (see ProfileStoreWriter), so posting a snapshot copies nothing.
+ *          Holding a snapshot long makes the manager's next edit copy the store.
+ */
+struct ProfileSnapshot
+{
+    uint64_t revision;
+    std::shared_ptr<const ProfileStore> store;
+};
+
+using ProfileSnapshotPtr = std::shared_ptr<const ProfileSnapshot>;
+
+/**
+ * @struct JournalReplayResult
+ * @brief Outcome of replaying the journal on top of a freshly loaded profile list.
+ */
+struct JournalReplayResult
+{
+    bool valid = false;       // Journal exists and belongs to the loaded JSON file
+    bool truncated = false;   // Replay stopped at a torn or inconsistent record
+    size_t applied = 0;       // Records applied
+    uint64_t bytes = 0;       // Journal size in bytes (only meaningful if valid)
+};
+
+/**
+ * @struct ProfileFileState
+ * @brief What the profiles JSON file on disk contains, as far as this process knows.
+ */
+struct ProfileFileState
+{
+    std::string fingerprint;                   // ProfilePersistence::fingerprintOf() of the file bytes ("" if no file)
+    std::shared_ptr<const ProfileStore> store; // Profiles parsed from those bytes, before any journal replay
+};
+
+/**
+ * @class ProfilePersistence
+ * @brief Owns the persistence worker thread for one profiles file.
+ *
+ * Saves are debounced: changes arriving within the debounce window of the last
+ * write are batched and written when the window ends. Every posted change
+ * therefore reaches disk within one debounce window.
+ */
+class ProfilePersistence
+{
+public:
+    ProfilePersistence();
+    ~ProfilePersistence();
+
+    ProfilePersistence(const ProfilePersistence &) = delete;
+    ProfilePersistence &operator=(const ProfilePersistence &) = delete;
+
+    /**
+     * @brief Starts the worker for the given file.
+     * @param path Full path of the profiles JSON file.
+     * @param debounce Minimum time between two background writes.
+     * @param journal Result of replayJournal() for the loaded state. If the
+     *        journal is not valid the first write is a full compaction.
+     * @param fileState Contents of the JSON file the state was loaded from.
+     */
+    void start(const std::string &path, std::chrono::milliseconds debounce, const JournalReplayResult &journal,
+               ProfileFileState fileState);
+
+    /**
+     * @brief Queues a change for writing. Never blocks on disk I/O.
+     * @param snapshot Profile list including the change (used for compaction).
+     * @param change Journal record for the change.
+     */
+    void post(ProfileSnapshotPtr snapshot, const ProfileChange &change);
+
+    /**
+     * @brief Queues a full rewrite of the JSON file (for edits that have no journal record).
+     */
+    void postFullSave(ProfileSnapshotPtr snapshot);
+
+    /**
+     * @brief Compacts to the given snapshot on the calling thread, superseding pending work.
+     * @return true if the JSON file was replaced successfully.
+     */
+    bool writeNow(const ProfileSnapshotPtr &snapshot);
+
+    /**
+     * @brief Stops the worker and writes any still-pending changes synchronously.
+     * @details Safe to call more than once.
+     */
+    void stop();
+
+    /**
+     * @brief Returns what the JSON file holds, waiting for a write in progress to finish.
+     */
+    ProfileFileState fileState();
+
+    /**
+     * @brief Records that another program replaced the JSON file.
+     * @details The journal belongs to the old file, so the next write is a full compaction.
+     * Holds the write lock from the check to the adoption, so no save can land in between.
+     * @param expectedFingerprint Fingerprint the edit was diffed against (from fileState()).
+     * @param apply Applies the edit to the live profiles; called only if the file state
+     *        still has expectedFingerprint.
+     * @return false if a save replaced the file since expectedFingerprint was read
+     *         (nothing is applied or adopted).
+     */
+    bool adoptExternalFile(const std::string &expectedFingerprint, ProfileFileState fileState,
+                           const std::function<void()> &apply);
+
+    /**
+     * @brief FNV-1a hash of a profiles file's bytes, as hex.
+     */
+    static std::string fingerprintOf(const std::string &bytes);
+
+    /**
+     * @brief Replays the journal next to a profiles JSON file onto its loaded contents.
+     * @param path Full path of the profiles JSON file.
+     * @param snapshotBytes Exact bytes of the JSON file the profiles were parsed from.
+     * @param profiles Store built from snapshotBytes; modified in place.
+     */
+    static JournalReplayResult replayJournal(const std::string &path, const std::string &snapshotBytes,
+                                             ProfileStore &profiles);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void workerLoop();
+    bool persist(const ProfileSnapshotPtr &snapshot, const std::vector<ProfileChange> &changes, bool compact);
+    bool compactTo(const ProfileSnapshot &snapshot);
+    bool appendToJournal(const std::string &lines);
+
+    std::string m_path;
+    std::string m_journalPath;
+    std::chrono::milliseconds m_debounce;
+
+    std::thread m_worker;
+    std::mutex m_mutex; // Protects the fields below
+    std::condition_variable m_wakeup;
+    ProfileSnapshotPtr m_pending;               // Newest snapshot not yet on disk
+    std::vector<ProfileChange> m_pendingChanges; // Records leading up to m_pending
+    bool m_compactRequested;                    // Some pending edit has no journal record
+    bool m_stopRequested;
+    Clock::time_point m_lastWriteTime;
+
+    std::mutex m_writeMutex;    // Serializes file writes between the worker and writeNow()
+    uint64_t m_writtenRevision; // Newest revision on disk (guarded by m_writeMutex)
+    bool m_journalValid;        // Journal on disk matches the JSON file (guarded by m_writeMutex)
+    uint64_t m_journalBytes;    // Current journal size (guarded by m_writeMutex)
+    ProfileFileState m_fileState; // Contents of the JSON file (guarded by m_writeMutex)
+};
+
+#endif // PROFILE_PERSISTENCE_H
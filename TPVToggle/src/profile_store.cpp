@@ -0,0 +1,241 @@
+/**
+ * @file profile_store.cpp
+ * @brief Implementation of the indexed camera profile store.
+ */
+
+#include "profile_store.h"
+
+#include <algorithm>
+#include <atomic>
+
+// --- StringPool ---
+
+const std::string *StringPool::intern(const std::string &value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return &*m_strings.insert(value).first;
+}
+
+// --- ProfileStore ---
+
+ProfileStore::ProfileStore(std::shared_ptr<StringPool> pool)
+    : m_pool(pool ? std::move(pool) : std::make_shared<StringPool>()),
+      m_nextId(INVALID_PROFILE_ID + 1)
+{
+}
+
+const StoredProfile *ProfileStore::findById(ProfileId id) const
+{
+    auto it = m_indexById.find(id);
+    return it != m_indexById.end() ? &m_profiles[it->second] : nullptr;
+}
+
+const StoredProfile *ProfileStore::findByName(const std::string &name) const
+{
+    auto it = m_idsByName.find(name);
+    if (it == m_idsByName.end())
+        return nullptr;
+
+    // Usually one ID; duplicates resolve to the first in display order
+    size_t first = npos;
+    for (ProfileId id : it->second)
+    {
+        first = std::min(first, m_indexById.at(id));
+    }
+    return &m_profiles[first];
+}
+
+size_t ProfileStore::indexOf(ProfileId id) const
+{
+    auto it = m_indexById.find(id);
+    return it != m_indexById.end() ? it->second : npos;
+}
+
+std::vector<size_t> ProfileStore::indicesInCategory(const std::string &category) const
+{
+    std::vector<size_t> indices;
+    auto it = m_idsByCategory.find(category);
+    if (it == m_idsByCategory.end())
+        return indices;
+
+    indices.reserve(it->second.size());
+    for (ProfileId id : it->second)
+    {
+        indices.push_back(m_indexById.at(id));
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+ProfileId ProfileStore::insert(size_t position, const CameraProfile &profile)
+{
+    ProfileId id = profile.id;
+    if (id == INVALID_PROFILE_ID || m_indexById.count(id) != 0)
+    {
+        id = m_nextId;
+    }
+    m_nextId = std::max<ProfileId>(m_nextId, id + 1);
+
+    StoredProfile stored;
+    stored.id = id;
+    stored.name = m_pool->intern(profile.name);
+    stored.category = m_pool->intern(profile.category);
+    stored.transitionCurve = m_pool->intern(profile.transitionCurve);
+    stored.offset = profile.offset;
+    stored.timestamp = profile.timestamp;
+
+    position = std::min(position, m_profiles.size());
+    m_profiles.insert(m_profiles.begin() + position, std::move(stored));
+    reindexFrom(position);
+
+    const StoredProfile &inserted = m_profiles[position];
+    m_idsByName[*inserted.name].push_back(id);
+    m_idsByCategory[*inserted.category].push_back(id);
+    return id;
+}
+
+bool ProfileStore::erase(ProfileId id)
+{
+    const size_t position = indexOf(id);
+    if (position == npos)
+        return false;
+
+    const StoredProfile removed = m_profiles[position];
+    m_profiles.erase(m_profiles.begin() + position);
+    m_indexById.erase(id);
+    reindexFrom(position);
+
+    unindex(m_idsByName, removed.name, id);
+    unindex(m_idsByCategory, removed.category, id);
+    return true;
+}
+
+bool ProfileStore::setOffset(ProfileId id, const Vector3 &offset, const std::string &timestamp)
+{
+    const size_t position = indexOf(id);
+    if (position == npos)
+        return false;
+
+    m_profiles[position].offset = offset;
+    m_profiles[position].timestamp = timestamp;
+    return true;
+}
+
+bool ProfileStore::rename(ProfileId id, const std::string &name, const std::string &timestamp)
+{
+    const size_t position = indexOf(id);
+    if (position == npos)
+        return false;
+
+    StoredProfile &profile = m_profiles[position];
+    unindex(m_idsByName, profile.name, id);
+    profile.name = m_pool->intern(name);
+    profile.timestamp = timestamp;
+    m_idsByName[*profile.name].push_back(id);
+    return true;
+}
+
+bool ProfileStore::setCategory(ProfileId id, const std::string &category, const std::string &timestamp)
+{
+    const size_t position = indexOf(id);
+    if (position == npos)
+        return false;
+
+    StoredProfile &profile = m_profiles[position];
+    unindex(m_idsByCategory, profile.category, id);
+    profile.category = m_pool->intern(category);
+    profile.timestamp = timestamp;
+    m_idsByCategory[*profile.category].push_back(id);
+    return true;
+}
+
+bool ProfileStore::setTransitionCurve(ProfileId id, const std::string &curve, const std::string &timestamp)
+{
+    const size_t position = indexOf(id);
+    if (position == npos)
+        return false;
+
+    m_profiles[position].transitionCurve = m_pool->intern(curve);
+    m_profiles[position].timestamp = timestamp;
+    return true;
+}
+
+bool ProfileStore::moveTo(ProfileId id, size_t position)
+{
+    const size_t from = indexOf(id);
+    if (from == npos)
+        return false;
+
+    position = std::min(position, m_profiles.size() - 1);
+    if (from == position)
+        return true;
+
+    if (from > position)
+        std::rotate(m_profiles.begin() + position, m_profiles.begin() + from, m_profiles.begin() + from + 1);
+    else
+        std::rotate(m_profiles.begin() + from, m_profiles.begin() + from + 1, m_profiles.begin() + position + 1);
+    reindexFrom(std::min(from, position));
+    return true;
+}
+
+void ProfileStore::reindexFrom(size_t position)
+{
+    for (size_t i = position; i < m_profiles.size(); ++i)
+    {
+        m_indexById[m_profiles[i].id] = i;
+    }
+}
+
+void ProfileStore::unindex(IdsByString &index, const std::string *key, ProfileId id)
+{
+    auto it = index.find(*key);
+    if (it == index.end())
+        return;
+
+    auto &ids = it->second;
+    ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+    if (ids.empty())
+        index.erase(it);
+}
+
+// --- ProfileStoreWriter ---
+
+void ProfileStoreWriter::reset(std::shared_ptr<ProfileStore> store)
+{
+    m_store = std::move(store);
+    m_shared = false;
+    m_spare.reset();
+    m_pendingEdits.clear();
+}
+
+std::shared_ptr<const ProfileStore> ProfileStoreWriter::share()
+{
+    m_shared = true;
+    return m_store;
+}
+
+ProfileStore &ProfileStoreWriter::writable()
+{
+    if (!m_shared)
+        return *m_store;
+
+    // Nobody else holds the spare, and nobody can get it again: it is only reachable through snapshots
+    // that were already replaced. The fence pairs with the release of the last reader's reference.
+    if (m_spare && m_spare.use_count() == 1)
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        for (Edit &edit : m_pendingEdits)
+            edit(*m_spare);
+        std::swap(m_store, m_spare);
+    }
+    else
+    {
+        m_spare = m_store;
+        m_store = std::make_shared<ProfileStore>(*m_spare);
+        ++m_copies;
+    }
+
+    m_pendingEdits.clear();
+    m_shared = false;
+    return *m_store;
+}
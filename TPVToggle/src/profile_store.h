@@ -0,0 +1,222 @@
+/**
+ * @file profile_store.h
+ * @brief Indexed storage for camera profiles with stable IDs.
+ *
+ * Profiles keep their display order (Default first) but are addressed by a
+ * stable ProfileId that survives deletes and is persisted in the profiles
+ * file. Name, category and curve strings are interned, so lookups by name or by
+ * category hash the query once against views of the pooled strings, and
+ * copying a store (for copy-on-write snapshots) copies no string data except
+ * timestamps. ProfileStoreWriter avoids even that copy on the common path by
+ * replaying edits onto a store readers have let go of.
+ */
+#ifndef PROFILE_STORE_H
+#define PROFILE_STORE_H
+
+#include "math_utils.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/** @brief Stable identifier of a profile, unique within a profiles file and kept across renames and deletes of other profiles. */
+using ProfileId = uint32_t;
+
+/** @brief Reserved "no profile" ID. */
+constexpr ProfileId INVALID_PROFILE_ID = 0;
+
+// Structure to represent a saved camera profile's persistent state
+struct CameraProfile
+{
+    std::string name;
+    Vector3 offset; // The *SAVED* offset for this profile
+    std::string category;
+    std::string timestamp; // Last saved timestamp
+    ProfileId id;          // Stable ID (INVALID_PROFILE_ID until stored)
+    std::string transitionCurve; // Easing curve spec for transitions to this profile; empty = configured default
+
+    CameraProfile(const std::string &profile_name = "Default",
+                  const Vector3 &profile_offset = Vector3(0.0f, 0.0f, 0.0f),
+                  const std::string &profile_category = "General",
+                  const std::string &profile_timestamp = "",
+                  ProfileId profile_id = INVALID_PROFILE_ID)
+        : name(profile_name), offset(profile_offset), category(profile_category), timestamp(profile_timestamp), id(profile_id) {}
+};
+
+/**
+ * @class StringPool
+ * @brief Append-only set of interned strings shared by a store and its copies.
+ * @details Returned pointers stay valid for the pool's lifetime. Thread-safe.
+ * Only writers intern; readers go through the store's indexes and never
+ * touch the pool (or its mutex).
+ */
+class StringPool
+{
+public:
+    /** @brief Returns the pooled copy of value, adding it if needed. */
+    const std::string *intern(const std::string &value);
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_set<std::string> m_strings; // Node-based: element addresses are stable
+};
+
+/**
+ * @struct StoredProfile
+ * @brief A profile as held by ProfileStore (interned name and category).
+ */
+struct StoredProfile
+{
+    ProfileId id;
+    const std::string *name;
+    const std::string *category;
+    const std::string *transitionCurve;
+    Vector3 offset;
+    std::string timestamp;
+
+    CameraProfile toProfile() const
+    {
+        CameraProfile profile(*name, offset, *category, timestamp, id);
+        profile.transitionCurve = *transitionCurve;
+        return profile;
+    }
+};
+
+/**
+ * @class ProfileStore
+ * @brief Ordered profile list with hash indexes by ID, name and category.
+ *
+ * Lookups are O(1) on average (O(k) for a name shared by k profiles, which
+ * only hand-edited files produce). Inserting, erasing or moving a profile
+ * rewrites the ID -> position entry of every profile after it: O(n - position)
+ * hash writes, about 0.1 ms at the front of a 10,000-profile store (see
+ * bench_profile_store.cpp). The manager creates profiles at the end, so the
+ * common path is O(1). Not thread-safe; CameraProfileManager serializes
+ * writers and shares read-only copies.
+ */
+class ProfileStore
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @param pool String pool to intern into; a new one is created if null.
+     */
+    explicit ProfileStore(std::shared_ptr<StringPool> pool = nullptr);
+
+    // --- Read access ---
+    size_t size() const { return m_profiles.size(); }
+    bool empty() const { return m_profiles.empty(); }
+    /** @brief All profiles in display order. */
+    const std::vector<StoredProfile> &profiles() const { return m_profiles; }
+    const StoredProfile &at(size_t index) const { return m_profiles[index]; }
+    const StoredProfile *findById(ProfileId id) const;
+    /** @brief First profile (in display order) with this name, or nullptr. */
+    const StoredProfile *findByName(const std::string &name) const;
+    /** @brief Display position of id, or npos. */
+    size_t indexOf(ProfileId id) const;
+    /** @brief Display positions of all profiles in category, ascending. */
+    std::vector<size_t> indicesInCategory(const std::string &category) const;
+    /** @brief ID the next inserted profile without an ID will get. */
+    ProfileId nextId() const { return m_nextId; }
+    const std::shared_ptr<StringPool> &stringPool() const { return m_pool; }
+
+    // --- Mutation ---
+    /**
+     * @brief Inserts a profile at a display position (clamped to the end).
+     * @details Keeps profile.id if it is set and unused, otherwise assigns a new ID.
+     * @return The ID of the inserted profile.
+     */
+    ProfileId insert(size_t position, const CameraProfile &profile);
+    ProfileId append(const CameraProfile &profile) { return insert(m_profiles.size(), profile); }
+    bool erase(ProfileId id);
+    bool setOffset(ProfileId id, const Vector3 &offset, const std::string &timestamp);
+    bool rename(ProfileId id, const std::string &name, const std::string &timestamp);
+    bool setCategory(ProfileId id, const std::string &category, const std::string &timestamp);
+    bool setTransitionCurve(ProfileId id, const std::string &curve, const std::string &timestamp);
+    /** @brief Moves a profile to a new display position. */
+    bool moveTo(ProfileId id, size_t position);
+
+private:
+    // Interned string -> IDs. Keys view pooled strings, which outlive the store.
+    using IdsByString = std::unordered_map<std::string_view, std::vector<ProfileId>>;
+
+    /** @brief Rewrites m_indexById for positions >= position: O(n - position). */
+    void reindexFrom(size_t position);
+    static void unindex(IdsByString &index, const std::string *key, ProfileId id);
+
+    std::shared_ptr<StringPool> m_pool;
+    std::vector<StoredProfile> m_profiles;             // Display order
+    std::unordered_map<ProfileId, size_t> m_indexById; // ID -> position
+    IdsByString m_idsByName;                           // Name -> IDs (more than one only in hand-edited files)
+    IdsByString m_idsByCategory;                       // Category -> IDs
+    ProfileId m_nextId;
+};
+
+/**
+ * @class ProfileStoreWriter
+ * @brief The writer's ProfileStore, shared with readers without copying it on every edit.
+ *
+ * share() hands the current store out read-only; the next edit must not
+ * touch it. Instead of copying all n profiles, the writer takes back the
+ * store it shared the time before (the spare), once nobody holds it any
+ * more, and replays the edits made since onto it. Each edit therefore costs
+ * its own work plus replaying the previous one. Only when the spare is still
+ * in use (a reader or the save worker is holding an older snapshot) is the
+ * store copied. Not thread-safe; CameraProfileManager calls it under its lock.
+ */
+class ProfileStoreWriter
+{
+public:
+    using Edit = std::function<void(ProfileStore &)>;
+
+    explicit ProfileStoreWriter(std::shared_ptr<ProfileStore> store = std::make_shared<ProfileStore>())
+        : m_store(std::move(store)), m_shared(false) {}
+
+    const ProfileStore &operator*() const { return *m_store; }
+    const ProfileStore *operator->() const { return m_store.get(); }
+
+    /** @brief Replaces the whole store (loading a file); pending edits and the spare are dropped. */
+    void reset(std::shared_ptr<ProfileStore> store);
+
+    /** @brief The current store, read-only; later edits go to another store. */
+    std::shared_ptr<const ProfileStore> share();
+
+    /**
+     * @brief Applies edit to a store no reader can see.
+     * @param edit Called once now and possibly once more on the spare, so it must
+     *             capture by value and do the same thing both times.
+     * @return Whatever edit returns.
+     */
+    template <typename Fn>
+    auto apply(Fn edit) -> decltype(edit(std::declval<ProfileStore &>()))
+    {
+        ProfileStore &store = writable();
+        if (m_spare)
+        {
+            m_pendingEdits.emplace_back([edit](ProfileStore &spare) mutable
+                                        { edit(spare); });
+        }
+        return edit(store);
+    }
+
+    /** @brief Stores built by copying instead of replaying since construction (for benchmarks and logs). */
+    uint64_t copyCount() const { return m_copies; }
+
+private:
+    ProfileStore &writable();
+
+    std::shared_ptr<ProfileStore> m_store;
+    bool m_shared;                         // m_store has been handed out by share()
+    std::shared_ptr<ProfileStore> m_spare; // Previously shared store, behind m_store by m_pendingEdits
+    std::vector<Edit> m_pendingEdits;      // Edits since m_spare matched m_store
+    uint64_t m_copies = 0;
+};
+
+#endif // PROFILE_STORE_H
@@ -0,0 +1,169 @@
+/**
+ * @file profile_zone_index.cpp
+ * @brief Implementation of profile zone containment and the zone grid index.
+ */
+
+#include "profile_zone_index.h"
+#include "constants.h"
+
+#include <algorithm>
+#include <cmath>
+
+// --- ProfileZone ---
+
+bool ProfileZone::contains(const Vector3 &point, float margin) const
+{
+    if (shape == Shape::Sphere)
+    {
+        const float reach = radius + margin;
+        return (point - center).MagnitudeSquared() <= reach * reach;
+    }
+    return point.x >= min.x - margin && point.x <= max.x + margin &&
+           point.y >= min.y - margin && point.y <= max.y + margin &&
+           point.z >= min.z - margin && point.z <= max.z + margin;
+}
+
+// --- ProfileZoneIndex ---
+
+ProfileZoneIndex::ProfileZoneIndex(float cellSize)
+    : m_cellSize(cellSize),
+      m_inverseCellSize(1.0f / cellSize)
+{
+}
+
+int32_t ProfileZoneIndex::cellCoord(float value) const
+{
+    // Clamped before the cast: converting an out-of-range float to int is undefined.
+    // Clamped coordinates land in edge cells, where the exact test still rejects them.
+    constexpr float limit = static_cast<float>((1 << 20) - 1); // cellKey's range
+    return static_cast<int32_t>(std::clamp(std::floor(value * m_inverseCellSize), -limit, limit));
+}
+
+uint64_t ProfileZoneIndex::cellKey(int32_t x, int32_t y, int32_t z)
+{
+    // 21 bits per axis (about +-1M cells); far outside any game world
+    constexpr uint32_t bias = 1u << 20;
+    constexpr uint64_t mask = (1u << 21) - 1;
+    return ((static_cast<uint64_t>(x + bias) & mask) << 42) |
+           ((static_cast<uint64_t>(y + bias) & mask) << 21) |
+           (static_cast<uint64_t>(z + bias) & mask);
+}
+
+bool ProfileZoneIndex::contains(uint32_t index, const Vector3 &point) const
+{
+    const ZoneBounds &b = m_bounds[index];
+    if (point.x < b.min.x || point.x > b.max.x || point.y < b.min.y || point.y > b.max.y ||
+        point.z < b.min.z || point.z > b.max.z)
+        return false;
+    return !b.sphere || (point - b.center).MagnitudeSquared() <= b.radiusSquared;
+}
+
+bool ProfileZoneIndex::better(uint32_t candidate, uint32_t current) const
+{
+    if (current == npos)
+        return true;
+    const ZoneBounds &a = m_bounds[candidate];
+    const ZoneBounds &b = m_bounds[current];
+    if (a.priority != b.priority)
+        return a.priority > b.priority;
+    if (a.volume != b.volume)
+        return a.volume < b.volume; // The more specific zone
+    return candidate < current;     // Stable: earlier in the file
+}
+
+void ProfileZoneIndex::build(std::vector<ProfileZone> zones)
+{
+    m_zones = std::move(zones);
+    m_cells.clear();
+    m_cellZones.clear();
+    m_largeZones.clear();
+
+    m_bounds.clear();
+    m_bounds.reserve(m_zones.size());
+    for (const ProfileZone &zone : m_zones)
+    {
+        const bool sphere = zone.shape == ProfileZone::Shape::Sphere;
+        m_bounds.push_back({zone.min, zone.max, zone.center, sphere ? zone.radius * zone.radius : 0.0f,
+                            zone.priority, zone.volume, sphere});
+    }
+
+    // Visits every grid cell a zone's bounding box touches
+    auto forEachCell = [this](const ProfileZone &zone, auto &&visit)
+    {
+        const int32_t x0 = cellCoord(zone.min.x), x1 = cellCoord(zone.max.x);
+        const int32_t y0 = cellCoord(zone.min.y), y1 = cellCoord(zone.max.y);
+        const int32_t z0 = cellCoord(zone.min.z), z1 = cellCoord(zone.max.z);
+        for (int32_t x = x0; x <= x1; ++x)
+            for (int32_t y = y0; y <= y1; ++y)
+                for (int32_t z = z0; z <= z1; ++z)
+                    visit(cellKey(x, y, z));
+    };
+    auto cellCount = [this](const ProfileZone &zone)
+    {
+        return static_cast<uint64_t>(cellCoord(zone.max.x) - cellCoord(zone.min.x) + 1) *
+               static_cast<uint64_t>(cellCoord(zone.max.y) - cellCoord(zone.min.y) + 1) *
+               static_cast<uint64_t>(cellCoord(zone.max.z) - cellCoord(zone.min.z) + 1);
+    };
+
+    // Pass 1: count zones per cell
+    std::vector<bool> large(m_zones.size(), false);
+    for (uint32_t i = 0; i < m_zones.size(); ++i)
+    {
+        if (cellCount(m_zones[i]) > Constants::PROFILE_ZONE_MAX_CELLS)
+        {
+            large[i] = true;
+            m_largeZones.push_back(i);
+            continue;
+        }
+        forEachCell(m_zones[i], [this](uint64_t key)
+                    { ++m_cells[key].count; });
+    }
+
+    // Assign each cell its range
+    uint32_t next = 0;
+    for (auto &cell : m_cells)
+    {
+        cell.second.begin = next;
+        next += cell.second.count;
+        cell.second.count = 0; // Refilled below
+    }
+
+    // Pass 2: fill the ranges
+    m_cellZones.resize(next);
+    for (uint32_t i = 0; i < m_zones.size(); ++i)
+    {
+        if (large[i])
+            continue;
+        forEachCell(m_zones[i], [this, i](uint64_t key)
+                    {
+                        CellRange &range = m_cells[key];
+                        m_cellZones[range.begin + range.count++] = i; });
+    }
+}
+
+uint32_t ProfileZoneIndex::find(const Vector3 &point) const
+{
+    uint32_t best = npos;
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z))
+        return best;
+
+    auto it = m_cells.find(cellKey(cellCoord(point.x), cellCoord(point.y), cellCoord(point.z)));
+    if (it != m_cells.end())
+    {
+        const uint32_t *candidates = m_cellZones.data() + it->second.begin;
+        for (uint32_t i = 0; i < it->second.count; ++i)
+        {
+            const uint32_t candidate = candidates[i];
+            if (contains(candidate, point) && better(candidate, best))
+                best = candidate;
+        }
+    }
+
+    for (uint32_t candidate : m_largeZones)
+    {
+        if (contains(candidate, point) && better(candidate, best))
+            best = candidate;
+    }
+
+    return best;
+}
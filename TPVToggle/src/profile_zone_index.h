@@ -0,0 +1,105 @@
+/**
+ * @file profile_zone_index.h
+ * @brief World-space profile zones and the grid index that finds the zone at a point.
+ *
+ * Kept apart from ProfileZoneManager (profile_zones.h) so the lookup has no
+ * dependency on the profile manager or the game.
+ */
+#ifndef PROFILE_ZONE_INDEX_H
+#define PROFILE_ZONE_INDEX_H
+
+#include "math_utils.h"
+#include "profile_store.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct ProfileZone
+ * @brief A named world-space volume that selects a camera profile.
+ */
+struct ProfileZone
+{
+    enum class Shape
+    {
+        Box,
+        Sphere
+    };
+
+    std::string name;
+    ProfileId profileId;
+    Shape shape;
+    Vector3 min, max; // Box bounds; for spheres the bounding box of the sphere
+    Vector3 center;   // Sphere only
+    float radius;     // Sphere only
+    int priority;     // Where zones overlap the higher priority wins, then the smaller zone
+    float volume;
+
+    /** @brief Point-in-zone test, with the zone grown by margin on every side. */
+    bool contains(const Vector3 &point, float margin = 0.0f) const;
+};
+
+/**
+ * @class ProfileZoneIndex
+ * @brief Uniform-grid spatial index answering "which zone contains this point".
+ *
+ * Each zone is listed in every grid cell its bounding box touches, so a
+ * query looks at one cell and tests only the zones listed there (O(1) on
+ * average). Zones covering more than Constants::PROFILE_ZONE_MAX_CELLS
+ * cells are kept in a separate list that every query tests, which keeps
+ * huge outdoor zones from bloating the grid. Cells are stored flat: one
+ * hash lookup yields a contiguous range of zone indices, and the containment
+ * test reads a compact copy of each zone's bounds rather than the full zone.
+ */
+class ProfileZoneIndex
+{
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    explicit ProfileZoneIndex(float cellSize);
+
+    /** @brief Replaces the indexed zones. */
+    void build(std::vector<ProfileZone> zones);
+
+    /** @brief Best zone containing point (see ProfileZone::priority), or npos (also for non-finite points). */
+    uint32_t find(const Vector3 &point) const;
+
+    const ProfileZone &zone(uint32_t index) const { return m_zones[index]; }
+    size_t size() const { return m_zones.size(); }
+
+private:
+    struct CellRange
+    {
+        uint32_t begin;
+        uint32_t count;
+    };
+
+    // What find() needs per zone, packed without the name
+    struct ZoneBounds
+    {
+        Vector3 min, max;
+        Vector3 center;
+        float radiusSquared; // 0 for boxes
+        int priority;
+        float volume;
+        bool sphere;
+    };
+
+    bool contains(uint32_t index, const Vector3 &point) const;
+
+    int32_t cellCoord(float value) const;
+    static uint64_t cellKey(int32_t x, int32_t y, int32_t z);
+    bool better(uint32_t candidate, uint32_t current) const;
+
+    float m_cellSize;
+    float m_inverseCellSize;
+    std::vector<ProfileZone> m_zones;
+    std::vector<ZoneBounds> m_bounds;                // Parallel to m_zones
+    std::unordered_map<uint64_t, CellRange> m_cells; // Cell -> range in m_cellZones
+    std::vector<uint32_t> m_cellZones;               // Zone indices grouped by cell
+    std::vector<uint32_t> m_largeZones;              // Zones tested by every query
+};
+
+#endif // PROFILE_ZONE_INDEX_H
@@ -0,0 +1,268 @@
+/**
+ * @file profile_zones.cpp
+ * @brief Implementation of the profile zone index and zone-driven profile switching.
+ */
+
+#include "profile_zones.h"
+#include "camera_profile.h"
+#include "constants.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+    bool vectorFromJson(const json &obj, Vector3 &out)
+    {
+        if (!obj.is_object())
+            return false;
+        for (const char *axis : {"x", "y", "z"})
+        {
+            auto it = obj.find(axis);
+            if (it == obj.end() || !it->is_number())
+                return false;
+        }
+        out = Vector3(obj["x"].get<float>(), obj["y"].get<float>(), obj["z"].get<float>());
+        return true;
+    }
+
+    bool zoneFromJson(const json &obj, ProfileZone &zone, std::string &error)
+    {
+        if (!obj.is_object())
+        {
+            error = "entry is not an object";
+            return false;
+        }
+
+        auto id_it = obj.find("profileId");
+        if (id_it == obj.end() || !id_it->is_number_unsigned() || id_it->get<uint64_t>() == INVALID_PROFILE_ID)
+        {
+            error = "missing or invalid \"profileId\"";
+            return false;
+        }
+        zone.profileId = id_it->get<ProfileId>();
+        zone.name = obj.value("name", std::string("Unnamed Zone"));
+        zone.priority = obj.value("priority", 0);
+
+        if (obj.contains("box"))
+        {
+            const json &box = obj["box"];
+            Vector3 a, b;
+            if (!box.is_object() || !box.contains("min") || !box.contains("max") ||
+                !vectorFromJson(box["min"], a) || !vectorFromJson(box["max"], b))
+            {
+                error = "\"box\" needs numeric \"min\" and \"max\"";
+                return false;
+            }
+            zone.shape = ProfileZone::Shape::Box;
+            zone.min = Vector3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+            zone.max = Vector3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+            zone.center = (zone.min + zone.max) * 0.5f;
+            zone.radius = 0.0f;
+            const Vector3 size = zone.max - zone.min;
+            zone.volume = size.x * size.y * size.z;
+            return true;
+        }
+
+        if (obj.contains("sphere"))
+        {
+            const json &sphere = obj["sphere"];
+            if (!sphere.is_object() || !sphere.contains("center") || !vectorFromJson(sphere["center"], zone.center) ||
+                !sphere.contains("radius") || !sphere["radius"].is_number() || sphere["radius"].get<float>() <= 0.0f)
+            {
+                error = "\"sphere\" needs a numeric \"center\" and a positive \"radius\"";
+                return false;
+            }
+            zone.shape = ProfileZone::Shape::Sphere;
+            zone.radius = sphere["radius"].get<float>();
+            const Vector3 extent(zone.radius, zone.radius, zone.radius);
+            zone.min = zone.center - extent;
+            zone.max = zone.center + extent;
+            zone.volume = 4.18879f * zone.radius * zone.radius * zone.radius; // 4/3 pi r^3
+            return true;
+        }
+
+        error = "needs a \"box\" or a \"sphere\"";
+        return false;
+    }
+}
+
+// --- ProfileZoneManager ---
+
+ProfileZoneManager &ProfileZoneManager::getInstance()
+{
+    static ProfileZoneManager instance;
+    return instance;
+}
+
+ProfileZoneManager::ProfileZoneManager()
+    : m_index(Constants::PROFILE_ZONE_CELL_SIZE),
+      m_locatedZone(ProfileZoneIndex::npos),
+      m_activeZone(ProfileZoneIndex::npos),
+      m_zoneProfile(INVALID_PROFILE_ID),
+      m_profileOutsideZones(INVALID_PROFILE_ID)
+{
+}
+
+bool ProfileZoneManager::loadZones(const std::string &directory)
+{
+    Logger &logger = Logger::getInstance();
+    const std::filesystem::path path = std::filesystem::path(directory) / (std::string(Constants::MOD_NAME) + "_Zones.json");
+    const std::string path_string = path.lexically_normal().string();
+
+    std::vector<ProfileZone> zones;
+
+    if (!std::filesystem::exists(path))
+    {
+        logger.log(LOG_INFO, "ProfileZoneManager: No zones file at " + path_string + ". Zone switching inactive.");
+    }
+    else
+    {
+        try
+        {
+            std::ifstream file(path);
+            if (!file.is_open())
+            {
+                logger.log(LOG_ERROR, "ProfileZoneManager: Failed to open zones file: " + path_string);
+                return false;
+            }
+            const json root = json::parse(file);
+            if (!root.is_array())
+            {
+                logger.log(LOG_ERROR, "ProfileZoneManager: Zones file must contain an array: " + path_string);
+                return false;
+            }
+
+            zones.reserve(root.size());
+            for (size_t i = 0; i < root.size(); ++i)
+            {
+                ProfileZone zone;
+                std::string error;
+                if (zoneFromJson(root[i], zone, error))
+                    zones.push_back(std::move(zone));
+                else
+                    logger.log(LOG_WARNING, "ProfileZoneManager: Skipping zone #" + std::to_string(i) + ": " + error + ".");
+            }
+        }
+        catch (const std::exception &e)
+        {
+            logger.log(LOG_ERROR, "ProfileZoneManager: Error reading zones file: " + std::string(e.what()) + ". File: " + path_string);
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> switch_lock(m_switchMutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.build(std::move(zones));
+    m_locatedZone = ProfileZoneIndex::npos;
+    m_activeZone = ProfileZoneIndex::npos;
+    m_zoneProfile = INVALID_PROFILE_ID;
+    m_profileOutsideZones = INVALID_PROFILE_ID;
+    if (m_index.size() > 0)
+    {
+        logger.log(LOG_INFO, "ProfileZoneManager: Loaded " + std::to_string(m_index.size()) + " profile zones.");
+    }
+    return true;
+}
+
+size_t ProfileZoneManager::getZoneCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.size();
+}
+
+bool ProfileZoneManager::locate(const Vector3 &playerPosition)
+{
+    if (!std::isfinite(playerPosition.x) || !std::isfinite(playerPosition.y) || !std::isfinite(playerPosition.z))
+        return false; // Garbage from a half-loaded entity; keep the current zone
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_index.size() == 0)
+        return false;
+
+    uint32_t zone = m_index.find(playerPosition);
+
+    // Hysteresis: leaving to "no zone" needs a clear step outside, so standing
+    // on a boundary does not flip profiles back and forth
+    if (zone == ProfileZoneIndex::npos && m_locatedZone != ProfileZoneIndex::npos &&
+        m_index.zone(m_locatedZone).contains(playerPosition, Constants::PROFILE_ZONE_EXIT_MARGIN))
+    {
+        zone = m_locatedZone;
+    }
+
+    if (zone == m_locatedZone)
+        return false;
+    m_locatedZone = zone;
+    return true;
+}
+
+void ProfileZoneManager::applyZoneChange()
+{
+    std::lock_guard<std::mutex> switch_lock(m_switchMutex);
+
+    uint32_t zone;
+    ProfileId zone_profile = INVALID_PROFILE_ID;
+    std::string zone_name, left_name;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        zone = m_locatedZone;
+        if (zone == m_activeZone)
+            return; // Moved back before this ran
+        if (zone != ProfileZoneIndex::npos)
+        {
+            zone_profile = m_index.zone(zone).profileId;
+            zone_name = m_index.zone(zone).name;
+        }
+        if (m_activeZone != ProfileZoneIndex::npos)
+            left_name = m_index.zone(m_activeZone).name;
+    }
+
+    const ProfileId current = CameraProfileManager::getInstance().getCurrentProfileId();
+    if (m_activeZone == ProfileZoneIndex::npos || current != m_zoneProfile)
+    {
+        // Entering the first zone, or the user picked a profile by hand inside the
+        // last one: either way that is the profile to return to outside all zones
+        m_profileOutsideZones = current;
+    }
+
+    if (zone != ProfileZoneIndex::npos)
+    {
+        activateProfile(zone_profile, "entered zone '" + zone_name + "'");
+        m_zoneProfile = zone_profile;
+    }
+    else
+    {
+        activateProfile(m_profileOutsideZones, "left zone '" + left_name + "'");
+        m_zoneProfile = INVALID_PROFILE_ID;
+        m_profileOutsideZones = INVALID_PROFILE_ID;
+    }
+    m_activeZone = zone;
+}
+
+void ProfileZoneManager::activateProfile(ProfileId id, const std::string &reason)
+{
+    // Assumes m_switchMutex (not m_mutex) is held by caller
+    CameraProfileManager &profiles = CameraProfileManager::getInstance();
+    const auto set = profiles.getProfileSet();
+    if (!set || id == INVALID_PROFILE_ID)
+        return;
+
+    if (!set->store->findById(id))
+    {
+        Logger::getInstance().log(LOG_WARNING, "ProfileZoneManager: Player " + reason + ", but profile ID " +
+                                                   std::to_string(id) + " does not exist.");
+        return;
+    }
+    if (set->currentProfileId == id)
+        return; // Already active; re-activating would discard live adjustments
+
+    Logger::getInstance().log(LOG_INFO, "ProfileZoneManager: Player " + reason + ". Switching profile.");
+    profiles.setActiveProfileById(id, true); // Transition through TransitionManager
+}
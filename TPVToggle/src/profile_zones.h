@@ -0,0 +1,82 @@
+/**
+ * @file profile_zones.h
+ * @brief Location-aware camera profiles: world-space zones bound to profile IDs.
+ *
+ * Zones are read from KCD2_TPVToggle_Zones.json next to the profiles file:
+ * @code
+ * [
+ *   { "name": "Rattay Tavern", "profileId": 3, "priority": 1,
+ *     "box": { "min": {"x": 0, "y": 0, "z": 0}, "max": {"x": 20, "y": 15, "z": 8} } },
+ *   { "name": "Skalitz Fields", "profileId": 4,
+ *     "sphere": { "center": {"x": 100, "y": 200, "z": 30}, "radius": 150 } }
+ * ]
+ * @endcode
+ * Entering a zone activates its profile with a transition; leaving every zone
+ * returns to the profile that was active before the first one was entered,
+ * or to the profile the user picked by hand while inside.
+ *
+ * The zone lookup runs every frame on the render thread (locate()); profile
+ * switches happen on the input thread (applyZoneChange()), only when the
+ * located zone changes.
+ */
+#ifndef PROFILE_ZONES_H
+#define PROFILE_ZONES_H
+
+#include "profile_zone_index.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/**
+ * @class ProfileZoneManager
+ * @brief Loads zones and switches profiles as the player moves between them.
+ */
+class ProfileZoneManager
+{
+public:
+    static ProfileZoneManager &getInstance();
+
+    /**
+     * @brief Loads KCD2_TPVToggle_Zones.json from the given directory.
+     * @return true if the file was read (a missing file is not an error and yields no zones).
+     */
+    bool loadZones(const std::string &directory);
+
+    /**
+     * @brief Finds the zone containing the player. Called every frame (render thread).
+     * @details One grid lookup; never waits for a profile switch. Non-finite
+     *          positions (a half-loaded entity) are ignored.
+     * @param playerPosition Player world position (see GetPlayerWorldTransform).
+     * @return true if the player is now in a different zone (or in none), in
+     *         which case applyZoneChange() should run on the input thread.
+     */
+    bool locate(const Vector3 &playerPosition);
+
+    /**
+     * @brief Switches to the profile for the zone last located (input thread).
+     */
+    void applyZoneChange();
+
+    size_t getZoneCount() const;
+
+private:
+    ProfileZoneManager();
+    ~ProfileZoneManager() = default;
+
+    ProfileZoneManager(const ProfileZoneManager &) = delete;
+    ProfileZoneManager &operator=(const ProfileZoneManager &) = delete;
+
+    void activateProfile(ProfileId id, const std::string &reason);
+
+    mutable std::mutex m_mutex; // Protects the index and the located zone; never held while switching profiles
+    ProfileZoneIndex m_index;
+    uint32_t m_locatedZone; // Zone the player is in, or npos (written by locate())
+
+    std::mutex m_switchMutex;        // Protects the fields below (applyZoneChange() and loadZones())
+    uint32_t m_activeZone;           // Zone whose profile was last applied, or npos
+    ProfileId m_zoneProfile;         // Profile the zones last switched to
+    ProfileId m_profileOutsideZones; // Restored when the player leaves all zones
+};
+
+#endif // PROFILE_ZONES_H
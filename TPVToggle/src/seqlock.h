@@ -0,0 +1,144 @@
+/**
+ * @file seqlock.h
+ * @brief Lock-free snapshot for small values shared between threads.
+ *
+ * Used for camera/player state that is written by input threads and read every
+ * frame by the render thread (e.g., g_currentCameraOffset). Readers never take
+ * a lock, never retry and never wait for a writer: a read is one atomic
+ * increment, one copy and one more increment, however the writer is scheduled.
+ * Readers can never observe a value whose components come from different
+ * writes.
+ */
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @class SeqLock
+ * @brief Holds a trivially copyable value readable wait-free and without tearing.
+ * @tparam T Value type (Vector3, Quaternion, ...). Must be trivially copyable.
+ *
+ * Each write goes to a slot no reader is using and is then published by
+ * swapping the slot index into m_published. Readers pin the published slot
+ * by incrementing the reader count packed next to the index, copy it and
+ * record that they are done on the slot. A writer only reuses a slot once
+ * every reader that pinned it has left; with three slots it normally finds
+ * one immediately. Multiple writers are allowed and take turns on a flag.
+ */
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() : SeqLock(T()) {}
+
+    explicit SeqLock(const T &initial)
+    {
+        m_slots[0].value = initial;
+    }
+
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    /**
+     * @brief Returns a consistent copy of the current value.
+     * @details Wait-free: a fixed number of steps whatever the writers do.
+     */
+    T load() const
+    {
+        // Pins the published slot: its writer counts this reader before reusing it
+        const uint64_t state = m_published.fetch_add(1, std::memory_order_acquire);
+        const Slot &slot = m_slots[state >> INDEX_SHIFT];
+        const T result = slot.value;
+        slot.exited.fetch_add(1, std::memory_order_release);
+        return result;
+    }
+
+    /**
+     * @brief Publishes a new value atomically with respect to readers.
+     */
+    void store(const T &value)
+    {
+        lockWriters();
+        publish(value);
+        unlockWriters();
+    }
+
+    /**
+     * @brief Atomic read-modify-write (e.g., adding a delta to an offset).
+     * @param fn Callable taking `T &` and modifying it in place.
+     * @return The value that was published.
+     */
+    template <typename Fn>
+    T update(Fn &&fn)
+    {
+        lockWriters();
+
+        // Writers hold the flag, so the published slot cannot change under us
+        T value = m_slots[m_published.load(std::memory_order_relaxed) >> INDEX_SHIFT].value;
+        fn(value);
+        publish(value);
+
+        unlockWriters();
+        return value;
+    }
+
+private:
+    static constexpr size_t SLOT_COUNT = 3;
+    static constexpr unsigned INDEX_SHIFT = 62; // m_published: slot index above, readers of that slot below
+
+    struct Slot
+    {
+        T value{};
+        mutable std::atomic<uint64_t> exited{0}; // Readers done with this slot, ever
+        uint64_t entered = 0;                    // Readers that pinned it while published (writers only)
+    };
+
+    void lockWriters()
+    {
+        while (m_writing.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield(); // Another writer; writes are short
+    }
+
+    void unlockWriters()
+    {
+        m_writing.clear(std::memory_order_release);
+    }
+
+    void publish(const T &value)
+    {
+        const size_t current = static_cast<size_t>(m_published.load(std::memory_order_relaxed) >> INDEX_SHIFT);
+
+        // Any other slot whose readers have all left; only a reader preempted mid-copy makes this wait
+        size_t target = current;
+        for (;;)
+        {
+            for (size_t i = 1; i < SLOT_COUNT && target == current; ++i)
+            {
+                const size_t candidate = (current + i) % SLOT_COUNT;
+                if (m_slots[candidate].exited.load(std::memory_order_acquire) == m_slots[candidate].entered)
+                    target = candidate;
+            }
+            if (target != current)
+                break;
+            std::this_thread::yield();
+        }
+
+        m_slots[target].value = value;
+        const uint64_t previous = m_published.exchange(static_cast<uint64_t>(target) << INDEX_SHIFT,
+                                                       std::memory_order_acq_rel);
+        m_slots[current].entered += previous & ((uint64_t(1) << INDEX_SHIFT) - 1);
+    }
+
+    Slot m_slots[SLOT_COUNT];
+    mutable std::atomic<uint64_t> m_published{0};
+    std::atomic_flag m_writing = ATOMIC_FLAG_INIT;
+};
+
+#endif // SEQLOCK_H
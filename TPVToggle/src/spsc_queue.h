@@ -0,0 +1,81 @@
+/**
+ * @file spsc_queue.h
+ * @brief Bounded lock-free single-producer/single-consumer queue.
+ *
+ * Used to hand commands to the render thread (e.g., transition starts from
+ * the profile thread) without the render thread ever waiting on a lock.
+ * push() and pop() are wait-free: each is a couple of loads and one release
+ * store. Exactly one thread may push and one thread may pop at a time;
+ * several producers must serialize among themselves.
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @class SpscQueue
+ * @brief Fixed-capacity ring of T shared by one producer and one consumer.
+ * @tparam T Element type (default-constructible and move-assignable).
+ * @tparam Capacity Number of slots; must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * @brief Appends value (producer thread only).
+     * @return false if the queue is full; value is left untouched.
+     */
+    bool push(T &&value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_slots[tail & (Capacity - 1)] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element into out (consumer thread only).
+     * @return false if the queue is empty.
+     */
+    bool pop(T &out)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        out = std::move(m_slots[head & (Capacity - 1)]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief True if nothing is queued (exact only on the consumer thread). */
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    // Head and tail on separate cache lines so the two threads do not invalidate each other
+    alignas(CACHE_LINE) std::atomic<size_t> m_head; // Next slot to pop (written by the consumer)
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail; // Next slot to push (written by the producer)
+    alignas(CACHE_LINE) std::array<T, Capacity> m_slots;
+};
+
+#endif // SPSC_QUEUE_H
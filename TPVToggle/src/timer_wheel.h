@@ -0,0 +1,136 @@
+/**
+ * @file timer_wheel.h
+ * @brief Hashed timer wheel for delayed work on a single thread.
+ *
+ * Time is cut into fixed ticks and each tick hashes to one of Slots buckets,
+ * so scheduling is an append to one bucket and advancing only looks at the
+ * buckets of the ticks that passed. Delays longer than one turn of the wheel
+ * stay in their bucket until their tick comes round. Items fire on the first
+ * advance at or after their due time, at most one tick late.
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class TimerWheel
+ * @brief Holds items of type T until their due time. Not thread-safe.
+ * @tparam Slots Number of buckets; one turn of the wheel is Slots ticks.
+ */
+template <typename T, size_t Slots>
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheel(Clock::duration tick)
+        : m_tick(tick), m_origin(), m_current(0), m_count(0)
+    {
+    }
+
+    /** @brief Drops every item and starts counting ticks from now. */
+    void reset(Clock::time_point now)
+    {
+        for (std::vector<Entry> &slot : m_slots)
+            slot.clear();
+        m_origin = now;
+        m_current = 0;
+        m_count = 0;
+    }
+
+    /** @brief Adds item, due at due (times already past fire on the next advance). */
+    void schedule(Clock::time_point due, T item)
+    {
+        uint64_t tick = m_current;
+        if (due > m_origin)
+            tick = std::max<uint64_t>(tick, static_cast<uint64_t>((due - m_origin + m_tick - Clock::duration(1)) / m_tick));
+        m_slots[tick % Slots].push_back({tick, std::move(item)});
+        ++m_count;
+    }
+
+    /**
+     * @brief Calls fire(item) for every item due by now, in tick order.
+     * @details fire may schedule new items.
+     */
+    template <typename Fn>
+    void advance(Clock::time_point now, Fn &&fire)
+    {
+        if (now < m_origin)
+            return;
+        const uint64_t target = static_cast<uint64_t>((now - m_origin) / m_tick);
+        if (target < m_current)
+            return;
+
+        // After a long sleep every bucket is visited once rather than once per elapsed tick
+        const uint64_t last = std::min<uint64_t>(target, m_current + Slots - 1);
+        for (uint64_t tick = m_current; tick <= last && m_count > 0; ++tick)
+        {
+            std::vector<Entry> &slot = m_slots[tick % Slots];
+            for (size_t i = 0; i < slot.size();)
+            {
+                if (slot[i].tick > target)
+                {
+                    ++i;
+                    continue;
+                }
+                m_due.push_back(std::move(slot[i].item));
+                slot[i] = std::move(slot.back());
+                slot.pop_back();
+                --m_count;
+            }
+        }
+        m_current = target + 1;
+
+        // Fired outside the bucket loop, so fire() may schedule freely
+        for (T &item : m_due)
+            fire(item);
+        m_due.clear();
+    }
+
+    /**
+     * @brief Time of the next non-empty tick within one turn (an upper bound to wake at),
+     *        or Clock::time_point::max() if nothing is scheduled.
+     */
+    Clock::time_point nextDue() const
+    {
+        if (m_count == 0)
+            return Clock::time_point::max();
+
+        for (uint64_t tick = m_current; tick < m_current + Slots; ++tick)
+        {
+            for (const Entry &entry : m_slots[tick % Slots])
+            {
+                if (entry.tick == tick)
+                    return m_origin + m_tick * static_cast<Clock::rep>(tick);
+            }
+        }
+        // Only items more than a turn away: look again once the wheel has turned
+        return m_origin + m_tick * static_cast<Clock::rep>(m_current + Slots);
+    }
+
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+private:
+    struct Entry
+    {
+        uint64_t tick;
+        T item;
+    };
+
+    Clock::duration m_tick;
+    Clock::time_point m_origin;
+    uint64_t m_current; // Next tick to process
+    size_t m_count;
+    std::array<std::vector<Entry>, Slots> m_slots;
+    std::vector<T> m_due; // Scratch for advance()
+};
+
+#endif // TIMER_WHEEL_H
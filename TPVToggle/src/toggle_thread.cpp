@@ -1,12 +1,16 @@
 /**
  * @file toggle_thread.cpp
- * @brief Implements background threads for TPV toggling and optional features.
+ * @brief Implements the view toggle hotkeys and overlay view requests.
  *
- * Manages the main hotkey monitoring thread that handles key input for toggling
- * between first-person and third-person view modes.
+ * The key handlers run on the InputService thread when a bound key changes,
+ * so a toggle is handled as soon as the key goes down instead of on the next
+ * polling tick.
  */
 
 #include "toggle_thread.h"
+#include "input_service.h"
+#include "hotkey.h"
+#include "game_commands.h"
 #include "logger.h"
 #include "utils.h"
 #include "constants.h"
@@ -15,180 +19,157 @@
 #include "config.h"
 #include "hooks/ui_overlay_hooks.h"
 
-#include <windows.h>
-#include <vector>
-#include <unordered_map>
+#include <chrono>
 #include <string>
-#include <cmath>
 
 // External config declaration
 extern Config g_config;
 
-/**
- * @brief Main hotkey monitoring thread.
- * @details Monitors for registered hotkeys and processes requests from overlay hooks.
- */
-DWORD WINAPI MonitorThread(LPVOID param)
+namespace
 {
-    ToggleData *data_ptr = static_cast<ToggleData *>(param);
-    if (!data_ptr)
+    enum ToggleAction : HotkeyEngine::ActionId
+    {
+        ActionToggle,
+        ActionFpv,
+        ActionTpv,
+        ActionHoldScroll
+    };
+
+    // Input thread state of the view actions
+    HotkeyEngine g_hotkeys;
+    bool g_holdScrollActive = false;
+
+    // Key presses before the game interface is resolved are ignored
+    bool isGameInterfaceReady()
     {
-        Logger::getInstance().log(LOG_ERROR, "MonitorThread: NULL data received.");
-        return 1;
+        if (getResolvedTpvFlagAddress())
+            return true;
+        Logger::getInstance().log(LOG_DEBUG, "ToggleActions: Game interface not ready, key ignored");
+        return false;
     }
 
-    // Move data and clean up
-    std::vector<int> toggle_keys = std::move(data_ptr->toggle_keys);
-    std::vector<int> fpv_keys = std::move(data_ptr->fpv_keys);
-    std::vector<int> tpv_keys = std::move(data_ptr->tpv_keys);
-    delete data_ptr;
-    data_ptr = nullptr;
+    // View changes are applied by the game thread; the VK is passed on for logging (none for hold timeouts)
+    void runAction(HotkeyEngine::ActionId action, int vkCode)
+    {
+        if (!isGameInterfaceReady())
+            return;
+
+        GameCommandQueue &commands = GameCommandQueue::getInstance();
+        switch (action)
+        {
+        case ActionToggle:
+            commands.toggleView(vkCode);
+            break;
+        case ActionFpv:
+            commands.setView(0, vkCode);
+            break;
+        case ActionTpv:
+            commands.setView(1, vkCode);
+            break;
+        default:
+            break;
+        }
+    }
 
+    // Hold-to-scroll: report when the first hotkey goes down and when the last one is released
+    void updateHoldToScroll(const KeyEvent &)
+    {
+        const bool anyHoldKeyPressed = g_hotkeys.isHeld(ActionHoldScroll, InputService::getInstance().keyState());
+        if (anyHoldKeyPressed == g_holdScrollActive)
+            return;
+
+        // Set the global flag and let the UI overlay hook handle the state change
+        g_holdToScrollActive.store(anyHoldKeyPressed, std::memory_order_relaxed);
+        handleHoldToScrollKeyState(anyHoldKeyPressed);
+        g_holdScrollActive = anyHoldKeyPressed;
+    }
+}
+
+void registerToggleActions(ToggleData data)
+{
     Logger &logger = Logger::getInstance();
-    logger.log(LOG_INFO, "MonitorThread: Started");
 
-    // Initialize key tracking
-    std::unordered_map<int, bool> key_down_states;
-    bool hotkeys_active = false;
+    // Starts over, so a replay harness can register again after InputService::clearBindings()
+    g_hotkeys = HotkeyEngine();
+    g_holdScrollActive = false;
 
-    auto initialize_keys = [&](const auto &keys)
-    {
-        for (int vk : keys)
+    g_hotkeys.add(ActionToggle, data.toggle_keys);
+    g_hotkeys.add(ActionFpv, data.fpv_keys);
+    g_hotkeys.add(ActionTpv, data.tpv_keys);
+    // Only sampled while held, so holding Shift to scroll does not block the view keys
+    g_hotkeys.addHeld(ActionHoldScroll, g_config.hold_scroll_keys);
+
+    const bool hotkeys_active = !data.toggle_keys.empty() || !data.fpv_keys.empty() || !data.tpv_keys.empty();
+    logger.log(LOG_INFO, "ToggleActions: Hotkeys " + std::string(hotkeys_active ? "ENABLED" : "DISABLED"));
+
+    if (g_config.hold_scroll_keys.empty())
+        g_hotkeys.bind(runAction);
+    else
+        g_hotkeys.bind(runAction, updateHoldToScroll);
+}
+
+void requestOverlayFpv()
+{
+    Logger::getInstance().log(LOG_DEBUG, "ToggleActions: Queueing FPV request");
+    GameCommandQueue::getInstance().setView(0);
+}
+
+void requestOverlayTpvRestore()
+{
+    // Give the UI time to settle (important) without holding up other input
+    InputService::getInstance().post([]
+                                     {
+        if (g_isOverlayActive.load())
         {
-            if (vk != 0)
-            {
-                key_down_states[vk] = false;
-                hotkeys_active = true;
-            }
+            Logger::getInstance().log(LOG_DEBUG, "ToggleActions: Overlay reopened, TPV restore skipped");
+            return;
         }
-    };
+        Logger::getInstance().log(LOG_DEBUG, "ToggleActions: Queueing TPV restore request");
+        GameCommandQueue::getInstance().setView(1); },
+                                     std::chrono::milliseconds(Constants::OVERLAY_TPV_RESTORE_DELAY_MS));
+}
 
-    initialize_keys(toggle_keys);
-    initialize_keys(fpv_keys);
-    initialize_keys(tpv_keys);
+bool handleOverlayHidden()
+{
+    Logger &logger = Logger::getInstance();
 
-    // Also initialize hold-to-scroll keys if configured
-    if (!g_config.hold_scroll_keys.empty())
+    // Another overlay opened on top of the first: the view to restore is already known
+    if (g_isOverlayActive.load())
     {
-        initialize_keys(g_config.hold_scroll_keys);
+        requestOverlayFpv();
+        return false;
     }
 
-    logger.log(LOG_INFO, "MonitorThread: Hotkeys " + std::string(hotkeys_active ? "ENABLED" : "DISABLED"));
-
-    // Wait for initialization
-    logger.log(LOG_INFO, "MonitorThread: Waiting for game interface...");
-    while (!getResolvedTpvFlagAddress() && WaitForSingleObject(g_exitEvent, 0) != WAIT_OBJECT_0)
+    // Remember if we're currently in TPV mode
+    if (getViewState() == 1)
+    {
+        g_wasTpvBeforeOverlay.store(true);
+        logger.log(LOG_DEBUG, "ToggleActions: Stored TPV state for later restoration");
+    }
+    else
     {
-        Sleep(250);
+        // We're already in FPV or unknown state
+        g_wasTpvBeforeOverlay.store(false);
     }
-    logger.log(LOG_INFO, "MonitorThread: Game interface ready");
 
-    // Track hold key state for hold-to-scroll feature
-    bool prevHoldKeyState = false;
+    requestOverlayFpv();
+    g_isOverlayActive.store(true);
+    return true;
+}
+
+void handleOverlayShown()
+{
+    Logger &logger = Logger::getInstance();
+    g_isOverlayActive.store(false);
 
-    // Main loop
-    while (WaitForSingleObject(g_exitEvent, Constants::MAIN_MONITOR_SLEEP_MS) != WAIT_OBJECT_0)
+    // Request restoration to TPV if that was the previous state
+    if (g_wasTpvBeforeOverlay.exchange(false))
     {
-        try
-        {
-            // Process overlay requests
-            if (g_overlayFpvRequest.load(std::memory_order_relaxed))
-            {
-                logger.log(LOG_DEBUG, "MonitorThread: Processing FPV request");
-                if (setViewState(0))
-                {
-                    g_overlayFpvRequest.store(false, std::memory_order_relaxed);
-                }
-                else
-                {
-                    logger.log(LOG_ERROR, "MonitorThread: Failed to execute FPV request");
-                    g_overlayFpvRequest.store(false, std::memory_order_relaxed);
-                }
-            }
-
-            if (g_overlayTpvRestoreRequest.load(std::memory_order_relaxed))
-            {
-                logger.log(LOG_DEBUG, "MonitorThread: Processing TPV restore request");
-
-                // Give UI time to settle (important)
-                Sleep(200);
-
-                if (setViewState(1))
-                {
-                    g_overlayTpvRestoreRequest.store(false, std::memory_order_relaxed);
-                }
-                else
-                {
-                    logger.log(LOG_ERROR, "MonitorThread: Failed to execute TPV restore request");
-                    g_overlayTpvRestoreRequest.store(false, std::memory_order_relaxed);
-                }
-            }
-
-            // Process hotkeys
-            if (hotkeys_active)
-            {
-                auto process_keys = [&](const auto &keys, auto callback)
-                {
-                    for (int vk : keys)
-                    {
-                        if (vk != 0)
-                        {
-                            bool pressed = (GetAsyncKeyState(vk) & 0x8000) != 0;
-                            if (pressed && !key_down_states[vk])
-                            {
-                                callback(&vk);
-                            }
-                            key_down_states[vk] = pressed;
-                        }
-                    }
-                };
-
-                process_keys(toggle_keys, safeToggleViewState);
-                process_keys(fpv_keys, [](int *vk)
-                             { setViewState(0, vk); });
-                process_keys(tpv_keys, [](int *vk)
-                             { setViewState(1, vk); });
-            }
-
-            // Process hold-to-scroll keys if configured
-            if (!g_config.hold_scroll_keys.empty())
-            {
-                bool anyHoldKeyPressed = false;
-
-                for (int vk : g_config.hold_scroll_keys)
-                {
-                    if (vk != 0 && (GetAsyncKeyState(vk) & 0x8000) != 0)
-                    {
-                        anyHoldKeyPressed = true;
-                        break;
-                    }
-                }
-
-                // Check if hold key state changed
-                if (anyHoldKeyPressed != prevHoldKeyState)
-                {
-                    // Set the global flag and handle state change
-                    g_holdToScrollActive.store(anyHoldKeyPressed, std::memory_order_relaxed);
-
-                    // Call the UI overlay hook to handle the scroll state change
-                    handleHoldToScrollKeyState(anyHoldKeyPressed);
-
-                    prevHoldKeyState = anyHoldKeyPressed;
-                }
-            }
-        }
-        catch (const std::exception &e)
-        {
-            logger.log(LOG_ERROR, "MonitorThread: Error: " + std::string(e.what()));
-            Sleep(1000);
-        }
-        catch (...)
-        {
-            logger.log(LOG_ERROR, "MonitorThread: Unknown error");
-            Sleep(1000);
-        }
+        logger.log(LOG_DEBUG, "ToggleActions: Requesting TPV restoration");
+        requestOverlayTpvRestore();
+    }
+    else
+    {
+        logger.log(LOG_DEBUG, "ToggleActions: No TPV restoration needed");
     }
-
-    logger.log(LOG_INFO, "MonitorThread: Exiting");
-    return 0;
 }
@@ -1,30 +1,58 @@
 /**
  * @file toggle_thread.h
- * @brief Header for background thread managing TPV toggle.
+ * @brief View toggle hotkeys and overlay view requests, handled by the input service.
  */
 #ifndef TOGGLE_THREAD_H
 #define TOGGLE_THREAD_H
 
-#include <windows.h>
+#include "hotkey.h"
+
 #include <vector>
 #include <atomic>
 
-// Thread data structure
+// Key bindings for the view actions
 struct ToggleData
 {
-    std::vector<int> toggle_keys;
-    std::vector<int> fpv_keys;
-    std::vector<int> tpv_keys;
+    HotkeyList toggle_keys;
+    HotkeyList fpv_keys;
+    HotkeyList tpv_keys;
 };
 
 // Thread communication variables
 extern std::atomic<bool> g_isOverlayActive;
-extern std::atomic<bool> g_overlayFpvRequest;
-extern std::atomic<bool> g_overlayTpvRestoreRequest;
 extern std::atomic<bool> g_wasTpvBeforeOverlay;
 extern std::atomic<bool> g_accumulatorWriteNOPped;
 
-// Thread function prototype - only main monitor thread is used now
-DWORD WINAPI MonitorThread(LPVOID param);
+/**
+ * @brief Binds the toggle/FPV/TPV and hold-to-scroll keys on the InputService.
+ * @details Call before InputService::start(). Replaces the bindings of an earlier
+ *          call, whose InputService bindings must have been cleared first.
+ */
+void registerToggleActions(ToggleData data);
+
+/**
+ * @brief Queues a switch to FPV for the game thread (an overlay opened).
+ * @details Safe to call from game hooks; does not block.
+ */
+void requestOverlayFpv();
+
+/**
+ * @brief Queues a TPV restore once the UI has settled (an overlay closed).
+ * @details Safe to call from game hooks; does not block.
+ */
+void requestOverlayTpvRestore();
+
+/**
+ * @brief Handles a UI element opening (HideOverlays): remembers TPV and switches to FPV.
+ * @details Called by the overlay hook and by input replay.
+ * @return true if no other UI element was open before.
+ */
+bool handleOverlayHidden();
+
+/**
+ * @brief Handles the UI element closing (ShowOverlays): restores TPV if it was active before.
+ * @details Called by the overlay hook and by input replay.
+ */
+void handleOverlayShown();
 
 #endif // TOGGLE_THREAD_H
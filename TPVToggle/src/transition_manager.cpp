@@ -1,9 +1,20 @@
 #include "transition_manager.h"
 #include "logger.h"
-#include "global_state.h"
+#include "damped_spring.h"
+#include "constants.h"
 #include <algorithm>
 #include <cmath>
 
+namespace
+{
+    // Until configure() runs, the struct's defaults apply
+    const TransitionSettings &defaultSettings()
+    {
+        static const TransitionSettings settings;
+        return settings;
+    }
+}
+
 TransitionManager &TransitionManager::getInstance()
 {
     static TransitionManager instance;
@@ -11,58 +22,175 @@ TransitionManager &TransitionManager::getInstance()
 }
 
 TransitionManager::TransitionManager()
-    : m_isTransitioning(false),
+    : m_hasPendingConfigure(false),
+      m_commandsDropped(false),
+      m_isTransitioningFlag(false),
+      m_isTransitioning(false),
       m_transitionProgress(0.0f),
-      m_transitionDuration(0.5f),
-      m_defaultDuration(0.5f),
-      m_useSpringPhysics(false),
-      m_springStrength(10.0f),
-      m_springDamping(0.8f),
+      m_transitionDuration(defaultSettings().duration),
+      m_defaultDuration(defaultSettings().duration),
+      m_curve(std::make_shared<EasingCurve>(defaultSettings().curve)),
+      m_defaultCurve(m_curve),
+      m_currentPosition(0.0f, 0.0f, 0.0f),
+      m_useSpringPhysics(defaultSettings().useSpringPhysics),
+      m_springStrength(defaultSettings().springStrength),
+      m_springDamping(defaultSettings().springDamping),
+      m_springPosition(0.0f, 0.0f, 0.0f),
       m_springVelocity(0.0f, 0.0f, 0.0f)
 {
 }
 
 void TransitionManager::startTransition(
+    const Vector3 &sourcePosition,
     const Vector3 &targetPosition,
     const Quaternion &targetRotation,
-    float durationSeconds)
+    float durationSeconds,
+    std::shared_ptr<const EasingCurve> curve)
+{
+    Command command;
+    command.type = Command::Type::Start;
+    command.source = sourcePosition;
+    command.target = CameraState(targetPosition, targetRotation);
+    command.duration = durationSeconds;
+    command.curve = std::move(curve);
+    sendCommand(std::move(command));
+
+    Logger::getInstance().log(LOG_DEBUG, "TransitionManager: Queued transition to: (" +
+                                             std::to_string(targetPosition.x) + ", " +
+                                             std::to_string(targetPosition.y) + ", " +
+                                             std::to_string(targetPosition.z) + ")");
+}
+
+void TransitionManager::cancelTransition()
+{
+    Command command;
+    command.type = Command::Type::Cancel;
+    sendCommand(std::move(command));
+}
+
+void TransitionManager::configure(const TransitionSettings &settings)
 {
-    // Store the current camera state if we're not already transitioning
+    Command command;
+    command.type = Command::Type::Configure;
+    // Built here, so the render thread only swaps pointers
+    command.duration = settings.duration;
+    command.curve = std::make_shared<const EasingCurve>(settings.curve);
+    command.useSpringPhysics = settings.useSpringPhysics;
+    command.springStrength = settings.springStrength;
+    command.springDamping = settings.springDamping;
+    sendCommand(std::move(command));
+}
+
+void TransitionManager::sendCommand(Command &&command)
+{
+    Command superseded; // Released after the lock, so no producer waits on a free
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+
+    // Settings that did not fit earlier go first, so the render thread applies them before this
+    if (m_hasPendingConfigure)
+    {
+        if (command.type == Command::Type::Configure)
+        {
+            m_hasPendingConfigure = false; // Superseded by the newer settings
+            superseded = std::move(m_pendingConfigure);
+        }
+        else if (m_commands.push(std::move(m_pendingConfigure)))
+        {
+            m_hasPendingConfigure = false;
+        }
+    }
+
+    if (!m_hasPendingConfigure && m_commands.push(std::move(command)))
+        return;
+
+    if (command.type == Command::Type::Configure)
+    {
+        // Kept until the queue has room again
+        m_pendingConfigure = std::move(command);
+        m_hasPendingConfigure = true;
+    }
+    // Render thread is not consuming (e.g., not in TPV). Dropping a start or cancel is safe:
+    // the render thread resyncs to g_currentCameraOffset, which gets the newest target through GameCommandQueue.
+    m_commandsDropped.store(true, std::memory_order_release);
+}
+
+void TransitionManager::drainCommands()
+{
+    Command command;
+    while (m_commands.pop(command))
+    {
+        switch (command.type)
+        {
+        case Command::Type::Start:
+            applyStart(command);
+            break;
+        case Command::Type::Cancel:
+            if (m_isTransitioning)
+            {
+                m_isTransitioning = false;
+                Logger::getInstance().log(LOG_DEBUG, "TransitionManager: Transition cancelled");
+            }
+            break;
+        case Command::Type::Configure:
+            m_defaultDuration = command.duration;
+            m_defaultCurve = std::move(command.curve);
+            m_useSpringPhysics = command.useSpringPhysics;
+            m_springStrength = command.springStrength;
+            m_springDamping = command.springDamping;
+            break;
+        }
+    }
+
+    if (m_commandsDropped.exchange(false, std::memory_order_acquire))
+    {
+        m_isTransitioning = false;
+        Logger::getInstance().log(LOG_DEBUG, "TransitionManager: Command queue overflowed; snapped to the live offset");
+    }
+
+    m_isTransitioningFlag.store(m_isTransitioning, std::memory_order_relaxed);
+}
+
+void TransitionManager::applyStart(const Command &command)
+{
+    // Retargeting continues from where the camera is now instead of jumping back to the old source
+    const Vector3 source = m_isTransitioning ? m_currentPosition : command.source;
     if (!m_isTransitioning)
     {
-        m_sourceState = CameraState(g_currentCameraOffset, Quaternion::Identity());
+        m_springPosition = source;
+        m_springVelocity = Vector3(0.0f, 0.0f, 0.0f);
     }
 
-    // Set up the new target
-    m_targetState = CameraState(targetPosition, targetRotation);
+    m_sourceState = CameraState(source, Quaternion::Identity());
+    m_targetState = command.target;
+    m_currentPosition = source;
 
     // Reset transition parameters
     m_transitionProgress = 0.0f;
-    m_transitionDuration = (durationSeconds > 0.0f) ? durationSeconds : m_defaultDuration;
-    m_springVelocity = Vector3(0.0f, 0.0f, 0.0f);
+    m_transitionDuration = (command.duration > 0.0f) ? command.duration : m_defaultDuration;
+    m_curve = command.curve ? command.curve : m_defaultCurve;
     m_isTransitioning = true;
-
-    Logger::getInstance().log(LOG_DEBUG, "TransitionManager: Started transition to: (" +
-                                             std::to_string(targetPosition.x) + ", " +
-                                             std::to_string(targetPosition.y) + ", " +
-                                             std::to_string(targetPosition.z) + ") over " +
-                                             std::to_string(m_transitionDuration) + " seconds");
 }
 
 bool TransitionManager::updateTransition(float deltaTime, Vector3 &outPosition, Quaternion &outRotation)
 {
+    drainCommands();
+
     if (!m_isTransitioning)
     {
         return false;
     }
 
     // Update transition progress
-    m_transitionProgress += deltaTime / m_transitionDuration;
+    m_transitionProgress = std::min(1.0f, m_transitionProgress + deltaTime / m_transitionDuration);
+
+    // The spring keeps moving until it settles, even if that takes longer than the duration
+    const bool springSettled = m_useSpringPhysics ? applySpringPhysics(deltaTime) : true;
 
     // Check if transition is complete
-    if (m_transitionProgress >= 1.0f)
+    if (m_transitionProgress >= 1.0f && springSettled)
     {
         m_isTransitioning = false;
+        m_isTransitioningFlag.store(false, std::memory_order_relaxed);
         m_transitionProgress = 1.0f;
 
         // Set final position and rotation
@@ -73,19 +201,17 @@ bool TransitionManager::updateTransition(float deltaTime, Vector3 &outPosition,
         return false; // Transition is complete
     }
 
-    // Calculate smoothed transition factor
-    float t = smoothstep(m_transitionProgress);
+    // Calculate eased transition factor (a table lookup)
+    float t = (*m_curve)(m_transitionProgress);
 
-    // Interpolate position
-    Vector3 interpolatedPosition = Vector3(
-        m_sourceState.position.x + (m_targetState.position.x - m_sourceState.position.x) * t,
-        m_sourceState.position.y + (m_targetState.position.y - m_sourceState.position.y) * t,
-        m_sourceState.position.z + (m_targetState.position.z - m_sourceState.position.z) * t);
-
-    // Apply spring physics if enabled
-    if (m_useSpringPhysics)
+    // Interpolate position (the spring drives it instead when enabled)
+    Vector3 interpolatedPosition = m_springPosition;
+    if (!m_useSpringPhysics)
     {
-        interpolatedPosition = applySpringPhysics(interpolatedPosition, m_targetState.position, deltaTime);
+        interpolatedPosition = Vector3(
+            m_sourceState.position.x + (m_targetState.position.x - m_sourceState.position.x) * t,
+            m_sourceState.position.y + (m_targetState.position.y - m_sourceState.position.y) * t,
+            m_sourceState.position.z + (m_targetState.position.z - m_sourceState.position.z) * t);
     }
 
     // Interpolate rotation using SLERP
@@ -94,6 +220,7 @@ bool TransitionManager::updateTransition(float deltaTime, Vector3 &outPosition,
     Quaternion interpolatedRotation = Quaternion::Slerp(m_sourceState.rotation, m_targetState.rotation, t);
 
     // Return result
+    m_currentPosition = interpolatedPosition;
     outPosition = interpolatedPosition;
     outRotation = interpolatedRotation;
 
@@ -102,38 +229,16 @@ bool TransitionManager::updateTransition(float deltaTime, Vector3 &outPosition,
 
 bool TransitionManager::isTransitioning() const
 {
-    return m_isTransitioning;
+    return m_isTransitioningFlag.load(std::memory_order_relaxed);
 }
 
-void TransitionManager::cancelTransition()
+bool TransitionManager::applySpringPhysics(float deltaTime)
 {
-    if (m_isTransitioning)
-    {
-        m_isTransitioning = false;
-        Logger::getInstance().log(LOG_DEBUG, "TransitionManager: Transition cancelled");
-    }
-}
-
-float TransitionManager::smoothstep(float x) const
-{
-    // Smoothstep provides a smooth ease-in/ease-out curve
-    // This is a common function in computer graphics for natural interpolation
-    x = std::max(0.0f, std::min(1.0f, x));
-    return x * x * (3.0f - 2.0f * x);
-}
-
-Vector3 TransitionManager::applySpringPhysics(const Vector3 &current, const Vector3 &target, float deltaTime)
-{
-    // Calculate spring force
-    Vector3 displacement = target - current;
-    Vector3 springForce = displacement * m_springStrength;
-
-    // Apply damping to velocity
-    m_springVelocity = m_springVelocity * (1.0f - m_springDamping * deltaTime);
-
-    // Apply spring force to velocity
-    m_springVelocity = m_springVelocity + springForce * deltaTime;
+    // Exact solution of the spring equation, so the path does not depend on the frame rate
+    const DampedSpring spring(m_springStrength, m_springDamping);
+    spring.step(m_springPosition, m_springVelocity, m_targetState.position, deltaTime);
 
-    // Apply velocity to position
-    return current + m_springVelocity * deltaTime;
+    const Vector3 remaining = m_targetState.position - m_springPosition;
+    return remaining.Magnitude() < Constants::SPRING_SETTLE_DISTANCE &&
+           m_springVelocity.Magnitude() < Constants::SPRING_SETTLE_SPEED;
 }
@@ -2,7 +2,13 @@
 #define TRANSITION_MANAGER_H
 
 #include "math_utils.h"
+#include "easing.h"
+#include "spsc_queue.h"
+#include "constants.h"
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
 
 // Camera state for transitions
 struct CameraState
@@ -14,12 +20,30 @@ struct CameraState
     CameraState(const Vector3 &pos, const Quaternion &rot) : position(pos), rotation(rot) {}
 };
 
+// Transition configuration, applied by configure()
+struct TransitionSettings
+{
+    float duration = 0.5f;
+    EasingCurve curve;
+    bool useSpringPhysics = false;
+    float springStrength = 10.0f; // Angular frequency (rad/s)
+    float springDamping = 1.0f;   // Damping ratio (1 = critical)
+};
+
 /**
  * @class TransitionManager
  * @brief Manages smooth transitions between camera profiles
  *
  * This singleton class handles the interpolation between different camera positions and
  * rotations when switching profiles, providing smooth animations rather than abrupt changes.
+ *
+ * All transition state belongs to the render thread. startTransition(), cancelTransition()
+ * and configure() may be called from any thread: they only queue a command, which
+ * updateTransition() applies at the start of the next camera update. Commands carry
+ * everything already built (curves included), so the render thread never allocates.
+ * A configure() that finds the queue full is kept and queued ahead of the next command.
+ * Profile switches start and cancel transitions from GameCommandQueue, which knows the
+ * offset a switch replaces only once the nudges queued before it have been applied.
  */
 class TransitionManager
 {
@@ -32,14 +56,17 @@ public:
 
     /**
      * @brief Start a transition to a new profile
+     * @param sourcePosition Position to start from if no transition is running (else it continues from where it is)
      * @param targetPosition The target position to transition to
      * @param targetRotation The target rotation to transition to
      * @param durationSeconds Duration of the transition in seconds, or -1 to use default
+     * @param curve Easing curve for this transition, or nullptr to use the default
      */
-    void startTransition(const Vector3 &targetPosition, const Quaternion &targetRotation, float durationSeconds);
+    void startTransition(const Vector3 &sourcePosition, const Vector3 &targetPosition, const Quaternion &targetRotation,
+                         float durationSeconds, std::shared_ptr<const EasingCurve> curve = nullptr);
 
     /**
-     * @brief Update the transition (call every frame)
+     * @brief Update the transition (call every frame, render thread only)
      * @param deltaTime Time elapsed since last frame in seconds
      * @param outPosition Output parameter for the interpolated position
      * @param outRotation Output parameter for the interpolated rotation
@@ -49,7 +76,7 @@ public:
 
     /**
      * @brief Check if a transition is in progress
-     * @return true if a transition is currently active
+     * @return true if a transition is currently active (queued commands are not yet reflected)
      */
     bool isTransitioning() const;
 
@@ -58,11 +85,12 @@ public:
      */
     void cancelTransition();
 
-    // Configuration methods
-    void setTransitionDuration(float seconds) { m_defaultDuration = seconds; }
-    void setUseSpringPhysics(bool enable) { m_useSpringPhysics = enable; }
-    void setSpringStrength(float value) { m_springStrength = value; }
-    void setSpringDamping(float value) { m_springDamping = value; }
+    /**
+     * @brief Replace the transition configuration (duration, default curve, spring)
+     * @details Never lost: if the queue is full, the newest settings are queued
+     *          before the next command, so every later transition uses them.
+     */
+    void configure(const TransitionSettings &settings);
 
 private:
     TransitionManager();
@@ -72,37 +100,64 @@ private:
     TransitionManager(const TransitionManager &) = delete;
     TransitionManager &operator=(const TransitionManager &) = delete;
 
-    // Transition state
+    // Request from another thread, applied by the render thread
+    struct Command
+    {
+        enum class Type : uint8_t
+        {
+            Start,
+            Cancel,
+            Configure
+        };
+
+        Type type = Type::Cancel;
+        Vector3 source;                           // Start: where to begin if no transition is running
+        CameraState target;                       // Start
+        float duration = -1.0f;                   // Start (-1 = default); Configure: default duration
+        std::shared_ptr<const EasingCurve> curve; // Start: nullptr = default curve; Configure: default curve
+        bool useSpringPhysics = false;            // Configure
+        float springStrength = 0.0f;              // Configure
+        float springDamping = 0.0f;               // Configure
+    };
+
+    void sendCommand(Command &&command);
+    void drainCommands();
+    void applyStart(const Command &command);
+
+    // Command handoff
+    SpscQueue<Command, Constants::TRANSITION_COMMAND_QUEUE_SIZE> m_commands;
+    std::mutex m_producerMutex;             // Serializes producers; held for one push, never while logging
+    Command m_pendingConfigure;             // Configure that found the queue full (guarded by m_producerMutex)
+    bool m_hasPendingConfigure;             // (guarded by m_producerMutex)
+    std::atomic<bool> m_commandsDropped;    // Queue was full; the render thread resyncs to the live offset
+    std::atomic<bool> m_isTransitioningFlag; // Mirror of m_isTransitioning for other threads
+
+    // Transition state (render thread only)
     bool m_isTransitioning;
     float m_transitionProgress;
     float m_transitionDuration;
     float m_defaultDuration;
+    std::shared_ptr<const EasingCurve> m_curve;        // Curve of the running transition
+    std::shared_ptr<const EasingCurve> m_defaultCurve; // Used when startTransition() gets none
+    Vector3 m_currentPosition;                         // Last position handed out, source of retargets
 
-    // Spring physics
+    // Spring physics (replaces the eased position curve when enabled)
     bool m_useSpringPhysics;
     float m_springStrength;
     float m_springDamping;
-    mutable Vector3 m_springVelocity;
+    Vector3 m_springPosition;
+    Vector3 m_springVelocity;
 
     // Current source and target states
     CameraState m_sourceState;
     CameraState m_targetState;
 
     /**
-     * @brief Smoothstep function for natural easing
-     * @param x Input value in range [0,1]
-     * @return Smoothed value in range [0,1]
-     */
-    float smoothstep(float x) const;
-
-    /**
-     * @brief Apply spring physics to position
-     * @param current Current position
-     * @param target Target position
+     * @brief Advance the spring-driven position toward the target
      * @param deltaTime Time elapsed since last frame
-     * @return New position after applying spring physics
+     * @return true once the spring has come to rest at the target
      */
-    Vector3 applySpringPhysics(const Vector3 &current, const Vector3 &target, float deltaTime);
+    bool applySpringPhysics(float deltaTime);
 };
 
 #endif // TRANSITION_MANAGER_H
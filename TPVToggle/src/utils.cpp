@@ -1,17 +1,27 @@
 /**
  * @file utils.cpp
  * @brief Implements utility functions including optimized thread-safe memory validation.
+ *
+ * Only the file helpers are built on other platforms (host-side tests).
  */
 
 #include "utils.h"
 #include "logger.h"
-#include <windows.h>
 #include <array>
 #include <algorithm>
 #include <chrono>
 #include <mutex>
 #include <atomic>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
 // --- Memory Region Cache Implementation ---
 
 // Constants for cache configuration
@@ -375,3 +385,151 @@ bool WriteBytes(BYTE *targetAddress, const BYTE *sourceBytes, size_t numBytes, L
 
     return true;
 }
+
+#endif // _WIN32
+
+// --- File System Utilities ---
+
+#ifndef _WIN32
+namespace
+{
+    // Writes all of bytes to fd and flushes it to disk
+    bool writeAllAndSync(int fd, const std::string &bytes)
+    {
+        size_t done = 0;
+        while (done < bytes.size())
+        {
+            const ssize_t n = ::write(fd, bytes.data() + done, bytes.size() - done);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return false;
+            done += static_cast<size_t>(n);
+        }
+        return ::fsync(fd) == 0;
+    }
+}
+#endif
+
+/**
+ * @brief Writes bytes to path via a flushed temp file and an atomic rename.
+ * @param path File to replace (created if missing).
+ * @param bytes New contents.
+ * @return true on success; the existing file is untouched on failure.
+ */
+bool replaceFileContents(const std::string &path, const std::string &bytes)
+{
+    Logger &logger = Logger::getInstance();
+    const std::string temp_path = path + ".tmp";
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(temp_path.c_str(), GENERIC_WRITE, 0, NULL,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        logger.log(LOG_ERROR, "replaceFileContents: Failed to create temp file " + temp_path +
+                                  " (error " + std::to_string(GetLastError()) + ")");
+        return false;
+    }
+
+    DWORD bytes_written = 0;
+    const bool write_ok = WriteFile(file, bytes.data(), static_cast<DWORD>(bytes.size()), &bytes_written, NULL) &&
+                          bytes_written == bytes.size() &&
+                          FlushFileBuffers(file);
+    CloseHandle(file);
+
+    if (!write_ok)
+    {
+        logger.log(LOG_ERROR, "replaceFileContents: Failed to write " + temp_path +
+                                  " (error " + std::to_string(GetLastError()) + ")");
+        DeleteFileA(temp_path.c_str());
+        return false;
+    }
+
+    if (!MoveFileExA(temp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        logger.log(LOG_ERROR, "replaceFileContents: Failed to replace " + path +
+                                  " (error " + std::to_string(GetLastError()) + ")");
+        DeleteFileA(temp_path.c_str());
+        return false;
+    }
+#else
+    const int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        logger.log(LOG_ERROR, "replaceFileContents: Failed to create temp file " + temp_path +
+                                  " (error " + std::to_string(errno) + ")");
+        return false;
+    }
+
+    const bool write_ok = writeAllAndSync(fd, bytes);
+    const int write_error = errno;
+    ::close(fd);
+
+    if (!write_ok)
+    {
+        logger.log(LOG_ERROR, "replaceFileContents: Failed to write " + temp_path +
+                                  " (error " + std::to_string(write_error) + ")");
+        ::unlink(temp_path.c_str());
+        return false;
+    }
+
+    if (::rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        logger.log(LOG_ERROR, "replaceFileContents: Failed to replace " + path +
+                                  " (error " + std::to_string(errno) + ")");
+        ::unlink(temp_path.c_str());
+        return false;
+    }
+#endif
+    return true;
+}
+
+/**
+ * @brief Appends bytes to an existing file and flushes them to disk.
+ * @param path File to append to; it is not created if missing.
+ * @param bytes Data to append.
+ * @return true if everything was written. On failure part of the data may
+ *         have been appended.
+ */
+bool appendFileContents(const std::string &path, const std::string &bytes)
+{
+    Logger &logger = Logger::getInstance();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        logger.log(LOG_WARNING, "appendFileContents: Cannot open " + path +
+                                    " (error " + std::to_string(GetLastError()) + ")");
+        return false;
+    }
+
+    DWORD bytes_written = 0;
+    const bool ok = WriteFile(file, bytes.data(), static_cast<DWORD>(bytes.size()), &bytes_written, NULL) &&
+                    bytes_written == bytes.size() &&
+                    FlushFileBuffers(file);
+    const unsigned long error = ok ? 0 : GetLastError();
+    CloseHandle(file);
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd < 0)
+    {
+        logger.log(LOG_WARNING, "appendFileContents: Cannot open " + path +
+                                    " (error " + std::to_string(errno) + ")");
+        return false;
+    }
+
+    const bool ok = writeAllAndSync(fd, bytes);
+    const int error = ok ? 0 : errno;
+    ::close(fd);
+#endif
+
+    if (!ok)
+    {
+        logger.log(LOG_WARNING, "appendFileContents: Failed to write " + path +
+                                    " (error " + std::to_string(error) + ")");
+    }
+    return ok;
+}
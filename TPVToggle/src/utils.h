@@ -17,7 +17,6 @@
 #include <algorithm>
 #include <cstddef>
 #include <chrono>
-#include <windows.h>
 #include <filesystem>
 #include <mutex>
 #include <atomic>
@@ -27,9 +26,14 @@
 #include "logger.h"
 #include "math_utils.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 // Forward declaration
 class Logger;
 
+#ifdef _WIN32
 // --- Memory Manipulation Functions ---
 
 /**
@@ -63,14 +67,29 @@ class Logger;
  * @endcode
  */
 bool WriteBytes(BYTE *targetAddress, const BYTE *sourceBytes, size_t numBytes, Logger &logger);
+#endif // _WIN32
 
 // --- File System Utilities ---
 
+/**
+ * @brief Replaces a file's contents atomically (temp file, flush, rename).
+ * @return true on success; the existing file is untouched on failure.
+ */
+bool replaceFileContents(const std::string &path, const std::string &bytes);
+
+/**
+ * @brief Appends to an existing file and flushes the data to disk.
+ * @return false if the file does not exist or the write failed (a partial
+ *         tail may remain in that case).
+ */
+bool appendFileContents(const std::string &path, const std::string &bytes);
+
 /**
  * @brief Gets the directory containing the currently executing module (DLL/EXE).
  * @details Uses Windows API to determine the full path of the current module
  *          and extracts its parent directory. Falls back to current working
- *          directory if module path detection fails.
+ *          directory if module path detection fails. Other platforms (host-side
+ *          tests and tools) always use the current working directory.
  *
  * @return std::string The directory path of the current module.
  *         Falls back to current working directory on error, or "." as last resort.
@@ -86,6 +105,11 @@ bool WriteBytes(BYTE *targetAddress, const BYTE *sourceBytes, size_t numBytes, L
  */
 inline std::string getRuntimeDirectory()
 {
+#ifndef _WIN32
+    std::error_code ec;
+    const std::filesystem::path current = std::filesystem::current_path(ec);
+    return ec ? std::string(".") : current.string();
+#else
     HMODULE h_self = NULL;
     char module_path_buffer[MAX_PATH] = {0};
     std::string result_path = "";
@@ -150,6 +174,7 @@ inline std::string getRuntimeDirectory()
     }
 
     return result_path;
+#endif
 }
 
 // --- Math Type String Conversion Utilities ---
@@ -267,6 +292,7 @@ inline std::string trim(const std::string &s)
     return s.substr(first, (last - first + 1));
 }
 
+#ifdef _WIN32
 // --- Memory Region Cache System ---
 
 /**
@@ -361,5 +387,6 @@ bool isMemoryReadable(const volatile void *address, size_t size);
  * @endcode
  */
 bool isMemoryWritable(volatile void *address, size_t size);
+#endif // _WIN32
 
 #endif // UTILS_H
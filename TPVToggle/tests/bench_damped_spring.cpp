@@ -0,0 +1,87 @@
+/**
+ * @file bench_damped_spring.cpp
+ * @brief Per-frame cost of the closed-form DampedSpring against the explicit Euler step it replaced.
+ *
+ * Both run one second of a transition at 30, 60 and 240 FPS. Besides the time
+ * per step, each record gives the distance from the exact position after that
+ * second, so frame-rate dependence shows up next to the speed.
+ */
+
+#include "bench_framework.h"
+#include "damped_spring.h"
+
+#include <cmath>
+
+namespace
+{
+    // The configured defaults: SpringStrength (rad/s) and SpringDamping (ratio)
+    constexpr float OMEGA = 10.0f;
+    constexpr float ZETA = 1.0f;
+
+    const Vector3 START(0.0f, 0.0f, 0.0f);
+    const Vector3 TARGET(1.0f, -2.0f, 0.5f);
+
+    // The old applySpringPhysics step, with stiffness and damping matching OMEGA and ZETA
+    void eulerStep(Vector3 &position, Vector3 &velocity, const Vector3 &target, float dt)
+    {
+        const float stiffness = OMEGA * OMEGA;
+        const float damping = 2.0f * ZETA * OMEGA;
+        velocity = velocity * (1.0f - damping * dt);
+        velocity = velocity + (target - position) * stiffness * dt;
+        position = position + velocity * dt;
+    }
+
+    float distance(const Vector3 &a, const Vector3 &b)
+    {
+        const Vector3 d = a - b;
+        return std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+    }
+
+    template <typename Step>
+    void benchStep(const char *variant, int fps, const Vector3 &exact, Step &&step)
+    {
+        const float dt = 1.0f / static_cast<float>(fps);
+
+        // One simulated second, for the error
+        Vector3 position = START, velocity;
+        for (int frame = 0; frame < fps; ++frame)
+            step(position, velocity, TARGET, dt);
+        const float error = distance(position, exact);
+
+        // Timing: restart the transition every simulated second so the state stays in range
+        int frame = 0;
+        const BenchFramework::Timing timing = BenchFramework::measure(2000000, [&]
+                                                                      {
+            if (frame++ == fps)
+            {
+                frame = 1;
+                position = START;
+                velocity = Vector3();
+            }
+            step(position, velocity, TARGET, dt); });
+        BenchFramework::doNotOptimize(position);
+
+        BenchFramework::Record("damped_spring_step")
+            .add("variant", variant)
+            .add("fps", fps)
+            .add("error_after_1s", static_cast<double>(error))
+            .add(timing)
+            .print();
+    }
+}
+
+BENCHMARK(bench_damped_spring_step)
+{
+    const DampedSpring spring(OMEGA, ZETA);
+
+    // A single one-second step is the exact trajectory
+    Vector3 exact = START, exactVelocity;
+    spring.step(exact, exactVelocity, TARGET, 1.0f);
+
+    for (int fps : {30, 60, 240})
+    {
+        benchStep("closed_form", fps, exact, [&spring](Vector3 &position, Vector3 &velocity, const Vector3 &target, float dt)
+                  { spring.step(position, velocity, target, dt); });
+        benchStep("euler", fps, exact, eulerStep);
+    }
+}
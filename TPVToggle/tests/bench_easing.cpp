@@ -0,0 +1,62 @@
+/**
+ * @file bench_easing.cpp
+ * @brief Per-frame cost of a baked easing curve against evaluating the curve directly.
+ */
+
+#include "bench_framework.h"
+#include "easing.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // Progress values as a transition would see them: many frames, uneven steps
+    std::vector<float> progressSamples()
+    {
+        std::vector<float> samples(4096);
+        for (size_t i = 0; i < samples.size(); ++i)
+            samples[i] = std::fmod(static_cast<float>(i) * 0.0137f, 1.0f);
+        return samples;
+    }
+
+    template <typename Fn>
+    void benchCurve(const char *curve, const char *variant, const std::vector<float> &samples, Fn &&evaluate)
+    {
+        size_t i = 0;
+        float sum = 0.0f;
+        const BenchFramework::Timing timing = BenchFramework::measure(2000000, [&]
+                                                                      { sum += evaluate(samples[i++ & 4095]); });
+        BenchFramework::doNotOptimize(sum);
+        BenchFramework::Record("easing_evaluate")
+            .add("curve", curve)
+            .add("variant", variant)
+            .add(timing)
+            .print();
+    }
+}
+
+BENCHMARK(bench_easing_evaluate)
+{
+    const std::vector<float> samples = progressSamples();
+
+    for (const char *spec : {"smoothstep", "ease-in-out", "ease-out-elastic", "ease"})
+    {
+        EasingCurve curve;
+        EasingCurve::parse(spec, curve);
+        benchCurve(spec, "baked", samples, [&curve](float t)
+                   { return curve(t); });
+    }
+
+    benchCurve("smoothstep", "direct", samples, [](float t)
+               { return t * t * (3.0f - 2.0f * t); });
+    // CSS 'ease' = cubic-bezier(0.25, 0.1, 0.25, 1.0), solved per call
+    benchCurve("ease", "direct", samples, [](float t)
+               { return EasingCurve::solveCubicBezier(0.25f, 0.1f, 0.25f, 1.0f, t); });
+
+    BenchFramework::Record("easing_bake")
+        .add("curve", "cubic-bezier")
+        .add(BenchFramework::measure(20000, []
+                                     { BenchFramework::doNotOptimize(EasingCurve::cubicBezier(0.3f, 0.7f, 0.4f, 1.2f)); }))
+        .print();
+}
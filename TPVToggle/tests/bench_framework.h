@@ -0,0 +1,179 @@
+/**
+ * @file bench_framework.h
+ * @brief Minimal benchmark registry with machine-readable output.
+ *
+ * Each BENCHMARK registers itself at static-init time; bench_main.cpp runs
+ * them all (or those whose name contains the first argument). Results are
+ * printed as one JSON object per line on stdout, e.g.
+ *
+ *   {"benchmark":"easing_evaluate","variant":"baked","iterations":1000000,"mean_ns":3.1,"min_ns":2.9}
+ *
+ * so runs can be collected and compared by scripts. Human-readable notes go
+ * to stderr.
+ *
+ * bench_main.cpp replaces the global operator new/delete to count heap
+ * bytes, so benchmarks can report peak allocation with peakAllocation().
+ */
+#ifndef BENCH_FRAMEWORK_H
+#define BENCH_FRAMEWORK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BenchFramework
+{
+    struct Benchmark
+    {
+        const char *name;
+        std::function<void()> fn;
+    };
+
+    inline std::vector<Benchmark> &registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char *name, std::function<void()> fn) { registry().push_back({name, std::move(fn)}); }
+    };
+
+    /** @brief Keeps the compiler from optimizing away a computed value. */
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /** @brief Bytes currently allocated with operator new (defined in bench_main.cpp). */
+    uint64_t allocatedBytes();
+
+    /** @brief Highest allocatedBytes() since the last resetPeakAllocation(). */
+    uint64_t peakAllocatedBytes();
+
+    /** @brief Restarts peak tracking at the current allocation. */
+    void resetPeakAllocation();
+
+    /** @brief Runs fn() once and returns the most heap it held at any point above what was allocated before. */
+    template <typename Fn>
+    uint64_t peakAllocation(Fn &&fn)
+    {
+        resetPeakAllocation();
+        const uint64_t before = allocatedBytes();
+        fn();
+        return peakAllocatedBytes() - before;
+    }
+
+    /** @brief Timing of `iterations` calls, split into `samples` equal batches. */
+    struct Timing
+    {
+        uint64_t iterations = 0;
+        double meanNs = 0.0; // Per call, over all batches
+        double minNs = 0.0;  // Per call, fastest batch
+    };
+
+    /**
+     * @brief Calls fn() iterations times (after one untimed warm-up batch) and times it.
+     * @param samples Number of batches; min_ns is the fastest batch's per-call time.
+     */
+    template <typename Fn>
+    Timing measure(uint64_t iterations, Fn &&fn, int samples = 5)
+    {
+        using Clock = std::chrono::steady_clock;
+        samples = std::max(1, samples);
+        const uint64_t batch = std::max<uint64_t>(1, iterations / static_cast<uint64_t>(samples));
+
+        for (uint64_t i = 0; i < std::min<uint64_t>(batch, 1000); ++i)
+            fn();
+
+        Timing timing;
+        double totalNs = 0.0;
+        timing.minNs = 1e300;
+        for (int s = 0; s < samples; ++s)
+        {
+            const auto start = Clock::now();
+            for (uint64_t i = 0; i < batch; ++i)
+                fn();
+            const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            totalNs += ns;
+            timing.minNs = std::min(timing.minNs, ns / static_cast<double>(batch));
+        }
+        timing.iterations = batch * static_cast<uint64_t>(samples);
+        timing.meanNs = totalNs / static_cast<double>(timing.iterations);
+        return timing;
+    }
+
+    /** @brief One output record: ordered "key": value pairs. */
+    class Record
+    {
+    public:
+        explicit Record(const std::string &benchmark) { add("benchmark", benchmark); }
+
+        Record &add(const std::string &key, const std::string &value)
+        {
+            std::string escaped;
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    escaped += '\\';
+                escaped += c;
+            }
+            m_fields.emplace_back(key, "\"" + escaped + "\"");
+            return *this;
+        }
+        Record &add(const std::string &key, const char *value) { return add(key, std::string(value)); }
+
+        Record &add(const std::string &key, double value)
+        {
+            std::ostringstream out;
+            out.precision(6);
+            out << value;
+            m_fields.emplace_back(key, out.str());
+            return *this;
+        }
+        Record &add(const std::string &key, int value) { return add(key, static_cast<double>(value)); }
+        Record &add(const std::string &key, uint64_t value)
+        {
+            m_fields.emplace_back(key, std::to_string(value));
+            return *this;
+        }
+
+        Record &add(const Timing &timing)
+        {
+            add("iterations", timing.iterations);
+            add("mean_ns", timing.meanNs);
+            return add("min_ns", timing.minNs);
+        }
+
+        /** @brief Prints the record as one JSON line. */
+        void print() const
+        {
+            std::cout << "{";
+            for (size_t i = 0; i < m_fields.size(); ++i)
+                std::cout << (i ? "," : "") << "\"" << m_fields[i].first << "\":" << m_fields[i].second;
+            std::cout << "}" << std::endl;
+        }
+
+    private:
+        std::vector<std::pair<std::string, std::string>> m_fields;
+    };
+}
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+
+/** @brief Defines and registers a benchmark: BENCHMARK(name) { ... } */
+#define BENCHMARK(name)                                                             \
+    static void name();                                                             \
+    static BenchFramework::Registrar BENCH_CONCAT(name, _registrar)(#name, name);   \
+    static void name()
+
+#endif // BENCH_FRAMEWORK_H
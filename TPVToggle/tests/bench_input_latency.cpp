@@ -0,0 +1,23 @@
+/**
+ * @file bench_input_latency.cpp
+ * @brief Key-to-handler latency percentiles of the input thread under simulated presses.
+ */
+
+#include "bench_framework.h"
+#include "input_latency.h"
+
+BENCHMARK(bench_input_latency)
+{
+    for (int gapUs : {0, 100, 1000})
+    {
+        const InputLatency::Result result = InputLatency::measure(1000, std::chrono::microseconds(gapUs));
+        BenchFramework::Record("input_latency")
+            .add("gap_us", gapUs)
+            .add("events", result.events)
+            .add("wakeups", result.wakeups)
+            .add("p50_us", result.percentile(0.5))
+            .add("p99_us", result.percentile(0.99))
+            .add("max_us", result.percentile(1.0))
+            .print();
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file bench_main.cpp
+ * @brief Runs the registered benchmarks, printing one JSON object per result line.
+ *
+ * Usage: tpvtoggle_bench [name-filter]
+ */
+
+#include "bench_framework.h"
+#include "logger.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// --- Allocation counting (see BenchFramework::peakAllocation) ---
+namespace
+{
+    std::atomic<uint64_t> g_allocatedBytes{0};
+    std::atomic<uint64_t> g_peakBytes{0};
+
+    // Each block starts with a header holding its size; aligned blocks use a header of their alignment
+    constexpr size_t HEADER = alignof(std::max_align_t);
+
+    void *countedAlloc(size_t size, size_t alignment)
+    {
+        const size_t header = alignment > HEADER ? alignment : HEADER;
+        const size_t total = (size + header + header - 1) / header * header;
+        char *block = static_cast<char *>(header > HEADER ? std::aligned_alloc(header, total) : std::malloc(total));
+        if (!block)
+            return nullptr;
+        *reinterpret_cast<size_t *>(block + header - sizeof(size_t)) = size;
+
+        const uint64_t now = g_allocatedBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peak = g_peakBytes.load(std::memory_order_relaxed);
+        while (now > peak && !g_peakBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed))
+        {
+        }
+        return block + header;
+    }
+
+    void countedFree(void *ptr, size_t alignment)
+    {
+        if (!ptr)
+            return;
+        const size_t header = alignment > HEADER ? alignment : HEADER;
+        char *block = static_cast<char *>(ptr) - header;
+        g_allocatedBytes.fetch_sub(*reinterpret_cast<size_t *>(block + header - sizeof(size_t)), std::memory_order_relaxed);
+        std::free(block);
+    }
+
+    void *throwingAlloc(size_t size, size_t alignment)
+    {
+        void *ptr = countedAlloc(size, alignment);
+        if (!ptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+void *operator new(size_t size) { return throwingAlloc(size, 0); }
+void *operator new[](size_t size) { return throwingAlloc(size, 0); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size, 0); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size, 0); }
+void *operator new(size_t size, std::align_val_t al) { return throwingAlloc(size, static_cast<size_t>(al)); }
+void *operator new[](size_t size, std::align_val_t al) { return throwingAlloc(size, static_cast<size_t>(al)); }
+void operator delete(void *ptr) noexcept { countedFree(ptr, 0); }
+void operator delete[](void *ptr) noexcept { countedFree(ptr, 0); }
+void operator delete(void *ptr, size_t) noexcept { countedFree(ptr, 0); }
+void operator delete[](void *ptr, size_t) noexcept { countedFree(ptr, 0); }
+void operator delete(void *ptr, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete[](void *ptr, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete(void *ptr, size_t, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete[](void *ptr, size_t, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+
+uint64_t BenchFramework::allocatedBytes()
+{
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t BenchFramework::peakAllocatedBytes()
+{
+    return g_peakBytes.load(std::memory_order_relaxed);
+}
+
+void BenchFramework::resetPeakAllocation()
+{
+    g_peakBytes.store(g_allocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+int main(int argc, char **argv)
+{
+    const std::string filter = argc > 1 ? argv[1] : "";
+
+    // Logging would dominate the I/O-bound benchmarks
+    Logger::getInstance().setLogLevel(LOG_ERROR);
+
+    int run = 0;
+    for (const BenchFramework::Benchmark &benchmark : BenchFramework::registry())
+    {
+        if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos)
+            continue;
+        std::cerr << "Running " << benchmark.name << "..." << std::endl;
+        benchmark.fn();
+        ++run;
+    }
+    return run > 0 ? 0 : 1;
+}
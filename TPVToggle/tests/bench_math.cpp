@@ -0,0 +1,206 @@
+/**
+ * @file bench_math.cpp
+ * @brief Throughput, latency and accuracy of the per-frame math kernels.
+ *
+ * Throughput runs independent calls over arrays of inputs; latency feeds each
+ * result into the next call, which is how a per-frame chain of updates runs.
+ * The accuracy records repeat the errors test_math_accuracy.cpp bounds, so a
+ * run tracks both precision and speed between releases.
+ */
+
+#include "bench_framework.h"
+#include "math_accuracy.h"
+
+#include <vector>
+
+using GameStructures::Matrix34f;
+
+namespace
+{
+    constexpr size_t INPUT_COUNT = 1024; // Power of two: inputs are indexed with a mask
+
+    std::vector<Quaternion> rotations(const std::string &distribution)
+    {
+        std::mt19937 rng(1);
+        std::vector<Quaternion> result(INPUT_COUNT);
+        for (Quaternion &q : result)
+            q = MathReference::randomRotation(rng, distribution);
+        return result;
+    }
+
+    std::vector<Vector3> vectors()
+    {
+        std::mt19937 rng(2);
+        std::vector<Vector3> result(INPUT_COUNT);
+        for (Vector3 &v : result)
+            v = MathReference::randomVector(rng, MathAccuracy::MIN_VECTOR_LENGTH, MathAccuracy::MAX_VECTOR_LENGTH);
+        return result;
+    }
+
+    void printAccuracy(const char *kernel, const std::string &inputs, const MathReference::ErrorStats &stats)
+    {
+        BenchFramework::Record record("math_accuracy");
+        record.add("kernel", kernel).add("inputs", inputs).add("samples", stats.samples);
+        if (stats.ulpSamples > 0)
+            record.add("max_ulp", stats.maxUlp).add("mean_ulp", stats.meanUlp());
+        record.add("max_angle_rad", stats.maxAngle).print();
+    }
+}
+
+BENCHMARK(bench_math_accuracy)
+{
+    for (const std::string &distribution : MathAccuracy::distributions())
+    {
+        printAccuracy("rotate", distribution, MathAccuracy::rotate(distribution, 100000));
+        printAccuracy("rotate_vectors", distribution, MathAccuracy::rotateBatch(distribution, 100, 1023, false));
+        printAccuracy("rotate_vectors_soa", distribution, MathAccuracy::rotateBatch(distribution, 100, 1023, true));
+        printAccuracy("to_basis", distribution, MathAccuracy::toBasis(distribution, 100000));
+        printAccuracy("decompose", distribution, MathAccuracy::decompose(distribution, 100000));
+        printAccuracy("slerp", distribution, MathAccuracy::slerp(distribution, 100000, false));
+        printAccuracy("slerp_nearby", distribution, MathAccuracy::slerp(distribution, 100000, true));
+    }
+    printAccuracy("look_rotation", "uniform", MathAccuracy::lookRotation(100000));
+}
+
+BENCHMARK(bench_math_rotate)
+{
+    const std::vector<Quaternion> qs = rotations("uniform");
+    const std::vector<Vector3> vs = vectors();
+
+    size_t i = 0;
+    Vector3 result;
+    BenchFramework::Record("math_rotate")
+        .add("mode", "throughput")
+        .add(BenchFramework::measure(5000000, [&]
+                                     {
+            result = qs[i & (INPUT_COUNT - 1)].Rotate(vs[i & (INPUT_COUNT - 1)]);
+            ++i;
+            BenchFramework::doNotOptimize(result); }))
+        .print();
+
+    Vector3 chained = vs[0];
+    BenchFramework::Record("math_rotate")
+        .add("mode", "latency")
+        .add(BenchFramework::measure(5000000, [&]
+                                     { chained = qs[i++ & (INPUT_COUNT - 1)].Rotate(chained); }))
+        .print();
+    BenchFramework::doNotOptimize(chained);
+
+    // Batches: per-vector cost is mean_ns / vectors
+    std::vector<Vector3> out(INPUT_COUNT);
+    BenchFramework::Record("math_rotate_vectors")
+        .add("layout", "aos")
+        .add("vectors", static_cast<uint64_t>(INPUT_COUNT))
+        .add(BenchFramework::measure(20000, [&]
+                                     {
+            RotateVectors(qs[i++ & (INPUT_COUNT - 1)], vs.data(), out.data(), INPUT_COUNT);
+            BenchFramework::doNotOptimize(out[0]); }))
+        .print();
+
+    std::vector<float> x(INPUT_COUNT), y(INPUT_COUNT), z(INPUT_COUNT);
+    for (size_t k = 0; k < INPUT_COUNT; ++k)
+    {
+        x[k] = vs[k].x;
+        y[k] = vs[k].y;
+        z[k] = vs[k].z;
+    }
+    std::vector<float> ox(INPUT_COUNT), oy(INPUT_COUNT), oz(INPUT_COUNT);
+    BenchFramework::Record("math_rotate_vectors")
+        .add("layout", "soa")
+        .add("vectors", static_cast<uint64_t>(INPUT_COUNT))
+        .add(BenchFramework::measure(20000, [&]
+                                     {
+            RotateVectorsSoA(qs[i++ & (INPUT_COUNT - 1)], x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), INPUT_COUNT);
+            BenchFramework::doNotOptimize(ox[0]); }))
+        .print();
+}
+
+BENCHMARK(bench_math_basis)
+{
+    const std::vector<Quaternion> qs = rotations("uniform");
+    const std::vector<Vector3> vs = vectors();
+
+    size_t i = 0;
+    Vector3 right, forward, up;
+    BenchFramework::Record("math_to_basis")
+        .add("mode", "throughput")
+        .add(BenchFramework::measure(5000000, [&]
+                                     {
+            qs[i++ & (INPUT_COUNT - 1)].ToBasis(right, forward, up);
+            BenchFramework::doNotOptimize(right);
+            BenchFramework::doNotOptimize(forward);
+            BenchFramework::doNotOptimize(up); }))
+        .print();
+
+    Matrix34f matrix;
+    BenchFramework::Record("math_matrix_set")
+        .add("mode", "throughput")
+        .add(BenchFramework::measure(5000000, [&]
+                                     {
+            matrix.Set(qs[i & (INPUT_COUNT - 1)], vs[i & (INPUT_COUNT - 1)]);
+            ++i;
+            BenchFramework::doNotOptimize(matrix); }))
+        .print();
+}
+
+BENCHMARK(bench_math_slerp)
+{
+    const std::vector<Quaternion> from = rotations("uniform");
+    std::mt19937 rng(3);
+    std::vector<Quaternion> random(INPUT_COUNT), nearby(INPUT_COUNT);
+    for (size_t k = 0; k < INPUT_COUNT; ++k)
+    {
+        random[k] = MathReference::randomRotation(rng);
+        // Close enough for the linear fallback: a spring settling on its target
+        nearby[k] = MathReference::randomSmallRotation(rng, 1e-3) * from[k];
+    }
+
+    for (const auto &targets : {std::make_pair("random", &random), std::make_pair("nearby", &nearby)})
+    {
+        const std::vector<Quaternion> &to = *targets.second;
+        size_t i = 0;
+        Quaternion result;
+        BenchFramework::Record("math_slerp")
+            .add("inputs", targets.first)
+            .add("mode", "throughput")
+            .add(BenchFramework::measure(2000000, [&]
+                                         {
+                result = Quaternion::Slerp(from[i & (INPUT_COUNT - 1)], to[i & (INPUT_COUNT - 1)], 0.3f);
+                ++i;
+                BenchFramework::doNotOptimize(result); }))
+            .print();
+    }
+
+    // A camera easing toward a fixed target each frame
+    Quaternion chained = from[0];
+    size_t i = 0;
+    BenchFramework::Record("math_slerp")
+        .add("inputs", "random")
+        .add("mode", "latency")
+        .add(BenchFramework::measure(2000000, [&]
+                                     { chained = Quaternion::Slerp(chained, random[i++ & (INPUT_COUNT - 1)], 0.1f); }))
+        .print();
+    BenchFramework::doNotOptimize(chained);
+}
+
+BENCHMARK(bench_math_look_rotation)
+{
+    std::mt19937 rng(4);
+    std::vector<Vector3> forwards;
+    while (forwards.size() < INPUT_COUNT)
+    {
+        const Vector3 forward = MathReference::randomVector(rng, 1.0, 1.0);
+        if (std::abs(forward.z) < 0.99f)
+            forwards.push_back(forward);
+    }
+
+    size_t i = 0;
+    Quaternion result;
+    BenchFramework::Record("math_look_rotation")
+        .add("mode", "throughput")
+        .add(BenchFramework::measure(2000000, [&]
+                                     {
+            result = Quaternion::LookRotation(forwards[i++ & (INPUT_COUNT - 1)]);
+            BenchFramework::doNotOptimize(result); }))
+        .print();
+}
@@ -0,0 +1,60 @@
+/**
+ * @file bench_matrix_decompose.cpp
+ * @brief Player transform sampling: Matrix34f::Decompose against the DirectXMath path it replaced.
+ */
+
+#include "bench_framework.h"
+#include "math_accuracy.h"
+
+#include <vector>
+
+using GameStructures::Matrix34f;
+
+namespace
+{
+    std::vector<Matrix34f> randomMatrices(const std::string &distribution)
+    {
+        std::mt19937 rng(1);
+        std::vector<Matrix34f> matrices(1024);
+        for (Matrix34f &matrix : matrices)
+            matrix = MathReference::matrixOf(MathReference::randomRotation(rng, distribution), Vector3(512.0f, -80.5f, 33.0f));
+        return matrices;
+    }
+}
+
+BENCHMARK(bench_matrix_decompose)
+{
+    // Uniform rotations select all four Shepperd cases at random; near identity always the trace
+    for (const std::string &distribution : MathAccuracy::distributions())
+    {
+        const std::vector<Matrix34f> matrices = randomMatrices(distribution);
+        size_t i = 0;
+        Vector3 position;
+        Quaternion rotation;
+        BenchFramework::Record("matrix_decompose")
+            .add("variant", "shepperd")
+            .add("inputs", distribution)
+            .add(BenchFramework::measure(5000000, [&]
+                                         {
+                matrices[i++ & 1023].Decompose(position, rotation);
+                BenchFramework::doNotOptimize(rotation); }))
+            .print();
+
+        // What GetPlayerWorldTransform did before: a full XMMATRIX and XMQuaternionRotationMatrix
+        BenchFramework::Record("matrix_decompose")
+            .add("variant", "directxmath")
+            .add("inputs", distribution)
+            .add(BenchFramework::measure(5000000, [&]
+                                         {
+                const Matrix34f &m = matrices[i++ & 1023];
+                position = Vector3(m.m[0][3], m.m[1][3], m.m[2][3]);
+                const DirectX::XMMATRIX dx = DirectX::XMMatrixSet(m.m[0][0], m.m[0][1], m.m[0][2], 0.0f,
+                                                                  m.m[1][0], m.m[1][1], m.m[1][2], 0.0f,
+                                                                  m.m[2][0], m.m[2][1], m.m[2][2], 0.0f,
+                                                                  0.0f, 0.0f, 0.0f, 1.0f);
+                rotation = Quaternion::FromXMVector(DirectX::XMQuaternionRotationMatrix(dx));
+                BenchFramework::doNotOptimize(rotation);
+                BenchFramework::doNotOptimize(position); }))
+            .print();
+    }
+}
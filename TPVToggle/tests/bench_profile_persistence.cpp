@@ -0,0 +1,227 @@
+/**
+ * @file bench_profile_persistence.cpp
+ * @brief Save, load and journal costs for a 10,000-profile file, and cold start of a 50,000-profile file.
+ *
+ * Runs against real files in the working directory, so the numbers include
+ * the flushes to disk the mod does in game. The cold start compares
+ * ProfileLoader with the nlohmann::json DOM loader it replaced.
+ */
+
+#include "bench_framework.h"
+#include "profile_persistence.h"
+#include "profile_loader.h"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using json = nlohmann::json;
+
+namespace
+{
+    constexpr size_t PROFILE_COUNT = 10000;
+    constexpr size_t COLD_START_PROFILE_COUNT = 50000;
+    constexpr size_t JOURNAL_RECORDS = 1000;
+
+    std::string readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    std::string benchPath()
+    {
+        std::filesystem::create_directories("scratch/bench_persistence");
+        return "scratch/bench_persistence/profiles.json";
+    }
+
+    ProfileStore makeStore(size_t count)
+    {
+        ProfileStore store;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float f = static_cast<float>(i);
+            store.append(CameraProfile("Profile " + std::to_string(i), Vector3(f * 0.01f, -1.0f - f * 0.001f, 0.25f),
+                                       "Category " + std::to_string(i % 16), "2025-01-01 12:00:00"));
+        }
+        return store;
+    }
+
+    ProfileSnapshotPtr snapshotOf(const ProfileStore &store, uint64_t revision)
+    {
+        return std::make_shared<ProfileSnapshot>(ProfileSnapshot{revision, std::make_shared<ProfileStore>(store)});
+    }
+
+    // The loader before ProfileLoader: parse the whole file into a DOM, then convert each object (profileFromJson)
+    size_t loadWithDom(const std::string &bytes, ProfileStore &store)
+    {
+        const json profilesJson = json::parse(bytes);
+        if (!profilesJson.is_array())
+            return 0;
+        for (const json &entry : profilesJson)
+        {
+            if (!entry.is_object())
+                continue;
+            const std::string name = entry.value("name", "Unnamed Profile");
+            const std::string category = entry.value("category", "General");
+            const std::string timestamp = entry.value("timestamp", std::string());
+            ProfileId id = INVALID_PROFILE_ID;
+            if (entry.contains("id") && entry["id"].is_number_unsigned())
+                id = entry["id"].get<ProfileId>();
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+            if (entry.contains("offset") && entry["offset"].is_object())
+            {
+                const json &offset = entry["offset"];
+                x = offset.value("x", 0.0f);
+                y = offset.value("y", 0.0f);
+                z = offset.value("z", 0.0f);
+            }
+            store.append(CameraProfile(name, Vector3(x, y, z), category, timestamp, id));
+        }
+        return store.size();
+    }
+}
+
+BENCHMARK(bench_profile_compact_10k)
+{
+    const std::string path = benchPath();
+    ProfileStore store = makeStore(PROFILE_COUNT);
+
+    ProfilePersistence persistence;
+    persistence.start(path, std::chrono::milliseconds(0), JournalReplayResult{}, ProfileFileState{});
+    uint64_t revision = 1;
+    // Serialize 10k profiles, write the temp file, flush, rename, rewrite the journal header
+    const BenchFramework::Timing timing = BenchFramework::measure(20, [&]
+                                                                  { persistence.writeNow(snapshotOf(store, revision++)); },
+                                                                  4);
+    persistence.stop();
+
+    BenchFramework::Record("profile_compact")
+        .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+        .add("file_bytes", static_cast<uint64_t>(std::filesystem::file_size(path)))
+        .add(timing)
+        .print();
+}
+
+BENCHMARK(bench_profile_load_10k)
+{
+    const std::string path = benchPath();
+    {
+        ProfilePersistence persistence;
+        persistence.start(path, std::chrono::milliseconds(0), JournalReplayResult{}, ProfileFileState{});
+        persistence.writeNow(snapshotOf(makeStore(PROFILE_COUNT), 1));
+        persistence.stop();
+    }
+    const std::string bytes = readFile(path);
+
+    const BenchFramework::Timing timing = BenchFramework::measure(20, [&]
+                                                                  {
+        ProfileStore store;
+        ProfileLoader::load(bytes, store, [] { return std::string(); });
+        BenchFramework::doNotOptimize(store.size()); },
+                                                                  4);
+
+    BenchFramework::Record("profile_load")
+        .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+        .add("file_bytes", static_cast<uint64_t>(bytes.size()))
+        .add(timing)
+        .print();
+}
+
+BENCHMARK(bench_profile_cold_start_50k)
+{
+    const std::string path = benchPath();
+    {
+        ProfilePersistence persistence;
+        persistence.start(path, std::chrono::milliseconds(0), JournalReplayResult{}, ProfileFileState{});
+        persistence.writeNow(snapshotOf(makeStore(COLD_START_PROFILE_COUNT), 1));
+        persistence.stop();
+    }
+    const uint64_t fileBytes = static_cast<uint64_t>(std::filesystem::file_size(path));
+
+    // Read the file and build the store, as loadProfilesFromJson does at startup
+    const auto dom = []
+    {
+        ProfileStore store;
+        BenchFramework::doNotOptimize(loadWithDom(readFile(benchPath()), store));
+    };
+    const auto sax = []
+    {
+        ProfileStore store;
+        ProfileLoader::load(readFile(benchPath()), store, []
+                            { return std::string(); });
+        BenchFramework::doNotOptimize(store.size());
+    };
+
+    const std::pair<const char *, std::function<void()>> variants[] = {{"dom", dom}, {"sax", sax}};
+    for (const auto &variant : variants)
+    {
+        const uint64_t peak = BenchFramework::peakAllocation(variant.second);
+        const BenchFramework::Timing timing = BenchFramework::measure(10, variant.second, 5);
+        BenchFramework::Record("profile_cold_start")
+            .add("variant", variant.first)
+            .add("profiles", static_cast<uint64_t>(COLD_START_PROFILE_COUNT))
+            .add("file_bytes", fileBytes)
+            .add("peak_alloc_bytes", peak)
+            .add(timing)
+            .print();
+    }
+}
+
+BENCHMARK(bench_profile_journal_10k)
+{
+    const std::string path = benchPath();
+    ProfileStore store = makeStore(PROFILE_COUNT);
+    {
+        ProfilePersistence persistence;
+        persistence.start(path, std::chrono::milliseconds(0), JournalReplayResult{}, ProfileFileState{});
+        persistence.writeNow(snapshotOf(store, 1));
+        persistence.stop();
+    }
+
+    // One edit appended to the journal: the path every offset save takes in game.
+    // The worker never gets to it (long debounce); stop() appends it on this thread.
+    const std::string fingerprint = ProfilePersistence::fingerprintOf(readFile(path));
+    const std::string journalPath = std::filesystem::path(path).replace_extension(".journal").string();
+    uint64_t revision = 2;
+    const BenchFramework::Timing append = BenchFramework::measure(JOURNAL_RECORDS, [&]
+                                                                  {
+        JournalReplayResult journal;
+        journal.valid = true;
+        journal.bytes = std::filesystem::file_size(journalPath);
+
+        const ProfileId id = store.at(revision % PROFILE_COUNT).id;
+        store.setOffset(id, Vector3(static_cast<float>(revision), 0.0f, 0.0f), "2025-01-01 12:00:01");
+        ProfilePersistence persistence;
+        persistence.start(path, std::chrono::hours(1), journal, ProfileFileState{fingerprint, nullptr});
+        persistence.post(snapshotOf(store, revision),
+                         ProfileChange{ProfileChange::Kind::Update, id, 0, store.findById(id)->toProfile(), revision});
+        ++revision;
+        persistence.stop(); },
+                                                                  1);
+    BenchFramework::Record("profile_journal_append")
+        .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+        .add("note", "includes starting and stopping the worker thread")
+        .add(append)
+        .print();
+
+    // Startup replay of the records just appended
+    const std::string bytes = readFile(path);
+    ProfileStore base;
+    ProfileLoader::load(bytes, base, []
+                        { return std::string(); });
+    uint64_t applied = 0;
+    const BenchFramework::Timing replay = BenchFramework::measure(10, [&]
+                                                                  {
+        ProfileStore copy = base;
+        applied = ProfilePersistence::replayJournal(path, bytes, copy).applied; },
+                                                                  2);
+    BenchFramework::Record("profile_journal_replay")
+        .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+        .add("records", applied)
+        .add("note", "includes copying the loaded store")
+        .add(replay)
+        .print();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file bench_profile_store.cpp
+ * @brief Lookup, reindexing and publish-per-edit costs of ProfileStore at 10,000 profiles.
+ */
+
+#include "bench_framework.h"
+#include "profile_store.h"
+
+#include <memory>
+
+namespace
+{
+    constexpr size_t PROFILE_COUNT = 10000;
+
+    ProfileStore makeStore(size_t count)
+    {
+        ProfileStore store;
+        for (size_t i = 0; i < count; ++i)
+        {
+            store.append(CameraProfile("Profile " + std::to_string(i), Vector3(), "Category " + std::to_string(i % 16)));
+        }
+        return store;
+    }
+}
+
+BENCHMARK(bench_profile_store_10k)
+{
+    ProfileStore store = makeStore(PROFILE_COUNT);
+
+    const std::string name = "Profile " + std::to_string(PROFILE_COUNT / 2);
+    BenchFramework::Record("profile_store_find_by_name")
+        .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+        .add(BenchFramework::measure(1000000, [&]
+                                     { BenchFramework::doNotOptimize(store.findByName(name)); }))
+        .print();
+
+    // Insert + erase at a position: both reindex every profile after it
+    for (const size_t position : {static_cast<size_t>(0), PROFILE_COUNT / 2, PROFILE_COUNT})
+    {
+        BenchFramework::Record("profile_store_insert_erase")
+            .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+            .add("position", static_cast<uint64_t>(position))
+            .add(BenchFramework::measure(2000, [&]
+                                         { store.erase(store.insert(position, CameraProfile("Temp"))); }))
+            .print();
+    }
+
+    BenchFramework::Record("profile_store_rename")
+        .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+        .add(BenchFramework::measure(100000, [&, flip = false]() mutable
+                                     {
+        store.rename(store.at(0).id, flip ? "Profile 0" : "Renamed", "t");
+        flip = !flip; }))
+        .print();
+}
+
+BENCHMARK(bench_profile_store_edit_10k)
+{
+    // Every edit in game is followed by publishing the store to readers and the save worker.
+    // "copy" is the old copy-on-write path: the first edit after a publish copies the whole store.
+    std::shared_ptr<const ProfileStore> published;
+    {
+        auto store = std::make_shared<ProfileStore>(makeStore(PROFILE_COUNT));
+        bool flip = false;
+        const BenchFramework::Timing timing = BenchFramework::measure(200, [&]
+                                                                      {
+            store = std::make_shared<ProfileStore>(*store);
+            store->rename(store->at(1).id, flip ? "Profile 1" : "Renamed", "2025-01-01 12:00:00");
+            flip = !flip;
+            published = store; });
+        BenchFramework::Record("profile_store_edit_publish")
+            .add("variant", "copy")
+            .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+            .add(timing)
+            .print();
+    }
+
+    ProfileStoreWriter writer(std::make_shared<ProfileStore>(makeStore(PROFILE_COUNT)));
+    bool flip = false;
+    const BenchFramework::Timing timing = BenchFramework::measure(20000, [&]
+                                                                  {
+        writer.apply([id = writer->at(1).id, name = std::string(flip ? "Profile 1" : "Renamed")](ProfileStore &store)
+                     { return store.rename(id, name, "2025-01-01 12:00:00"); });
+        flip = !flip;
+        published = writer.share(); });
+    BenchFramework::Record("profile_store_edit_publish")
+        .add("variant", "replay")
+        .add("profiles", static_cast<uint64_t>(PROFILE_COUNT))
+        .add("copies", writer.copyCount())
+        .add(timing)
+        .print();
+}
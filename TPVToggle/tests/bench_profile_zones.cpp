@@ -0,0 +1,115 @@
+/**
+ * @file bench_profile_zones.cpp
+ * @brief Per-frame zone lookup cost with 100,000 zones.
+ */
+
+#include "bench_framework.h"
+#include "profile_zone_index.h"
+#include "constants.h"
+
+#include <random>
+
+namespace
+{
+    constexpr size_t ZONE_COUNT = 100000;
+    constexpr float WORLD_SIZE = 8000.0f; // Zones spread over an 8 km square, like a large open-world map
+}
+
+BENCHMARK(bench_profile_zones_100k)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(0.0f, WORLD_SIZE);
+    std::uniform_real_distribution<float> extent(2.0f, 40.0f);
+
+    std::vector<ProfileZone> zones;
+    zones.reserve(ZONE_COUNT);
+    for (size_t i = 0; i < ZONE_COUNT; ++i)
+    {
+        ProfileZone zone;
+        zone.name = "Zone " + std::to_string(i);
+        zone.profileId = static_cast<ProfileId>(i % 50 + 1);
+        zone.priority = 0;
+        zone.center = Vector3(position(rng), position(rng), extent(rng));
+        if (i % 4 == 0)
+        {
+            zone.shape = ProfileZone::Shape::Sphere;
+            zone.radius = extent(rng);
+            const Vector3 r(zone.radius, zone.radius, zone.radius);
+            zone.min = zone.center - r;
+            zone.max = zone.center + r;
+            zone.volume = 4.18879f * zone.radius * zone.radius * zone.radius;
+        }
+        else
+        {
+            zone.shape = ProfileZone::Shape::Box;
+            zone.radius = 0.0f;
+            const Vector3 half(extent(rng), extent(rng), extent(rng) * 0.25f);
+            zone.min = zone.center - half;
+            zone.max = zone.center + half;
+            zone.volume = 8.0f * half.x * half.y * half.z;
+        }
+        zones.push_back(std::move(zone));
+    }
+    // A few region-sized zones that every query also tests
+    for (int i = 0; i < 8; ++i)
+    {
+        ProfileZone region;
+        region.name = "Region " + std::to_string(i);
+        region.profileId = 1;
+        region.priority = -1;
+        region.shape = ProfileZone::Shape::Box;
+        region.min = Vector3(static_cast<float>(i) * WORLD_SIZE / 8.0f, 0.0f, -100.0f);
+        region.max = Vector3(static_cast<float>(i + 1) * WORLD_SIZE / 8.0f, WORLD_SIZE, 200.0f);
+        region.center = (region.min + region.max) * 0.5f;
+        region.radius = 0.0f;
+        const Vector3 size = region.max - region.min;
+        region.volume = size.x * size.y * size.z;
+        zones.push_back(std::move(region));
+    }
+    const size_t zoneCount = zones.size();
+
+    ProfileZoneIndex index(Constants::PROFILE_ZONE_CELL_SIZE);
+    const BenchFramework::Timing build = BenchFramework::measure(3, [&]
+                                                                 { index.build(zones); },
+                                                                 3);
+    BenchFramework::Record("profile_zones_build")
+        .add("zones", static_cast<uint64_t>(zoneCount))
+        .add(build)
+        .print();
+
+    // A walk across the map, one sample per frame at 60 fps and walking speed
+    std::vector<Vector3> path;
+    Vector3 player(100.0f, 100.0f, 10.0f);
+    for (int i = 0; i < 4096; ++i)
+    {
+        player = player + Vector3(0.06f, 0.045f, 0.0f);
+        path.push_back(player);
+    }
+    size_t step = 0;
+    uint64_t inZone = 0;
+    const BenchFramework::Timing walk = BenchFramework::measure(2000000, [&]
+                                                                {
+        const uint32_t zone = index.find(path[step++ & 4095]);
+        inZone += zone != ProfileZoneIndex::npos; });
+    BenchFramework::doNotOptimize(inZone);
+    BenchFramework::Record("profile_zones_find")
+        .add("zones", static_cast<uint64_t>(zoneCount))
+        .add("pattern", "walk")
+        .add(walk)
+        .print();
+
+    // Random points: every query lands in a cold cell
+    std::vector<Vector3> random(4096);
+    for (Vector3 &point : random)
+        point = Vector3(position(rng), position(rng), extent(rng));
+    const BenchFramework::Timing scattered = BenchFramework::measure(2000000, [&]
+                                                                     {
+        const uint32_t zone = index.find(random[step++ & 4095]);
+        inZone += zone != ProfileZoneIndex::npos; });
+    BenchFramework::doNotOptimize(inZone);
+    BenchFramework::Record("profile_zones_find")
+        .add("zones", static_cast<uint64_t>(zoneCount))
+        .add("pattern", "random")
+        .add(scattered)
+        .print();
+}
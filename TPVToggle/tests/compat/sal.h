@@ -0,0 +1,43 @@
+/**
+ * @file sal.h
+ * @brief Empty SAL annotations so DirectXMath compiles outside the Windows SDK.
+ *
+ * The tests Makefile adds this directory with -idirafter, so a real sal.h
+ * (e.g. from DirectX-Headers' WSL stubs) takes precedence when installed.
+ */
+#ifndef TPVTOGGLE_COMPAT_SAL_H
+#define TPVTOGGLE_COMPAT_SAL_H
+
+#define _In_
+#define _In_opt_
+#define _In_z_
+#define _In_reads_(size)
+#define _In_reads_opt_(size)
+#define _In_reads_bytes_(size)
+#define _In_range_(low, high)
+#define _Inout_
+#define _Inout_opt_
+#define _Inout_updates_(size)
+#define _Inout_updates_bytes_(size)
+#define _Out_
+#define _Out_opt_
+#define _Out_writes_(size)
+#define _Out_writes_opt_(size)
+#define _Out_writes_bytes_(size)
+#define _Out_writes_all_(size)
+#define _Out_writes_all_opt_(size)
+#define _Outptr_
+#define _Outptr_opt_
+#define _Ret_maybenull_
+#define _Ret_notnull_
+#define _Success_(expr)
+#define _Check_return_
+#define _Use_decl_annotations_
+#define _Analysis_assume_(expr)
+#define _Printf_format_string_
+#define _Pre_
+#define _Post_
+#define _Notnull_
+#define _Null_terminated_
+
+#endif // TPVTOGGLE_COMPAT_SAL_H
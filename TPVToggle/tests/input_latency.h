@@ -0,0 +1,90 @@
+/**
+ * @file input_latency.h
+ * @brief Key-to-handler latency of the input thread, driven by simulated key presses.
+ *
+ * Feeds transitions through InputService::injectKeyEvent (the same queue the
+ * Windows hooks use) with the service running on its own thread, and measures
+ * the time from capture (KeyEvent::timestamp) to the bound handler. Shared by
+ * test_input_latency.cpp, which bounds it, and bench_input_latency.cpp, which
+ * reports the percentiles.
+ */
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include "input_service.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace InputLatency
+{
+    // Any key; nothing else is bound while measuring
+    constexpr int KEY = 0x72;
+
+    struct Result
+    {
+        std::vector<double> latenciesUs; // Sorted
+        uint64_t events = 0;
+        uint64_t wakeups = 0; // Input thread wakeups while the events were delivered
+
+        /** @brief Latency at fraction p (0..1) of the sorted samples. */
+        double percentile(double p) const
+        {
+            if (latenciesUs.empty())
+                return 0.0;
+            const size_t index = static_cast<size_t>(p * static_cast<double>(latenciesUs.size() - 1) + 0.5);
+            return latenciesUs[std::min(index, latenciesUs.size() - 1)];
+        }
+    };
+
+    /**
+     * @brief Presses and releases KEY presses times, one transition every gap, and times each delivery.
+     * @details Replaces the service's bindings; they are cleared again on return.
+     */
+    inline Result measure(int presses, std::chrono::microseconds gap)
+    {
+        InputService &service = InputService::getInstance();
+        service.stop();
+        service.clearBindings();
+        service.setKeySampler(nullptr);
+
+        const size_t events = static_cast<size_t>(presses) * 2;
+        std::vector<double> latencies(events);
+        std::atomic<size_t> delivered(0);
+        service.bindKeys({KEY}, [&](const KeyEvent &event)
+                         {
+                             const size_t i = delivered.load(std::memory_order_relaxed);
+                             if (i < events)
+                                 latencies[i] = (service.nowSeconds() - event.timestamp) * 1e6;
+                             delivered.store(i + 1, std::memory_order_release); });
+        service.start();
+
+        const uint64_t wakeupsBefore = service.getWakeupCount();
+        for (size_t i = 0; i < events; ++i)
+        {
+            service.injectKeyEvent(KEY, i % 2 == 0);
+            // Wait for the delivery so every event is a separate wakeup
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while (delivered.load(std::memory_order_acquire) <= i && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::yield();
+            std::this_thread::sleep_for(gap);
+        }
+
+        Result result;
+        result.wakeups = service.getWakeupCount() - wakeupsBefore;
+        service.stop();
+        service.clearBindings();
+
+        latencies.resize(std::min(events, delivered.load()));
+        std::sort(latencies.begin(), latencies.end());
+        result.latenciesUs = std::move(latencies);
+        result.events = events;
+        return result;
+    }
+}
+
+#endif // INPUT_LATENCY_H
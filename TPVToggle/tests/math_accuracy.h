@@ -0,0 +1,156 @@
+/**
+ * @file math_accuracy.h
+ * @brief Error of each math kernel against the double-precision references, per input distribution.
+ *
+ * Shared by test_math_accuracy.cpp, which bounds the errors, and
+ * bench_math.cpp, which reports them as JSON records next to the timings.
+ */
+#ifndef MATH_ACCURACY_H
+#define MATH_ACCURACY_H
+
+#include "math_reference.h"
+
+#include <string>
+#include <vector>
+
+namespace MathAccuracy
+{
+    /** @brief Rotation distributions every kernel is measured over. */
+    inline const std::vector<std::string> &distributions()
+    {
+        static const std::vector<std::string> names = {"uniform", "near_identity", "near_half_turn"};
+        return names;
+    }
+
+    // Vectors from camera-offset scale up to world positions
+    constexpr double MIN_VECTOR_LENGTH = 1e-2;
+    constexpr double MAX_VECTOR_LENGTH = 1e4;
+
+    /** @brief Quaternion::Rotate on single vectors. */
+    inline MathReference::ErrorStats rotate(const std::string &distribution, size_t count)
+    {
+        std::mt19937 rng(101);
+        MathReference::ErrorStats stats;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Quaternion q = MathReference::randomRotation(rng, distribution);
+            const Vector3 v = MathReference::randomVector(rng, MIN_VECTOR_LENGTH, MAX_VECTOR_LENGTH);
+            double reference[3];
+            MathReference::rotate(q, v, reference);
+            stats.addVector(q.Rotate(v), reference);
+        }
+        return stats;
+    }
+
+    /** @brief RotateVectors or RotateVectorsSoA on batches of batchSize vectors. */
+    inline MathReference::ErrorStats rotateBatch(const std::string &distribution, size_t batches, size_t batchSize, bool soa)
+    {
+        std::mt19937 rng(202);
+        MathReference::ErrorStats stats;
+        std::vector<Vector3> in(batchSize), out(batchSize);
+        std::vector<float> x(batchSize), y(batchSize), z(batchSize);
+        for (size_t b = 0; b < batches; ++b)
+        {
+            const Quaternion q = MathReference::randomRotation(rng, distribution);
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                in[i] = MathReference::randomVector(rng, MIN_VECTOR_LENGTH, MAX_VECTOR_LENGTH);
+                x[i] = in[i].x;
+                y[i] = in[i].y;
+                z[i] = in[i].z;
+            }
+
+            if (soa)
+            {
+                RotateVectorsSoA(q, x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), batchSize);
+                for (size_t i = 0; i < batchSize; ++i)
+                    out[i] = Vector3(x[i], y[i], z[i]);
+            }
+            else
+            {
+                RotateVectors(q, in.data(), out.data(), batchSize);
+            }
+
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                double reference[3];
+                MathReference::rotate(q, in[i], reference);
+                stats.addVector(out[i], reference);
+            }
+        }
+        return stats;
+    }
+
+    /** @brief Quaternion::ToBasis rows (unit length, so ulps are of 1). */
+    inline MathReference::ErrorStats toBasis(const std::string &distribution, size_t count)
+    {
+        std::mt19937 rng(303);
+        MathReference::ErrorStats stats;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Quaternion q = MathReference::randomRotation(rng, distribution);
+            Vector3 rows[3];
+            q.ToBasis(rows[0], rows[1], rows[2]);
+
+            MathReference::QuatD reference = MathReference::toDouble(q);
+            const double length = std::sqrt(reference.x * reference.x + reference.y * reference.y +
+                                            reference.z * reference.z + reference.w * reference.w);
+            reference = {reference.x / length, reference.y / length, reference.z / length, reference.w / length};
+            double referenceRows[3][3];
+            MathReference::basis(reference, referenceRows);
+            for (int r = 0; r < 3; ++r)
+                stats.addVector(rows[r], referenceRows[r]);
+        }
+        return stats;
+    }
+
+    /** @brief Matrix34f::Decompose of matrices rounded from exact rotations. */
+    inline MathReference::ErrorStats decompose(const std::string &distribution, size_t count)
+    {
+        std::mt19937 rng(404);
+        MathReference::ErrorStats stats;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Quaternion q = MathReference::randomRotation(rng, distribution);
+            Vector3 position;
+            Quaternion decomposed;
+            MathReference::matrixOf(q, Vector3()).Decompose(position, decomposed);
+            stats.addRotation(decomposed, MathReference::toDouble(q));
+        }
+        return stats;
+    }
+
+    /** @brief Quaternion::Slerp from a rotation of the distribution to a random one, or a nearby one. */
+    inline MathReference::ErrorStats slerp(const std::string &distribution, size_t count, bool nearby)
+    {
+        std::mt19937 rng(505);
+        std::uniform_real_distribution<float> t(0.0f, 1.0f);
+        MathReference::ErrorStats stats;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Quaternion from = MathReference::randomRotation(rng, distribution);
+            const Quaternion to = nearby ? MathReference::randomSmallRotation(rng, 1e-2) * from : MathReference::randomRotation(rng);
+            const float fraction = t(rng);
+            stats.addRotation(Quaternion::Slerp(from, to, fraction), MathReference::slerp(from, to, fraction));
+        }
+        return stats;
+    }
+
+    /** @brief Quaternion::LookRotation with Z up, forward at least ~8 degrees off vertical. */
+    inline MathReference::ErrorStats lookRotation(size_t count)
+    {
+        std::mt19937 rng(606);
+        MathReference::ErrorStats stats;
+        const Vector3 up(0.0f, 0.0f, 1.0f);
+        while (stats.samples < count)
+        {
+            const Vector3 forward = MathReference::randomVector(rng, 1.0, 1.0);
+            if (std::abs(forward.z) > 0.99f)
+                continue;
+            stats.addRotation(Quaternion::LookRotation(forward, up), MathReference::lookRotation(forward, up));
+        }
+        return stats;
+    }
+}
+
+#endif // MATH_ACCURACY_H
@@ -0,0 +1,293 @@
+/**
+ * @file math_reference.h
+ * @brief Input generators, double-precision reference math and error measurement
+ *        for the math tests and benchmarks.
+ *
+ * Errors are reported two ways:
+ * - ulp: absolute error divided by the spacing of floats at the magnitude of
+ *   the result (the vector length, or 1 for unit rows), so a component near
+ *   zero is not charged millions of ulps for an error that is invisible next
+ *   to the others;
+ * - angle: radians between the computed and reference direction or rotation.
+ */
+#ifndef MATH_REFERENCE_H
+#define MATH_REFERENCE_H
+
+#include "math_utils.h"
+#include "game_structures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace MathReference
+{
+    constexpr double TWO_PI = 6.283185307179586;
+
+    /** @brief Quaternion in double precision (x, y, z, w). */
+    struct QuatD
+    {
+        double x, y, z, w;
+    };
+
+    inline QuatD toDouble(const Quaternion &q) { return {q.x, q.y, q.z, q.w}; }
+
+    /** @brief Uniformly distributed unit quaternion (Shoemake's method). */
+    inline Quaternion randomRotation(std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        const double u1 = unit(rng), u2 = unit(rng) * TWO_PI, u3 = unit(rng) * TWO_PI;
+        const double a = std::sqrt(1.0 - u1), b = std::sqrt(u1);
+        return Quaternion(static_cast<float>(a * std::sin(u2)), static_cast<float>(a * std::cos(u2)),
+                          static_cast<float>(b * std::sin(u3)), static_cast<float>(b * std::cos(u3)));
+    }
+
+    /** @brief Unit quaternion within maxAngle radians of identity. */
+    inline Quaternion randomSmallRotation(std::mt19937 &rng, double maxAngle)
+    {
+        std::normal_distribution<double> normal;
+        std::uniform_real_distribution<double> angle(0.0, maxAngle);
+        double ax = normal(rng), ay = normal(rng), az = normal(rng);
+        const double length = std::sqrt(ax * ax + ay * ay + az * az);
+        const double half = angle(rng) * 0.5, s = std::sin(half) / length;
+        return Quaternion(static_cast<float>(ax * s), static_cast<float>(ay * s), static_cast<float>(az * s),
+                          static_cast<float>(std::cos(half)));
+    }
+
+    /** @brief Unit quaternion within maxAngle radians of a half turn (w near zero). */
+    inline Quaternion randomNearHalfTurn(std::mt19937 &rng, double maxAngle)
+    {
+        const Quaternion q = randomSmallRotation(rng, maxAngle);
+        // Compose with a half turn about a random axis
+        std::normal_distribution<double> normal;
+        double ax = normal(rng), ay = normal(rng), az = normal(rng);
+        const double length = std::sqrt(ax * ax + ay * ay + az * az);
+        const Quaternion halfTurn(static_cast<float>(ax / length), static_cast<float>(ay / length),
+                                  static_cast<float>(az / length), 0.0f);
+        return halfTurn * q;
+    }
+
+    /** @brief Random direction with length log-uniform in [minLength, maxLength]. */
+    inline Vector3 randomVector(std::mt19937 &rng, double minLength, double maxLength)
+    {
+        std::normal_distribution<double> normal;
+        std::uniform_real_distribution<double> logLength(std::log(minLength), std::log(maxLength));
+        const double x = normal(rng), y = normal(rng), z = normal(rng);
+        const double scale = std::exp(logLength(rng)) / std::sqrt(x * x + y * y + z * z);
+        return Vector3(static_cast<float>(x * scale), static_cast<float>(y * scale), static_cast<float>(z * scale));
+    }
+
+    /** @brief Rotation drawn from a named distribution: "uniform", "near_identity" or "near_half_turn". */
+    inline Quaternion randomRotation(std::mt19937 &rng, const std::string &distribution)
+    {
+        if (distribution == "near_identity")
+            return randomSmallRotation(rng, 1e-3);
+        if (distribution == "near_half_turn")
+            return randomNearHalfTurn(rng, 1e-3);
+        return randomRotation(rng);
+    }
+
+    /** @brief Rotation matrix rows (the rotated X, Y, Z axes, as ToBasis) of a unit quaternion. */
+    inline void basis(const QuatD &q, double rows[3][3])
+    {
+        const double xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        const double xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        const double wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+        const double r[3][3] = {{1.0 - 2.0 * (yy + zz), 2.0 * (xy + wz), 2.0 * (xz - wy)},
+                                {2.0 * (xy - wz), 1.0 - 2.0 * (xx + zz), 2.0 * (yz + wx)},
+                                {2.0 * (xz + wy), 2.0 * (yz - wx), 1.0 - 2.0 * (xx + yy)}};
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                rows[i][j] = r[i][j];
+    }
+
+    /** @brief v rotated by the (normalized) quaternion, in double precision. */
+    inline void rotate(const Quaternion &rotation, const Vector3 &v, double out[3])
+    {
+        QuatD q = toDouble(rotation);
+        const double length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        q = {q.x / length, q.y / length, q.z / length, q.w / length};
+        double rows[3][3];
+        basis(q, rows);
+        // The rows are the images of the axes
+        for (int j = 0; j < 3; ++j)
+            out[j] = v.x * rows[0][j] + v.y * rows[1][j] + v.z * rows[2][j];
+    }
+
+    /** @brief Unit quaternion whose basis() gives the given orthonormal rows (Shepperd's method, in double). */
+    inline QuatD fromRows(const double r[3][3])
+    {
+        const double trace = r[0][0] + r[1][1] + r[2][2];
+        QuatD q;
+        if (trace >= r[0][0] && trace >= r[1][1] && trace >= r[2][2])
+        {
+            const double s = 2.0 * std::sqrt(1.0 + trace);
+            q = {(r[1][2] - r[2][1]) / s, (r[2][0] - r[0][2]) / s, (r[0][1] - r[1][0]) / s, 0.25 * s};
+        }
+        else if (r[0][0] >= r[1][1] && r[0][0] >= r[2][2])
+        {
+            const double s = 2.0 * std::sqrt(1.0 + r[0][0] - r[1][1] - r[2][2]);
+            q = {0.25 * s, (r[0][1] + r[1][0]) / s, (r[0][2] + r[2][0]) / s, (r[1][2] - r[2][1]) / s};
+        }
+        else if (r[1][1] >= r[2][2])
+        {
+            const double s = 2.0 * std::sqrt(1.0 + r[1][1] - r[0][0] - r[2][2]);
+            q = {(r[0][1] + r[1][0]) / s, 0.25 * s, (r[1][2] + r[2][1]) / s, (r[2][0] - r[0][2]) / s};
+        }
+        else
+        {
+            const double s = 2.0 * std::sqrt(1.0 + r[2][2] - r[0][0] - r[1][1]);
+            q = {(r[0][2] + r[2][0]) / s, (r[1][2] + r[2][1]) / s, 0.25 * s, (r[0][1] - r[1][0]) / s};
+        }
+        return q;
+    }
+
+    /** @brief Quaternion::LookRotation in double: the rotation whose rows are the inverse of XMMatrixLookToRH. */
+    inline QuatD lookRotation(const Vector3 &forward, const Vector3 &up)
+    {
+        auto normalize = [](double v[3])
+        {
+            const double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+            for (int i = 0; i < 3; ++i)
+                v[i] /= length;
+        };
+        auto cross = [](const double a[3], const double b[3], double out[3])
+        {
+            out[0] = a[1] * b[2] - a[2] * b[1];
+            out[1] = a[2] * b[0] - a[0] * b[2];
+            out[2] = a[0] * b[1] - a[1] * b[0];
+        };
+        double r[3][3];
+        double u[3] = {up.x, up.y, up.z};
+        r[2][0] = -forward.x;
+        r[2][1] = -forward.y;
+        r[2][2] = -forward.z;
+        normalize(r[2]);
+        cross(u, r[2], r[0]);
+        normalize(r[0]);
+        cross(r[2], r[0], r[1]);
+        return fromRows(r);
+    }
+
+    /** @brief Quaternion::Slerp in double (shortest path, like XMQuaternionSlerp). */
+    inline QuatD slerp(const Quaternion &from, const Quaternion &to, double t)
+    {
+        const QuatD a = toDouble(from);
+        QuatD b = toDouble(to);
+        double cosine = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        if (cosine < 0.0)
+        {
+            b = {-b.x, -b.y, -b.z, -b.w};
+            cosine = -cosine;
+        }
+        double wa = 1.0 - t, wb = t;
+        if (cosine < 1.0 - 1e-12)
+        {
+            const double angle = std::acos(std::min(1.0, cosine));
+            wa = std::sin((1.0 - t) * angle) / std::sin(angle);
+            wb = std::sin(t * angle) / std::sin(angle);
+        }
+        QuatD q = {wa * a.x + wb * b.x, wa * a.y + wb * b.y, wa * a.z + wb * b.z, wa * a.w + wb * b.w};
+        const double length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        return {q.x / length, q.y / length, q.z / length, q.w / length};
+    }
+
+    /** @brief CryEngine 3x4 matrix of a rotation and position, each entry rounded once from double. */
+    inline GameStructures::Matrix34f matrixOf(const Quaternion &rotation, const Vector3 &position)
+    {
+        QuatD q = toDouble(rotation);
+        const double length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        q = {q.x / length, q.y / length, q.z / length, q.w / length};
+        double rows[3][3];
+        basis(q, rows);
+
+        GameStructures::Matrix34f matrix;
+        const float translation[3] = {position.x, position.y, position.z};
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+                matrix.m[i][j] = static_cast<float>(rows[i][j]);
+            matrix.m[i][3] = translation[i];
+        }
+        return matrix;
+    }
+
+    /**
+     * @brief Angle in radians of the rotation taking a to b, in double precision.
+     * @details q and -q are the same rotation, so the nearer sign is used. Uses
+     *          atan2 of |a - b| and |a + b| rather than acos of the dot product,
+     *          which loses all precision for small angles.
+     */
+    inline double angleBetween(const QuatD &p, const QuatD &q)
+    {
+        const double pLength = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z + p.w * p.w);
+        const double qLength = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        const double sign = (p.x * q.x + p.y * q.y + p.z * q.z + p.w * q.w) < 0.0 ? -1.0 : 1.0;
+
+        double difference = 0.0, sum = 0.0;
+        const double pc[4] = {p.x / pLength, p.y / pLength, p.z / pLength, p.w / pLength};
+        const double qc[4] = {sign * q.x / qLength, sign * q.y / qLength, sign * q.z / qLength, sign * q.w / qLength};
+        for (int i = 0; i < 4; ++i)
+        {
+            difference += (pc[i] - qc[i]) * (pc[i] - qc[i]);
+            sum += (pc[i] + qc[i]) * (pc[i] + qc[i]);
+        }
+        return 4.0 * std::atan2(std::sqrt(difference), std::sqrt(sum));
+    }
+
+    inline double angleBetween(const Quaternion &a, const Quaternion &b) { return angleBetween(toDouble(a), toDouble(b)); }
+
+    /** @brief Spacing of floats at magnitude (ulp), in double. */
+    inline double ulpAt(double magnitude)
+    {
+        const float f = std::max(static_cast<float>(std::abs(magnitude)), std::numeric_limits<float>::min());
+        return static_cast<double>(std::nextafter(f, std::numeric_limits<float>::infinity())) - static_cast<double>(f);
+    }
+
+    /** @brief Worst and mean error over a run of samples. */
+    struct ErrorStats
+    {
+        uint64_t samples = 0;
+        uint64_t ulpSamples = 0; // Rotations are measured by angle only
+        double maxUlp = 0.0;
+        double sumUlp = 0.0;
+        double maxAngle = 0.0; // Radians
+
+        double meanUlp() const { return ulpSamples ? sumUlp / static_cast<double>(ulpSamples) : 0.0; }
+
+        /** @brief Adds a computed vector against its reference, in ulps of the reference length and angle. */
+        void addVector(const Vector3 &computed, const double reference[3])
+        {
+            const double length = std::sqrt(reference[0] * reference[0] + reference[1] * reference[1] + reference[2] * reference[2]);
+            const double c[3] = {computed.x, computed.y, computed.z};
+            double error = 0.0, dot = 0.0, crossSquared = 0.0;
+            for (int i = 0; i < 3; ++i)
+            {
+                error = std::max(error, std::abs(c[i] - reference[i]));
+                dot += c[i] * reference[i];
+            }
+            const double cross[3] = {c[1] * reference[2] - c[2] * reference[1], c[2] * reference[0] - c[0] * reference[2],
+                                     c[0] * reference[1] - c[1] * reference[0]};
+            for (double component : cross)
+                crossSquared += component * component;
+            ++samples;
+            ++ulpSamples;
+            const double ulp = error / ulpAt(length);
+            maxUlp = std::max(maxUlp, ulp);
+            sumUlp += ulp;
+            maxAngle = std::max(maxAngle, std::atan2(std::sqrt(crossSquared), dot));
+        }
+
+        /** @brief Adds a computed rotation against its reference (angle only). */
+        void addRotation(const Quaternion &computed, const QuatD &reference)
+        {
+            ++samples;
+            maxAngle = std::max(maxAngle, angleBetween(toDouble(computed), reference));
+        }
+    };
+}
+
+#endif // MATH_REFERENCE_H
@@ -0,0 +1,124 @@
+/**
+ * @file replay_main.cpp
+ * @brief Replays an input recording (RecordInput = true) through the view toggle actions.
+ *
+ * Usage: tpvtoggle_replay <recording.rec> [--toggle KEYS] [--fpv KEYS] [--tpv KEYS]
+ *                         [--hold-scroll KEYS] [--view 0|1]
+ *
+ * KEYS take the INI syntax (comma-separated hotkey expressions) and default
+ * to the INI defaults; pass the values the recording was made with. --view
+ * is the view the game was in when recording started (default FPV). The
+ * game is simulated (sim_game.cpp). Prints one JSON object with the recorded
+ * and replay times and the resulting view changes.
+ */
+
+#include "input_recording.h"
+#include "input_service.h"
+#include "toggle_thread.h"
+#include "game_commands.h"
+#include "config.h"
+#include "logger.h"
+#include "sim_game.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+extern Config g_config;
+
+namespace
+{
+    bool parseHotkeys(const std::string &text, HotkeyList &out)
+    {
+        out.clear();
+        size_t begin = 0;
+        while (begin <= text.size())
+        {
+            size_t end = text.find(',', begin);
+            if (end == std::string::npos)
+                end = text.size();
+            const std::string expression = text.substr(begin, end - begin);
+            if (expression.find_first_not_of(" \t") != std::string::npos)
+            {
+                Hotkey hotkey;
+                std::string error;
+                if (!Hotkey::parse(expression, hotkey, error))
+                {
+                    std::cerr << "Invalid hotkey '" << expression << "': " << error << std::endl;
+                    return false;
+                }
+                out.push_back(std::move(hotkey));
+            }
+            begin = end + 1;
+        }
+        return true;
+    }
+
+    int usage()
+    {
+        std::cerr << "Usage: tpvtoggle_replay <recording.rec> [--toggle KEYS] [--fpv KEYS] [--tpv KEYS]"
+                     " [--hold-scroll KEYS] [--view 0|1]"
+                  << std::endl;
+        return 2;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+        return usage();
+    const std::string path = argv[1];
+
+    ToggleData keys;
+    parseHotkeys("0x72", keys.toggle_keys); // ToggleKey default
+    int view = 0;
+    for (int i = 2; i < argc; i += 2)
+    {
+        if (i + 1 >= argc)
+            return usage();
+        const char *option = argv[i];
+        const std::string value = argv[i + 1];
+        bool ok = true;
+        if (std::strcmp(option, "--toggle") == 0)
+            ok = parseHotkeys(value, keys.toggle_keys);
+        else if (std::strcmp(option, "--fpv") == 0)
+            ok = parseHotkeys(value, keys.fpv_keys);
+        else if (std::strcmp(option, "--tpv") == 0)
+            ok = parseHotkeys(value, keys.tpv_keys);
+        else if (std::strcmp(option, "--hold-scroll") == 0)
+            ok = parseHotkeys(value, g_config.hold_scroll_keys);
+        else if (std::strcmp(option, "--view") == 0 && (value == "0" || value == "1"))
+            view = value == "1" ? 1 : 0;
+        else
+            return usage();
+        if (!ok)
+            return 2;
+    }
+
+    std::vector<InputRecord> records;
+    std::string error;
+    if (!loadInputRecording(path, records, error))
+    {
+        std::cerr << "Cannot read " << path << ": " << error << std::endl;
+        return 1;
+    }
+
+    Logger::getInstance().setLogLevel(LOG_WARNING);
+    SimGame::reset(static_cast<uint8_t>(view));
+    registerToggleActions(std::move(keys));
+
+    // No camera updates in the simulation: the input thread (here the replay) applies game commands
+    GameCommandQueue::getInstance().setGameThreadAttached(false);
+    InputReplay replay(std::move(records));
+    const double wallSeconds = replay.run();
+
+    std::cout << "{\"replay\":\"" << path << "\""
+              << ",\"events\":" << replay.size()
+              << ",\"recorded_s\":" << replay.duration()
+              << ",\"replay_s\":" << wallSeconds
+              << ",\"speedup\":" << (wallSeconds > 0.0 ? replay.duration() / wallSeconds : 0.0)
+              << ",\"view_changes\":" << SimGame::viewChanges()
+              << ",\"final_view\":" << static_cast<int>(SimGame::view()) << "}" << std::endl;
+    return 0;
+}
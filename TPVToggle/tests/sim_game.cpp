@@ -0,0 +1,96 @@
+/**
+ * @file sim_game.cpp
+ * @brief Stand-ins for the game-facing functions the host-side tests and tools link against.
+ *
+ * The real definitions live in the hooks and game_interface.cpp and read or
+ * patch game memory; these keep just enough state for the code under test to
+ * observe (see sim_game.h).
+ */
+
+#include "sim_game.h"
+#include "config.h"
+#include "game_interface.h"
+#include "hooks/fov_hook.h"
+#include "hooks/ui_overlay_hooks.h"
+
+#include <atomic>
+
+// Defined by dllmain.cpp in the mod; defaults here
+Config g_config;
+
+namespace
+{
+    std::atomic<float> g_simFovOverride(0.0f);
+
+    // Written by whichever thread drains the game commands, read by the test
+    volatile uint8_t g_simTpvFlag = 0;
+    std::atomic<uint64_t> g_simViewChanges(0);
+    std::atomic<bool> g_simHoldToScroll(false);
+}
+
+void SimGame::reset(uint8_t view)
+{
+    g_simTpvFlag = view;
+    g_simViewChanges.store(0);
+    g_simHoldToScroll.store(false);
+}
+
+uint8_t SimGame::view()
+{
+    return g_simTpvFlag;
+}
+
+uint64_t SimGame::viewChanges()
+{
+    return g_simViewChanges.load();
+}
+
+bool SimGame::holdToScroll()
+{
+    return g_simHoldToScroll.load();
+}
+
+// --- game_interface.h ---
+
+volatile uint8_t *getResolvedTpvFlagAddress()
+{
+    return &g_simTpvFlag;
+}
+
+int getViewState()
+{
+    return g_simTpvFlag;
+}
+
+bool setViewState(uint8_t new_state, int *)
+{
+    if (g_simTpvFlag != new_state)
+    {
+        g_simTpvFlag = new_state;
+        g_simViewChanges.fetch_add(1);
+    }
+    return true;
+}
+
+bool safeToggleViewState(int *key_pressed_vk)
+{
+    return setViewState(g_simTpvFlag == 1 ? 0 : 1, key_pressed_vk);
+}
+
+// --- hooks ---
+
+void setTpvFovOverride(float degrees)
+{
+    g_simFovOverride.store(degrees, std::memory_order_relaxed);
+}
+
+float getConfiguredTpvFov()
+{
+    return 0.0f; // FOV hook not configured
+}
+
+bool handleHoldToScrollKeyState(bool holdKeyPressed)
+{
+    g_simHoldToScroll.store(holdKeyPressed);
+    return true;
+}
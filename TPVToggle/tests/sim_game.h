@@ -0,0 +1,28 @@
+/**
+ * @file sim_game.h
+ * @brief Controls of the simulated game (sim_game.cpp) for host-side tests and tools.
+ *
+ * The view flag behaves like the game's: setViewState() writes it and the
+ * game reads it on its next frame, which the simulation does at once.
+ */
+#ifndef SIM_GAME_H
+#define SIM_GAME_H
+
+#include <cstdint>
+
+namespace SimGame
+{
+    /** @brief Puts the game in view (0 = FPV, 1 = TPV) and clears the counters. */
+    void reset(uint8_t view);
+
+    /** @brief Current view flag (0 = FPV, 1 = TPV). */
+    uint8_t view();
+
+    /** @brief Times the flag was written with a different value since reset(). */
+    uint64_t viewChanges();
+
+    /** @brief State last passed to handleHoldToScrollKeyState(). */
+    bool holdToScroll();
+}
+
+#endif // SIM_GAME_H
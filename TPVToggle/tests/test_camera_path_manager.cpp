@@ -0,0 +1,65 @@
+/**
+ * @file test_camera_path_manager.cpp
+ * @brief Path playback toggling between the input thread and the render thread.
+ */
+
+#include "test_framework.h"
+#include "camera_path_manager.h"
+#include "global_state.h"
+
+namespace
+{
+    // Loads (no paths file yet) and records a two-keyframe path one second long
+    void recordPath(CameraPathManager &paths, const std::string &name)
+    {
+        REQUIRE(paths.loadPaths(TestFramework::scratchDirectory(name), 1.0f));
+        g_currentCameraOffset.store(Vector3(0.0f, 0.0f, 0.0f));
+        paths.captureKeyframe();
+        g_currentCameraOffset.store(Vector3(2.0f, 0.0f, 0.0f));
+        paths.captureKeyframe();
+    }
+
+    bool renderFrame(CameraPathManager &paths, float deltaTime)
+    {
+        Vector3 offset;
+        Quaternion rotation;
+        return paths.updatePlayback(deltaTime, offset, rotation);
+    }
+}
+
+TEST_CASE(path_quick_double_press_plays_then_stops)
+{
+    CameraPathManager &paths = CameraPathManager::getInstance();
+    recordPath(paths, "path_double_press");
+    renderFrame(paths, 0.0f);
+
+    // Two presses before the render thread runs: play, then stop (not play twice)
+    paths.togglePlayback();
+    paths.togglePlayback();
+    CHECK(!renderFrame(paths, 0.016f));
+    CHECK(!paths.isPlaying());
+
+    // A third press plays again
+    paths.togglePlayback();
+    CHECK(renderFrame(paths, 0.016f));
+    CHECK(paths.isPlaying());
+    paths.togglePlayback();
+    CHECK(!renderFrame(paths, 0.016f));
+}
+
+TEST_CASE(path_press_after_playback_finished_plays_again)
+{
+    CameraPathManager &paths = CameraPathManager::getInstance();
+    recordPath(paths, "path_finished");
+    renderFrame(paths, 0.0f);
+
+    paths.togglePlayback();
+    CHECK(renderFrame(paths, 0.5f));
+    CHECK(!renderFrame(paths, 0.6f)); // Ran past the 1 s path: finished on its own
+
+    // The last command sent was a play, but it has ended: the next press plays
+    paths.togglePlayback();
+    CHECK(renderFrame(paths, 0.1f));
+    paths.togglePlayback();
+    CHECK(!renderFrame(paths, 0.0f));
+}
@@ -0,0 +1,145 @@
+/**
+ * @file test_damped_spring.cpp
+ * @brief Property tests: the spring lands in the same place whatever the frame rate.
+ */
+
+#include "test_framework.h"
+#include "damped_spring.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct State
+    {
+        float position;
+        float velocity;
+    };
+
+    // Steps the 1-D spring through the given frame times
+    State simulate(const DampedSpring &spring, State state, float target, const std::vector<float> &frames)
+    {
+        for (float dt : frames)
+            spring.step(state.position, state.velocity, target, dt);
+        return state;
+    }
+
+    std::vector<float> fixedFrames(float seconds, float fps)
+    {
+        const int count = static_cast<int>(seconds * fps + 0.5f);
+        return std::vector<float>(static_cast<size_t>(count), seconds / static_cast<float>(count));
+    }
+
+    // Irregular frame times (5..60 ms, plus the odd hitch) summing to seconds
+    std::vector<float> jitteredFrames(float seconds, std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> frame(0.005f, 0.06f);
+        std::uniform_int_distribution<int> hitch(0, 30);
+        std::vector<float> frames;
+        float total = 0.0f;
+        while (total < seconds)
+        {
+            float dt = hitch(rng) == 0 ? 0.15f : frame(rng);
+            dt = std::min(dt, seconds - total);
+            frames.push_back(dt);
+            total += dt;
+        }
+        return frames;
+    }
+}
+
+TEST_CASE(spring_trajectory_is_frame_rate_independent)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> damping(0.1f, 3.0f);
+    std::uniform_real_distribution<float> frequency(0.5f, 30.0f);
+    std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+
+    const float seconds = 1.0f;
+    int cases = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        const DampedSpring spring(frequency(rng), damping(rng));
+        const State start{value(rng), value(rng)};
+        const float target = value(rng);
+
+        // One analytic step over the whole interval is the reference
+        const State reference = simulate(spring, start, target, {seconds});
+        const float scale = 1.0f + std::abs(start.position - target) + std::abs(start.velocity);
+
+        for (const float fps : {30.0f, 60.0f, 144.0f, 240.0f})
+        {
+            const State stepped = simulate(spring, start, target, fixedFrames(seconds, fps));
+            CHECK_NEAR(stepped.position, reference.position, 1e-4 * scale);
+            CHECK_NEAR(stepped.velocity, reference.velocity, 1e-3 * scale * (1.0f + spring.angularFrequency()));
+        }
+        const State jittered = simulate(spring, start, target, jitteredFrames(seconds, rng));
+        CHECK_NEAR(jittered.position, reference.position, 1e-4 * scale);
+        ++cases;
+    }
+    CHECK_EQ(cases, 200);
+}
+
+TEST_CASE(spring_near_critical_damping_is_continuous)
+{
+    // The critical branch takes over inside a small band; either side must agree with it
+    const State start{5.0f, -2.0f};
+    const State critical = simulate(DampedSpring(8.0f, 1.0f), start, 0.0f, {0.25f});
+    for (const float zeta : {0.998f, 0.9995f, 1.0005f, 1.002f})
+    {
+        const State nearby = simulate(DampedSpring(8.0f, zeta), start, 0.0f, {0.25f});
+        CHECK_NEAR(nearby.position, critical.position, 5e-3);
+    }
+}
+
+TEST_CASE(spring_critically_damped_approach_does_not_overshoot)
+{
+    // From rest, a critically damped spring approaches the target monotonically at any frame rate
+    for (const float fps : {24.0f, 60.0f, 240.0f})
+    {
+        const DampedSpring spring(DampedSpring::frequencyForHalfLife(0.2f), 1.0f);
+        State state{10.0f, 0.0f};
+        float previous = state.position;
+        bool monotonic = true;
+        for (float dt : fixedFrames(3.0f, fps))
+        {
+            spring.step(state.position, state.velocity, 0.0f, dt);
+            monotonic = monotonic && state.position <= previous && state.position >= 0.0f;
+            previous = state.position;
+        }
+        CHECK(monotonic);
+        CHECK_NEAR(state.position, 0.0f, 1e-3);
+    }
+}
+
+TEST_CASE(spring_half_life_closes_half_the_gap)
+{
+    for (const float halfLife : {0.05f, 0.2f, 1.0f})
+    {
+        const DampedSpring spring(DampedSpring::frequencyForHalfLife(halfLife), 1.0f);
+        const State after = simulate(spring, State{1.0f, 0.0f}, 0.0f, fixedFrames(halfLife, 120.0f));
+        CHECK_NEAR(after.position, 0.5f, 1e-4);
+    }
+}
+
+TEST_CASE(spring_stays_finite_for_extreme_frame_times)
+{
+    const DampedSpring stiff(200.0f, 0.3f);
+    State state{1000.0f, -500.0f};
+    for (const float dt : {0.0f, 1e-7f, 0.5f, 10.0f})
+    {
+        stiff.step(state.position, state.velocity, 0.0f, dt);
+        CHECK(std::isfinite(state.position));
+        CHECK(std::isfinite(state.velocity));
+    }
+    CHECK_NEAR(state.position, 0.0f, 1e-2);
+
+    // No spring at all: drift at the current velocity
+    const DampedSpring none(0.0f, 1.0f);
+    State drift{0.0f, 2.0f};
+    none.step(drift.position, drift.velocity, 5.0f, 0.5f);
+    CHECK_NEAR(drift.position, 1.0f, 1e-6);
+}
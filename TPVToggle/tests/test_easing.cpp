@@ -0,0 +1,59 @@
+/**
+ * @file test_easing.cpp
+ * @brief Baked easing tables against the curves they sample.
+ */
+
+#include "test_framework.h"
+#include "easing.h"
+
+#include <cmath>
+
+TEST_CASE(easing_curves_hit_their_endpoints)
+{
+    for (const char *spec : {"linear", "smoothstep", "smootherstep", "ease-in", "ease-out", "ease-in-out", "ease-in-back",
+                             "ease-out-back", "ease-in-out-back", "ease-in-elastic", "ease-out-elastic", "ease",
+                             "cubic-bezier(0.1, 0.7, 1.0, 0.1)"})
+    {
+        EasingCurve curve;
+        REQUIRE(EasingCurve::parse(spec, curve));
+        CHECK_NEAR(curve(0.0f), 0.0f, 1e-6);
+        CHECK_NEAR(curve(1.0f), 1.0f, 1e-6);
+        CHECK_NEAR(curve(-3.0f), 0.0f, 1e-6); // Clamped
+        CHECK_NEAR(curve(7.0f), 1.0f, 1e-6);
+    }
+
+    EasingCurve untouched;
+    CHECK(!EasingCurve::parse("bouncy", untouched));
+    CHECK(!EasingCurve::parse("cubic-bezier(0.1, 0.2)", untouched));
+    CHECK_EQ(untouched.spec(), std::string("smoothstep"));
+}
+
+TEST_CASE(easing_baked_table_error_is_bounded)
+{
+    // Interpolation error of the table between samples, against the exact curve
+    double smoothstepError = 0.0, bezierError = 0.0;
+    EasingCurve smoothstep;
+    const EasingCurve css = EasingCurve::cubicBezier(0.25f, 0.1f, 0.25f, 1.0f);
+    for (int i = 0; i <= 10000; ++i)
+    {
+        const float t = static_cast<float>(i) / 10000.0f;
+        smoothstepError = std::max(smoothstepError, std::fabs(double(smoothstep(t)) - t * t * (3.0 - 2.0 * t)));
+        bezierError = std::max(bezierError, std::fabs(double(css(t)) - EasingCurve::solveCubicBezier(0.25f, 0.1f, 0.25f, 1.0f, t)));
+    }
+    CHECK(smoothstepError < 5e-5);
+    CHECK(bezierError < 2e-4);
+}
+
+TEST_CASE(easing_bezier_solver_inverts_x)
+{
+    // Points on the curve: solving at x(s) must give y(s)
+    const float x1 = 0.42f, y1 = 0.0f, x2 = 0.58f, y2 = 1.0f;
+    for (int i = 1; i < 100; ++i)
+    {
+        const float s = static_cast<float>(i) / 100.0f;
+        const float u = 1.0f - s;
+        const float x = 3.0f * u * u * s * x1 + 3.0f * u * s * s * x2 + s * s * s;
+        const float y = 3.0f * u * u * s * y1 + 3.0f * u * s * s * y2 + s * s * s;
+        CHECK_NEAR(EasingCurve::solveCubicBezier(x1, y1, x2, y2, x), y, 1e-5);
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_frame_clock.cpp
+ * @brief FrameClock driven by a synthetic time source.
+ */
+
+#include "test_framework.h"
+#include "frame_clock.h"
+#include "constants.h"
+
+namespace
+{
+    // Synthetic time; FrameClock takes a plain function pointer
+    double g_now = 0.0;
+    double syntheticSeconds() { return g_now; }
+
+    // Ticks at a fixed rate for a while and returns the last delta
+    float run(FrameClock &clock, double frameSeconds, int frames)
+    {
+        float delta = 0.0f;
+        for (int i = 0; i < frames; ++i)
+        {
+            g_now += frameSeconds;
+            delta = clock.tick();
+        }
+        return delta;
+    }
+}
+
+TEST_CASE(frame_clock_first_tick_returns_nominal_delta)
+{
+    g_now = 100.0;
+    FrameClock clock(&syntheticSeconds);
+    CHECK_NEAR(clock.tick(), Constants::FRAME_CLOCK_NOMINAL_DELTA, 1e-7);
+}
+
+TEST_CASE(frame_clock_converges_to_the_frame_rate)
+{
+    g_now = 0.0;
+    FrameClock clock(&syntheticSeconds);
+    clock.tick();
+
+    CHECK_NEAR(run(clock, 1.0 / 144.0, 100), 1.0 / 144.0, 1e-5);
+    CHECK_NEAR(clock.deltaSeconds(), 1.0 / 144.0, 1e-5);
+    CHECK_NEAR(run(clock, 1.0 / 30.0, 100), 1.0 / 30.0, 1e-5);
+}
+
+TEST_CASE(frame_clock_second_update_in_a_frame_adds_no_time)
+{
+    g_now = 0.0;
+    FrameClock clock(&syntheticSeconds);
+    clock.tick();
+    run(clock, 1.0 / 60.0, 50);
+
+    // Two camera updates within one frame: the second returns 0 and the time is not lost
+    g_now += 0.00005;
+    CHECK_EQ(clock.tick(), 0.0f);
+    g_now += 1.0 / 60.0 - 0.00005;
+    CHECK_NEAR(clock.tick(), 1.0 / 60.0, 1e-5);
+}
+
+TEST_CASE(frame_clock_clamps_hitches_and_ignores_pauses)
+{
+    g_now = 0.0;
+    FrameClock clock(&syntheticSeconds);
+    clock.tick();
+    const float steady = run(clock, 1.0 / 60.0, 100);
+
+    // A 300 ms hitch counts as at most FRAME_CLOCK_MAX_DELTA, then smoothed
+    g_now += 0.3;
+    const float hitch = clock.tick();
+    CHECK(hitch > steady);
+    CHECK(hitch <= steady + (Constants::FRAME_CLOCK_MAX_DELTA - steady) * Constants::FRAME_CLOCK_SMOOTHING + 1e-6f);
+
+    // A loading screen (longer than the resume threshold) is not frame time at all
+    run(clock, 1.0 / 60.0, 100);
+    const float before = clock.deltaSeconds();
+    g_now += 5.0;
+    CHECK_NEAR(clock.tick(), before, 1e-7);
+    CHECK_NEAR(run(clock, 1.0 / 60.0, 1), before, 1e-5);
+}
+
+TEST_CASE(frame_clock_total_time_matches_wall_time_at_steady_rates)
+{
+    // What transitions rely on: summed deltas track elapsed time
+    for (const double rate : {30.0, 60.0, 144.0, 240.0})
+    {
+        g_now = 0.0;
+        FrameClock clock(&syntheticSeconds);
+        clock.tick();
+        run(clock, 1.0 / rate, 60); // Settle from the nominal delta
+
+        double total = 0.0;
+        const int frames = static_cast<int>(rate * 2.0);
+        for (int i = 0; i < frames; ++i)
+        {
+            g_now += 1.0 / rate;
+            total += clock.tick();
+        }
+        CHECK_NEAR(total, 2.0, 0.01);
+    }
+}
+
+TEST_CASE(frame_clock_reset_forgets_previous_tick)
+{
+    g_now = 0.0;
+    FrameClock clock(&syntheticSeconds);
+    clock.tick();
+    run(clock, 1.0 / 30.0, 100);
+
+    clock.reset();
+    CHECK_NEAR(clock.deltaSeconds(), Constants::FRAME_CLOCK_NOMINAL_DELTA, 1e-7);
+    g_now += 10.0;
+    CHECK_NEAR(clock.tick(), Constants::FRAME_CLOCK_NOMINAL_DELTA, 1e-7);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_framework.h
+ * @brief Minimal test registry and check macros for the host-side tests.
+ *
+ * Each TEST_CASE registers itself at static-init time; test_main.cpp runs
+ * them all (or those whose name contains the first argument) and exits
+ * non-zero if any check failed. A failed CHECK reports and continues; a
+ * failed REQUIRE also ends the current test.
+ */
+#ifndef TEST_FRAMEWORK_H
+#define TEST_FRAMEWORK_H
+
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TestFramework
+{
+    struct TestCase
+    {
+        const char *name;
+        std::function<void()> fn;
+    };
+
+    /** @brief Thrown by REQUIRE to end the current test. */
+    struct RequireFailed
+    {
+    };
+
+    inline std::vector<TestCase> &registry()
+    {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    inline int &failureCount()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char *name, std::function<void()> fn) { registry().push_back({name, std::move(fn)}); }
+    };
+
+    /**
+     * @brief Returns an empty directory for a test's files (scratch/<name> under the working directory).
+     */
+    inline std::string scratchDirectory(const std::string &name)
+    {
+        const std::filesystem::path dir = std::filesystem::path("scratch") / name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir.string();
+    }
+
+    inline bool reportCheck(bool ok, const char *expression, const char *file, int line, const std::string &detail = std::string())
+    {
+        if (!ok)
+        {
+            ++failureCount();
+            std::cerr << file << ":" << line << ": CHECK failed: " << expression;
+            if (!detail.empty())
+                std::cerr << " (" << detail << ")";
+            std::cerr << std::endl;
+        }
+        return ok;
+    }
+
+    template <typename A, typename B>
+    bool checkEqual(const A &a, const B &b, const char *expression, const char *file, int line)
+    {
+        if (a == b)
+            return true;
+        std::ostringstream detail;
+        detail << a << " != " << b;
+        return reportCheck(false, expression, file, line, detail.str());
+    }
+
+    inline bool checkNear(double a, double b, double tolerance, const char *expression, const char *file, int line)
+    {
+        if (std::abs(a - b) <= tolerance)
+            return true;
+        std::ostringstream detail;
+        detail.precision(9);
+        detail << a << " vs " << b << ", tolerance " << tolerance;
+        return reportCheck(false, expression, file, line, detail.str());
+    }
+}
+
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+/** @brief Defines and registers a test: TEST_CASE(name) { ... } */
+#define TEST_CASE(name)                                                                     \
+    static void name();                                                                     \
+    static TestFramework::Registrar TEST_CONCAT(name, _registrar)(#name, name);             \
+    static void name()
+
+#define CHECK(expr) TestFramework::reportCheck(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+#define CHECK_EQ(a, b) TestFramework::checkEqual((a), (b), #a " == " #b, __FILE__, __LINE__)
+#define CHECK_NEAR(a, b, tol) TestFramework::checkNear((a), (b), (tol), #a " ~= " #b, __FILE__, __LINE__)
+
+#define REQUIRE(expr)                                 \
+    do                                                \
+    {                                                 \
+        if (!CHECK(expr))                             \
+            throw TestFramework::RequireFailed();     \
+    } while (0)
+
+#endif // TEST_FRAMEWORK_H
@@ -0,0 +1,73 @@
+/**
+ * @file test_game_commands.cpp
+ * @brief Who applies queued game commands, and when the input thread is woken for it.
+ */
+
+#include "test_framework.h"
+#include "game_commands.h"
+#include "global_state.h"
+#include "input_service.h"
+#include "constants.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    const std::chrono::milliseconds STALL(Constants::GAME_COMMAND_STALL_MS);
+
+    void resetState()
+    {
+        InputService &service = InputService::getInstance();
+        service.stop();
+        service.clearBindings();
+        service.setKeySampler(nullptr);
+        GameCommandQueue::getInstance().setGameThreadAttached(false);
+        g_currentCameraOffset.store(Vector3());
+    }
+}
+
+TEST_CASE(game_commands_camera_update_nudges_do_not_wake_the_input_thread)
+{
+    resetState();
+    InputService &service = InputService::getInstance();
+    GameCommandQueue &queue = GameCommandQueue::getInstance();
+    REQUIRE(service.start());
+    queue.setGameThreadAttached(true);
+    queue.onCameraUpdate();
+
+    // Held offset keys: one nudge per frame, queued and drained by the same camera update
+    std::this_thread::sleep_for(STALL * 3);
+    const uint64_t before = service.getWakeupCount();
+    for (int frame = 0; frame < 30; ++frame)
+    {
+        queue.beginCameraUpdate();
+        queue.nudgeOffset(Vector3(0.1f, 0.0f, 0.0f));
+        queue.onCameraUpdate();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::this_thread::sleep_for(STALL * 3);
+
+    CHECK_EQ(service.getWakeupCount(), before);
+    CHECK_NEAR(g_currentCameraOffset.load().x, 3.0f, 1e-4f);
+    resetState();
+}
+
+TEST_CASE(game_commands_input_thread_applies_commands_without_camera_updates)
+{
+    resetState();
+    InputService &service = InputService::getInstance();
+    GameCommandQueue &queue = GameCommandQueue::getInstance();
+    REQUIRE(service.start());
+    queue.setGameThreadAttached(true);
+    queue.onCameraUpdate();
+
+    // Queued outside a camera update and no frame follows (FPV): the stall check applies it
+    queue.nudgeOffset(Vector3(0.0f, 1.0f, 0.0f));
+    const auto deadline = std::chrono::steady_clock::now() + STALL * 20;
+    while (g_currentCameraOffset.load().y == 0.0f && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    CHECK_NEAR(g_currentCameraOffset.load().y, 1.0f, 1e-6f);
+    resetState();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file test_held_adjustment.cpp
+ * @brief HeldAdjustment on a simulated frame clock.
+ */
+
+#include "test_framework.h"
+#include "held_adjustment.h"
+
+namespace
+{
+    const Vector3 RIGHT(1.0f, 0.0f, 0.0f);
+
+    HeldAdjustment::Settings rampSettings()
+    {
+        HeldAdjustment::Settings settings;
+        settings.speed = 0.5f;
+        settings.maxMultiplier = 4.0f;
+        settings.rampSeconds = 1.5f;
+        settings.precisionScale = 0.25f;
+        return settings;
+    }
+
+    // Holds direction for seconds at a fixed frame rate; returns the distance moved along x
+    float holdFor(HeldAdjustment &adjustment, float seconds, float fps, bool precision = false)
+    {
+        const int frames = static_cast<int>(seconds * fps + 0.5f);
+        float moved = 0.0f;
+        for (int i = 0; i < frames; ++i)
+            moved += adjustment.step(RIGHT, precision, 1.0f / fps).x;
+        return moved;
+    }
+}
+
+TEST_CASE(held_adjustment_without_ramp_moves_at_constant_speed)
+{
+    HeldAdjustment::Settings settings;
+    settings.speed = 0.5f;
+    settings.maxMultiplier = 2.0f;
+    HeldAdjustment adjustment;
+    adjustment.setSettings(settings);
+
+    CHECK_NEAR(adjustment.step(RIGHT, false, 0.25f).x, 0.25f, 1e-6f);
+    CHECK_NEAR(holdFor(adjustment, 2.0f, 60.0f), 2.0f, 1e-4f);
+
+    const Vector3 back = adjustment.step(Vector3(-1.0f, 0.0f, 1.0f), false, 0.5f);
+    CHECK_NEAR(back.x, -0.5f, 1e-6f);
+    CHECK_NEAR(back.y, 0.0f, 1e-6f);
+    CHECK_NEAR(back.z, 0.5f, 1e-6f);
+}
+
+TEST_CASE(held_adjustment_distance_is_independent_of_frame_rate)
+{
+    HeldAdjustment slow, fast, hitch;
+    slow.setSettings(rampSettings());
+    fast.setSettings(rampSettings());
+    hitch.setSettings(rampSettings());
+
+    const float at30 = holdFor(slow, 3.0f, 30.0f);
+    const float at144 = holdFor(fast, 3.0f, 144.0f);
+    // One 2 s hitch across the end of the ramp, then normal frames
+    const float withHitch = hitch.step(RIGHT, false, 2.0f).x + holdFor(hitch, 1.0f, 60.0f);
+
+    CHECK_NEAR(at30, at144, 1e-3f);
+    CHECK_NEAR(withHitch, at144, 1e-3f);
+    CHECK_NEAR(slow.holdTime(), 3.0f, 1e-4f);
+}
+
+TEST_CASE(held_adjustment_ramp_reaches_full_speed)
+{
+    HeldAdjustment adjustment;
+    adjustment.setSettings(rampSettings());
+
+    // Starts at the base speed, then holds at the full speed once the ramp is over
+    CHECK_NEAR(adjustment.speedAt(0.0f), 0.5f, 1e-5f);
+    CHECK_NEAR(adjustment.speedAt(1.5f), 2.0f, 1e-5f);
+    CHECK_NEAR(adjustment.speedAt(10.0f), 2.0f, 1e-5f);
+
+    const float first = adjustment.step(RIGHT, false, 1.0f / 60.0f).x;
+    CHECK(first < 0.5f / 60.0f * 1.1f);
+
+    holdFor(adjustment, 2.0f, 60.0f);
+    CHECK_NEAR(adjustment.step(RIGHT, false, 1.0f / 60.0f).x, 2.0f / 60.0f, 1e-6f);
+
+    // Ramp plus one second at full speed lies between base and full speed over the whole hold
+    HeldAdjustment fresh;
+    fresh.setSettings(rampSettings());
+    const float moved = holdFor(fresh, 2.5f, 60.0f);
+    CHECK(moved > 0.5f * 2.5f);
+    CHECK(moved < 2.0f * 2.5f);
+}
+
+TEST_CASE(held_adjustment_precision_scales_the_step)
+{
+    HeldAdjustment normal, precise;
+    normal.setSettings(rampSettings());
+    precise.setSettings(rampSettings());
+
+    const float full = holdFor(normal, 1.0f, 60.0f);
+    const float fine = holdFor(precise, 1.0f, 60.0f, true);
+    CHECK_NEAR(fine, full * 0.25f, 1e-5f);
+
+    // Precision does not slow the ramp down: releasing it gives the same speed as a normal hold
+    CHECK_NEAR(precise.step(RIGHT, false, 0.01f).x, normal.step(RIGHT, false, 0.01f).x, 1e-6f);
+}
+
+TEST_CASE(held_adjustment_reset_restarts_at_base_speed)
+{
+    HeldAdjustment adjustment;
+    adjustment.setSettings(rampSettings());
+    CHECK(!adjustment.isActive());
+
+    // A zero step starts the hold without moving
+    const Vector3 none = adjustment.step(RIGHT, false, 0.0f);
+    CHECK(adjustment.isActive());
+    CHECK_EQ(none.x, 0.0f);
+    CHECK_EQ(adjustment.holdTime(), 0.0f);
+
+    const float firstFrame = adjustment.step(RIGHT, false, 1.0f / 60.0f).x;
+    holdFor(adjustment, 3.0f, 60.0f);
+
+    adjustment.reset();
+    CHECK(!adjustment.isActive());
+    CHECK_EQ(adjustment.holdTime(), 0.0f);
+    CHECK_NEAR(adjustment.step(RIGHT, false, 1.0f / 60.0f).x, firstFrame, 1e-7f);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file test_hook_watchdog.cpp
+ * @brief KeyHookWatchdog on fake key states: stuck keys and a silently removed hook.
+ */
+
+#include "test_framework.h"
+#include "hook_watchdog.h"
+
+namespace
+{
+    using KeyBits = KeyHookWatchdog::KeyBits;
+
+    KeyBits keys(std::initializer_list<int> down)
+    {
+        KeyBits bits;
+        for (int vk : down)
+            bits.set(static_cast<size_t>(vk));
+        return bits;
+    }
+}
+
+TEST_CASE(hook_watchdog_agreeing_states_are_fine)
+{
+    KeyHookWatchdog watchdog(3);
+    watchdog.reset(KeyBits());
+    for (int i = 0; i < 10; ++i)
+    {
+        const KeyHookWatchdog::Verdict verdict = watchdog.check(keys({0x41, 0xA0}), keys({0x41, 0xA0}));
+        CHECK(verdict.stuck.none());
+        CHECK(!verdict.hookLost);
+    }
+}
+
+TEST_CASE(hook_watchdog_reports_key_up_the_hook_missed)
+{
+    KeyHookWatchdog watchdog(3);
+    watchdog.reset(KeyBits());
+    // The hook saw Ctrl and F3 go down; F3 was released on the secure desktop
+    const KeyHookWatchdog::Verdict verdict = watchdog.check(keys({0xA2}), keys({0xA2, 0x72}));
+    CHECK(verdict.stuck == keys({0x72}));
+    CHECK(!verdict.hookLost);
+}
+
+TEST_CASE(hook_watchdog_lost_after_consecutive_unseen_checks)
+{
+    KeyHookWatchdog watchdog(3);
+    watchdog.reset(KeyBits());
+    CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+    CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+    CHECK(watchdog.check(keys({0x57}), KeyBits()).hookLost);
+}
+
+TEST_CASE(hook_watchdog_key_unseen_once_is_not_a_lost_hook)
+{
+    // A key pressed just before the check reaches the hook a moment later
+    KeyHookWatchdog watchdog(2);
+    watchdog.reset(KeyBits());
+    CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+    CHECK(!watchdog.check(keys({0x57}), keys({0x57})).hookLost);
+    CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+    CHECK(!watchdog.check(KeyBits(), KeyBits()).hookLost);
+}
+
+TEST_CASE(hook_watchdog_run_restarts_when_the_unseen_key_changes)
+{
+    // Different keys each missed once (typing faster than the checks) are not one persistent miss
+    KeyHookWatchdog watchdog(2);
+    watchdog.reset(KeyBits());
+    CHECK(!watchdog.check(keys({0x41}), KeyBits()).hookLost);
+    CHECK(!watchdog.check(keys({0x42}), KeyBits()).hookLost);
+    CHECK(!watchdog.check(keys({0x43}), KeyBits()).hookLost);
+    CHECK(watchdog.check(keys({0x43}), KeyBits()).hookLost);
+}
+
+TEST_CASE(hook_watchdog_ignores_keys_held_at_reset_until_released)
+{
+    KeyHookWatchdog watchdog(2);
+    // W was held while the hook was installed, so the hook never saw it go down
+    watchdog.reset(keys({0x57}));
+    for (int i = 0; i < 5; ++i)
+        CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+
+    // Released and pressed again: now the hook must report it
+    CHECK(!watchdog.check(KeyBits(), KeyBits()).hookLost);
+    CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+    CHECK(watchdog.check(keys({0x57}), KeyBits()).hookLost);
+}
+
+TEST_CASE(hook_watchdog_reset_clears_an_unseen_run)
+{
+    KeyHookWatchdog watchdog(2);
+    watchdog.reset(KeyBits());
+    CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+    // Focus went to another application, which may bypass the hook
+    watchdog.reset(keys({0x57}));
+    CHECK(!watchdog.check(keys({0x57}), KeyBits()).hookLost);
+}
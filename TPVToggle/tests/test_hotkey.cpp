@@ -0,0 +1,162 @@
+/**
+ * @file test_hotkey.cpp
+ * @brief HotkeyEngine matching: exact modifiers, held-only keys, sequences and taps.
+ */
+
+#include "test_framework.h"
+#include "hotkey.h"
+#include "input_service.h"
+#include "constants.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    enum Action : HotkeyEngine::ActionId
+    {
+        ActionPlain,
+        ActionCtrl,
+        ActionSequence,
+        ActionTap,
+        ActionPrecision
+    };
+
+    HotkeyList parse(const std::string &expression)
+    {
+        Hotkey hotkey;
+        std::string error;
+        REQUIRE(Hotkey::parse(expression, hotkey, error));
+        return {hotkey};
+    }
+
+    // Feeds transitions to an engine the way the input thread does
+    struct Keyboard
+    {
+        explicit Keyboard(HotkeyEngine &e) : engine(e) {}
+
+        HotkeyEngine &engine;
+        KeyState state;
+        double now = 0.0;
+        std::vector<HotkeyEngine::ActionId> fired;
+
+        void key(int vk, bool down)
+        {
+            state.set(static_cast<size_t>(vk), down);
+            engine.onKeyEvent({vk, down, now}, state, fired);
+        }
+
+        void press(int vk)
+        {
+            key(vk, true);
+            key(vk, false);
+        }
+
+        bool firedOnly(HotkeyEngine::ActionId action) const { return fired.size() == 1 && fired[0] == action; }
+    };
+}
+
+TEST_CASE(hotkey_modifiers_match_exactly)
+{
+    HotkeyEngine engine;
+    engine.add(ActionPlain, parse("0x61"));
+    engine.add(ActionCtrl, parse("Ctrl+0x61"));
+    Keyboard keyboard(engine);
+
+    keyboard.press(0x61);
+    CHECK(keyboard.firedOnly(ActionPlain));
+
+    keyboard.fired.clear();
+    keyboard.key(0x11, true);
+    keyboard.press(0x61);
+    keyboard.key(0x11, false);
+    CHECK(keyboard.firedOnly(ActionCtrl));
+}
+
+TEST_CASE(hotkey_held_only_modifier_does_not_block_other_hotkeys)
+{
+    HotkeyEngine engine;
+    engine.add(ActionPlain, parse("0x72"));
+    engine.addHeld(ActionPrecision, parse("0x11"));
+    Keyboard keyboard(engine);
+
+    keyboard.key(0x11, true);
+    CHECK(keyboard.fired.empty());
+    CHECK(engine.isHeld(ActionPrecision, keyboard.state));
+
+    keyboard.press(0x72);
+    CHECK(keyboard.firedOnly(ActionPlain));
+
+    // Its keys are still captured, so isHeld can see them
+    const std::vector<int> keys = engine.keys();
+    CHECK(std::find(keys.begin(), keys.end(), 0x11) != keys.end());
+}
+
+TEST_CASE(hotkey_held_only_modifier_still_blocks_when_another_hotkey_uses_it)
+{
+    HotkeyEngine engine;
+    engine.add(ActionPlain, parse("0x72"));
+    engine.add(ActionCtrl, parse("Ctrl+0x61"));
+    engine.addHeld(ActionPrecision, parse("0x11"));
+    Keyboard keyboard(engine);
+
+    keyboard.key(0x11, true);
+    keyboard.press(0x72);
+    CHECK(keyboard.fired.empty());
+}
+
+TEST_CASE(hotkey_sequence_is_broken_by_another_bound_key)
+{
+    HotkeyEngine engine;
+    engine.add(ActionSequence, parse("0x47>0x47"));
+    engine.add(ActionPlain, parse("0x72"));
+    Keyboard keyboard(engine);
+
+    keyboard.press(0x47);
+    keyboard.now = 0.1;
+    keyboard.press(0x72);
+    keyboard.now = 0.2;
+    keyboard.press(0x47);
+    CHECK(keyboard.firedOnly(ActionPlain));
+
+    keyboard.fired.clear();
+    keyboard.now = 0.3;
+    keyboard.press(0x47);
+    CHECK(keyboard.firedOnly(ActionSequence));
+}
+
+TEST_CASE(hotkey_sequence_times_out)
+{
+    HotkeyEngine engine;
+    engine.add(ActionSequence, parse("0x47>0x47"));
+    Keyboard keyboard(engine);
+
+    keyboard.press(0x47);
+    keyboard.now = Constants::HOTKEY_SEQUENCE_TIMEOUT_MS / 1000.0 + 0.1;
+    keyboard.press(0x47);
+    CHECK(keyboard.fired.empty());
+    keyboard.now += 0.1;
+    keyboard.press(0x47);
+    CHECK(keyboard.firedOnly(ActionSequence));
+}
+
+TEST_CASE(hotkey_tap_is_cancelled_by_another_key)
+{
+    HotkeyEngine engine;
+    engine.add(ActionTap, parse("0x72:tap"));
+    engine.add(ActionPlain, parse("0x61"));
+    Keyboard keyboard(engine);
+
+    keyboard.key(0x72, true);
+    keyboard.press(0x61);
+    keyboard.key(0x72, false);
+    CHECK(keyboard.firedOnly(ActionPlain));
+
+    keyboard.fired.clear();
+    keyboard.now = 1.0;
+    keyboard.key(0x72, true);
+    keyboard.now = 1.1;
+    keyboard.key(0x72, false);
+    CHECK(keyboard.firedOnly(ActionTap));
+}
@@ -0,0 +1,30 @@
+/**
+ * @file test_input_latency.cpp
+ * @brief Simulated key presses reach their handler promptly, one wakeup per event.
+ */
+
+#include "test_framework.h"
+#include "input_latency.h"
+
+TEST_CASE(input_latency_every_event_is_delivered)
+{
+    const InputLatency::Result result = InputLatency::measure(50, std::chrono::microseconds(200));
+    CHECK_EQ(result.latenciesUs.size(), result.events);
+}
+
+TEST_CASE(input_latency_p99_is_bounded)
+{
+    const InputLatency::Result result = InputLatency::measure(200, std::chrono::microseconds(200));
+    REQUIRE(!result.latenciesUs.empty());
+    // Generous: a loaded CI machine (or a sanitizer build) can deschedule the input thread
+    CHECK(result.percentile(0.99) < 20000.0);
+    CHECK(result.percentile(0.5) < 5000.0);
+}
+
+TEST_CASE(input_latency_wakes_once_per_event)
+{
+    // Without a sampler the thread is event-driven: no polling wakeups between presses
+    const InputLatency::Result result = InputLatency::measure(100, std::chrono::microseconds(500));
+    CHECK(result.wakeups >= result.events / 2);
+    CHECK(result.wakeups <= result.events + 5);
+}
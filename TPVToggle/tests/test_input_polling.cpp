@@ -0,0 +1,181 @@
+/**
+ * @file test_input_polling.cpp
+ * @brief The polling path of InputService (the fallback when hooks are unavailable) on a fake keyboard.
+ */
+
+#include "test_framework.h"
+#include "input_service.h"
+#include "constants.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int VK_F3 = 0x72;
+    constexpr int VK_A = 0x41;
+    constexpr int VK_CONTROL = 0x11;
+    constexpr int VK_LCONTROL = 0xA2;
+    constexpr int VK_RCONTROL = 0xA3;
+
+    // Key state set by the test thread and sampled by the input thread
+    struct FakeKeyboard
+    {
+        std::atomic<bool> down[InputService::KEY_COUNT] = {};
+        std::atomic<bool> sampled[InputService::KEY_COUNT] = {};
+
+        InputService::KeySampler sampler()
+        {
+            return [this](int vk)
+            {
+                sampled[vk].store(true);
+                return down[vk].load();
+            };
+        }
+    };
+
+    // Events delivered to a handler, waited on by the test thread
+    struct Received
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<KeyEvent> events;
+
+        InputService::KeyHandler handler()
+        {
+            return [this](const KeyEvent &event)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                events.push_back(event);
+                changed.notify_all();
+            };
+        }
+
+        // Waits (a few poll intervals at most) until count events arrived
+        bool waitFor(size_t count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            return changed.wait_for(lock, std::chrono::seconds(2), [&]
+                                    { return events.size() >= count; });
+        }
+
+        std::vector<KeyEvent> snapshot()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return events;
+        }
+    };
+
+    // Starts the service polling keyboard with keys bound to received
+    void startPolling(FakeKeyboard &keyboard, Received &received, const std::vector<int> &keys)
+    {
+        InputService &service = InputService::getInstance();
+        service.stop();
+        service.clearBindings();
+        service.setKeySampler(keyboard.sampler());
+        service.bindKeys(keys, received.handler());
+        REQUIRE(service.start());
+    }
+
+    void stopPolling()
+    {
+        InputService &service = InputService::getInstance();
+        service.stop();
+        service.clearBindings();
+        service.setKeySampler(nullptr);
+    }
+
+    // Long enough for several polls at the active rate
+    void settle()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(Constants::INPUT_FALLBACK_POLL_MS * 4));
+    }
+}
+
+TEST_CASE(input_polling_delivers_each_transition_once)
+{
+    FakeKeyboard keyboard;
+    Received received;
+    startPolling(keyboard, received, {VK_F3});
+
+    keyboard.down[VK_F3].store(true);
+    REQUIRE(received.waitFor(1));
+    settle(); // The key stays down over many polls
+    keyboard.down[VK_F3].store(false);
+    REQUIRE(received.waitFor(2));
+    settle();
+    stopPolling();
+
+    const std::vector<KeyEvent> events = received.snapshot();
+    REQUIRE(events.size() == 2);
+    CHECK_EQ(events[0].vkCode, VK_F3);
+    CHECK(events[0].down);
+    CHECK_EQ(events[1].vkCode, VK_F3);
+    CHECK(!events[1].down);
+    CHECK(events[1].timestamp > events[0].timestamp);
+}
+
+TEST_CASE(input_polling_samples_only_bound_keys)
+{
+    FakeKeyboard keyboard;
+    Received received;
+    startPolling(keyboard, received, {VK_F3});
+
+    keyboard.down[VK_A].store(true);
+    keyboard.down[VK_F3].store(true);
+    REQUIRE(received.waitFor(1));
+    settle();
+    stopPolling();
+
+    CHECK(keyboard.sampled[VK_F3].load());
+    CHECK(!keyboard.sampled[VK_A].load());
+    CHECK_EQ(received.snapshot().size(), size_t(1));
+}
+
+TEST_CASE(input_polling_derives_generic_modifiers_from_their_sides)
+{
+    FakeKeyboard keyboard;
+    Received received;
+    startPolling(keyboard, received, {VK_CONTROL});
+
+    // Right Ctrl goes down, then left, then both up: Ctrl is down from the first to the last
+    keyboard.down[VK_RCONTROL].store(true);
+    REQUIRE(received.waitFor(1));
+    keyboard.down[VK_LCONTROL].store(true);
+    settle();
+    keyboard.down[VK_RCONTROL].store(false);
+    settle();
+    keyboard.down[VK_LCONTROL].store(false);
+    REQUIRE(received.waitFor(2));
+    settle();
+    stopPolling();
+
+    // The generic code follows from the sides and is never sampled itself
+    CHECK(!keyboard.sampled[VK_CONTROL].load());
+    CHECK(keyboard.sampled[VK_LCONTROL].load());
+    CHECK(keyboard.sampled[VK_RCONTROL].load());
+
+    const std::vector<KeyEvent> events = received.snapshot();
+    REQUIRE(events.size() == 2);
+    CHECK_EQ(events[0].vkCode, VK_CONTROL);
+    CHECK(events[0].down);
+    CHECK_EQ(events[1].vkCode, VK_CONTROL);
+    CHECK(!events[1].down);
+}
+
+TEST_CASE(input_polling_reports_a_key_held_at_start)
+{
+    FakeKeyboard keyboard;
+    keyboard.down[VK_F3].store(true);
+    Received received;
+    startPolling(keyboard, received, {VK_F3});
+
+    REQUIRE(received.waitFor(1));
+    const std::vector<KeyEvent> events = received.snapshot();
+    CHECK(events[0].down);
+    stopPolling();
+}
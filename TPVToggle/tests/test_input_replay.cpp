@@ -0,0 +1,139 @@
+/**
+ * @file test_input_replay.cpp
+ * @brief Input recordings replayed through the view toggle actions against the simulated game.
+ */
+
+#include "test_framework.h"
+#include "input_recording.h"
+#include "input_service.h"
+#include "toggle_thread.h"
+#include "game_commands.h"
+#include "config.h"
+#include "sim_game.h"
+
+#include <string>
+#include <vector>
+
+extern Config g_config;
+
+namespace
+{
+    constexpr int VK_F3 = 0x72;
+
+    using Type = InputRecord::Type;
+
+    // Binds F3 as the toggle key on a stopped service, with the game in view
+    void setUpReplay(uint8_t view)
+    {
+        InputService &input = InputService::getInstance();
+        input.stop();
+        input.clearBindings();
+        input.setKeySampler(nullptr);
+        g_config.hold_scroll_keys.clear();
+        g_isOverlayActive.store(false);
+        g_wasTpvBeforeOverlay.store(false);
+        SimGame::reset(view);
+
+        ToggleData keys;
+        Hotkey toggle;
+        std::string error;
+        REQUIRE(Hotkey::parse("0x72", toggle, error));
+        keys.toggle_keys.push_back(toggle);
+        registerToggleActions(std::move(keys));
+
+        // No camera updates: the replay applies the game commands itself
+        GameCommandQueue::getInstance().setGameThreadAttached(false);
+    }
+
+    void tearDownReplay()
+    {
+        InputService::getInstance().clearBindings();
+        g_isOverlayActive.store(false);
+        g_wasTpvBeforeOverlay.store(false);
+    }
+
+    void press(std::vector<InputRecord> &records, int vk, double time)
+    {
+        records.push_back({Type::KeyDown, static_cast<uint8_t>(vk), time});
+        records.push_back({Type::KeyUp, static_cast<uint8_t>(vk), time + 0.1});
+    }
+}
+
+TEST_CASE(replay_toggle_key_switches_the_view)
+{
+    setUpReplay(0);
+    std::vector<InputRecord> records;
+    press(records, VK_F3, 1.0);
+    press(records, VK_F3, 3.0);
+    press(records, VK_F3, 5.0);
+
+    InputReplay(records).run();
+    CHECK_EQ(SimGame::viewChanges(), uint64_t(3));
+    CHECK_EQ(static_cast<int>(SimGame::view()), 1);
+    tearDownReplay();
+}
+
+TEST_CASE(replay_overlay_switches_to_fpv_and_restores_tpv)
+{
+    setUpReplay(1);
+    std::vector<InputRecord> records;
+    records.push_back({Type::OverlayHidden, 0, 1.0});
+    records.push_back({Type::OverlayShown, 0, 4.0});
+
+    InputReplay(records).run();
+    // FPV while the overlay was open, TPV again after the restore delay
+    CHECK_EQ(SimGame::viewChanges(), uint64_t(2));
+    CHECK_EQ(static_cast<int>(SimGame::view()), 1);
+    tearDownReplay();
+}
+
+TEST_CASE(replay_overlay_in_fpv_stays_in_fpv)
+{
+    setUpReplay(0);
+    std::vector<InputRecord> records;
+    records.push_back({Type::OverlayHidden, 0, 1.0});
+    records.push_back({Type::OverlayShown, 0, 2.0});
+
+    InputReplay(records).run();
+    CHECK_EQ(SimGame::viewChanges(), uint64_t(0));
+    CHECK_EQ(static_cast<int>(SimGame::view()), 0);
+    tearDownReplay();
+}
+
+TEST_CASE(replay_skips_recorded_waits)
+{
+    setUpReplay(0);
+    std::vector<InputRecord> records;
+    for (int i = 0; i < 30; ++i)
+        press(records, VK_F3, 2.0 * i + 1.0);
+
+    InputReplay replay(records);
+    const double wallSeconds = replay.run();
+    CHECK(replay.duration() > 59.0);
+    CHECK(wallSeconds < replay.duration() / 10.0);
+    CHECK_EQ(SimGame::viewChanges(), uint64_t(30));
+    tearDownReplay();
+}
+
+TEST_CASE(recording_round_trips_through_the_file)
+{
+    const std::string path = TestFramework::scratchDirectory("input_recording") + "/keys.rec";
+    InputRecorder &recorder = InputRecorder::getInstance();
+    REQUIRE(recorder.start(path));
+    recorder.recordKey({VK_F3, true, 100.0});
+    recorder.recordKey({VK_F3, false, 100.25});
+    recorder.recordKey({0x4D, true, 101.5});
+    recorder.stop();
+
+    std::vector<InputRecord> records;
+    std::string error;
+    REQUIRE(loadInputRecording(path, records, error));
+    REQUIRE(records.size() == 3);
+    CHECK(records[0].type == Type::KeyDown);
+    CHECK_EQ(static_cast<int>(records[0].vkCode), VK_F3);
+    CHECK_NEAR(records[0].time, 0.0, 1e-9);
+    CHECK(records[1].type == Type::KeyUp);
+    CHECK_NEAR(records[1].time, 0.25, 1e-6);
+    CHECK_EQ(static_cast<int>(records[2].vkCode), 0x4D);
+    CHECK_NEAR(records[2].time, 1.5, 1e-6);
+}
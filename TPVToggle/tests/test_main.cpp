@@ -0,0 +1,52 @@
+/**
+ * @file test_main.cpp
+ * @brief Runs the registered host-side tests.
+ *
+ * Usage: tpvtoggle_tests [name-filter]
+ */
+
+#include "test_framework.h"
+#include "logger.h"
+
+#include <chrono>
+#include <exception>
+
+int main(int argc, char **argv)
+{
+    const std::string filter = argc > 1 ? argv[1] : "";
+
+    // Keep the test log to problems; the modules under test log as they do in game
+    Logger::getInstance().setLogLevel(LOG_WARNING);
+
+    int run = 0;
+    int failed = 0;
+    for (const TestFramework::TestCase &test : TestFramework::registry())
+    {
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos)
+            continue;
+
+        ++run;
+        const int failuresBefore = TestFramework::failureCount();
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            test.fn();
+        }
+        catch (const TestFramework::RequireFailed &)
+        {
+        }
+        catch (const std::exception &e)
+        {
+            TestFramework::reportCheck(false, "unexpected exception", test.name, 0, e.what());
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const bool ok = TestFramework::failureCount() == failuresBefore;
+        if (!ok)
+            ++failed;
+        std::cout << (ok ? "[  OK  ] " : "[ FAIL ] ") << test.name << " (" << static_cast<long>(ms) << " ms)" << std::endl;
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed" << std::endl;
+    return failed == 0 && run > 0 ? 0 : 1;
+}
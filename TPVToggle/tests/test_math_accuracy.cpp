@@ -0,0 +1,48 @@
+/**
+ * @file test_math_accuracy.cpp
+ * @brief Error bounds for the per-frame math kernels against double-precision references.
+ *
+ * The bounds sit about twice above the worst error measured, so they catch a
+ * kernel change that loses precision rather than rounding noise.
+ */
+
+#include "test_framework.h"
+#include "math_accuracy.h"
+
+TEST_CASE(math_rotate_error_is_a_few_ulps)
+{
+    for (const std::string &distribution : MathAccuracy::distributions())
+    {
+        const MathReference::ErrorStats single = MathAccuracy::rotate(distribution, 20000);
+        // Odd batch size: the SoA kernel's scalar remainder is covered too
+        const MathReference::ErrorStats batch = MathAccuracy::rotateBatch(distribution, 20, 1023, false);
+        const MathReference::ErrorStats soa = MathAccuracy::rotateBatch(distribution, 20, 1023, true);
+        for (const MathReference::ErrorStats *stats : {&single, &batch, &soa})
+        {
+            CHECK(stats->maxUlp < 16.0);
+            CHECK(stats->meanUlp() < 2.0);
+            CHECK(stats->maxAngle < 1e-6);
+        }
+    }
+}
+
+TEST_CASE(math_to_basis_rows_are_within_ulps_of_exact)
+{
+    for (const std::string &distribution : MathAccuracy::distributions())
+    {
+        const MathReference::ErrorStats stats = MathAccuracy::toBasis(distribution, 20000);
+        CHECK(stats.maxUlp < 10.0);
+        CHECK(stats.maxAngle < 1e-6);
+    }
+}
+
+TEST_CASE(math_rotation_kernels_are_within_a_microradian)
+{
+    for (const std::string &distribution : MathAccuracy::distributions())
+    {
+        CHECK(MathAccuracy::decompose(distribution, 20000).maxAngle < 1e-6);
+        CHECK(MathAccuracy::slerp(distribution, 20000, false).maxAngle < 1e-6);
+        CHECK(MathAccuracy::slerp(distribution, 20000, true).maxAngle < 1e-6);
+    }
+    CHECK(MathAccuracy::lookRotation(20000).maxAngle < 1e-6);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_matrix_decompose.cpp
+ * @brief Matrix34f::Decompose against double-precision references and DirectXMath.
+ */
+
+#include "test_framework.h"
+#include "math_reference.h"
+
+#include <algorithm>
+#include <limits>
+
+using GameStructures::Matrix34f;
+
+namespace
+{
+    // Largest round-trip angle error over count rotations drawn from generate
+    template <typename Generate>
+    double worstRoundTripError(size_t count, Generate &&generate)
+    {
+        double worst = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Quaternion expected = generate();
+            Vector3 position;
+            Quaternion decomposed;
+            if (!MathReference::matrixOf(expected, Vector3()).Decompose(position, decomposed))
+                return std::numeric_limits<double>::infinity();
+            worst = std::max(worst, MathReference::angleBetween(expected, decomposed));
+        }
+        return worst;
+    }
+
+    double quaternionLength(const Quaternion &q)
+    {
+        return std::sqrt(static_cast<double>(q.x) * q.x + static_cast<double>(q.y) * q.y +
+                         static_cast<double>(q.z) * q.z + static_cast<double>(q.w) * q.w);
+    }
+}
+
+TEST_CASE(decompose_recovers_rotations_to_float_precision)
+{
+    std::mt19937 rng(7);
+    // Each matrix entry carries half an ulp of rounding; the extraction adds a few more
+    CHECK(worstRoundTripError(100000, [&]
+                              { return MathReference::randomRotation(rng); }) < 1e-6);
+    CHECK(worstRoundTripError(20000, [&]
+                              { return MathReference::randomSmallRotation(rng, 1e-3); }) < 1e-6);
+    // w near zero: the trace branch would take the square root of almost nothing
+    CHECK(worstRoundTripError(20000, [&]
+                              { return MathReference::randomNearHalfTurn(rng, 1e-3); }) < 1e-6);
+}
+
+TEST_CASE(decompose_matches_directxmath)
+{
+    std::mt19937 rng(11);
+    double worst = 0.0;
+    for (int i = 0; i < 50000; ++i)
+    {
+        const Matrix34f matrix = MathReference::matrixOf(MathReference::randomRotation(rng), Vector3());
+        const DirectX::XMMATRIX dx = DirectX::XMMatrixSet(matrix.m[0][0], matrix.m[0][1], matrix.m[0][2], 0.0f,
+                                                          matrix.m[1][0], matrix.m[1][1], matrix.m[1][2], 0.0f,
+                                                          matrix.m[2][0], matrix.m[2][1], matrix.m[2][2], 0.0f,
+                                                          0.0f, 0.0f, 0.0f, 1.0f);
+        const Quaternion expected = Quaternion::FromXMVector(DirectX::XMQuaternionRotationMatrix(dx));
+
+        Vector3 position;
+        Quaternion decomposed;
+        REQUIRE(matrix.Decompose(position, decomposed));
+        worst = std::max(worst, MathReference::angleBetween(expected, decomposed));
+    }
+    CHECK(worst < 2e-6);
+}
+
+TEST_CASE(decompose_inverts_set_and_returns_unit_quaternions)
+{
+    std::mt19937 rng(3);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const Quaternion rotation = MathReference::randomRotation(rng);
+        const Vector3 position(static_cast<float>(i) * 1.5f, -2048.25f, 0.125f);
+        Matrix34f matrix;
+        matrix.Set(rotation, position);
+
+        Vector3 decomposedPosition;
+        Quaternion decomposed;
+        REQUIRE(matrix.Decompose(decomposedPosition, decomposed));
+        CHECK(decomposedPosition.x == position.x && decomposedPosition.y == position.y && decomposedPosition.z == position.z);
+        CHECK(MathReference::angleBetween(rotation, decomposed) < 2e-6);
+        CHECK_NEAR(quaternionLength(decomposed), 1.0, 1e-6);
+    }
+}
+
+TEST_CASE(decompose_normalizes_scaled_and_skewed_rows)
+{
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> scale(0.01f, 100.0f);
+    std::uniform_real_distribution<float> skew(-1e-4f, 1e-4f);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const Quaternion rotation = MathReference::randomRotation(rng);
+        Matrix34f matrix = MathReference::matrixOf(rotation, Vector3());
+        for (auto &row : matrix.m)
+        {
+            const float s = scale(rng);
+            for (int j = 0; j < 3; ++j)
+                row[j] = (row[j] + skew(rng)) * s;
+        }
+
+        Vector3 position;
+        Quaternion decomposed;
+        REQUIRE(matrix.Decompose(position, decomposed));
+        // The skew itself tilts the rows by up to ~2e-4 rad
+        CHECK(MathReference::angleBetween(rotation, decomposed) < 1e-3);
+        CHECK_NEAR(quaternionLength(decomposed), 1.0, 1e-6);
+    }
+}
+
+TEST_CASE(decompose_rejects_degenerate_rows)
+{
+    Matrix34f matrix = MathReference::matrixOf(Quaternion::Identity(), Vector3(1.0f, 2.0f, 3.0f));
+    Vector3 position;
+    Quaternion rotation;
+    CHECK(matrix.Decompose(position, rotation));
+
+    Matrix34f zeroRow = matrix;
+    zeroRow.m[1][0] = zeroRow.m[1][1] = zeroRow.m[1][2] = 0.0f;
+    CHECK(!zeroRow.Decompose(position, rotation));
+
+    Matrix34f nanRow = matrix;
+    nanRow.m[2][1] = std::numeric_limits<float>::quiet_NaN();
+    CHECK(!nanRow.Decompose(position, rotation));
+}
@@ -0,0 +1,115 @@
+/**
+ * @file test_poll_scheduler.cpp
+ * @brief AdaptivePollScheduler against a virtual clock.
+ */
+
+#include "test_framework.h"
+#include "poll_scheduler.h"
+#include "constants.h"
+
+namespace
+{
+    using Clock = AdaptivePollScheduler::Clock;
+    using std::chrono::milliseconds;
+
+    const milliseconds ACTIVE(Constants::INPUT_FALLBACK_POLL_MS);
+    const milliseconds IDLE(Constants::INPUT_IDLE_POLL_MS);
+    const milliseconds IDLE_AFTER(Constants::INPUT_IDLE_AFTER_MS);
+
+    AdaptivePollScheduler makeScheduler(Clock::time_point start)
+    {
+        AdaptivePollScheduler scheduler(ACTIVE, IDLE, IDLE_AFTER);
+        scheduler.reset(start);
+        return scheduler;
+    }
+
+    // Polls at whatever interval the scheduler asks for until time reaches end; returns the poll count
+    int pollUntil(AdaptivePollScheduler &scheduler, Clock::time_point &now, Clock::time_point end)
+    {
+        int polls = 0;
+        while (now < end)
+        {
+            now += scheduler.interval(now);
+            ++polls;
+        }
+        return polls;
+    }
+}
+
+TEST_CASE(poll_scheduler_goes_idle_after_the_quiet_period)
+{
+    const Clock::time_point start;
+    AdaptivePollScheduler scheduler = makeScheduler(start);
+
+    CHECK(scheduler.interval(start) == ACTIVE);
+    CHECK(scheduler.interval(start + IDLE_AFTER - milliseconds(1)) == ACTIVE);
+    CHECK(!scheduler.isIdle(start + IDLE_AFTER - milliseconds(1)));
+    CHECK(scheduler.isIdle(start + IDLE_AFTER));
+    CHECK(scheduler.interval(start + IDLE_AFTER) == IDLE);
+    CHECK(scheduler.interval(start + IDLE_AFTER * 100) == IDLE);
+}
+
+TEST_CASE(poll_scheduler_idle_minute_costs_few_polls)
+{
+    // One quiet minute: active polls for the quiet period, idle polls after it
+    Clock::time_point now;
+    AdaptivePollScheduler scheduler = makeScheduler(now);
+    const int polls = pollUntil(scheduler, now, now + milliseconds(60000));
+
+    const int expected = static_cast<int>(IDLE_AFTER / ACTIVE + (milliseconds(60000) - IDLE_AFTER) / IDLE);
+    CHECK(polls >= expected - 1);
+    CHECK(polls <= expected + 2);
+}
+
+TEST_CASE(poll_scheduler_boost_holds_the_active_rate)
+{
+    const Clock::time_point start;
+    AdaptivePollScheduler scheduler = makeScheduler(start);
+
+    scheduler.setBoosted(true, start + milliseconds(100));
+    CHECK(scheduler.interval(start + IDLE_AFTER * 10) == ACTIVE);
+    CHECK(!scheduler.isIdle(start + IDLE_AFTER * 10));
+
+    // Clearing the boost restarts the quiet period
+    const Clock::time_point cleared = start + IDLE_AFTER * 10;
+    scheduler.setBoosted(false, cleared);
+    CHECK(scheduler.interval(cleared + IDLE_AFTER - milliseconds(1)) == ACTIVE);
+    CHECK(scheduler.interval(cleared + IDLE_AFTER) == IDLE);
+}
+
+TEST_CASE(poll_scheduler_boost_while_idle_returns_to_the_active_rate)
+{
+    const Clock::time_point start;
+    AdaptivePollScheduler scheduler = makeScheduler(start);
+    const Clock::time_point idle = start + IDLE_AFTER * 2;
+    REQUIRE(scheduler.isIdle(idle));
+
+    scheduler.setBoosted(true, idle);
+    CHECK(scheduler.interval(idle) == ACTIVE);
+}
+
+TEST_CASE(poll_scheduler_key_activity_returns_to_the_active_rate)
+{
+    const Clock::time_point start;
+    AdaptivePollScheduler scheduler = makeScheduler(start);
+    const Clock::time_point pressed = start + IDLE_AFTER * 3;
+    REQUIRE(scheduler.interval(pressed) == IDLE);
+
+    scheduler.onKeyActivity(pressed);
+    CHECK(scheduler.interval(pressed) == ACTIVE);
+    CHECK(scheduler.interval(pressed + IDLE_AFTER - milliseconds(1)) == ACTIVE);
+    CHECK(scheduler.interval(pressed + IDLE_AFTER) == IDLE);
+}
+
+TEST_CASE(poll_scheduler_reset_starts_at_the_active_rate)
+{
+    const Clock::time_point start;
+    AdaptivePollScheduler scheduler = makeScheduler(start);
+    scheduler.setBoosted(true, start);
+
+    const Clock::time_point restart = start + IDLE_AFTER * 5;
+    scheduler.reset(restart);
+    CHECK(scheduler.interval(restart) == ACTIVE);
+    // The boost does not survive the reset
+    CHECK(scheduler.interval(restart + IDLE_AFTER) == IDLE);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file test_profile_diff.cpp
+ * @brief Diffing two versions of the profiles file, and adopting an outside edit.
+ */
+
+#include "test_framework.h"
+#include "profile_diff.h"
+#include "profile_persistence.h"
+
+namespace
+{
+    ProfileStore baseStore()
+    {
+        ProfileStore store;
+        store.append(CameraProfile("Default", Vector3(), "General", "t0", 1));
+        store.append(CameraProfile("Close", Vector3(0.0f, -1.0f, 0.0f), "Combat", "t0", 2));
+        store.append(CameraProfile("Wide", Vector3(0.0f, -4.0f, 0.0f), "Travel", "t0", 3));
+        return store;
+    }
+}
+
+TEST_CASE(diff_reports_removed_added_and_changed_by_id)
+{
+    const ProfileStore before = baseStore();
+    ProfileStore after = baseStore();
+    after.erase(3);
+    after.rename(2, "Closer", "t1");
+    after.setOffset(1, Vector3(0.0f, 0.0f, 1.0f), "t1");
+    after.append(CameraProfile("New", Vector3(), "General", "t1", 9));
+
+    const ProfileDiff diff = diffProfileFiles(before, after, {});
+    REQUIRE(diff.removed.size() == 1u);
+    CHECK_EQ(diff.removed[0], 3u);
+    REQUIRE(diff.added.size() == 1u);
+    CHECK_EQ(diff.added[0].profile.id, 9u);
+    CHECK(diff.added[0].hasStableId);
+    REQUIRE(diff.changed.size() == 2u);
+    CHECK(diff.changed[0].offsetChanged && !diff.changed[0].nameChanged);
+    CHECK(diff.changed[1].nameChanged && !diff.changed[1].offsetChanged);
+}
+
+TEST_CASE(diff_treats_generated_ids_as_new_profiles)
+{
+    // A file rewritten without "id" fields: the loader numbers entries 1..n again,
+    // which must not be mistaken for the old profiles with those IDs
+    const ProfileStore before = baseStore();
+    const ProfileStore after = baseStore();
+
+    const ProfileDiff diff = diffProfileFiles(before, after, {1, 2, 3});
+    CHECK_EQ(diff.removed.size(), 3u);
+    CHECK_EQ(diff.added.size(), 3u);
+    CHECK(diff.changed.empty());
+    for (const AddedProfile &added : diff.added)
+        CHECK(!added.hasStableId);
+}
+
+TEST_CASE(persistence_rejects_outside_edit_diffed_against_stale_file)
+{
+    const std::string path = TestFramework::scratchDirectory("persistence_adopt") + "/profiles.json";
+    ProfileStore store = baseStore();
+
+    ProfilePersistence persistence;
+    persistence.start(path, std::chrono::milliseconds(0), JournalReplayResult{}, ProfileFileState{});
+    persistence.writeNow(std::make_shared<ProfileSnapshot>(ProfileSnapshot{1, std::make_shared<ProfileStore>(store)}));
+    const std::string base = persistence.fileState().fingerprint;
+
+    // The game saves again after the watcher read the file state
+    store.setOffset(2, Vector3(1.0f, 1.0f, 1.0f), "t1");
+    persistence.writeNow(std::make_shared<ProfileSnapshot>(ProfileSnapshot{2, std::make_shared<ProfileStore>(store)}));
+    const std::string saved = persistence.fileState().fingerprint;
+    CHECK(saved != base);
+
+    bool applied = false;
+    CHECK(!persistence.adoptExternalFile(base, ProfileFileState{"edited", nullptr}, [&]
+                                         { applied = true; }));
+    CHECK(!applied);
+    CHECK_EQ(persistence.fileState().fingerprint, saved);
+
+    CHECK(persistence.adoptExternalFile(saved, ProfileFileState{"edited", nullptr}, [&]
+                                        { applied = true; }));
+    CHECK(applied);
+    CHECK_EQ(persistence.fileState().fingerprint, std::string("edited"));
+    persistence.stop();
+}
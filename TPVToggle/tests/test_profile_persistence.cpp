@@ -0,0 +1,248 @@
+/**
+ * @file test_profile_persistence.cpp
+ * @brief Crash-consistency tests for the profile JSON file + journal pair.
+ *
+ * Each test writes through ProfilePersistence, damages or interrupts the
+ * files the way a crash would, then reloads them the way the game does at
+ * startup (ProfileLoader + replayJournal) and checks that the result is a
+ * state the mod actually saved, never a mix.
+ */
+
+#include "test_framework.h"
+#include "profile_persistence.h"
+#include "profile_loader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+    struct LoadedState
+    {
+        std::string bytes;
+        ProfileStore store;
+        JournalReplayResult journal;
+    };
+
+    std::string readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void appendRaw(const std::string &path, const std::string &bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        file << bytes;
+    }
+
+    // What CameraProfileManager does at startup
+    LoadedState load(const std::string &path)
+    {
+        LoadedState state;
+        state.bytes = readFile(path);
+        ProfileLoader::load(state.bytes, state.store, []
+                            { return std::string("loaded"); });
+        state.journal = ProfilePersistence::replayJournal(path, state.bytes, state.store);
+        return state;
+    }
+
+    // Comparable text form of a store: id, name, category, offset and timestamp in display order
+    std::string describe(const ProfileStore &store)
+    {
+        std::ostringstream out;
+        for (const StoredProfile &p : store.profiles())
+        {
+            out << p.id << ":" << *p.name << "/" << *p.category << "@" << p.offset.x << "," << p.offset.y << ","
+                << p.offset.z << "#" << p.timestamp << ";";
+        }
+        return out.str();
+    }
+
+    ProfileSnapshotPtr snapshotOf(const ProfileStore &store, uint64_t revision)
+    {
+        return std::make_shared<ProfileSnapshot>(ProfileSnapshot{revision, std::make_shared<ProfileStore>(store)});
+    }
+
+    ProfileChange updateChange(const ProfileStore &store, ProfileId id, uint64_t revision)
+    {
+        return ProfileChange{ProfileChange::Kind::Update, id, 0, store.findById(id)->toProfile(), revision};
+    }
+
+    ProfileChange createChange(const ProfileStore &store, ProfileId id, uint64_t revision)
+    {
+        return ProfileChange{ProfileChange::Kind::Create, id, store.indexOf(id), store.findById(id)->toProfile(), revision};
+    }
+
+    ProfileStore initialStore()
+    {
+        ProfileStore store;
+        store.append(CameraProfile("Default", Vector3(0.0f, 0.0f, 0.0f), "General", "t0"));
+        store.append(CameraProfile("Close", Vector3(0.0f, -1.0f, 0.2f), "Combat", "t0"));
+        store.append(CameraProfile("Wide", Vector3(1.0f, -4.0f, 0.5f), "Travel", "t0"));
+        return store;
+    }
+
+    /**
+     * Writes the initial store as a compaction, then two journaled edits.
+     * Leaves `store` at the final state and returns the next free revision.
+     */
+    uint64_t writeBaseline(const std::string &path, ProfileStore &store)
+    {
+        ProfilePersistence persistence;
+        persistence.start(path, std::chrono::milliseconds(0), JournalReplayResult{}, ProfileFileState{});
+        persistence.writeNow(snapshotOf(store, 1));
+
+        const ProfileId close = store.findByName("Close")->id;
+        store.setOffset(close, Vector3(0.5f, -1.5f, 0.25f), "t1");
+        persistence.post(snapshotOf(store, 2), updateChange(store, close, 2));
+
+        const ProfileId added = store.insert(1, CameraProfile("Added", Vector3(2.0f, 2.0f, 2.0f), "General", "t2"));
+        persistence.post(snapshotOf(store, 3), createChange(store, added, 3));
+        persistence.stop();
+        return 4;
+    }
+}
+
+TEST_CASE(persistence_journal_replays_onto_compacted_file)
+{
+    const std::string path = TestFramework::scratchDirectory("persistence_baseline") + "/profiles.json";
+    ProfileStore store = initialStore();
+    writeBaseline(path, store);
+
+    const LoadedState loaded = load(path);
+    CHECK(loaded.journal.valid);
+    CHECK(!loaded.journal.truncated);
+    CHECK_EQ(loaded.journal.applied, 2u);
+    CHECK_EQ(describe(loaded.store), describe(store));
+}
+
+TEST_CASE(persistence_torn_last_journal_line_is_dropped)
+{
+    const std::string path = TestFramework::scratchDirectory("persistence_torn") + "/profiles.json";
+    const std::string journalPath = std::filesystem::path(path).replace_extension(".journal").string();
+    ProfileStore store = initialStore();
+    uint64_t revision = writeBaseline(path, store);
+    const std::string savedState = describe(store);
+
+    // Power loss in the middle of an append: the record's newline never made it
+    const ProfileId wide = store.findByName("Wide")->id;
+    appendRaw(journalPath, "{\"id\":" + std::to_string(wide) + ",\"offset\":{\"x\":9.0,\"y\"");
+
+    LoadedState loaded = load(path);
+    CHECK(loaded.journal.valid);
+    CHECK(loaded.journal.truncated);
+    CHECK_EQ(loaded.journal.applied, 2u);
+    CHECK_EQ(describe(loaded.store), savedState);
+
+    // The next session must not append after the torn tail: its first write compacts
+    ProfilePersistence persistence;
+    persistence.start(path, std::chrono::milliseconds(0), loaded.journal,
+                      ProfileFileState{ProfilePersistence::fingerprintOf(loaded.bytes),
+                                       std::make_shared<ProfileStore>(loaded.store)});
+    loaded.store.setOffset(wide, Vector3(3.0f, -3.0f, 1.0f), "t3");
+    persistence.post(snapshotOf(loaded.store, revision), updateChange(loaded.store, wide, revision));
+    persistence.stop();
+
+    const LoadedState reloaded = load(path);
+    CHECK(reloaded.journal.valid);
+    CHECK(!reloaded.journal.truncated);
+    CHECK_EQ(reloaded.journal.applied, 0u);
+    CHECK_EQ(describe(reloaded.store), describe(loaded.store));
+}
+
+TEST_CASE(persistence_crash_between_json_replace_and_journal_rewrite)
+{
+    const std::string dir = TestFramework::scratchDirectory("persistence_compaction_crash");
+    const std::string path = dir + "/profiles.json";
+    const std::string journalPath = dir + "/profiles.journal";
+    ProfileStore store = initialStore();
+    uint64_t revision = writeBaseline(path, store);
+    const std::string oldJournal = readFile(journalPath);
+
+    // A directory where the journal's temp file goes makes the header rewrite
+    // fail right after the JSON file was replaced, like a crash at that point
+    std::filesystem::create_directory(journalPath + ".tmp");
+
+    ProfilePersistence persistence;
+    {
+        LoadedState loaded = load(path);
+        persistence.start(path, std::chrono::milliseconds(0), loaded.journal,
+                          ProfileFileState{ProfilePersistence::fingerprintOf(loaded.bytes),
+                                           std::make_shared<ProfileStore>(loaded.store)});
+    }
+    store.rename(store.findByName("Added")->id, "Renamed", "t3");
+    CHECK(persistence.writeNow(snapshotOf(store, revision++)));
+    persistence.stop();
+
+    // The old journal is still there and still holds records already folded into the new JSON
+    CHECK_EQ(readFile(journalPath), oldJournal);
+
+    const LoadedState loaded = load(path);
+    CHECK(!loaded.journal.valid); // Fingerprint names the old JSON file
+    CHECK_EQ(loaded.journal.applied, 0u);
+    CHECK_EQ(describe(loaded.store), describe(store));
+
+    // Once the journal can be written again the next save restores a matching pair
+    std::filesystem::remove(journalPath + ".tmp");
+    ProfilePersistence next;
+    next.start(path, std::chrono::milliseconds(0), loaded.journal,
+               ProfileFileState{ProfilePersistence::fingerprintOf(loaded.bytes), std::make_shared<ProfileStore>(loaded.store)});
+    const ProfileId close = store.findByName("Close")->id;
+    store.setOffset(close, Vector3(0.0f, -2.0f, 0.0f), "t4");
+    next.post(snapshotOf(store, revision), updateChange(store, close, revision));
+    next.stop();
+
+    const LoadedState repaired = load(path);
+    CHECK(repaired.journal.valid);
+    CHECK_EQ(describe(repaired.store), describe(store));
+}
+
+TEST_CASE(persistence_journal_for_another_file_is_ignored)
+{
+    const std::string dir = TestFramework::scratchDirectory("persistence_fingerprint");
+    const std::string path = dir + "/profiles.json";
+    ProfileStore store = initialStore();
+    writeBaseline(path, store);
+
+    // Hand edit of the JSON file while the game was closed: the journal no longer applies
+    std::string bytes = readFile(path);
+    const size_t wide = bytes.find("\"Wide\"");
+    REQUIRE(wide != std::string::npos);
+    bytes.replace(wide, 6, "\"Far\"");
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << bytes;
+    }
+
+    const LoadedState loaded = load(path);
+    CHECK(!loaded.journal.valid);
+    CHECK_EQ(loaded.journal.applied, 0u);
+    CHECK(loaded.store.findByName("Far") != nullptr);
+    CHECK(loaded.store.findByName("Added") == nullptr); // Only in the ignored journal
+    CHECK_EQ(loaded.store.size(), 3u);
+}
+
+TEST_CASE(persistence_journal_with_unknown_version_is_ignored)
+{
+    const std::string dir = TestFramework::scratchDirectory("persistence_version");
+    const std::string path = dir + "/profiles.json";
+    const std::string journalPath = dir + "/profiles.journal";
+    ProfileStore store = initialStore();
+    writeBaseline(path, store);
+
+    std::string journal = readFile(journalPath);
+    const size_t version = journal.find("\"journal\":1");
+    REQUIRE(version != std::string::npos);
+    journal.replace(version, 11, "\"journal\":2");
+    {
+        std::ofstream file(journalPath, std::ios::binary | std::ios::trunc);
+        file << journal;
+    }
+
+    const LoadedState loaded = load(path);
+    CHECK(!loaded.journal.valid);
+    CHECK_EQ(loaded.store.size(), 3u);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_profile_reload.cpp
+ * @brief Hot reload of the profiles file: FileWatcher (inotify) notices outside edits and the diff is merged.
+ *
+ * Runs the same steps as CameraProfileManager::reloadProfilesFromDisk on a
+ * scratch file: load the edited file, diff it against the last version and
+ * merge the diff into a live store that has edits of its own.
+ */
+
+#include "test_framework.h"
+#include "file_watcher.h"
+#include "profile_diff.h"
+#include "profile_loader.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+namespace
+{
+    const std::chrono::milliseconds SETTLE(30);
+    const std::chrono::seconds RELOAD_TIMEOUT(5);
+
+    std::string profileJson(ProfileId id, const std::string &name, float y)
+    {
+        return "{\"id\":" + std::to_string(id) + ",\"name\":\"" + name +
+               "\",\"category\":\"General\",\"timestamp\":\"t0\",\"offset\":{\"x\":0,\"y\":" + std::to_string(y) + ",\"z\":0}}";
+    }
+
+    std::string readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    std::string nowTimestamp()
+    {
+        return "now";
+    }
+
+    void writeFile(const std::string &path, const std::string &bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << bytes;
+    }
+
+    // The watcher callback and the test thread meet here
+    struct ReloadLog
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        int reloads = 0;
+
+        bool waitFor(int count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            return changed.wait_for(lock, RELOAD_TIMEOUT, [&]
+                                    { return reloads >= count; });
+        }
+    };
+}
+
+TEST_CASE(reload_merges_in_place_and_atomic_rename_edits)
+{
+    const std::string dir = TestFramework::scratchDirectory("profile_reload");
+    const std::string path = dir + "/profiles.json";
+    writeFile(path, "[" + profileJson(1, "Default", 0.0f) + "," + profileJson(2, "Close", -1.0f) + "]");
+
+    // Live store: the file's profiles plus one created in game and not saved yet
+    auto base = std::make_shared<ProfileStore>();
+    REQUIRE(ProfileLoader::load(readFile(path), *base, nowTimestamp).ok);
+    ProfileStoreWriter live(std::make_shared<ProfileStore>(*base));
+    const ProfileId inGame = live.apply([](ProfileStore &store)
+                                        { return store.append(CameraProfile("In game", Vector3(), "General", "t1", 50)); });
+
+    ReloadLog log;
+    FileWatcher watcher;
+    REQUIRE(watcher.start(path, SETTLE, [&]
+                          {
+        auto edited = std::make_shared<ProfileStore>();
+        const ProfileLoadResult result = ProfileLoader::load(readFile(path), *edited, nowTimestamp);
+        std::lock_guard<std::mutex> lock(log.mutex);
+        if (result.ok)
+        {
+            mergeProfileDiff(diffProfileFiles(*base, *edited, result.generatedIds), live, 1);
+            base = std::move(edited);
+            ++log.reloads; // A half-written file is skipped; the write that completes it notifies again
+        }
+        log.changed.notify_all(); }));
+
+    // Editor writing the file in place: rename "Close" and change its offset
+    writeFile(path, "[" + profileJson(1, "Default", 0.0f) + "," + profileJson(2, "Closer", -2.0f) + "]");
+    REQUIRE(log.waitFor(1));
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        REQUIRE(live->findById(2) != nullptr);
+        CHECK_EQ(*live->findById(2)->name, std::string("Closer"));
+        CHECK_EQ(live->findById(2)->offset.y, -2.0f);
+        CHECK(live->findById(inGame) != nullptr);
+    }
+
+    // Atomic saver: write a temp file and rename it over the watched one (add 7, remove 2)
+    const int reloads = [&]
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        return log.reloads;
+    }();
+    writeFile(dir + "/profiles.json.tmp", "[" + profileJson(1, "Default", 0.0f) + "," + profileJson(7, "Wide", -4.0f) + "]");
+    std::filesystem::rename(dir + "/profiles.json.tmp", path);
+    REQUIRE(log.waitFor(reloads + 1));
+    watcher.stop();
+
+    CHECK(live->findById(2) == nullptr);
+    REQUIRE(live->findById(7) != nullptr);
+    CHECK_EQ(*live->findById(7)->name, std::string("Wide"));
+    CHECK_EQ(live->indexOf(7), 1u);
+    CHECK(live->findById(inGame) != nullptr);
+    CHECK_EQ(live->at(0).id, 1u);
+}
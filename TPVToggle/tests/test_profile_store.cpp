@@ -0,0 +1,176 @@
+/**
+ * @file test_profile_store.cpp
+ * @brief Index consistency of ProfileStore under inserts, erases, renames and moves,
+ * and ProfileStoreWriter keeping shared stores untouched.
+ */
+
+#include "test_framework.h"
+#include "profile_store.h"
+
+#include <algorithm>
+
+TEST_CASE(store_duplicate_names_hand_over_in_display_order)
+{
+    // Hand-edited files can repeat a name; lookups return the first in display order
+    ProfileStore store;
+    const ProfileId a = store.append(CameraProfile("Same", Vector3(1.0f, 0.0f, 0.0f)));
+    const ProfileId b = store.append(CameraProfile("Other"));
+    const ProfileId c = store.append(CameraProfile("Same", Vector3(3.0f, 0.0f, 0.0f)));
+
+    REQUIRE(store.findByName("Same") != nullptr);
+    CHECK_EQ(store.findByName("Same")->id, a);
+
+    store.moveTo(c, 0);
+    CHECK_EQ(store.findByName("Same")->id, c);
+
+    store.erase(c);
+    CHECK_EQ(store.findByName("Same")->id, a);
+
+    store.rename(a, "Renamed", "t1");
+    CHECK(store.findByName("Same") == nullptr);
+    CHECK_EQ(store.findByName("Renamed")->id, a);
+    CHECK_EQ(store.findByName("Other")->id, b);
+}
+
+TEST_CASE(store_unknown_strings_are_not_found)
+{
+    ProfileStore store;
+    store.append(CameraProfile("Default", Vector3(), "General"));
+
+    CHECK(store.findByName("Missing") == nullptr);
+    CHECK(store.indicesInCategory("Missing").empty());
+
+    // Interned but no longer used by any profile
+    store.append(CameraProfile("Temp", Vector3(), "Scratch"));
+    store.erase(store.findByName("Temp")->id);
+    CHECK(store.findByName("Temp") == nullptr);
+    CHECK(store.indicesInCategory("Scratch").empty());
+}
+
+TEST_CASE(store_indexes_follow_front_inserts_and_category_moves)
+{
+    ProfileStore store;
+    for (int i = 0; i < 50; ++i)
+        store.insert(0, CameraProfile("P" + std::to_string(i), Vector3(), i % 2 ? "Odd" : "Even"));
+
+    for (size_t i = 0; i < store.size(); ++i)
+        CHECK_EQ(store.indexOf(store.at(i).id), i);
+
+    const ProfileId p10 = store.findByName("P10")->id;
+    store.setCategory(p10, "Odd", "t1");
+
+    const std::vector<size_t> odd = store.indicesInCategory("Odd");
+    CHECK_EQ(odd.size(), 26u);
+    CHECK(std::is_sorted(odd.begin(), odd.end()));
+    CHECK_EQ(store.indicesInCategory("Even").size(), 24u);
+
+    // A copy shares the pool and answers the same
+    const ProfileStore copy = store;
+    CHECK_EQ(copy.findByName("P10")->id, p10);
+    CHECK(copy.indicesInCategory("Odd") == odd);
+}
+
+namespace
+{
+    // Same profiles, IDs, order and indexes
+    bool sameStore(const ProfileStore &a, const ProfileStore &b)
+    {
+        if (a.size() != b.size() || a.nextId() != b.nextId())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            const StoredProfile &pa = a.at(i);
+            const StoredProfile &pb = b.at(i);
+            if (pa.id != pb.id || *pa.name != *pb.name || *pa.category != *pb.category ||
+                pa.timestamp != pb.timestamp || pa.offset.x != pb.offset.x || b.indexOf(pa.id) != i ||
+                b.findByName(*pa.name) == nullptr)
+                return false;
+        }
+        return true;
+    }
+
+    // One edit per step, mixing every kind; IDs come from the store so replays must assign the same ones
+    void editStep(ProfileStoreWriter &writer, ProfileStore &reference, int step)
+    {
+        const std::string name = "P" + std::to_string(step);
+        const auto edit = [&](auto fn)
+        {
+            fn(reference);
+            writer.apply(fn);
+        };
+        switch (step % 4)
+        {
+        case 0:
+            edit([name](ProfileStore &store)
+                 { return store.append(CameraProfile(name, Vector3(), "C" + name)); });
+            break;
+        case 1:
+            edit([name, id = reference.at(reference.size() - 1).id](ProfileStore &store)
+                 { return store.rename(id, name + "r", "t"); });
+            break;
+        case 2:
+            edit([step, id = reference.at(0).id](ProfileStore &store)
+                 { return store.setOffset(id, Vector3(static_cast<float>(step), 0.0f, 0.0f), "t"); });
+            break;
+        default:
+            if (reference.size() > 2)
+            {
+                edit([id = reference.at(1).id](ProfileStore &store)
+                     { return store.erase(id); });
+            }
+            break;
+        }
+    }
+}
+
+TEST_CASE(store_writer_replays_edits_instead_of_copying)
+{
+    ProfileStoreWriter writer;
+    ProfileStore reference;
+    writer.apply([](ProfileStore &store)
+                 { return store.append(CameraProfile("Default")); });
+    reference.append(CameraProfile("Default"));
+
+    std::shared_ptr<const ProfileStore> published;
+    for (int step = 0; step < 200; ++step)
+    {
+        editStep(writer, reference, step);
+        published = writer.share(); // Readers move on to the new store; the old one is free to reuse
+        REQUIRE(sameStore(*published, reference));
+    }
+
+    // Only the first hand-out needed a copy (there was no spare yet)
+    CHECK_EQ(writer.copyCount(), 1u);
+}
+
+TEST_CASE(store_writer_never_changes_a_store_still_held)
+{
+    ProfileStoreWriter writer;
+    ProfileStore reference;
+    writer.apply([](ProfileStore &store)
+                 { return store.append(CameraProfile("Default")); });
+    reference.append(CameraProfile("Default"));
+
+    // A reader keeps every snapshot (a slow save worker); each must stay as it was shared
+    std::vector<std::pair<std::shared_ptr<const ProfileStore>, ProfileStore>> held;
+    for (int step = 0; step < 40; ++step)
+    {
+        editStep(writer, reference, step);
+        held.emplace_back(writer.share(), reference);
+    }
+    for (const auto &snapshot : held)
+        CHECK(sameStore(*snapshot.first, snapshot.second));
+    const uint64_t copies = writer.copyCount();
+    CHECK(copies > 30u);
+
+    // Once they are released, edits replay again
+    held.clear();
+    std::shared_ptr<const ProfileStore> published;
+    for (int step = 40; step < 60; ++step)
+    {
+        editStep(writer, reference, step);
+        published = writer.share();
+        CHECK(sameStore(*published, reference));
+    }
+    CHECK(writer.copyCount() <= copies + 1);
+}
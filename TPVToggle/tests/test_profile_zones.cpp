@@ -0,0 +1,93 @@
+/**
+ * @file test_profile_zones.cpp
+ * @brief ProfileZoneIndex lookups, including points no zone grid should ever see.
+ */
+
+#include "test_framework.h"
+#include "profile_zone_index.h"
+#include "constants.h"
+
+#include <limits>
+
+namespace
+{
+    ProfileZone box(ProfileId id, const Vector3 &min, const Vector3 &max, int priority = 0)
+    {
+        ProfileZone zone;
+        zone.name = "Box " + std::to_string(id);
+        zone.profileId = id;
+        zone.shape = ProfileZone::Shape::Box;
+        zone.min = min;
+        zone.max = max;
+        zone.center = (min + max) * 0.5f;
+        zone.radius = 0.0f;
+        const Vector3 size = max - min;
+        zone.volume = size.x * size.y * size.z;
+        zone.priority = priority;
+        return zone;
+    }
+
+    ProfileZone sphere(ProfileId id, const Vector3 &center, float radius)
+    {
+        ProfileZone zone;
+        zone.name = "Sphere " + std::to_string(id);
+        zone.profileId = id;
+        zone.shape = ProfileZone::Shape::Sphere;
+        zone.center = center;
+        zone.radius = radius;
+        zone.min = center - Vector3(radius, radius, radius);
+        zone.max = center + Vector3(radius, radius, radius);
+        zone.volume = 4.18879f * radius * radius * radius;
+        zone.priority = 0;
+        return zone;
+    }
+
+    ProfileId profileAt(const ProfileZoneIndex &index, const Vector3 &point)
+    {
+        const uint32_t zone = index.find(point);
+        return zone == ProfileZoneIndex::npos ? INVALID_PROFILE_ID : index.zone(zone).profileId;
+    }
+}
+
+TEST_CASE(zones_overlap_resolves_by_priority_then_size)
+{
+    ProfileZoneIndex index(Constants::PROFILE_ZONE_CELL_SIZE);
+    index.build({box(1, Vector3(0, 0, 0), Vector3(100, 100, 10)),
+                 box(2, Vector3(10, 10, 0), Vector3(20, 20, 10)),
+                 box(3, Vector3(50, 50, 0), Vector3(90, 90, 10), 1),
+                 sphere(4, Vector3(60, 60, 5), 5.0f)});
+
+    CHECK_EQ(profileAt(index, Vector3(5, 5, 5)), 1u);
+    CHECK_EQ(profileAt(index, Vector3(15, 15, 5)), 2u);  // Smaller zone wins at equal priority
+    CHECK_EQ(profileAt(index, Vector3(60, 60, 5)), 3u);  // Priority beats the smaller sphere
+    CHECK_EQ(profileAt(index, Vector3(-1, 5, 5)), INVALID_PROFILE_ID);
+}
+
+TEST_CASE(zones_huge_zone_is_found_everywhere_it_covers)
+{
+    // Too many cells to grid: kept in the list every query tests
+    ProfileZoneIndex index(Constants::PROFILE_ZONE_CELL_SIZE);
+    index.build({box(1, Vector3(-50000, -50000, -1000), Vector3(50000, 50000, 1000)),
+                 box(2, Vector3(0, 0, 0), Vector3(4, 4, 4))});
+
+    CHECK_EQ(profileAt(index, Vector3(-49000, 49000, 0)), 1u);
+    CHECK_EQ(profileAt(index, Vector3(2, 2, 2)), 2u);
+}
+
+TEST_CASE(zones_reject_non_finite_and_out_of_range_points)
+{
+    ProfileZoneIndex index(Constants::PROFILE_ZONE_CELL_SIZE);
+    index.build({box(1, Vector3(0, 0, 0), Vector3(10, 10, 10)),
+                 box(2, Vector3(-100, -100, -100), Vector3(100, 100, 100))});
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    CHECK_EQ(index.find(Vector3(nan, 5, 5)), ProfileZoneIndex::npos);
+    CHECK_EQ(index.find(Vector3(5, inf, 5)), ProfileZoneIndex::npos);
+    CHECK_EQ(index.find(Vector3(5, 5, -inf)), ProfileZoneIndex::npos);
+
+    // Far beyond the grid's cell range: clamped to an edge cell, then rejected by the exact test
+    CHECK_EQ(index.find(Vector3(1e30f, 5, 5)), ProfileZoneIndex::npos);
+    CHECK_EQ(index.find(Vector3(-3e38f, -3e38f, -3e38f)), ProfileZoneIndex::npos);
+    CHECK_EQ(profileAt(index, Vector3(5, 5, 5)), 1u);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file test_spsc_queue.cpp
+ * @brief SpscQueue: capacity edges and a producer/consumer stress run.
+ */
+
+#include "test_framework.h"
+#include "spsc_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    // Time-based, so producer and consumer interleave even on a single core
+    constexpr auto STRESS_DURATION = std::chrono::milliseconds(200);
+
+    // Several words, so a torn slot copy would show as mismatched fields
+    struct Message
+    {
+        uint64_t sequence = 0;
+        uint64_t check = 0;
+        uint32_t words[6] = {};
+    };
+
+    Message makeMessage(uint64_t sequence)
+    {
+        Message m;
+        m.sequence = sequence;
+        m.check = ~sequence;
+        for (uint32_t &w : m.words)
+            w = static_cast<uint32_t>(sequence * 2654435761u);
+        return m;
+    }
+
+    bool isIntact(const Message &m)
+    {
+        if (m.check != ~m.sequence)
+            return false;
+        for (uint32_t w : m.words)
+        {
+            if (w != static_cast<uint32_t>(m.sequence * 2654435761u))
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE(spsc_queue_fills_to_capacity_and_wraps)
+{
+    SpscQueue<int, 4> queue;
+    int out = 0;
+    CHECK(queue.empty());
+    CHECK(!queue.pop(out));
+
+    for (int round = 0; round < 3; ++round) // Wraps the indices several times
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            int value = round * 10 + i;
+            CHECK(queue.push(std::move(value)));
+        }
+        int extra = 99;
+        CHECK(!queue.push(std::move(extra)));
+        CHECK_EQ(extra, 99); // Left untouched when full
+
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(queue.pop(out));
+            CHECK_EQ(out, round * 10 + i);
+        }
+        CHECK(queue.empty());
+    }
+}
+
+TEST_CASE(spsc_queue_moves_owning_values)
+{
+    SpscQueue<std::shared_ptr<int>, 2> queue;
+    auto value = std::make_shared<int>(7);
+    std::weak_ptr<int> watch = value;
+    CHECK(queue.push(std::move(value)));
+
+    std::shared_ptr<int> out;
+    REQUIRE(queue.pop(out));
+    CHECK_EQ(*out, 7);
+    out.reset();
+    CHECK(watch.expired()); // The queue keeps no copy behind
+}
+
+TEST_CASE(spsc_queue_stress_delivers_every_message_in_order)
+{
+    SpscQueue<Message, 64> queue;
+    std::atomic<bool> ready{false};
+    std::atomic<bool> producerDone{false};
+    uint64_t produced = 0;
+    uint64_t fullPushes = 0;
+
+    std::thread producer([&]
+                         {
+        while (!ready.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        const auto end = std::chrono::steady_clock::now() + STRESS_DURATION;
+        while (std::chrono::steady_clock::now() < end)
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                Message m = makeMessage(produced);
+                if (queue.push(std::move(m)))
+                    ++produced;
+                else
+                    ++fullPushes;
+            }
+            std::this_thread::yield();
+        }
+        producerDone.store(true, std::memory_order_release); });
+
+    uint64_t consumed = 0, outOfOrder = 0, torn = 0, emptyPops = 0;
+    ready.store(true, std::memory_order_release);
+    Message m;
+    for (;;)
+    {
+        if (queue.pop(m))
+        {
+            if (m.sequence != consumed)
+                ++outOfOrder;
+            if (!isIntact(m))
+                ++torn;
+            consumed = m.sequence + 1;
+            continue;
+        }
+        ++emptyPops;
+        if (producerDone.load(std::memory_order_acquire) && queue.empty())
+            break;
+        if (emptyPops % 64 == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+
+    CHECK_EQ(outOfOrder, 0u);
+    CHECK_EQ(torn, 0u);
+    CHECK_EQ(consumed, produced);
+    CHECK(produced > 1000);
+    // Both edges were exercised: the producer found the queue full and the consumer found it empty
+    CHECK(fullPushes > 0);
+    CHECK(emptyPops > 0);
+}
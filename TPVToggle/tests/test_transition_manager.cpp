@@ -0,0 +1,222 @@
+/**
+ * @file test_transition_manager.cpp
+ * @brief TransitionManager command handoff when the render thread is not consuming,
+ *        and under profile cycles racing a running render loop.
+ */
+
+#include "test_framework.h"
+#include "transition_manager.h"
+#include "game_commands.h"
+#include "global_state.h"
+#include "input_service.h"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    // Every target lies on the line (k, 2k, 3k), so any blend of them does too:
+    // a frame that mixes fields of two commands falls off it.
+    Vector3 cycleTarget(int cycle)
+    {
+        const float k = static_cast<float>(cycle % 97);
+        return Vector3(k, 2.0f * k, 3.0f * k);
+    }
+
+    // What the camera hook's GetActiveOffset does with camera profiles enabled and no path playing
+    Vector3 activeOffset(float deltaTime, Quaternion &outRotation)
+    {
+        Vector3 position;
+        Quaternion rotation;
+        if (TransitionManager::getInstance().updateTransition(deltaTime, position, rotation))
+        {
+            outRotation = rotation;
+            return position;
+        }
+        outRotation = Quaternion::Identity();
+        return g_currentCameraOffset.load();
+    }
+
+    bool isConsistentFrame(const Vector3 &position, const Quaternion &rotation)
+    {
+        const float values[] = {position.x, position.y, position.z, rotation.x, rotation.y, rotation.z, rotation.w};
+        for (float value : values)
+        {
+            if (!std::isfinite(value))
+                return false;
+        }
+        const float tolerance = 1e-3f * (1.0f + std::fabs(position.x));
+        const float norm = rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z +
+                           rotation.w * rotation.w;
+        return std::fabs(position.y - 2.0f * position.x) < 2.0f * tolerance &&
+               std::fabs(position.z - 3.0f * position.x) < 3.0f * tolerance &&
+               std::fabs(rotation.x) < 1e-4f && std::fabs(rotation.y) < 1e-4f && std::fabs(norm - 1.0f) < 1e-3f;
+    }
+}
+
+TEST_CASE(transition_configure_survives_a_full_command_queue)
+{
+    TransitionManager &transitions = TransitionManager::getInstance();
+    Vector3 position;
+    Quaternion rotation;
+    transitions.updateTransition(0.0f, position, rotation); // Start from an empty queue
+
+    // Out of TPV the camera hook does not drain: fill the queue, then configure
+    for (size_t i = 0; i < Constants::TRANSITION_COMMAND_QUEUE_SIZE; ++i)
+        transitions.cancelTransition();
+
+    TransitionSettings settings;
+    settings.duration = 2.0f;
+    REQUIRE(EasingCurve::parse("linear", settings.curve));
+    settings.useSpringPhysics = false;
+    transitions.configure(settings);
+
+    // Back in TPV: the backlog drains, then the next start uses the new settings
+    transitions.updateTransition(0.0f, position, rotation);
+    transitions.startTransition(Vector3(0.0f, 0.0f, 0.0f), Vector3(10.0f, 0.0f, 0.0f), Quaternion::Identity(), -1.0f);
+
+    CHECK(transitions.updateTransition(1.0f, position, rotation)); // Still running after 1 s of 2 s
+    CHECK_NEAR(position.x, 5.0f, 1e-4);
+    CHECK(!transitions.updateTransition(1.0f, position, rotation));
+    CHECK_NEAR(position.x, 10.0f, 1e-6);
+}
+
+TEST_CASE(transition_newer_configure_replaces_a_waiting_one)
+{
+    TransitionManager &transitions = TransitionManager::getInstance();
+    Vector3 position;
+    Quaternion rotation;
+    transitions.updateTransition(0.0f, position, rotation);
+
+    for (size_t i = 0; i < Constants::TRANSITION_COMMAND_QUEUE_SIZE; ++i)
+        transitions.cancelTransition();
+
+    TransitionSettings first;
+    first.duration = 8.0f;
+    REQUIRE(EasingCurve::parse("linear", first.curve));
+    transitions.configure(first);
+    TransitionSettings second = first;
+    second.duration = 4.0f;
+    transitions.configure(second);
+
+    transitions.updateTransition(0.0f, position, rotation);
+    transitions.startTransition(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 8.0f, 0.0f), Quaternion::Identity(), -1.0f);
+
+    CHECK(transitions.updateTransition(1.0f, position, rotation));
+    CHECK_NEAR(position.y, 2.0f, 1e-4); // A quarter of 4 s, not an eighth of 8 s
+    transitions.cancelTransition();
+    transitions.updateTransition(0.0f, position, rotation);
+}
+
+TEST_CASE(transition_profile_cycles_during_frames_never_tear)
+{
+    TransitionManager &transitions = TransitionManager::getInstance();
+    GameCommandQueue &queue = GameCommandQueue::getInstance();
+    InputService &service = InputService::getInstance();
+    Vector3 position;
+    Quaternion rotation;
+    transitions.cancelTransition();
+    transitions.updateTransition(0.0f, position, rotation);
+
+    TransitionSettings settings;
+    settings.duration = 0.05f;
+    REQUIRE(EasingCurve::parse("linear", settings.curve));
+    transitions.configure(settings);
+    g_currentCameraOffset.store(Vector3(0.0f, 0.0f, 0.0f));
+    transitions.updateTransition(0.0f, position, rotation);
+
+    // The input thread runs stall checks, as in game; the render loop below keeps them idle
+    REQUIRE(service.start());
+    queue.setGameThreadAttached(true);
+    queue.onCameraUpdate();
+
+    constexpr int CYCLES = 5000;
+    std::atomic<bool> cycling(true);
+    std::atomic<int> badFrames(0);
+    std::atomic<int> frames(0);
+
+    // Render thread: the camera hook's per-frame sequence, at 240 FPS of simulated time
+    std::thread render([&]
+                       {
+        Quaternion frameRotation;
+        while (cycling.load(std::memory_order_acquire))
+        {
+            queue.beginCameraUpdate();
+            queue.onCameraUpdate();
+            const Vector3 frameOffset = activeOffset(1.0f / 240.0f, frameRotation);
+            if (!isConsistentFrame(frameOffset, frameRotation))
+                badFrames.fetch_add(1, std::memory_order_relaxed);
+            frames.fetch_add(1, std::memory_order_relaxed);
+        } });
+
+    // Profile switches as setActiveProfile queues them, each with a transition. This loop
+    // outruns any player, so it waits for room instead of losing a switch to a full queue.
+    for (int cycle = 1; cycle <= CYCLES; ++cycle)
+    {
+        while (!queue.switchOffset(cycleTarget(cycle), true, std::make_shared<const EasingCurve>(settings.curve)))
+            std::this_thread::yield();
+        if (cycle % 64 == 0)
+            std::this_thread::yield();
+    }
+    // Keep the render loop going until it has seen frames after the last switch
+    const int framesAtLastCycle = frames.load(std::memory_order_relaxed);
+    while (frames.load(std::memory_order_relaxed) < framesAtLastCycle + 100)
+        std::this_thread::yield();
+    cycling.store(false, std::memory_order_release);
+    render.join();
+
+    CHECK_EQ(badFrames.load(), 0);
+    CHECK(frames.load() > 100);
+
+    // Settle: the last target is where the camera ends up, whether its start was applied or dropped
+    queue.onCameraUpdate();
+    for (int frame = 0; frame < 240 && transitions.updateTransition(1.0f / 240.0f, position, rotation); ++frame)
+    {
+    }
+    CHECK(!transitions.isTransitioning());
+    const Vector3 last = cycleTarget(CYCLES);
+    const Vector3 settled = activeOffset(1.0f / 240.0f, rotation);
+    CHECK_NEAR(settled.x, last.x, 1e-4f);
+    CHECK_NEAR(settled.y, last.y, 1e-4f);
+    CHECK_NEAR(settled.z, last.z, 1e-4f);
+
+    service.stop();
+    queue.setGameThreadAttached(false);
+    transitions.configure(TransitionSettings());
+    transitions.updateTransition(0.0f, position, rotation);
+    g_currentCameraOffset.store(Vector3(0.0f, 0.0f, 0.0f));
+}
+
+TEST_CASE(transition_profile_switch_starts_from_nudges_queued_before_it)
+{
+    TransitionManager &transitions = TransitionManager::getInstance();
+    GameCommandQueue &queue = GameCommandQueue::getInstance();
+    Vector3 position;
+    Quaternion rotation;
+    transitions.cancelTransition();
+    TransitionSettings settings;
+    settings.duration = 1.0f;
+    REQUIRE(EasingCurve::parse("linear", settings.curve));
+    transitions.configure(settings);
+    transitions.updateTransition(0.0f, position, rotation);
+    g_currentCameraOffset.store(Vector3(0.0f, 0.0f, 0.0f));
+
+    // A held key nudged the camera, then a switch was queued before either was applied
+    queue.setGameThreadAttached(true);
+    queue.beginCameraUpdate();
+    queue.nudgeOffset(Vector3(2.0f, 0.0f, 0.0f));
+    queue.switchOffset(Vector3(10.0f, 0.0f, 0.0f), true);
+    queue.onCameraUpdate();
+
+    CHECK(transitions.updateTransition(0.5f, position, rotation));
+    CHECK_NEAR(position.x, 6.0f, 1e-4f); // Halfway from the nudged 2, not from 0
+    CHECK(!transitions.updateTransition(0.5f, position, rotation));
+    CHECK_NEAR(g_currentCameraOffset.load().x, 10.0f, 1e-6f); // The nudge is not added on top
+
+    queue.setGameThreadAttached(false);
+    transitions.configure(TransitionSettings());
+    transitions.updateTransition(0.0f, position, rotation);
+    g_currentCameraOffset.store(Vector3(0.0f, 0.0f, 0.0f));
+}